@@ -10,9 +10,11 @@ import java.io.Serializable;
 import java.util.Collections;
 import java.util.Iterator;
 import java.util.LinkedHashSet;
+import java.util.Locale;
 import java.util.Objects;
 import java.util.Optional;
 import java.util.Set;
+import java.util.TreeSet;
 
 /**
  * An index definition in a search definition.
@@ -62,6 +64,12 @@ public class Index implements Cloneable, Serializable {
     /** Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream. */
     private boolean interleavedFeatures = false;
 
+    /** Whether the skip lists of this index field should have block max info (max num occs, min field length). */
+    private boolean blockMax = false;
+
+    /** The common words selecting which adjacent word pairs of this index field are indexed as phrase bigrams. */
+    private Set<String> phraseBigramWords = new TreeSet<>();
+
     public Index(String name) {
         this(name, false);
     }
@@ -123,6 +131,8 @@ public class Index implements Cloneable, Serializable {
         Index index = (Index) o;
         return prefix == index.prefix &&
                interleavedFeatures == index.interleavedFeatures &&
+               blockMax == index.blockMax &&
+               Objects.equals(phraseBigramWords, index.phraseBigramWords) &&
                Objects.equals(name, index.name) &&
                rankType == index.rankType &&
                Objects.equals(aliases, index.aliases) &&
@@ -134,7 +144,7 @@ public class Index implements Cloneable, Serializable {
 
     @Override
     public int hashCode() {
-        return Objects.hash(name, rankType, prefix, aliases, stemming, type, boolIndex, hnswIndexParams, interleavedFeatures);
+        return Objects.hash(name, rankType, prefix, aliases, stemming, type, boolIndex, hnswIndexParams, interleavedFeatures, blockMax, phraseBigramWords);
     }
 
     public String toString() {
@@ -150,6 +160,7 @@ public class Index implements Cloneable, Serializable {
         try {
             Index copy = (Index)super.clone();
             copy.aliases = new LinkedHashSet<>(this.aliases);
+            copy.phraseBigramWords = new TreeSet<>(this.phraseBigramWords);
             return copy;
         }
         catch (CloneNotSupportedException e) {
@@ -197,4 +208,26 @@ public class Index implements Cloneable, Serializable {
         return interleavedFeatures;
     }
 
+    public void setBlockMax(boolean value) {
+        blockMax = value;
+    }
+
+    public boolean useBlockMax() {
+        return blockMax;
+    }
+
+    /** Adds a common word, making adjacent word pairs containing it be indexed as phrase bigrams */
+    public void addPhraseBigramWord(String word) {
+        phraseBigramWords.add(word.toLowerCase(Locale.ENGLISH));
+    }
+
+    /** Returns a read-only sorted set of the common words selecting phrase bigrams */
+    public Set<String> getPhraseBigramWords() {
+        return Collections.unmodifiableSet(phraseBigramWords);
+    }
+
+    public boolean usePhraseBigrams() {
+        return ! phraseBigramWords.isEmpty();
+    }
+
 }
@@ -514,6 +514,12 @@ public class Schema implements ImmutableSchema {
             if (current.useInterleavedFeatures()) {
                 consolidated.setInterleavedFeatures(true);
             }
+            if (current.useBlockMax()) {
+                consolidated.setBlockMax(true);
+            }
+            for (String word : current.getPhraseBigramWords()) {
+                consolidated.addPhraseBigramWord(word);
+            }
 
             if (consolidated.getRankType() == null) {
                 consolidated.setRankType(current.getRankType());
@@ -18,6 +18,7 @@ import java.util.LinkedHashMap;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 
 /**
  * Deriver of indexschema config containing information of all text index fields with name and data type.
@@ -118,7 +119,10 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
                 .prefix(f.hasPrefix())
                 .phrases(false)
                 .positions(true)
-                .interleavedfeatures(f.useInterleavedFeatures());
+                .interleavedfeatures(f.useInterleavedFeatures())
+                .phrasebigrams(f.usePhraseBigrams())
+                .blockmax(f.useBlockMax())
+                .phrasebigramword(f.getPhraseBigramWords());
             if (!f.getCollectionType().equals("SINGLE")) {
                 ifB.collectiontype(IndexschemaConfig.Indexfield.Collectiontype.Enum.valueOf(f.getCollectionType()));
             }
@@ -177,6 +181,12 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
         // Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream.
         private boolean interleavedFeatures = false;
 
+        // Whether the skip lists of this index field should have block max info. Requires interleaved features.
+        private boolean blockMax = false;
+
+        // The common words selecting which adjacent word pairs are indexed as phrase bigrams.
+        private Set<String> phraseBigramWords = Set.of();
+
         public IndexField(String name, Index.Type type, DataType sdFieldType) {
             this.name = name;
             this.type = type;
@@ -186,6 +196,8 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
             if (type.equals(Index.Type.TEXT)) {
                 prefix = index.isPrefix();
                 interleavedFeatures = index.useInterleavedFeatures();
+                blockMax = index.useBlockMax();
+                phraseBigramWords = index.getPhraseBigramWords();
             }
         }
         public String getName() { return name; }
@@ -204,6 +216,9 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
 	    }
         public boolean hasPrefix() { return prefix; }
         public boolean useInterleavedFeatures() { return interleavedFeatures; }
+        public boolean useBlockMax() { return blockMax; }
+        public boolean usePhraseBigrams() { return ! phraseBigramWords.isEmpty(); }
+        public Set<String> getPhraseBigramWords() { return phraseBigramWords; }
     }
 
     /**
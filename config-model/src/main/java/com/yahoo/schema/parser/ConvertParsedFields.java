@@ -271,6 +271,10 @@ public class ConvertParsedFields {
             index.setBooleanIndexDefiniton(bid);
         }
         parsed.getEnableBm25().ifPresent(enableBm25 -> index.setInterleavedFeatures(enableBm25));
+        parsed.getEnableBlockMax().ifPresent(enableBlockMax -> index.setBlockMax(enableBlockMax));
+        for (String word : parsed.getPhraseBigramWords()) {
+            index.addPhraseBigramWord(word);
+        }
         parsed.getHnswIndexParams().ifPresent
             (hnswIndexParams -> index.setHnswIndexParams(hnswIndexParams));
     }
@@ -17,9 +17,11 @@ import java.util.Optional;
 class ParsedIndex extends ParsedBlock {
 
     private Boolean enableBm25 = null;
+    private Boolean enableBlockMax = null;
     private Boolean isPrefix = null;
     private HnswIndexParams hnswParams = null;
     private final List<String> aliases = new ArrayList<>();
+    private final List<String> phraseBigramWords = new ArrayList<>();
     private Stemming stemming = null;
     private Integer arity = null;
     private Long lowerBound = null;
@@ -31,9 +33,11 @@ class ParsedIndex extends ParsedBlock {
     }
 
     Optional<Boolean> getEnableBm25() { return Optional.ofNullable(this.enableBm25); }
+    Optional<Boolean> getEnableBlockMax() { return Optional.ofNullable(this.enableBlockMax); }
     Optional<Boolean> getPrefix() { return Optional.ofNullable(this.isPrefix); }
     Optional<HnswIndexParams> getHnswIndexParams() { return Optional.ofNullable(this.hnswParams); }
     List<String> getAliases() { return List.copyOf(aliases); }
+    List<String> getPhraseBigramWords() { return List.copyOf(phraseBigramWords); }
     boolean hasStemming() { return stemming != null; }
     Optional<Stemming> getStemming() { return Optional.ofNullable(stemming); }
     Optional<Integer> getArity() { return Optional.ofNullable(this.arity); }
@@ -45,6 +49,10 @@ class ParsedIndex extends ParsedBlock {
         aliases.add(alias);
     }
 
+    void addPhraseBigramWord(String word) {
+        phraseBigramWords.add(word);
+    }
+
     void setArity(int arity) {
         this.arity = arity;
     }
@@ -57,6 +65,10 @@ class ParsedIndex extends ParsedBlock {
         this.enableBm25 = value;
     }
 
+    void setEnableBlockMax(boolean value) {
+        this.enableBlockMax = value;
+    }
+
     void setHnswIndexParams(HnswIndexParams params) {
         this.hnswParams = params;
     }
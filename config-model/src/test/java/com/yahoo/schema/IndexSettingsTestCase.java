@@ -7,9 +7,11 @@ import com.yahoo.schema.parser.ParseException;
 import org.junit.jupiter.api.Test;
 
 import java.io.IOException;
+import java.util.List;
 
 import static com.yahoo.config.model.test.TestUtil.joinLines;
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
 /**
@@ -59,4 +61,50 @@ public class IndexSettingsTestCase extends AbstractSchemaTestCase {
         assertTrue(extraIndex.useInterleavedFeatures());
     }
 
+    @Test
+    void requireThatBlockMaxCanBeEnabled() throws ParseException {
+        ApplicationBuilder builder = ApplicationBuilder.createFromString(joinLines(
+                "search test {",
+                "  document test {",
+                "    field content type string {",
+                "      indexing: index | summary",
+                "      index: enable-bm25",
+                "      index: enable-block-max",
+                "    }",
+                "    field other type string {",
+                "      indexing: index | summary",
+                "      index: enable-bm25",
+                "    }",
+                "  }",
+                "}"
+        ));
+        Schema schema = builder.getSchema();
+        assertTrue(schema.getIndex("content").useBlockMax());
+        assertFalse(schema.getIndex("other").useBlockMax());
+    }
+
+    @Test
+    void requireThatPhraseBigramsAreSelectedByCommonWords() throws ParseException {
+        ApplicationBuilder builder = ApplicationBuilder.createFromString(joinLines(
+                "search test {",
+                "  document test {",
+                "    field content type string {",
+                "      indexing: index | summary",
+                "      index: phrase-bigrams: the, Of",
+                "      index: phrase-bigrams: a",
+                "    }",
+                "    field other type string {",
+                "      indexing: index | summary",
+                "      index: enable-bm25",
+                "    }",
+                "  }",
+                "}"
+        ));
+        Schema schema = builder.getSchema();
+        Index content = schema.getIndex("content");
+        assertTrue(content.usePhraseBigrams());
+        assertEquals(List.of("a", "of", "the"), List.copyOf(content.getPhraseBigramWords()));
+        assertFalse(schema.getIndex("other").usePhraseBigrams());
+    }
+
 }
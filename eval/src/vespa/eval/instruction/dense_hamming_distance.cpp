@@ -4,7 +4,7 @@
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/hamming_distance.h>
-#include <vespa/vespalib/util/binary_hamming_distance.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".eval.instruction.dense_hamming_distance");
@@ -15,12 +15,14 @@ using namespace tensor_function;
 
 namespace {
 
+static const auto &hw = hwaccelrated::IAccelrated::getAccelerator();
+
 void int8_hamming_to_double_op(InterpretedFunction::State &state, uint64_t vector_size) {
     const auto &lhs = state.peek(1);
     const auto &rhs = state.peek(0);
     auto a = lhs.cells();
     auto b = rhs.cells();
-    double result = binary_hamming_distance(a.data, b.data, vector_size);
+    double result = hw.binaryHammingDistance(a.data, b.data, vector_size);
     state.pop_pop_push(state.stash.create<DoubleValue>(result));
 }
 
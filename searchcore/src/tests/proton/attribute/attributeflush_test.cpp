@@ -240,6 +240,7 @@ private:
     void requireThatFlushedAttributeCanBeLoaded();
 
     void requireThatFlushFailurePreventsSyncTokenUpdate();
+    void requireThatDeltaFlushIsUsedWhenFewDocumentsAreChanged();
 public:
     int
     Main() override;
@@ -654,6 +655,46 @@ Test::requireThatFlushFailurePreventsSyncTokenUpdate()
     EXPECT_EQUAL(0u, flush_target->getFlushedSerialNum());
 }
 
+void
+Test::requireThatDeltaFlushIsUsedWhenFewDocumentsAreChanged()
+{
+    constexpr uint32_t numDocs = 100000;
+    BaseFixture f;
+    {
+        AttributeManagerFixture amf(f);
+        AttributeManager &am = amf._m;
+        AttributeVector::SP av = amf.addAttribute("a13");
+        IntegerAttribute & ia = static_cast<IntegerAttribute &>(*av);
+        av->addDocs(numDocs);
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            ia.update(i + 1, i + 43);
+        }
+        av->commit(CommitParam(100, CommitParam::UpdateStats::FORCE));
+        IFlushTarget::SP ft = am.getFlushable("a13");
+        (static_cast<FlushableAttribute *>(ft.get()))->setCleanUpAfterFlush(false);
+        uint64_t fullFlushBytes = ft->getApproxBytesToWriteToDisk();
+        ft->initFlush(100, std::make_shared<search::FlushToken>())->run();
+        ia.update(10, 1000);
+        av->commit(CommitParam(200, CommitParam::UpdateStats::FORCE));
+        EXPECT_LESS(ft->getApproxBytesToWriteToDisk() * 10, fullFlushBytes);
+        ft->initFlush(200, std::make_shared<search::FlushToken>())->run();
+        EXPECT_EQUAL(200u, ft->getFlushedSerialNum());
+        // Only the changed documents are written, the data file is shared with the full flush
+        EXPECT_TRUE(std::filesystem::exists("flush/a13/snapshot-200/a13.ddat"));
+        EXPECT_TRUE(std::filesystem::equivalent("flush/a13/snapshot-100/a13.dat", "flush/a13/snapshot-200/a13.dat"));
+        EXPECT_LESS(std::filesystem::file_size("flush/a13/snapshot-200/a13.ddat") * 10,
+                    std::filesystem::file_size("flush/a13/snapshot-200/a13.dat"));
+    }
+    {
+        AttributeManagerFixture amf(f);
+        AttributeVector::SP av = amf.addAttribute("a13");
+        EXPECT_EQUAL(numDocs + 1, av->getNumDocs());
+        EXPECT_EQUAL(1000, av->getInt(10));
+        EXPECT_EQUAL(53, av->getInt(11));
+        EXPECT_EQUAL(100u, av->getDeltaSaveBaseSerialNum());
+    }
+}
+
 int
 Test::Main()
 {
@@ -674,6 +715,7 @@ Test::Main()
     TEST_DO(requireThatShrinkWorks());
     TEST_DO(requireThatFlushedAttributeCanBeLoaded());
     TEST_DO(requireThatFlushFailurePreventsSyncTokenUpdate());
+    TEST_DO(requireThatDeltaFlushIsUsedWhenFewDocumentsAreChanged());
 
     TEST_DONE();
 }
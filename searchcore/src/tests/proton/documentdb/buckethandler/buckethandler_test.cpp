@@ -3,6 +3,7 @@
 #include <vespa/searchcore/proton/server/ibucketstatechangedhandler.h>
 #include <vespa/searchcore/proton/server/ibucketmodifiedhandler.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
+#include <vespa/searchcore/proton/common/docid_limit.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/test/test.h>
 #include <vespa/persistence/spi/test.h>
@@ -93,6 +94,7 @@ struct Fixture
     ThreadStackExecutor             _exec;
     BucketHandler                   _handler;
     MyChangedHandler                _changedHandler;
+    DocIdLimit                      _readyDocIdLimit;
     BucketStateCalculator::SP       _calc;
     test::BucketIdListResultHandler _bucketList;
     test::BucketInfoResultHandler   _bucketInfo;
@@ -106,6 +108,7 @@ struct Fixture
           _exec(1, 64000),
           _handler(_exec),
           _changedHandler(),
+          _readyDocIdLimit(0),
           _calc(new BucketStateCalculator()),
           _bucketList(), _bucketInfo(),
           _genResult(std::make_shared<test::GenericResultHandler>())
@@ -124,7 +127,7 @@ struct Fixture
         _notReady.insertDocs(_builder.clearDocs().
                                       createDocs(4, 22, 24). // 2 docs
                                       getDocs());
-        _handler.setReadyBucketHandler(_ready._metaStore);
+        _handler.setReadyBucketHandler(_ready._metaStore, &_readyDocIdLimit);
         _handler.addBucketStateChangedHandler(&_changedHandler);
         _handler.notifyClusterStateChanged(_calc);
     }
@@ -215,6 +218,21 @@ TEST_F("require that changed handlers are notified when bucket state changes", F
 }
 
 
+TEST_F("require that bucket state changes bump commit generation of ready sub db", Fixture)
+{
+    uint64_t generation = f._readyDocIdLimit.getCommitGeneration();
+    f._handler.handleSetCurrentState(f._ready.bucket(2), BucketInfo::ACTIVE, f._genResult);
+    f.sync();
+    EXPECT_EQUAL(generation + 1, f._readyDocIdLimit.getCommitGeneration());
+    f._handler.handlePopulateActiveBuckets({f._ready.bucket(3)}, *f._genResult);
+    f.sync();
+    EXPECT_EQUAL(generation + 2, f._readyDocIdLimit.getCommitGeneration());
+    f.setNodeUp(false);
+    f.sync();
+    EXPECT_EQUAL(generation + 3, f._readyDocIdLimit.getCommitGeneration());
+}
+
+
 TEST_F("require that unready bucket can be reported as active", Fixture)
 {
     f._handler.handleSetCurrentState(f._ready.bucket(4),
@@ -3,11 +3,14 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
 
 using namespace proton;
+using proton::matching::BudgetedThreadBundle;
+using proton::matching::ThreadBudget;
 using namespace search::engine;
 using namespace vespalib::slime;
 using vespalib::Slime;
@@ -118,13 +121,21 @@ TEST("requireThatCorrectHandlerIsUsed")
 struct ObserveBundleMatchHandler : MySearchHandler {
     typedef std::shared_ptr<ObserveBundleMatchHandler> SP;
     mutable size_t bundleSize;
-    ObserveBundleMatchHandler() : bundleSize(0) {}
+    size_t wantedThreads;
+    mutable size_t reservedThreads;
+    ObserveBundleMatchHandler(size_t wantedThreads_in = 0)
+        : bundleSize(0), wantedThreads(wantedThreads_in), reservedThreads(0) {}
 
     search::engine::SearchReply::UP match(
             const search::engine::SearchRequest &,
             vespalib::ThreadBundle &threadBundle) const override
     {
         bundleSize = threadBundle.size();
+        if (wantedThreads > 0) {
+            // as done by the matcher when the hit estimate is known
+            auto &budgeted = dynamic_cast<BudgetedThreadBundle &>(threadBundle);
+            reservedThreads = budgeted.reserve(wantedThreads);
+        }
         return std::make_unique<SearchReply>();
     }
 };
@@ -146,6 +157,95 @@ TEST("requireThatBundlesAreUsed")
     EXPECT_EQUAL(5u, handler->bundleSize);
 }
 
+TEST("require that idle threads can be borrowed by a search")
+{
+    MatchEngine engine(8, 2, 6, 7, true);
+    engine.setNodeUp(true);
+
+    auto handler = std::make_shared<ObserveBundleMatchHandler>(6);
+    DocTypeName dtnvfoo("foo");
+    engine.putSearchHandler(dtnvfoo, handler);
+
+    LocalSearchClient client;
+    SearchRequest::Source request(new SearchRequest());
+    engine.search(std::move(request), client);
+    SearchReply::UP reply = client.getReply(10000);
+    // only the guaranteed threads until the query asks for more
+    EXPECT_EQUAL(2u, handler->bundleSize);
+    EXPECT_EQUAL(6u, handler->reservedThreads);
+    EXPECT_EQUAL(8u, engine.get_thread_budget().total());
+    EXPECT_EQUAL(0u, engine.get_thread_budget().used());
+}
+
+struct CountingThreadBundle : vespalib::ThreadBundle {
+    ThreadBudget &budget;
+    size_t bundleSize;
+    size_t usedDuringRun;
+    CountingThreadBundle(ThreadBudget &budget_in, size_t size_in)
+        : budget(budget_in), bundleSize(size_in), usedDuringRun(0) {}
+    size_t size() const override { return bundleSize; }
+    void run(const std::vector<vespalib::Runnable*> &) override {
+        usedDuringRun = budget.used();
+    }
+};
+
+struct CountingRunnable : vespalib::Runnable {
+    std::atomic<size_t> &count;
+    explicit CountingRunnable(std::atomic<size_t> &count_in) : count(count_in) {}
+    void run() override { ++count; }
+};
+
+TEST("require that budgeted thread bundle reserves threads when asked")
+{
+    ThreadBudget budget(8);
+    CountingThreadBundle bundle(budget, 2);
+    vespalib::SimpleThreadBundle::Pool pool(6);
+    {
+        BudgetedThreadBundle first(bundle, pool, budget, 6);
+        EXPECT_EQUAL(2u, first.size());
+        EXPECT_EQUAL(2u, budget.used());
+        EXPECT_EQUAL(6u, first.reserve(10));
+        EXPECT_EQUAL(6u, budget.used());
+        BudgetedThreadBundle second(bundle, pool, budget, 6);
+        EXPECT_EQUAL(8u, budget.used());
+        EXPECT_EQUAL(2u, second.reserve(6));
+        EXPECT_EQUAL(8u, budget.used());
+        // unused threads are given back
+        EXPECT_EQUAL(1u, first.reserve(1));
+        EXPECT_EQUAL(3u, budget.used());
+        EXPECT_EQUAL(6u, second.reserve(6));
+        EXPECT_EQUAL(7u, budget.used());
+        // the threads of the wrapped bundle are always available
+        budget.acquire(1);
+        EXPECT_EQUAL(2u, first.reserve(4));
+        EXPECT_EQUAL(9u, budget.used());
+        budget.release(1);
+        EXPECT_EQUAL(1u, second.reserve(0));
+        EXPECT_EQUAL(3u, budget.used());
+    }
+    EXPECT_EQUAL(0u, budget.used());
+}
+
+TEST("require that borrowed threads run in a bundle from the pool")
+{
+    ThreadBudget budget(8);
+    CountingThreadBundle bundle(budget, 2);
+    vespalib::SimpleThreadBundle::Pool pool(6);
+    {
+        BudgetedThreadBundle budgeted(bundle, pool, budget, 6);
+        EXPECT_EQUAL(4u, budgeted.reserve(4));
+        std::vector<vespalib::Runnable*> few(2, nullptr);
+        budgeted.run(few);
+        EXPECT_EQUAL(4u, bundle.usedDuringRun);
+        std::atomic<size_t> count(0);
+        CountingRunnable runnable(count);
+        std::vector<vespalib::Runnable*> many(4, &runnable);
+        budgeted.run(many);
+        EXPECT_EQUAL(4u, count.load());
+    }
+    EXPECT_EQUAL(0u, budget.used());
+}
+
 TEST("requireThatHandlersCanBeRemoved")
 {
     MatchEngine engine(1, 1, 7);
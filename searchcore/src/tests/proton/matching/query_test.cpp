@@ -29,6 +29,7 @@
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/document/datatype/positiondatatype.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/log/log.h>
@@ -115,6 +116,7 @@ class Test : public vespalib::TestApp {
     void requireThatWeakAndBlueprintsAreCreatedCorrectly();
     void requireThatParallelWandBlueprintsAreCreatedCorrectly();
     void requireThatWhiteListBlueprintCanBeUsed();
+    void requireThatBlockMaxCanBeEnabledForWeakAnd();
     void requireThatRankBlueprintStaysOnTopAfterWhiteListing();
     void requireThatAndNotBlueprintStaysOnTopAfterWhiteListing();
     void requireThatSameElementTermsAreProperlyPrefixed();
@@ -971,6 +973,38 @@ Test::requireThatWhiteListBlueprintCanBeUsed()
     EXPECT_EQUAL(exp, act);
 }
 
+void
+Test::requireThatBlockMaxCanBeEnabledForWeakAnd()
+{
+    using search::queryeval::WeakAndBlueprint;
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(2);
+    builder.addStringTerm("foo", field, field_id, string_weight);
+    builder.addWeakAnd(2, 10, field);
+    builder.addStringTerm("foo", field, field_id, string_weight);
+    builder.addStringTerm("bar", field, field_id, string_weight);
+    std::string stackDump = StackDumpCreator::create(*builder.build());
+
+    Query query;
+    query.buildTree(stackDump, "", ViewResolver(), plain_index_env);
+    FakeSearchContext context(42);
+    context.addIdx(0).idx(0).getFake()
+        .addResult(field, "foo", FakeResult().doc(1).doc(3))
+        .addResult(field, "bar", FakeResult().doc(2).doc(3));
+    FakeRequestContext requestContext;
+    MatchDataLayout mdl;
+    query.reserveHandles(requestContext, context, mdl);
+
+    auto *root = dynamic_cast<const IntermediateBlueprint *>(query.peekRoot());
+    ASSERT_TRUE(root != nullptr);
+    ASSERT_EQUAL(2u, root->childCnt());
+    auto *wbp = dynamic_cast<const WeakAndBlueprint *>(&root->getChild(1));
+    ASSERT_TRUE(wbp != nullptr);
+    EXPECT_FALSE(wbp->use_block_max());
+    query.enable_block_max_weak_and(42.0);
+    EXPECT_TRUE(wbp->use_block_max());
+}
+
 template<typename T1, typename T2>
 void verifyThatRankBlueprintAndAndNotStaysOnTopAfterWhiteListing(QueryBuilder<ProtonNodeTypes> & builder) {
     builder.addStringTerm("foo", field, field_id, string_weight);
@@ -1139,23 +1173,24 @@ Test::global_filter_is_calculated_and_handled()
     // estimated hits = 3, estimated hit ratio = 0.3
     auto result = SimpleResult().addHit(3).addHit(5).addHit(7);
     uint32_t docid_limit = 10;
+    auto &thread_bundle = vespalib::ThreadBundle::trivial();
     { // global filter is not wanted
         GlobalFilterBlueprint bp(result, false);
-        auto res = Query::handle_global_filter(bp, docid_limit, 0, 1, nullptr);
+        auto res = Query::handle_global_filter(bp, docid_limit, 0, 1, thread_bundle, nullptr);
         EXPECT_FALSE(res);
         EXPECT_FALSE(bp.filter);
         EXPECT_EQUAL(-1.0, bp.estimated_hit_ratio);
     }
     { // estimated_hit_ratio < global_filter_lower_limit
         GlobalFilterBlueprint bp(result, true);
-        auto res = Query::handle_global_filter(bp, docid_limit, 0.31, 1, nullptr);
+        auto res = Query::handle_global_filter(bp, docid_limit, 0.31, 1, thread_bundle, nullptr);
         EXPECT_FALSE(res);
         EXPECT_FALSE(bp.filter);
         EXPECT_EQUAL(-1.0, bp.estimated_hit_ratio);
     }
     { // estimated_hit_ratio <= global_filter_upper_limit
         GlobalFilterBlueprint bp(result, true);
-        auto res = Query::handle_global_filter(bp, docid_limit, 0, 0.3, nullptr);
+        auto res = Query::handle_global_filter(bp, docid_limit, 0, 0.3, thread_bundle, nullptr);
         EXPECT_TRUE(res);
         EXPECT_TRUE(bp.filter);
         EXPECT_TRUE(bp.filter->has_filter());
@@ -1169,7 +1204,7 @@ Test::global_filter_is_calculated_and_handled()
     }
     { // estimated_hit_ratio > global_filter_upper_limit
         GlobalFilterBlueprint bp(result, true);
-        auto res = Query::handle_global_filter(bp, docid_limit, 0, 0.29, nullptr);
+        auto res = Query::handle_global_filter(bp, docid_limit, 0, 0.29, thread_bundle, nullptr);
         EXPECT_TRUE(res);
         EXPECT_TRUE(bp.filter);
         EXPECT_FALSE(bp.filter->has_filter());
@@ -1210,6 +1245,7 @@ Test::Main()
     TEST_CALL(requireThatWeakAndBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatParallelWandBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatWhiteListBlueprintCanBeUsed);
+    TEST_CALL(requireThatBlockMaxCanBeEnabledForWeakAnd);
     TEST_CALL(requireThatRankBlueprintStaysOnTopAfterWhiteListing);
     TEST_CALL(requireThatAndNotBlueprintStaysOnTopAfterWhiteListing);
     TEST_CALL(requireThatSameElementTermsAreProperlyPrefixed);
@@ -6,6 +6,9 @@
 #include <vespa/searchcore/proton/matching/session_manager_explorer.h>
 #include <vespa/searchcore/proton/matching/search_session.h>
 #include <vespa/searchcore/proton/matching/match_tools.h>
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -19,6 +22,8 @@ using namespace proton;
 using namespace proton::matching;
 using vespalib::StateExplorer;
 using vespalib::steady_time;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
 
 namespace {
 
@@ -84,6 +89,130 @@ TEST("require that SessionManager can be explored") {
     EXPECT_EQUAL(3u, full_state.get()["sessions"].entries());
 }
 
+void fill_request(SearchRequest &request, const vespalib::string &query) {
+    request.stackDump.assign(query.begin(), query.end());
+    request.ranking = "default";
+    request.maxhits = 10;
+}
+
+SearchReply make_reply(uint64_t total_hits) {
+    SearchReply reply;
+    reply.totalHitCount = total_hits;
+    reply.hits.resize(2);
+    reply.hits[0].metric = 2.0;
+    reply.hits[1].metric = 1.0;
+    return reply;
+}
+
+TEST("require that result cache keys depend on everything affecting the result") {
+    SearchRequest a;
+    SearchRequest b;
+    fill_request(a, "foo");
+    fill_request(b, "foo");
+    EXPECT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(b));
+    b.propertiesMap.lookupCreate(search::MapNames::RANK).add("x", "1");
+    EXPECT_NOT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(b));
+    a.propertiesMap.lookupCreate(search::MapNames::RANK).add("x", "1");
+    EXPECT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(b));
+    b.offset = 10;
+    EXPECT_NOT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(b));
+    SearchRequest c;
+    fill_request(c, "bar");
+    EXPECT_NOT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(c));
+    c.propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "");
+    fill_request(c, "foo");
+    c.propertiesMap.lookupCreate(search::MapNames::RANK).add("x", "1");
+    EXPECT_EQUAL(ResultCache::make_key(a), ResultCache::make_key(c));
+}
+
+TEST("require that requests using sessions or grouping are not cached") {
+    SearchRequest request;
+    fill_request(request, "foo");
+    EXPECT_TRUE(ResultCache::can_cache(request));
+    request.sessionId.push_back('x');
+    EXPECT_FALSE(ResultCache::can_cache(request));
+    request.sessionId.clear();
+    request.groupSpec.push_back('x');
+    EXPECT_FALSE(ResultCache::can_cache(request));
+}
+
+TEST("require that result cache is disabled by default") {
+    SessionManager session_manager(10);
+    EXPECT_FALSE(session_manager.getResultCache().enabled());
+}
+
+TEST("require that cached results are invalidated by new commit generations") {
+    SessionManager session_manager(10, 10, vespalib::duration::zero());
+    ResultCache &cache = session_manager.getResultCache();
+    EXPECT_TRUE(cache.enabled());
+    steady_time now(100ns);
+    EXPECT_TRUE(cache.lookup("foo", 1, now).get() == nullptr);
+    cache.insert("foo", 1, now, make_reply(42));
+    auto reply = cache.lookup("foo", 1, now + 1s);
+    ASSERT_TRUE(reply.get() != nullptr);
+    EXPECT_EQUAL(42u, reply->totalHitCount);
+    EXPECT_EQUAL(2u, reply->hits.size());
+    EXPECT_EQUAL(2.0, reply->hits[0].metric);
+    EXPECT_TRUE(cache.lookup("foo", 2, now + 1s).get() == nullptr);
+    EXPECT_TRUE(cache.lookup("foo", 1, now + 1s).get() == nullptr);
+    auto stats = session_manager.getResultCacheStats();
+    EXPECT_EQUAL(4u, stats.numLookup);
+    EXPECT_EQUAL(1u, stats.numHit);
+    EXPECT_EQUAL(1u, stats.numInsert);
+    EXPECT_EQUAL(1u, stats.numInvalidated);
+    EXPECT_EQUAL(0u, stats.numCached);
+}
+
+TEST("require that cached results can be used until they are too stale") {
+    SessionManager session_manager(10, 10, 5s);
+    ResultCache &cache = session_manager.getResultCache();
+    steady_time now(100ns);
+    cache.insert("foo", 1, now, make_reply(42));
+    EXPECT_TRUE(cache.lookup("foo", 2, now + 4s).get() != nullptr);
+    EXPECT_TRUE(cache.lookup("foo", 2, now + 6s).get() == nullptr);
+}
+
+TEST("require that cleared result cache does not cache results matched before it was cleared") {
+    SessionManager session_manager(10, 10, 5s);
+    ResultCache &cache = session_manager.getResultCache();
+    steady_time now(100ns);
+    cache.insert("foo", 1, now, make_reply(42));
+    cache.clear(now + 2s);
+    EXPECT_TRUE(cache.lookup("foo", 1, now + 2s).get() == nullptr);
+    cache.insert("foo", 1, now + 1s, make_reply(42));
+    EXPECT_TRUE(cache.lookup("foo", 1, now + 2s).get() == nullptr);
+    cache.insert("foo", 1, now + 2s, make_reply(42));
+    EXPECT_TRUE(cache.lookup("foo", 1, now + 2s).get() != nullptr);
+    auto stats = session_manager.getResultCacheStats();
+    EXPECT_EQUAL(2u, stats.numInsert);
+    EXPECT_EQUAL(1u, stats.numInvalidated);
+}
+
+TEST("require that result cache is bounded") {
+    SessionManager session_manager(10, 2, vespalib::duration::zero());
+    ResultCache &cache = session_manager.getResultCache();
+    steady_time now(100ns);
+    cache.insert("a", 1, now, make_reply(1));
+    cache.insert("b", 1, now, make_reply(2));
+    cache.insert("c", 1, now, make_reply(3));
+    EXPECT_TRUE(cache.lookup("a", 1, now).get() == nullptr);
+    EXPECT_TRUE(cache.lookup("c", 1, now).get() != nullptr);
+    auto stats = session_manager.getResultCacheStats();
+    EXPECT_EQUAL(1u, stats.numDropped);
+    EXPECT_EQUAL(2u, stats.numCached);
+    EXPECT_GREATER(stats.memoryUsage, 0u);
+}
+
+TEST("require that results degraded by timeout are not cached") {
+    SessionManager session_manager(10, 10, vespalib::duration::zero());
+    ResultCache &cache = session_manager.getResultCache();
+    steady_time now(100ns);
+    auto reply = make_reply(42);
+    reply.coverage.degradeTimeout();
+    cache.insert("foo", 1, now, reply);
+    EXPECT_TRUE(cache.lookup("foo", 1, now).get() == nullptr);
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -42,6 +42,11 @@ convertStatusToSlime(const Status &status, Cursor &object)
         memory.setLong("onHoldBytes", status.getOnHold());
         memory.setLong("onHoldBytesMax", status.getOnHoldMax());
     }
+    {
+        Cursor &compaction = object.setObject("compaction");
+        compaction.setLong("steps", status.getCompactions());
+        compaction.setDouble("timeSeconds", vespalib::to_s(status.getCompactionTime()));
+    }
 }
 
 void
@@ -11,8 +11,10 @@
 #include <vespa/searchlib/attribute/attributememorysavetarget.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/fastos/file.h>
 #include <filesystem>
 #include <fstream>
 #include <future>
@@ -28,6 +30,33 @@ using searchcorespi::IFlushTarget;
 
 namespace proton {
 
+namespace {
+
+/*
+ * A delta flush writes all documents changed since the last full flush.
+ * When this grows beyond the given fraction of a full flush, a full flush
+ * is performed instead, merging the changes into a new base data file.
+ */
+constexpr double max_delta_flush_size_ratio = 0.25;
+
+uint64_t
+getSerialNumTag(const vespalib::string &fileName)
+{
+    FastOS_File file(fileName.c_str());
+    if (!file.OpenReadOnly()) {
+        return 0;
+    }
+    vespalib::FileHeader header;
+    try {
+        header.readFile(file);
+    } catch (const vespalib::IllegalHeaderException &) {
+        return 0;
+    }
+    return header.hasTag("serialNum") ? header.getTag("serialNum").asInteger() : 0;
+}
+
+}
+
 /**
  * Task performing the actual flushing to disk.
  **/
@@ -38,8 +67,10 @@ private:
     std::unique_ptr<search::AttributeSaver>   _saver;
     uint64_t                                  _syncToken;
     vespalib::string                          _flushFile;
+    vespalib::string                          _baseDatFile; // set for delta flush
 
     bool saveAttribute(); // not updating snap info.
+    bool linkBaseDatFile();
 public:
     Flusher(FlushableAttribute & fattr, uint64_t syncToken, AttributeDirectory::Writer &writer);
     ~Flusher() override;
@@ -61,13 +92,23 @@ FlushableAttribute::Flusher::Flusher(FlushableAttribute & fattr, SerialNum syncT
       _saveTarget(),
       _saver(),
       _syncToken(syncToken),
-      _flushFile("")
+      _flushFile(""),
+      _baseDatFile()
 {
     fattr._attr->commit(CommitParam(syncToken));
     AttributeVector &attr = *_fattr._attr;
     // Called by attribute field writer executor
     _flushFile = writer.getSnapshotDir(_syncToken) + "/" + attr.getName();
-    _saver = attr.initSave(_flushFile);
+    _baseDatFile = _fattr.getDeltaFlushBaseDatFile();
+    if (!_baseDatFile.empty()) {
+        _saver = attr.initDeltaSave(_flushFile);
+        if (!_saver) {
+            _baseDatFile.clear();
+        }
+    }
+    if (!_saver) {
+        _saver = attr.initSave(_flushFile);
+    }
     if (!_saver) {
         // New style background save not available, use old style save.
         attr.save(_saveTarget, _flushFile);
@@ -99,6 +140,24 @@ FlushableAttribute::Flusher::saveAttribute()
     return saveSuccess;
 }
 
+bool
+FlushableAttribute::Flusher::linkBaseDatFile()
+{
+    // The save target always writes a data file, replace it with the base data file
+    std::error_code ec;
+    std::filesystem::path datFile(_flushFile + ".dat");
+    std::filesystem::remove(datFile, ec);
+    if (!ec) {
+        std::filesystem::create_hard_link(std::filesystem::path(_baseDatFile), datFile, ec);
+    }
+    if (ec) {
+        LOG(warning, "Could not link base data file '%s' to '%s': %s",
+            _baseDatFile.c_str(), datFile.c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
 bool
 FlushableAttribute::Flusher::flush(AttributeDirectory::Writer &writer)
 {
@@ -107,6 +166,9 @@ FlushableAttribute::Flusher::flush(AttributeDirectory::Writer &writer)
         LOG(warning, "Could not write attribute vector '%s' to disk", _flushFile.c_str());
         return false;
     }
+    if (!_baseDatFile.empty() && !linkBaseDatFile()) {
+        return false;
+    }
     writer.markValidSnapshot(_syncToken);
     writer.setLastFlushTime(search::FileKit::getModificationTime(vespalib::dirname(_flushFile)));
     return true;
@@ -203,6 +265,30 @@ FlushableAttribute::getLastFlushTime() const
     return _attrDir->getLastFlushTime();
 }
 
+bool
+FlushableAttribute::useDeltaFlush() const
+{
+    if (_attr->getDeltaSaveBaseSerialNum() == 0 || getFlushedSerialNum() == 0) {
+        return false;
+    }
+    return _attr->getEstimatedDeltaSaveByteSize() <= max_delta_flush_size_ratio * _attr->getEstimatedSaveByteSize();
+}
+
+vespalib::string
+FlushableAttribute::getDeltaFlushBaseDatFile() const
+{
+    // Called by attribute field writer thread while holding the attribute directory writer
+    if (!useDeltaFlush()) {
+        return vespalib::string();
+    }
+    // The data file of the last snapshot must be the one the tracked changes are relative to.
+    vespalib::string datFile = _attrDir->getAttributeFileName(getFlushedSerialNum()) + ".dat";
+    if (getSerialNumTag(datFile) != _attr->getDeltaSaveBaseSerialNum()) {
+        return vespalib::string();
+    }
+    return datFile;
+}
+
 IFlushTarget::Task::UP
 FlushableAttribute::internalInitFlush(SerialNum currentSerial)
 {
@@ -238,7 +324,7 @@ FlushableAttribute::initFlush(SerialNum currentSerial, std::shared_ptr<search::I
 uint64_t
 FlushableAttribute::getApproxBytesToWriteToDisk() const
 {
-    return _attr->getEstimatedSaveByteSize();
+    return useDeltaFlush() ? _attr->getEstimatedDeltaSaveByteSize() : _attr->getEstimatedSaveByteSize();
 }
 
 double
@@ -19,6 +19,12 @@ class AttributeDirectory;
 
 /**
  * Implementation of IFlushTarget interface for attribute vectors.
+ *
+ * Attribute vectors supporting delta save are flushed by only writing the
+ * documents changed since the last full flush, as long as that is
+ * considerably cheaper than a full flush. The snapshot of a delta flush gets
+ * a hard link to the data file of the last full flush, so each snapshot can
+ * be loaded and pruned on its own.
  */
 class FlushableAttribute : public searchcorespi::IFlushTarget
 {
@@ -41,6 +47,8 @@ private:
     double                       _replay_operation_cost;
 
     Task::UP internalInitFlush(SerialNum currentSerial);
+    bool useDeltaFlush() const;
+    vespalib::string getDeltaFlushBaseDatFile() const;
 
 public:
     typedef std::shared_ptr<FlushableAttribute> SP;
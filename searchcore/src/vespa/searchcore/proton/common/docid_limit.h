@@ -7,16 +7,22 @@ namespace proton {
 
 /**
  * Class representing the end of a local document id range.
+ *
+ * Also tracks the commit generation, which is bumped each time feed
+ * changes are made visible to searches.
  */
 class DocIdLimit
 {
 private:
     std::atomic<uint32_t> _docIdLimit;
+    std::atomic<uint64_t> _commitGeneration;
 
 public:
-    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit) {}
+    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit), _commitGeneration(0) {}
     void set(uint32_t docIdLimit) { _docIdLimit = docIdLimit; }
     uint32_t get() const { return _docIdLimit; }
+    void bumpCommitGeneration() { _commitGeneration.fetch_add(1, std::memory_order_release); }
+    uint64_t getCommitGeneration() const { return _commitGeneration.load(std::memory_order_acquire); }
 
     void bumpUpLimit(uint32_t newLimit) {
         for (;;) {
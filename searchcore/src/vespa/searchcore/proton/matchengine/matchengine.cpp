@@ -44,7 +44,8 @@ namespace proton {
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, size_t maxThreadsPerSearch,
+                         uint32_t distributionKey, bool async)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -53,8 +54,13 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256_Ki,
                 CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch),
+      _threadsPerSearch(std::max(size_t(1), threadsPerSearch)),
+      _maxThreadsPerSearch(std::max(_threadsPerSearch, std::min(maxThreadsPerSearch, numThreads))),
+      _threadBudget(std::max(numThreads, _threadsPerSearch)),
+      _threadBundlePool(_threadsPerSearch,
                         CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+      _borrowThreadBundlePool(_maxThreadsPerSearch,
+                              CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
       _nodeUp(false),
       _nodeMaintenance(false)
 {
@@ -140,8 +146,10 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req)
             std::lock_guard<std::mutex> guard(_lock);
             searchHandler = _handlers.getHandler(docTypeName);
         }
+        matching::BudgetedThreadBundle budgetedThreadBundle(*threadBundle, _borrowThreadBundlePool,
+                                                            _threadBudget, _maxThreadsPerSearch);
         if (searchHandler) {
-            ret = searchHandler->match(*searchRequest, *threadBundle);
+            ret = searchHandler->match(*searchRequest, budgetedThreadBundle);
         } else {
             HandlerMap<ISearchHandler>::Snapshot snapshot;
             {
@@ -149,7 +157,7 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req)
                 snapshot = _handlers.snapshot();
             }
             if (snapshot.valid()) {
-                ret = snapshot.get()->match(*searchRequest, *threadBundle); // use the first handler
+                ret = snapshot.get()->match(*searchRequest, budgetedThreadBundle); // use the first handler
             }
         }
         _threadBundlePool.release(std::move(threadBundle));
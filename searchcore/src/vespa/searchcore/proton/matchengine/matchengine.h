@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchcore/proton/common/statusreport.h>
+#include <vespa/searchcore/proton/matching/thread_budget.h>
 #include <vespa/searchlib/engine/searchapi.h>
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
@@ -24,7 +25,11 @@ private:
     std::atomic<bool>                  _forward_issues;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
+    const size_t                       _threadsPerSearch;
+    const size_t                       _maxThreadsPerSearch;
+    matching::ThreadBudget             _threadBudget;
     vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    vespalib::SimpleThreadBundle::Pool _borrowThreadBundlePool;
     std::atomic<bool>                  _nodeUp;
     std::atomic<bool>                  _nodeMaintenance;
 
@@ -44,11 +49,17 @@ public:
      * using the putSearchHandler() method.
      *
      * @param numThreads Number of threads allocated for handling search requests.
-     * @param threadsPerSearch number of threads used for each search
+     * @param threadsPerSearch number of threads guaranteed for each search
+     * @param maxThreadsPerSearch max number of threads used for a single
+     *                            search when other matching threads are idle
      * @param distributionKey distributionkey of this node.
      * @param async if query is dispatched to threadpool
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, size_t maxThreadsPerSearch,
+                uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+        : MatchEngine(numThreads, threadsPerSearch, threadsPerSearch, distributionKey, async)
+    {}
     MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
         : MatchEngine(numThreads, threadsPerSearch, distributionKey, true)
     {}
@@ -71,6 +82,11 @@ public:
      */
     const vespalib::ThreadExecutor& get_executor() const { return _executor; }
 
+    /**
+     * Returns the budget tracking matching threads in use across queries.
+     */
+    const matching::ThreadBudget &get_thread_budget() const { return _threadBudget; }
+
     /**
      * Closes the request handler interface. This will prevent any more data
      * from entering this object, allowing you to flush all pending operations
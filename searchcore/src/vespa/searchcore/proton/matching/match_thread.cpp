@@ -10,6 +10,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/queryeval/multibitvectoriterator.h>
 #include <vespa/searchlib/queryeval/andnotsearch.h>
+#include <vespa/searchlib/queryeval/profiled_iterator.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
@@ -53,6 +54,13 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
     return resolver.resolve(0);
 }
 
+constexpr size_t rank_batch_size = 64;
+
+search::fef::FeatureExecutor *get_batch_executor(const LazyValue &score_feature) {
+    auto *executor = score_feature.get_executor();
+    return ((executor != nullptr) && executor->supports_batch()) ? executor : nullptr;
+}
+
 } // namespace proton::matching::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -64,14 +72,50 @@ MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollec
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom()),
+      _batch_executor(get_batch_executor(_score_feature)),
+      _batch_inputs(),
+      _batch_docids(),
+      _batch_scores(),
       dropped()
 {
+    if (_batch_executor != nullptr) {
+        _batch_inputs = std::make_unique<search::fef::BatchInputs>(*_batch_executor, rank_batch_size);
+        _batch_docids.reserve(rank_batch_size);
+        _batch_scores.resize(rank_batch_size);
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    if (_batch_executor != nullptr) {
+        _batch_inputs->collect(docId, _batch_docids.size());
+        _batch_docids.push_back(docId);
+        if (_batch_docids.size() == rank_batch_size) {
+            flushRankBatch<use_rank_drop_limit>();
+        }
+    } else {
+        addRankedHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+    }
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::flushRankBatch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _batch_executor->execute_batch(_batch_inputs->columns(), _batch_inputs->column_stride(),
+                                   _batch_scores.data(), _batch_docids.size());
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addRankedHit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addRankedHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -164,6 +208,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushRankBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -284,9 +331,17 @@ MatchThread::findMatches(MatchTools &tools)
             tools.search().asSlime(inserter);
         }
     }
+    if (match_profiler) {
+        tools.give_back_search(search::queryeval::ProfiledIterator::profile(*match_profiler, tools.borrow_search()));
+    }
     HitCollector hits(matchParams.numDocs, matchParams.arraySize);
     trace->addEvent(4, "Start match and first phase rank");
     match_loop_helper(tools, hits);
+    if (trace->shouldTrace(7)) {
+        // iterators may report what they did while matching (e.g. distances calculated by exact nearest neighbor search)
+        vespalib::slime::ObjectInserter inserter(trace->createCursor("iterator"), "executed");
+        tools.search().asSlime(inserter);
+    }
     if (tools.has_second_phase_rank()) {
         trace->addEvent(4, "Start second phase rerank");
         auto sorted_hit_seq = matchToolsFactory.should_diversify()
@@ -415,11 +470,13 @@ MatchThread::MatchThread(size_t thread_id_in,
     wait_time_s(0.0),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
     trace(std::make_unique<Trace>(relativeTime, traceLevel, profileDepth)),
+    match_profiler(),
     first_phase_profiler(),
     second_phase_profiler(),
     my_issues()
 {
     if ((traceLevel > 0) && (profileDepth > 0)) {
+        match_profiler = std::make_unique<vespalib::ExecutionProfiler>(profileDepth);
         first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(profileDepth);
         second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(profileDepth);
     }
@@ -454,6 +511,9 @@ MatchThread::run()
     trace->addEvent(4, "Start thread merge");
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
     trace->addEvent(4, "MatchThread::run Done");
+    if (match_profiler) {
+        match_profiler->report(trace->createCursor("match_profiling"));
+    }
     if (first_phase_profiler) {
         first_phase_profiler->report(trace->createCursor("first_phase_profiling"));
     }
@@ -15,6 +15,7 @@
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/searchlib/common/unique_issues.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
+#include <vespa/searchlib/fef/batch_inputs.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 
 namespace search::engine {
@@ -67,6 +68,7 @@ private:
     double                        wait_time_s;
     bool                          match_with_ranking;
     std::unique_ptr<Trace>        trace;
+    std::unique_ptr<vespalib::ExecutionProfiler> match_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> first_phase_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> second_phase_profiler;
     UniqueIssues                  my_issues;
@@ -77,6 +79,8 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void flushRankBatch();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,11 +88,20 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addRankedHit(uint32_t docId, double score);
+
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
+        // first phase scores are calculated for blocks of hits when
+        // the score feature executor supports batch execution
+        search::fef::FeatureExecutor                *_batch_executor;
+        std::unique_ptr<search::fef::BatchInputs>    _batch_inputs;
+        std::vector<uint32_t>                        _batch_docids;
+        std::vector<double>                          _batch_scores;
     public:
         std::vector<uint32_t> dropped;
     };
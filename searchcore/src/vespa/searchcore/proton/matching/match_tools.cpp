@@ -160,6 +160,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const vespalib::Doom       & doom,
                   ISearchContext             & searchContext,
                   IAttributeContext          & attributeContext,
+                  vespalib::ThreadBundle     & thread_bundle,
                   search::engine::Trace      & root_trace,
                   vespalib::stringref          queryStack,
                   const vespalib::string     & location,
@@ -193,6 +194,10 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         _query.extractLocations(_queryEnv.locations());
         trace.addEvent(5, "Build query execution plan");
         _query.reserveHandles(_requestContext, searchContext, _mdl);
+        if (WeakAndBlockMax::check(_queryEnv.getProperties(), rankSetup.get_weak_and_block_max())) {
+            _query.enable_block_max_weak_and(WeakAndAverageFieldLength::lookup(_queryEnv.getProperties(),
+                                                                                 rankSetup.get_weak_and_average_field_length()));
+        }
         trace.addEvent(5, "Optimize query execution plan");
         _query.optimize();
         trace.addEvent(4, "Perform dictionary lookups and posting lists initialization");
@@ -201,7 +206,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
             _query.handle_global_filter(searchContext.getDocIdLimit(),
                                         _global_filter_params.global_filter_lower_limit,
                                         _global_filter_params.global_filter_upper_limit,
-                                        trace);
+                                        thread_bundle, trace);
         }
         _query.freeze();
         trace.addEvent(5, "Prepare shared state for multi-threaded rank executors");
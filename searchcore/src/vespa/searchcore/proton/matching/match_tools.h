@@ -133,6 +133,7 @@ public:
                       const vespalib::Doom & softDoom,
                       ISearchContext &searchContext,
                       IAttributeContext &attributeContext,
+                      vespalib::ThreadBundle &thread_bundle,
                       search::engine::Trace & root_trace,
                       vespalib::stringref queryStack,
                       const vespalib::string &location,
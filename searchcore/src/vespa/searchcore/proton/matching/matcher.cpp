@@ -7,6 +7,7 @@
 #include "match_params.h"
 #include "matcher.h"
 #include "sessionmanager.h"
+#include "thread_budget.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchrequest.h>
@@ -141,7 +142,8 @@ using search::fef::indexproperties::softtimeout::Factor;
 std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
-                                    const Properties &feature_overrides, bool is_search) const
+                                    const Properties &feature_overrides, vespalib::ThreadBundle &thread_bundle,
+                                    bool is_search) const
 {
     const Properties & rankProperties = request.propertiesMap.rankProperties();
     bool softTimeoutEnabled = Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
@@ -158,7 +160,7 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
                    _stats.softDoomFactor(), factor, hasFactorOverride, vespalib::count_ns(safeLeft));
     }
     vespalib::Doom doom(_clock, safeDoom, request.getTimeOfDoom(), hasFactorOverride);
-    return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, searchContext, attrContext,
+    return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, searchContext, attrContext, thread_bundle,
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
                                                rankProperties, feature_overrides, is_search);
@@ -220,15 +222,18 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             feature_overrides = owned_objects.feature_overrides.get();
         }
 
+        const Properties & rankProperties = request.propertiesMap.rankProperties();
+        // The global filter is calculated before the hit estimate is known, so only the configured limit applies.
+        LimitedThreadBundleWrapper globalFilterThreadBundle(threadBundle,
+                NumThreadsPerSearch::lookup(rankProperties, _rankSetup->getNumThreadsPerSearch()));
         MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
-                metaStore, *feature_overrides, true);
+                metaStore, *feature_overrides, globalFilterThreadBundle, true);
         isDoomExplicit = mtf->getRequestContext().getDoom().isExplicitSoftDoom();
         traceQuery(6, request.trace(), mtf->query());
         if (!mtf->valid()) {
             return reply;
         }
 
-        const Properties & rankProperties = request.propertiesMap.rankProperties();
         uint32_t heapSize = HeapSize::lookup(rankProperties, _rankSetup->getHeapSize());
 
         MatchParams params(searchContext.getDocIdLimit(), heapSize, _rankSetup->getArraySize(),
@@ -239,11 +244,20 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                            request.sortSpec, params.offset, params.hits);
 
         size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
+        // Threads are taken from the shared budget only when the hit estimate is known.
+        auto *budgetedThreadBundle = dynamic_cast<BudgetedThreadBundle *>(&threadBundle);
+        if (budgetedThreadBundle != nullptr) {
+            numThreadsPerSearch = budgetedThreadBundle->reserve(numThreadsPerSearch);
+        }
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
                                                           _distributionKey, numParts);
+        if (budgetedThreadBundle != nullptr) {
+            // the rest of the query runs in this thread
+            budgetedThreadBundle->reserve(1);
+        }
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -372,7 +386,7 @@ Matcher::create_docsum_matcher(const DocsumRequest &req, ISearchContext &search_
     }
     StupidMetaStore meta;
     MatchToolsFactory::UP mtf = create_match_tools_factory(req, search_ctx, attr_ctx, meta,
-            req.propertiesMap.featureOverrides(), false);
+            req.propertiesMap.featureOverrides(), vespalib::ThreadBundle::trivial(), false);
     if (!mtf->valid()) {
         LOG(warning, "could not initialize docsum matching: %s",
             (expectedSessionCached) ? "session has expired" : "invalid query");
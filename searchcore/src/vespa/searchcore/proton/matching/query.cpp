@@ -14,6 +14,8 @@
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <vespa/vespalib/util/time.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.query");
@@ -39,6 +41,7 @@ using search::queryeval::IRequestContext;
 using search::queryeval::IntermediateBlueprint;
 using search::queryeval::RankBlueprint;
 using search::queryeval::SearchIterator;
+using search::queryeval::WeakAndBlueprint;
 using vespalib::Issue;
 using vespalib::string;
 using std::vector;
@@ -63,6 +66,18 @@ inject(Node::UP query, Node::UP to_inject) {
     return query;
 }
 
+void
+enable_block_max_weak_and(Blueprint &blueprint, double avg_field_length) {
+    if (auto *weak_and = dynamic_cast<WeakAndBlueprint *>(&blueprint)) {
+        weak_and->set_use_block_max(true, avg_field_length);
+    }
+    if (auto *parent = dynamic_cast<IntermediateBlueprint *>(&blueprint)) {
+        for (size_t i = 0; i < parent->childCnt(); ++i) {
+            enable_block_max_weak_and(parent->getChild(i), avg_field_length);
+        }
+    }
+}
+
 void
 find_location_terms(Node *node, std::vector<LocationTerm *> & locations) {
     if (node->isLocationTerm() ) {
@@ -231,6 +246,12 @@ Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &co
     }
 }
 
+void
+Query::enable_block_max_weak_and(double avg_field_length)
+{
+    proton::matching::enable_block_max_weak_and(*_blueprint, avg_field_length);
+}
+
 void
 Query::optimize()
 {
@@ -246,9 +267,10 @@ Query::fetchPostings()
 
 void
 Query::handle_global_filter(uint32_t docid_limit, double global_filter_lower_limit, double global_filter_upper_limit,
-                            search::engine::Trace& trace)
+                            vespalib::ThreadBundle &thread_bundle, search::engine::Trace& trace)
 {
-    if (!handle_global_filter(*_blueprint, docid_limit, global_filter_lower_limit, global_filter_upper_limit, &trace)) {
+    if (!handle_global_filter(*_blueprint, docid_limit, global_filter_lower_limit, global_filter_upper_limit,
+                              thread_bundle, &trace)) {
         return;
     }
     // optimized order may change after accounting for global filter:
@@ -262,7 +284,7 @@ Query::handle_global_filter(uint32_t docid_limit, double global_filter_lower_lim
 bool
 Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
                             double global_filter_lower_limit, double global_filter_upper_limit,
-                            search::engine::Trace* trace)
+                            vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace)
 {
     using search::queryeval::GlobalFilter;
     double estimated_hit_ratio = blueprint.getState().hit_ratio(docid_limit);
@@ -284,12 +306,13 @@ Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
             trace->addEvent(5, vespalib::make_string("Calculate global filter (estimated_hit_ratio (%f) <= upper_limit (%f))",
                                                      estimated_hit_ratio, global_filter_upper_limit));
         }
-        auto constraint = Blueprint::FilterConstraint::UPPER_BOUND;
-        bool strict = true;
-        auto filter_iterator = blueprint.createFilterSearch(strict, constraint);
-        filter_iterator->initRange(1, docid_limit);
-        auto white_list = filter_iterator->get_hits(1);
-        global_filter = GlobalFilter::create(std::move(white_list));
+        vespalib::Timer timer;
+        global_filter = GlobalFilter::calculate(blueprint, docid_limit, thread_bundle);
+        if (trace && trace->shouldTrace(5)) {
+            trace->addEvent(5, vespalib::make_string("Global filter calculated: hits=%u, max_threads=%zu, time=%1.3f ms",
+                                                     global_filter->filter()->countTrueBits(), thread_bundle.size(),
+                                                     vespalib::count_ns(timer.elapsed()) / 1000000.0));
+        }
     } else {
         if (trace && trace->shouldTrace(5)) {
             trace->addEvent(5, vespalib::make_string("Create match all global filter (estimated_hit_ratio (%f) > upper_limit (%f))",
@@ -11,6 +11,7 @@
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 
 namespace search::engine { class Trace; }
+namespace vespalib { struct ThreadBundle; }
 
 namespace proton::matching {
 
@@ -83,6 +84,15 @@ public:
                         ISearchContext &context,
                         search::fef::MatchDataLayout &mdl);
 
+    /**
+     * Evaluate all weakAnd nodes in the blueprint tree as block-max
+     * weakAnd. This function should be called after the
+     * reserveHandles function.
+     *
+     * @param avg_field_length used to normalize term frequencies
+     **/
+    void enable_block_max_weak_and(double avg_field_length);
+
     /**
      * Optimize the query to be executed. This function should be
      * called after the reserveHandles function and before the
@@ -95,7 +105,7 @@ public:
     void fetchPostings();
 
     void handle_global_filter(uint32_t docid_limit, double global_filter_lower_limit, double global_filter_upper_limit,
-                              search::engine::Trace& trace);
+                              vespalib::ThreadBundle &thread_bundle, search::engine::Trace& trace);
 
     /**
      * Calculates and handles the global filter if needed by the blueprint tree.
@@ -104,7 +114,7 @@ public:
      * 1) estimated_hit_ratio < global_filter_lower_limit:
      *     Nothing is done.
      * 2) estimated_hit_ratio <= global_filter_upper_limit:
-     *     Calculate the global filter and set it on the blueprint.
+     *     Calculate the global filter (in parallel using the given thread bundle) and set it on the blueprint.
      * 3) estimated_hit_ratio > global_filter_upper_limit:
      *     Set a "match all filter" on the blueprint.
      *
@@ -112,7 +122,7 @@ public:
      */
     static bool handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
                                      double global_filter_lower_limit, double global_filter_upper_limit,
-                                     search::engine::Trace* trace);
+                                     vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace);
 
     void freeze();
 
@@ -0,0 +1,201 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+struct CachedResult {
+    uint64_t                         generation;
+    vespalib::steady_time            created;
+    uint64_t                         totalHitCount;
+    std::vector<uint32_t>            sortIndex;
+    std::vector<char>                sortData;
+    SearchReply::Coverage            coverage;
+    std::vector<SearchReply::Hit>    hits;
+    search::FeatureValues            match_features;
+
+    CachedResult(uint64_t generation_in, vespalib::steady_time created_in, const SearchReply &reply)
+        : generation(generation_in),
+          created(created_in),
+          totalHitCount(reply.totalHitCount),
+          sortIndex(reply.sortIndex),
+          sortData(reply.sortData),
+          coverage(reply.coverage),
+          hits(reply.hits),
+          match_features(reply.match_features)
+    {}
+
+    size_t memory_usage() const {
+        size_t usage = sizeof(CachedResult);
+        usage += sortIndex.capacity() * sizeof(uint32_t);
+        usage += sortData.capacity();
+        usage += hits.capacity() * sizeof(SearchReply::Hit);
+        usage += match_features.values.capacity() * sizeof(search::FeatureValues::Value);
+        for (const auto &name : match_features.names) {
+            usage += sizeof(name) + name.size();
+        }
+        return usage;
+    }
+
+    std::unique_ptr<SearchReply> make_reply() const {
+        auto reply = std::make_unique<SearchReply>();
+        reply->totalHitCount = totalHitCount;
+        reply->sortIndex = sortIndex;
+        reply->sortData = sortData;
+        reply->coverage = coverage;
+        reply->hits = hits;
+        reply->match_features = match_features;
+        return reply;
+    }
+};
+
+namespace {
+
+class KeyBuilder : public search::fef::IPropertiesVisitor {
+private:
+    vespalib::nbostream &_os;
+public:
+    explicit KeyBuilder(vespalib::nbostream &os) : _os(os) {}
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        _os << key << uint32_t(values.size());
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            _os << values.getAt(i);
+        }
+    }
+    void add(const Properties &props) {
+        _os << props.numKeys();
+        props.visitProperties(*this);
+    }
+};
+
+}
+
+struct ResultCacheMap : vespalib::lrucache_map<vespalib::LruParam<vespalib::string, std::shared_ptr<const CachedResult>>> {
+    using Parent = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, std::shared_ptr<const CachedResult>>>;
+    using Parent::Parent;
+};
+
+ResultCache::ResultCache(uint32_t max_entries, vespalib::duration max_staleness)
+    : _cache(std::make_unique<ResultCacheMap>(max_entries)),
+      _max_staleness(max_staleness),
+      _cleared(),
+      _stats(),
+      _lock()
+{
+}
+
+ResultCache::~ResultCache() = default;
+
+bool
+ResultCache::enabled() const
+{
+    return (_cache->capacity() > 0);
+}
+
+bool
+ResultCache::can_cache(const SearchRequest &request)
+{
+    return (request.sessionId.empty() &&
+            request.groupSpec.empty() &&
+            !request.dumpFeatures &&
+            (request.trace().getLevel() == 0) &&
+            !request.stackDump.empty());
+}
+
+bool
+ResultCache::can_cache(const SearchReply &reply)
+{
+    // results cut short by timeout are not representative
+    return (!reply.coverage.wasDegradedByTimeout() &&
+            reply.groupResult.empty() &&
+            !reply.my_issues);
+}
+
+vespalib::string
+ResultCache::make_key(const SearchRequest &request)
+{
+    vespalib::nbostream os;
+    os << request.getStackRef();
+    os << request.ranking << request.location << request.sortSpec;
+    os << request.offset << request.maxhits;
+    KeyBuilder builder(os);
+    builder.add(request.propertiesMap.rankProperties());
+    builder.add(request.propertiesMap.featureOverrides());
+    builder.add(request.propertiesMap.matchProperties());
+    builder.add(request.propertiesMap.modelOverrides());
+    return vespalib::string(os.peek(), os.size());
+}
+
+std::unique_ptr<SearchReply>
+ResultCache::lookup(const vespalib::string &key, uint64_t generation, vespalib::steady_time now)
+{
+    std::shared_ptr<const CachedResult> result;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stats.numLookup++;
+        auto *found = _cache->findAndRef(key);
+        if (found == nullptr) {
+            return {};
+        }
+        if (((*found)->generation != generation) && ((now - (*found)->created) > _max_staleness)) {
+            _cache->erase(key);
+            _stats.numInvalidated++;
+            return {};
+        }
+        _stats.numHit++;
+        result = *found;
+    }
+    return result->make_reply();
+}
+
+void
+ResultCache::insert(const vespalib::string &key, uint64_t generation, vespalib::steady_time now, const SearchReply &reply)
+{
+    if (!can_cache(reply)) {
+        return;
+    }
+    auto result = std::make_shared<const CachedResult>(generation, now, reply);
+    std::lock_guard<std::mutex> guard(_lock);
+    if (now < _cleared) {
+        // matched using the configuration in effect before the cache was cleared
+        return;
+    }
+    if (!_cache->hasKey(key) && (_cache->size() >= _cache->capacity())) {
+        _stats.numDropped++;
+    }
+    (*_cache)[key] = std::move(result);
+    _stats.numInsert++;
+}
+
+void
+ResultCache::clear(vespalib::steady_time now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _stats.numInvalidated += _cache->size();
+    _cache = std::make_unique<ResultCacheMap>(_cache->capacity());
+    _cleared = std::max(_cleared, now);
+}
+
+ResultCache::Stats
+ResultCache::getStats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats = _stats;
+    stats.numCached = _cache->size();
+    for (const auto &result : *_cache) {
+        stats.memoryUsage += result->memory_usage();
+    }
+    _stats = Stats();
+    return stats;
+}
+
+}
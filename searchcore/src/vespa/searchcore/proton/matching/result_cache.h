@@ -0,0 +1,99 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+struct ResultCacheMap;
+
+/**
+ * Bounded LRU cache of search results, used to avoid re-running
+ * matching for repeated queries.
+ *
+ * Results are keyed by a canonical serialization of everything in
+ * the request that affects the result: query stack, rank profile,
+ * rank/feature/match/model properties, sorting, location and the
+ * requested hit window. Each result is tagged with the commit
+ * generation of the searched data when matching started. A cached
+ * result is only used if the generation is unchanged, or if it is
+ * younger than the configured max staleness. All results are
+ * dropped when the matchers or attributes are reconfigured.
+ **/
+class ResultCache {
+public:
+    struct Stats {
+        Stats()
+            : numLookup(0),
+              numHit(0),
+              numInsert(0),
+              numDropped(0),
+              numInvalidated(0),
+              numCached(0),
+              memoryUsage(0)
+        {}
+        uint32_t numLookup;
+        uint32_t numHit;
+        uint32_t numInsert;
+        uint32_t numDropped;
+        uint32_t numInvalidated;
+        uint32_t numCached;
+        size_t   memoryUsage;
+    };
+
+private:
+    using SearchRequest = search::engine::SearchRequest;
+    using SearchReply = search::engine::SearchReply;
+
+    std::unique_ptr<ResultCacheMap> _cache;
+    vespalib::duration              _max_staleness;
+    vespalib::steady_time           _cleared;
+    Stats                           _stats;
+    mutable std::mutex              _lock;
+
+public:
+    ResultCache(uint32_t max_entries, vespalib::duration max_staleness);
+    ~ResultCache();
+
+    bool enabled() const;
+
+    /**
+     * Requests using grouping, search sessions, feature dumping or
+     * tracing are never cached.
+     **/
+    static bool can_cache(const SearchRequest &request);
+    static bool can_cache(const SearchReply &reply);
+    static vespalib::string make_key(const SearchRequest &request);
+
+    /**
+     * @return a copy of the cached result for the given key, or
+     *         nullptr if there is no usable result.
+     **/
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key, uint64_t generation, vespalib::steady_time now);
+    /**
+     * The result is not cached if matching started (now) before the
+     * cache was last cleared.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, vespalib::steady_time now, const SearchReply &reply);
+
+    /**
+     * Drop all cached results, e.g. when the rank profiles change.
+     **/
+    void clear(vespalib::steady_time now);
+
+    /**
+     * Observe and reset stats.
+     **/
+    Stats getStats();
+};
+
+}
@@ -169,8 +169,15 @@ struct SearchSessionCache : public SessionMap<SearchSession> {
 
 
 SessionManager::SessionManager(uint32_t maxSize)
+    : SessionManager(maxSize, 0, vespalib::duration::zero())
+{
+}
+
+SessionManager::SessionManager(uint32_t maxSize, uint32_t maxSizeResults, vespalib::duration maxResultStaleness)
     : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _result_cache(maxSizeResults, maxResultStaleness)
+{
 }
 
 SessionManager::~SessionManager() = default;
@@ -3,6 +3,7 @@
 
 #include "search_session.h"
 #include "isessioncachepruner.h"
+#include "result_cache.h"
 #include <vespa/searchcore/grouping/groupingsession.h>
 #include <vespa/searchcore/grouping/sessionid.h>
 #include <vespa/vespalib/stllike/lrucache_map.h>
@@ -44,12 +45,14 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    ResultCache _result_cache;
 
 public:
     typedef std::unique_ptr<SessionManager> UP;
     typedef std::shared_ptr<SessionManager> SP;
 
     SessionManager(uint32_t maxSizeGrouping);
+    SessionManager(uint32_t maxSizeGrouping, uint32_t maxSizeResults, vespalib::duration maxResultStaleness);
     ~SessionManager() override;
 
     void insert(search::grouping::GroupingSession::UP session);
@@ -60,6 +63,9 @@ public:
     SearchSession::SP pickSearch(const SessionId &id);
     Stats getSearchStats();
     size_t getNumSearchSessions() const;
+
+    ResultCache &getResultCache() { return _result_cache; }
+    ResultCache::Stats getResultCacheStats() { return _result_cache.getStats(); }
     std::vector<SearchSessionInfo> getSortedSearchSessionInfo() const;
 
     void pruneTimedOutSessions(vespalib::steady_time currentTime) override;
@@ -0,0 +1,80 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "thread_budget.h"
+#include <algorithm>
+#include <cassert>
+
+namespace proton::matching {
+
+uint32_t
+ThreadBudget::reserve(uint32_t guaranteed, uint32_t wanted) noexcept
+{
+    uint32_t my_used = _used.load(std::memory_order_relaxed);
+    uint32_t threads;
+    do {
+        uint32_t my_available = (my_used < _total) ? (_total - my_used) : 0;
+        threads = std::min(wanted, std::max(guaranteed, my_available));
+    } while (!_used.compare_exchange_weak(my_used, my_used + threads, std::memory_order_relaxed));
+    return threads;
+}
+
+BudgetedThreadBundle::BudgetedThreadBundle(vespalib::ThreadBundle &bundle, vespalib::SimpleThreadBundle::Pool &pool,
+                                           ThreadBudget &budget, size_t max_size)
+    : _bundle(bundle),
+      _pool(pool),
+      _budget(budget),
+      _max_size(std::max(max_size, bundle.size())),
+      _size(bundle.size()),
+      _borrowed()
+{
+    _budget.acquire(_size);
+}
+
+BudgetedThreadBundle::~BudgetedThreadBundle()
+{
+    set_size(std::min(_size, _bundle.size()));
+    _budget.release(_size);
+}
+
+void
+BudgetedThreadBundle::set_size(size_t new_size)
+{
+    if (new_size < _size) {
+        _budget.release(_size - new_size);
+    }
+    _size = new_size;
+    if (_borrowed && (_size <= _bundle.size())) {
+        _pool.release(std::move(_borrowed));
+    }
+}
+
+size_t
+BudgetedThreadBundle::reserve(size_t wanted)
+{
+    wanted = std::clamp(wanted, size_t(1), _max_size);
+    if (wanted < _size) {
+        set_size(wanted);
+    } else if (wanted > _size) {
+        // the guaranteed threads of the wrapped bundle are always available
+        size_t guaranteed = (_size < _bundle.size()) ? (std::min(wanted, _bundle.size()) - _size) : 0;
+        _size += _budget.reserve(guaranteed, wanted - _size);
+        if ((_size > _bundle.size()) && !_borrowed) {
+            _borrowed = _pool.obtain();
+            assert(_borrowed->size() >= _size);
+        }
+    }
+    return _size;
+}
+
+void
+BudgetedThreadBundle::run(const std::vector<vespalib::Runnable*> &targets)
+{
+    assert(targets.size() <= _size);
+    if (targets.size() <= _bundle.size()) {
+        _bundle.run(targets);
+    } else {
+        _borrowed->run(targets);
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <atomic>
+#include <cstdint>
+
+namespace proton::matching {
+
+/**
+ * Keeps track of how many matching threads are in use across all
+ * concurrent queries. Used to let queries borrow threads that would
+ * otherwise be idle.
+ **/
+class ThreadBudget
+{
+private:
+    const uint32_t        _total;
+    std::atomic<uint32_t> _used;
+
+public:
+    explicit ThreadBudget(uint32_t total) noexcept : _total(total), _used(0) {}
+    uint32_t total() const noexcept { return _total; }
+    uint32_t used() const noexcept { return _used.load(std::memory_order_relaxed); }
+    uint32_t available() const noexcept {
+        uint32_t my_used = used();
+        return (my_used < _total) ? (_total - my_used) : 0;
+    }
+    void acquire(uint32_t threads) noexcept { _used.fetch_add(threads, std::memory_order_relaxed); }
+    void release(uint32_t threads) noexcept { _used.fetch_sub(threads, std::memory_order_relaxed); }
+    /**
+     * Atomically acquire the available threads, at least 'guaranteed'
+     * and at most 'wanted'. Returns the number of threads acquired.
+     **/
+    uint32_t reserve(uint32_t guaranteed, uint32_t wanted) noexcept;
+};
+
+/**
+ * Thread bundle wrapper that sizes a single query according to the
+ * current load. The query starts out with the threads of the wrapped
+ * bundle, which are accounted for in the shared budget. When the
+ * matcher knows how many threads the query wants (from the blueprint
+ * hit estimate), it calls reserve(). Unused guaranteed threads are then
+ * given back to the budget, and idle threads may be borrowed up to
+ * 'max_size'. Targets that need borrowed threads run in a larger bundle
+ * obtained from 'pool'. The matcher calls reserve() again to give the
+ * threads back when it no longer needs them.
+ **/
+class BudgetedThreadBundle final : public vespalib::ThreadBundle
+{
+private:
+    vespalib::ThreadBundle             &_bundle;
+    vespalib::SimpleThreadBundle::Pool &_pool;
+    ThreadBudget                       &_budget;
+    const size_t                        _max_size;
+    size_t                              _size;
+    vespalib::SimpleThreadBundle::UP    _borrowed;
+
+    void set_size(size_t new_size);
+
+public:
+    BudgetedThreadBundle(vespalib::ThreadBundle &bundle, vespalib::SimpleThreadBundle::Pool &pool,
+                         ThreadBudget &budget, size_t max_size);
+    ~BudgetedThreadBundle() override;
+    /**
+     * Resize this bundle to 'wanted' threads, limited by 'max_size'
+     * and by the threads available in the budget. The size is never
+     * reduced below 1 or increased above the wrapped bundle size when
+     * no threads are available. Returns the new size.
+     **/
+    size_t reserve(size_t wanted);
+    size_t size() const override { return _size; }
+    void run(const std::vector<vespalib::Runnable*> &targets) override;
+};
+
+}
@@ -8,10 +8,34 @@ using Entry = AttributeMetrics::Entry;
 
 AttributeMetrics::Entry::Entry(const vespalib::string &attrName)
     : metrics::MetricSet("attribute", {{"field", attrName}}, "Metrics for a given attribute vector", nullptr),
-      memoryUsage(this)
+      memoryUsage(this),
+      compactions("compactions", {}, "Number of compaction steps performed in the attribute writer thread", this),
+      compactionLatency("compaction_latency", {}, "Time (in seconds) spent per compaction step in the attribute writer thread", this),
+      _last_compactions(0),
+      _last_compaction_time(vespalib::duration::zero())
 {
 }
 
+AttributeMetrics::Entry::~Entry() = default;
+
+void
+AttributeMetrics::Entry::update_compaction(uint64_t compactions_in, vespalib::duration compaction_time)
+{
+    if (compactions_in < _last_compactions) {
+        // Attribute vector has been replaced, start over.
+        _last_compactions = 0;
+        _last_compaction_time = vespalib::duration::zero();
+    }
+    uint64_t delta_compactions = compactions_in - _last_compactions;
+    if (delta_compactions != 0) {
+        compactions.inc(delta_compactions);
+        compactionLatency.addTotalValueWithCount(vespalib::to_s(compaction_time - _last_compaction_time),
+                                                  static_cast<uint32_t>(delta_compactions));
+    }
+    _last_compactions = compactions_in;
+    _last_compaction_time = compaction_time;
+}
+
 AttributeMetrics::AttributeMetrics(metrics::MetricSet *parent)
     : _parent(parent),
       _attributes()
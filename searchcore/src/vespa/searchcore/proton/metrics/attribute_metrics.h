@@ -3,6 +3,9 @@
 #pragma once
 
 #include "memory_usage_metrics.h"
+#include <vespa/metrics/countmetric.h>
+#include <vespa/metrics/valuemetric.h>
+#include <vespa/vespalib/util/time.h>
 #include <map>
 
 namespace proton {
@@ -13,7 +16,18 @@ public:
     struct Entry : public metrics::MetricSet {
         using SP = std::shared_ptr<Entry>;
         MemoryUsageMetrics memoryUsage;
+        metrics::LongCountMetric compactions;
+        metrics::DoubleAverageMetric compactionLatency;
         Entry(const vespalib::string &attrName);
+        ~Entry() override;
+        /*
+         * Update compaction metrics based on the accumulated number of compaction
+         * steps and time spent compacting in the attribute writer thread.
+         */
+        void update_compaction(uint64_t compactions_in, vespalib::duration compaction_time);
+    private:
+        uint64_t           _last_compactions;
+        vespalib::duration _last_compaction_time;
     };
 private:
     using Map = std::map<vespalib::string, Entry::SP>;
@@ -260,6 +260,7 @@ DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docType
       threadingService("threading_service", this),
       matching(this),
       sessionCache(this),
+      resultCache(this),
       documents(this),
       bucketMove(this),
       feeding(this),
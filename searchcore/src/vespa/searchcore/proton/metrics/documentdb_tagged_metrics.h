@@ -4,6 +4,7 @@
 #include "attribute_metrics.h"
 #include "memory_usage_metrics.h"
 #include "executor_threading_service_metrics.h"
+#include "result_cache_metrics.h"
 #include "sessionmanager_metrics.h"
 #include "document_db_feeding_metrics.h"
 #include <vespa/metrics/metricset.h>
@@ -199,6 +200,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
     ExecutorThreadingServiceMetrics threadingService;
     MatchingMetrics matching;
     SessionCacheMetrics sessionCache;
+    ResultCacheMetrics resultCache;
     DocumentsMetrics documents;
     BucketMoveMetrics bucketMove;
     DocumentDBFeedingMetrics feeding;
@@ -0,0 +1,37 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache_metrics.h"
+
+namespace proton {
+
+ResultCacheMetrics::ResultCacheMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("result_cache", {}, "Metrics for the search result cache", parent),
+      lookups("lookups", {}, "Number of search requests looked up in the cache", this),
+      hits("hits", {}, "Number of search requests answered from the cache", this),
+      inserts("inserts", {}, "Number of search results inserted into the cache", this),
+      dropped("dropped", {}, "Number of cached search results dropped to make room for new ones", this),
+      invalidated("invalidated", {}, "Number of cached search results invalidated by committed feed", this),
+      hitRate("hit_rate", {}, "Rate of search requests answered from the cache", this),
+      numCached("num_cached", {}, "Number of currently cached search results", this),
+      memoryUsage("memory_usage", {}, "Memory used by cached search results (in bytes)", this)
+{
+}
+
+ResultCacheMetrics::~ResultCacheMetrics() = default;
+
+void
+ResultCacheMetrics::update(const proton::matching::ResultCache::Stats &stats)
+{
+    lookups.inc(stats.numLookup);
+    hits.inc(stats.numHit);
+    inserts.inc(stats.numInsert);
+    dropped.inc(stats.numDropped);
+    invalidated.inc(stats.numInvalidated);
+    if (stats.numLookup > 0) {
+        hitRate.set(double(stats.numHit) / stats.numLookup);
+    }
+    numCached.set(stats.numCached);
+    memoryUsage.set(stats.memoryUsage);
+}
+
+}
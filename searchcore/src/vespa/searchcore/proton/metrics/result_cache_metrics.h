@@ -0,0 +1,31 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/metrics/countmetric.h>
+#include <vespa/metrics/metricset.h>
+#include <vespa/metrics/valuemetric.h>
+#include <vespa/searchcore/proton/matching/result_cache.h>
+
+namespace proton {
+
+/**
+ * Metrics for the search result cache of a document db.
+ */
+struct ResultCacheMetrics : metrics::MetricSet
+{
+    metrics::LongCountMetric lookups;
+    metrics::LongCountMetric hits;
+    metrics::LongCountMetric inserts;
+    metrics::LongCountMetric dropped;
+    metrics::LongCountMetric invalidated;
+    metrics::DoubleValueMetric hitRate;
+    metrics::LongValueMetric numCached;
+    metrics::LongValueMetric memoryUsage;
+
+    void update(const proton::matching::ResultCache::Stats &stats);
+    ResultCacheMetrics(metrics::MetricSet *parent);
+    ~ResultCacheMetrics() override;
+};
+
+}
@@ -3,6 +3,7 @@
 #include "buckethandler.h"
 #include "ibucketstatechangedhandler.h"
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
+#include <vespa/searchcore/proton/common/docid_limit.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <cassert>
 
@@ -36,6 +37,7 @@ BucketHandler::performSetCurrentState(BucketId bucketId,
     LOG(debug, "performSetCurrentState(%s, %s)",
         bucketId.toString().c_str(), (active ? "ACTIVE" : "NOT_ACTIVE"));
     _ready->setBucketState(bucketId, active);
+    bumpReadyCommitGeneration();
     for (const auto & ch : _changedHandlers) {
         ch->notifyBucketStateChanged(bucketId, newState);
     }
@@ -47,6 +49,7 @@ BucketHandler::performPopulateActiveBuckets(document::BucketId::List buckets,
                                             IGenericResultHandler *resultHandler)
 {
     _ready->populateActiveBuckets(std::move(buckets));
+    bumpReadyCommitGeneration();
     resultHandler->handle(Result());
 }
 
@@ -59,6 +62,17 @@ BucketHandler::deactivateAllActiveBuckets()
         // Don't notify bucket state changed, node is marked down so
         // noone is listening.
     }
+    if (!buckets.empty()) {
+        bumpReadyCommitGeneration();
+    }
+}
+
+void
+BucketHandler::bumpReadyCommitGeneration()
+{
+    if (_readyDocIdLimit != nullptr) {
+        _readyDocIdLimit->bumpCommitGeneration();
+    }
 }
 
 BucketHandler::BucketHandler(vespalib::Executor &executor)
@@ -66,6 +80,7 @@ BucketHandler::BucketHandler(vespalib::Executor &executor)
       IBucketStateChangedNotifier(),
       _executor(executor),
       _ready(nullptr),
+      _readyDocIdLimit(nullptr),
       _changedHandlers(),
       _nodeUp(false),
       _nodeMaintenance(false)
@@ -79,9 +94,10 @@ BucketHandler::~BucketHandler()
 }
 
 void
-BucketHandler::setReadyBucketHandler(documentmetastore::IBucketHandler &ready)
+BucketHandler::setReadyBucketHandler(documentmetastore::IBucketHandler &ready, DocIdLimit *readyDocIdLimit)
 {
     _ready = &ready;
+    _readyDocIdLimit = readyDocIdLimit;
 }
 
 void
@@ -10,6 +10,7 @@
 
 namespace proton {
 
+class DocIdLimit;
 class IBucketStateChangedhandler;
 
 
@@ -23,6 +24,7 @@ class BucketHandler : public IClusterStateChangedHandler,
 private:
     vespalib::Executor                       &_executor;
     documentmetastore::IBucketHandler        *_ready;
+    DocIdLimit                               *_readyDocIdLimit;
     std::vector<IBucketStateChangedHandler *> _changedHandlers;
     bool                                      _nodeUp;
     bool                                      _nodeMaintenance;
@@ -38,6 +40,11 @@ private:
      * up to down in cluster state.  Called by document db executor thread.
      */
     void deactivateAllActiveBuckets();
+    /**
+     * Bucket activation changes which documents are searchable, making
+     * cached search results for the ready sub database stale.
+     */
+    void bumpReadyCommitGeneration();
 
 public:
     /**
@@ -48,7 +55,7 @@ public:
     BucketHandler(vespalib::Executor &executor);
     ~BucketHandler() override;
 
-    void setReadyBucketHandler(documentmetastore::IBucketHandler &ready);
+    void setReadyBucketHandler(documentmetastore::IBucketHandler &ready, DocIdLimit *readyDocIdLimit = nullptr);
 
     /**
      * Implements the bucket aspect of IPersistenceHandler.
@@ -204,7 +204,9 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _indexCfg(makeIndexConfig(protonCfg.index)),
       _replay_throttling_policy(std::make_unique<ReplayThrottlingPolicy>(make_replay_throttling_policy(protonCfg.replayThrottlingPolicy))),
       _config_store(std::move(config_store)),
-      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries)),
+      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries,
+                                                                 protonCfg.search.resultcache.maxentries,
+                                                                 vespalib::from_s(protonCfg.search.resultcache.maxstaleness))),
       _metricsWireService(metricsWireService),
       _metrics(_docTypeName.getName(), protonCfg.numthreadspersearch),
       _metricsHook(std::make_unique<MetricsUpdateHook>(*this)),
@@ -337,7 +339,8 @@ DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot)
 {
     // Called by executor thread
     assert(_writeService.master().isCurrentThread());
-    _bucketHandler.setReadyBucketHandler(_subDBs.getReadySubDB()->getDocumentMetaStoreContext().get());
+    _bucketHandler.setReadyBucketHandler(_subDBs.getReadySubDB()->getDocumentMetaStoreContext().get(),
+                                         _subDBs.getReadySubDB()->getDocIdLimit());
     _subDBs.initViews(*configSnapshot, _sessionManager);
     syncFeedView();
     // Check that feed view has been activated.
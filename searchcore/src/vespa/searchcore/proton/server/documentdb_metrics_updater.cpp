@@ -83,12 +83,16 @@ updateIndexMetrics(DocumentDBTaggedMetrics &metrics, const search::SearchableSta
 
 struct TempAttributeMetric
 {
-    MemoryUsage memoryUsage;
-    uint64_t    bitVectors;
+    MemoryUsage        memoryUsage;
+    uint64_t           bitVectors;
+    uint64_t           compactions;
+    vespalib::duration compactionTime;
 
     TempAttributeMetric()
         : memoryUsage(),
-          bitVectors(0)
+          bitVectors(0),
+          compactions(0),
+          compactionTime(vespalib::duration::zero())
     {}
 };
 
@@ -113,13 +117,18 @@ isNotReadySubDB(const IDocumentSubDB *subDb, const DocumentSubDBCollection &subD
 
 void
 fillTempAttributeMetrics(TempAttributeMetrics &metrics, const vespalib::string &attrName,
-                         const MemoryUsage &memoryUsage, uint32_t bitVectors)
+                         const MemoryUsage &memoryUsage, uint32_t bitVectors,
+                         uint64_t compactions, vespalib::duration compactionTime)
 {
     metrics.total.memoryUsage.merge(memoryUsage);
     metrics.total.bitVectors += bitVectors;
+    metrics.total.compactions += compactions;
+    metrics.total.compactionTime += compactionTime;
     TempAttributeMetric &m = metrics.attrs[attrName];
     m.memoryUsage.merge(memoryUsage);
     m.bitVectors += bitVectors;
+    m.compactions += compactions;
+    m.compactionTime += compactionTime;
 }
 
 void
@@ -140,9 +149,11 @@ fillTempAttributeMetrics(TempAttributeMetrics &totalMetrics,
                 const search::attribute::Status &status = attr->getStatus();
                 MemoryUsage memoryUsage(status.getAllocated(), status.getUsed(), status.getDead(), status.getOnHold());
                 uint32_t bitVectors = status.getBitVectors();
-                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors);
+                uint64_t compactions = status.getCompactions();
+                vespalib::duration compactionTime = status.getCompactionTime();
+                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors, compactions, compactionTime);
                 if (subMetrics != nullptr) {
-                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors);
+                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors, compactions, compactionTime);
                 }
             }
         }
@@ -156,6 +167,7 @@ updateAttributeMetrics(AttributeMetrics &metrics, const TempAttributeMetrics &tm
         auto entry = metrics.get(attr.first);
         if (entry) {
             entry->memoryUsage.update(attr.second.memoryUsage);
+            entry->update_compaction(attr.second.compactions, attr.second.compactionTime);
         }
     }
 }
@@ -194,6 +206,9 @@ updateSessionCacheMetrics(DocumentDBTaggedMetrics &metrics, proton::matching::Se
 
     auto groupingStats = sessionManager.getGroupingStats();
     metrics.sessionCache.grouping.update(groupingStats);
+
+    auto resultCacheStats = sessionManager.getResultCacheStats();
+    metrics.resultCache.update(resultCacheStats);
 }
 
 void
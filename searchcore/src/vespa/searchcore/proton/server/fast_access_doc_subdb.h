@@ -121,6 +121,7 @@ public:
     SerialNum getOldestFlushedSerial() override;
     SerialNum getNewestFlushedSerial() override;
     virtual void pruneRemovedFields(SerialNum serialNum) override;
+    DocIdLimit *getDocIdLimit() override { return &_docIdLimit; }
 };
 
 } // namespace proton
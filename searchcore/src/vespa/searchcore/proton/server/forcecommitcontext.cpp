@@ -26,6 +26,7 @@ ForceCommitContext::~ForceCommitContext()
 {
     if (_docIdLimit != nullptr) {
         _docIdLimit->bumpUpLimit(_committedDocIdLimit);
+        _docIdLimit->bumpCommitGeneration();
     }
     if (!_task->empty()) {
         vespalib::Executor::Task::UP res = _executor.execute(std::move(_task));
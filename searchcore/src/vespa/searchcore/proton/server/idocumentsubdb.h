@@ -24,6 +24,7 @@ namespace proton {
 
 namespace matching { class SessionManager; }
 
+class DocIdLimit;
 class DocumentDBConfig;
 class DocumentSubDbInitializer;
 class DocumentSubDbInitializerResult;
@@ -123,6 +124,11 @@ public:
     virtual void tearDownReferences(IDocumentDBReferenceResolver &resolver) = 0;
     virtual void validateDocStore(FeedHandler &op, SerialNum serialNum) const = 0;
     virtual PendingLidTrackerBase & getUncommittedLidsTracker() = 0;
+    /**
+     * Returns the doc id limit (and commit generation) used by searches,
+     * or nullptr if this sub database has none.
+     */
+    virtual DocIdLimit *getDocIdLimit() = 0;
 };
 
 } // namespace proton
@@ -3,6 +3,7 @@
 #include "matchview.h"
 #include "searchcontext.h"
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -31,6 +32,7 @@ namespace proton {
 
 using matching::ISearchContext;
 using matching::Matcher;
+using matching::ResultCache;
 using matching::SessionManager;
 
 MatchView::MatchView(Matchers::SP matchers,
@@ -67,14 +69,30 @@ MatchView::match(std::shared_ptr<const ISearchHandler> searchHandler, const Sear
                  vespalib::ThreadBundle &threadBundle) const
 {
     Matcher::SP matcher = getMatcher(req.ranking);
+    ResultCache &resultCache = _sessionMgr->getResultCache();
+    bool useResultCache = resultCache.enabled() && ResultCache::can_cache(req);
+    vespalib::string cacheKey;
+    // must be sampled before matching, so results are never newer than their generation
+    uint64_t generation = _docIdLimit.getCommitGeneration();
+    if (useResultCache) {
+        cacheKey = ResultCache::make_key(req);
+        auto reply = resultCache.lookup(cacheKey, generation, vespalib::steady_clock::now());
+        if (reply) {
+            return reply;
+        }
+    }
     SearchSession::OwnershipBundle owned_objects;
     owned_objects.search_handler = std::move(searchHandler);
     owned_objects.readGuard = _metaStore->getReadGuard();
     owned_objects.context = createContext();
     MatchContext *ctx = owned_objects.context.get();
     const search::IDocumentMetaStore & dms = owned_objects.readGuard->get();
-    return matcher->match(req, threadBundle, ctx->getSearchContext(), ctx->getAttributeContext(),
-                          *_sessionMgr, dms, std::move(owned_objects));
+    auto reply = matcher->match(req, threadBundle, ctx->getSearchContext(), ctx->getAttributeContext(),
+                                *_sessionMgr, dms, std::move(owned_objects));
+    if (useResultCache) {
+        resultCache.insert(cacheKey, generation, req.getStartTime(), *reply);
+    }
+    return reply;
 }
 
 } // namespace proton
@@ -302,6 +302,9 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  protonConfig.numthreadspersearch,
+                                                 (protonConfig.maxthreadspersearch > 0)
+                                                 ? protonConfig.maxthreadspersearch
+                                                 : protonConfig.numthreadspersearch,
                                                  protonConfig.distributionkey,
                                                  protonConfig.search.async);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
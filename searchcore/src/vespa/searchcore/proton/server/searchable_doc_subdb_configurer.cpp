@@ -3,6 +3,7 @@
 #include "searchable_doc_subdb_configurer.h"
 #include "reconfig_params.h"
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/common/document_type_inspector.h>
@@ -65,6 +66,10 @@ reconfigureMatchView(const Matchers::SP &matchers,
     auto matchView = std::make_shared<MatchView>(matchers, indexSearchable, attrMgr, curr->getSessionManager(),
                                                  curr->getDocumentMetaStore(), curr->getDocIdLimit());
     reconfigureSearchView(matchView);
+    if ((matchers != curr->getMatchers()) || (attrMgr != curr->getAttributeManager())) {
+        // cached results might have been ranked or matched differently
+        curr->getSessionManager()->getResultCache().clear(vespalib::steady_clock::now());
+    }
 }
 
 void
@@ -101,6 +101,7 @@ struct DummyDocumentSubDb : public IDocumentSubDB
     PendingLidTrackerBase &getUncommittedLidsTracker() override {
         return _pendingLidTracker;
     }
+    DocIdLimit *getDocIdLimit() override { return nullptr; }
 
     void tearDownReferences(IDocumentDBReferenceResolver &) override { }
 };
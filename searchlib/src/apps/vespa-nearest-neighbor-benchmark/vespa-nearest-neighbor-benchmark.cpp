@@ -0,0 +1,593 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <getopt.h>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-nearest-neighbor-benchmark");
+
+using search::BitVector;
+using search::attribute::DistanceMetric;
+using search::tensor::DocVectorAccess;
+using search::tensor::HnswIndex;
+using search::tensor::InvLogLevelGenerator;
+using search::tensor::NearestNeighborIndex;
+using search::tensor::QuantizedVectorStore;
+using vespalib::GenerationHandler;
+using vespalib::eval::TypedCells;
+
+namespace {
+
+using FilterTraversal = NearestNeighborIndex::FilterTraversal;
+
+/**
+ * Vectors read from a file in fvecs or bvecs format, where each vector is stored as
+ * its dimension (int32) followed by the cells (float32 or uint8).
+ * Vector number i (0-based) in the file is stored as docid i + 1.
+ */
+class VectorSet : public DocVectorAccess {
+    uint32_t _dim_size;
+    std::vector<float> _cells;
+
+public:
+    VectorSet() : _dim_size(0), _cells() {}
+    ~VectorSet() override;
+    bool load(const std::string& file_name, uint32_t max_vectors);
+    uint32_t dim_size() const noexcept { return _dim_size; }
+    uint32_t size() const noexcept { return (_dim_size != 0) ? (_cells.size() / _dim_size - 1) : 0; }
+    TypedCells get_vector(uint32_t docid) const override {
+        return TypedCells(vespalib::ConstArrayRef<float>(&_cells[size_t(docid) * _dim_size], _dim_size));
+    }
+};
+
+VectorSet::~VectorSet() = default;
+
+bool
+ends_with(const std::string& str, const std::string& suffix)
+{
+    return (str.size() >= suffix.size()) && (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+bool
+VectorSet::load(const std::string& file_name, uint32_t max_vectors)
+{
+    bool byte_cells = ends_with(file_name, ".bvecs");
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file) {
+        LOG(error, "Could not open '%s'", file_name.c_str());
+        return false;
+    }
+    std::vector<uint8_t> byte_buf;
+    int32_t dim_size = 0;
+    uint32_t num_vectors = 0;
+    while (num_vectors < max_vectors && file.read(reinterpret_cast<char*>(&dim_size), sizeof(dim_size))) {
+        if (dim_size <= 0 || (_dim_size != 0 && uint32_t(dim_size) != _dim_size)) {
+            LOG(error, "Vector %u in '%s' has unexpected dimension size %d", num_vectors, file_name.c_str(), dim_size);
+            return false;
+        }
+        if (_dim_size == 0) {
+            _dim_size = dim_size;
+            // Docid 0 is not used.
+            _cells.resize(_dim_size, 0.0);
+        }
+        size_t offset = _cells.size();
+        _cells.resize(offset + _dim_size);
+        if (byte_cells) {
+            byte_buf.resize(_dim_size);
+            file.read(reinterpret_cast<char*>(byte_buf.data()), _dim_size);
+            std::copy(byte_buf.begin(), byte_buf.end(), _cells.begin() + offset);
+        } else {
+            file.read(reinterpret_cast<char*>(&_cells[offset]), _dim_size * sizeof(float));
+        }
+        if (!file) {
+            LOG(error, "Vector %u in '%s' is truncated", num_vectors, file_name.c_str());
+            return false;
+        }
+        ++num_vectors;
+    }
+    LOG(info, "Loaded %u vectors with %u dimensions from '%s'", num_vectors, _dim_size, file_name.c_str());
+    return num_vectors > 0;
+}
+
+/**
+ * Reads the ground truth neighbors from a file in ivecs format (0-based vector numbers),
+ * and converts them to docids.
+ */
+bool
+load_ground_truth(const std::string& file_name, uint32_t max_queries, std::vector<std::vector<uint32_t>>& result)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file) {
+        LOG(error, "Could not open '%s'", file_name.c_str());
+        return false;
+    }
+    int32_t num_neighbors = 0;
+    while (result.size() < max_queries && file.read(reinterpret_cast<char*>(&num_neighbors), sizeof(num_neighbors))) {
+        std::vector<int32_t> ids(std::max(num_neighbors, 0));
+        file.read(reinterpret_cast<char*>(ids.data()), ids.size() * sizeof(int32_t));
+        if (!file) {
+            LOG(error, "Ground truth %zu in '%s' is truncated", result.size(), file_name.c_str());
+            return false;
+        }
+        auto& docids = result.emplace_back();
+        for (int32_t id : ids) {
+            docids.push_back(id + 1);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<T>
+parse_list(const char* arg)
+{
+    std::vector<T> result;
+    std::string str(arg);
+    size_t pos = 0;
+    while (pos <= str.size()) {
+        size_t end = str.find(',', pos);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+        if (end > pos) {
+            result.push_back(static_cast<T>(std::stod(str.substr(pos, end - pos))));
+        }
+        pos = end + 1;
+    }
+    return result;
+}
+
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, size_t(p * sorted.size()));
+    return sorted[idx];
+}
+
+void
+print_result(const vespalib::Slime& slime)
+{
+    vespalib::SimpleBuffer buf;
+    vespalib::slime::JsonFormat::encode(slime, buf, true);
+    printf("%s\n", buf.get().make_string().c_str());
+    fflush(stdout);
+}
+
+const char*
+traversal_name(FilterTraversal traversal)
+{
+    return (traversal == FilterTraversal::FILTERED) ? "filtered" : "plain";
+}
+
+}
+
+/**
+ * Benchmark of the hnsw index used for approximate nearest neighbor search.
+ *
+ * The index is built for each combination of the given index parameters,
+ * and the queries are executed for each combination of explore hits, filter hit ratio and thread count.
+ * Build throughput, query throughput, latency percentiles and recall@k (compared to brute force search)
+ * are written as one json object per line to stdout.
+ */
+class NearestNeighborBenchmarkApp
+{
+    std::string _base_file;
+    std::string _query_file;
+    std::string _ground_truth_file;
+    DistanceMetric _metric;
+    uint32_t _num_docs;
+    uint32_t _num_queries;
+    uint32_t _target_hits;
+    std::vector<uint32_t> _max_links_per_node;
+    std::vector<uint32_t> _neighbors_to_explore_at_insert;
+    std::vector<uint32_t> _explore_additional_hits;
+    std::vector<double> _filter_hit_ratios;
+    std::vector<uint32_t> _threads;
+    std::vector<uint32_t> _int8_quantization;
+    uint32_t _seed;
+
+    VectorSet _docs;
+    VectorSet _queries;
+    std::vector<std::vector<uint32_t>> _file_ground_truth;
+
+    void usage(const char* self);
+    bool get_options(int argc, char** argv);
+    std::unique_ptr<BitVector> make_filter(double hit_ratio) const;
+    std::vector<std::vector<uint32_t>> brute_force(const search::tensor::DistanceFunction& distance_func,
+                                                   const BitVector* filter, uint32_t num_threads) const;
+    std::unique_ptr<HnswIndex> build_index(uint32_t max_links_per_node, uint32_t neighbors_to_explore_at_insert,
+                                           bool int8_quantization, vespalib::Slime& result) const;
+    void run_queries(const HnswIndex& index, const BitVector* filter, FilterTraversal traversal,
+                     uint32_t explore_k, uint32_t num_threads,
+                     const std::vector<std::vector<uint32_t>>& ground_truth,
+                     vespalib::slime::Cursor& result) const;
+public:
+    NearestNeighborBenchmarkApp();
+    int main(int argc, char** argv);
+};
+
+NearestNeighborBenchmarkApp::NearestNeighborBenchmarkApp()
+    : _base_file(),
+      _query_file(),
+      _ground_truth_file(),
+      _metric(DistanceMetric::Euclidean),
+      _num_docs(std::numeric_limits<uint32_t>::max()),
+      _num_queries(1000),
+      _target_hits(10),
+      _max_links_per_node({16}),
+      _neighbors_to_explore_at_insert({200}),
+      _explore_additional_hits({0, 90}),
+      _filter_hit_ratios({1.0}),
+      _threads({1}),
+      _int8_quantization({0}),
+      _seed(42),
+      _docs(),
+      _queries(),
+      _file_ground_truth()
+{
+}
+
+void
+NearestNeighborBenchmarkApp::usage(const char* self)
+{
+    printf("Usage: %s --base <file> --queries <file> [options]\n", self);
+    printf("Vector files are in fvecs or bvecs format (by file name suffix), ground truth in ivecs format.\n");
+    printf("Options (lists are comma separated):\n");
+    printf("  --groundtruth <file>                     ground truth for unfiltered queries (default: brute force)\n");
+    printf("  --metric <euclidean|angular|innerproduct> distance metric (default: euclidean)\n");
+    printf("  --num-docs <n>                           max number of documents to index\n");
+    printf("  --num-queries <n>                        max number of queries (default: 1000)\n");
+    printf("  --target-hits <k>                        number of hits per query (default: 10)\n");
+    printf("  --max-links-per-node <list>              (default: 16)\n");
+    printf("  --neighbors-to-explore-at-insert <list>  (default: 200)\n");
+    printf("  --explore-additional-hits <list>         (default: 0,90)\n");
+    printf("  --filter-hit-ratios <list>               (default: 1.0, i.e. no filter)\n");
+    printf("  --threads <list>                         number of query threads (default: 1)\n");
+    printf("  --int8-quantization <list>               traverse the graph using int8 quantized vectors, 0 or 1 (default: 0)\n");
+    printf("  --seed <n>                               seed used when generating filters (default: 42)\n");
+    fflush(stdout);
+}
+
+bool
+NearestNeighborBenchmarkApp::get_options(int argc, char** argv)
+{
+    static struct option longopts[] = {
+        { "base", 1, nullptr, 0 },
+        { "queries", 1, nullptr, 0 },
+        { "groundtruth", 1, nullptr, 0 },
+        { "metric", 1, nullptr, 0 },
+        { "num-docs", 1, nullptr, 0 },
+        { "num-queries", 1, nullptr, 0 },
+        { "target-hits", 1, nullptr, 0 },
+        { "max-links-per-node", 1, nullptr, 0 },
+        { "neighbors-to-explore-at-insert", 1, nullptr, 0 },
+        { "explore-additional-hits", 1, nullptr, 0 },
+        { "filter-hit-ratios", 1, nullptr, 0 },
+        { "threads", 1, nullptr, 0 },
+        { "int8-quantization", 1, nullptr, 0 },
+        { "seed", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_BASE,
+        LONGOPT_QUERIES,
+        LONGOPT_GROUNDTRUTH,
+        LONGOPT_METRIC,
+        LONGOPT_NUM_DOCS,
+        LONGOPT_NUM_QUERIES,
+        LONGOPT_TARGET_HITS,
+        LONGOPT_MAX_LINKS_PER_NODE,
+        LONGOPT_NEIGHBORS_TO_EXPLORE_AT_INSERT,
+        LONGOPT_EXPLORE_ADDITIONAL_HITS,
+        LONGOPT_FILTER_HIT_RATIOS,
+        LONGOPT_THREADS,
+        LONGOPT_INT8_QUANTIZATION,
+        LONGOPT_SEED
+    };
+    int c;
+    int longopt_index = 0;
+    while ((c = getopt_long(argc, argv, "", longopts, &longopt_index)) != -1) {
+        if (c != 0) {
+            return false;
+        }
+        switch (longopt_index) {
+        case LONGOPT_BASE:
+            _base_file = optarg;
+            break;
+        case LONGOPT_QUERIES:
+            _query_file = optarg;
+            break;
+        case LONGOPT_GROUNDTRUTH:
+            _ground_truth_file = optarg;
+            break;
+        case LONGOPT_METRIC:
+            if (strcmp(optarg, "euclidean") == 0) {
+                _metric = DistanceMetric::Euclidean;
+            } else if (strcmp(optarg, "angular") == 0) {
+                _metric = DistanceMetric::Angular;
+            } else if (strcmp(optarg, "innerproduct") == 0) {
+                _metric = DistanceMetric::InnerProduct;
+            } else {
+                LOG(error, "Unsupported distance metric '%s'", optarg);
+                return false;
+            }
+            break;
+        case LONGOPT_NUM_DOCS:
+            _num_docs = strtoul(optarg, nullptr, 0);
+            break;
+        case LONGOPT_NUM_QUERIES:
+            _num_queries = strtoul(optarg, nullptr, 0);
+            break;
+        case LONGOPT_TARGET_HITS:
+            _target_hits = strtoul(optarg, nullptr, 0);
+            break;
+        case LONGOPT_MAX_LINKS_PER_NODE:
+            _max_links_per_node = parse_list<uint32_t>(optarg);
+            break;
+        case LONGOPT_NEIGHBORS_TO_EXPLORE_AT_INSERT:
+            _neighbors_to_explore_at_insert = parse_list<uint32_t>(optarg);
+            break;
+        case LONGOPT_EXPLORE_ADDITIONAL_HITS:
+            _explore_additional_hits = parse_list<uint32_t>(optarg);
+            break;
+        case LONGOPT_FILTER_HIT_RATIOS:
+            _filter_hit_ratios = parse_list<double>(optarg);
+            break;
+        case LONGOPT_THREADS:
+            _threads = parse_list<uint32_t>(optarg);
+            break;
+        case LONGOPT_INT8_QUANTIZATION:
+            _int8_quantization = parse_list<uint32_t>(optarg);
+            break;
+        case LONGOPT_SEED:
+            _seed = strtoul(optarg, nullptr, 0);
+            break;
+        default:
+            return false;
+        }
+    }
+    return !_base_file.empty() && !_query_file.empty() && _target_hits > 0 &&
+           !_max_links_per_node.empty() && !_neighbors_to_explore_at_insert.empty() &&
+           !_explore_additional_hits.empty() && !_filter_hit_ratios.empty() && !_threads.empty() &&
+           !_int8_quantization.empty();
+}
+
+std::unique_ptr<BitVector>
+NearestNeighborBenchmarkApp::make_filter(double hit_ratio) const
+{
+    if (hit_ratio >= 1.0) {
+        return {};
+    }
+    auto filter = BitVector::create(_docs.size() + 1);
+    std::mt19937 rng(_seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (uint32_t docid = 1; docid <= _docs.size(); ++docid) {
+        if (uniform(rng) < hit_ratio) {
+            filter->setBit(docid);
+        }
+    }
+    filter->invalidateCachedCount();
+    return filter;
+}
+
+std::vector<std::vector<uint32_t>>
+NearestNeighborBenchmarkApp::brute_force(const search::tensor::DistanceFunction& distance_func,
+                                         const BitVector* filter, uint32_t num_threads) const
+{
+    std::vector<std::vector<uint32_t>> result(_queries.size());
+    std::atomic<uint32_t> next_query(0);
+    vespalib::ThreadStackExecutor executor(num_threads, 128_Ki);
+    for (uint32_t thread = 0; thread < num_threads; ++thread) {
+        executor.execute(vespalib::makeLambdaTask([&]() {
+            std::vector<std::pair<double, uint32_t>> hits;
+            for (uint32_t i = next_query++; i < _queries.size(); i = next_query++) {
+                auto query = _queries.get_vector(i + 1);
+                hits.clear();
+                for (uint32_t docid = 1; docid <= _docs.size(); ++docid) {
+                    if (filter == nullptr || filter->testBit(docid)) {
+                        hits.emplace_back(distance_func.calc(query, _docs.get_vector(docid)), docid);
+                    }
+                }
+                size_t k = std::min(size_t(_target_hits), hits.size());
+                std::partial_sort(hits.begin(), hits.begin() + k, hits.end());
+                for (size_t j = 0; j < k; ++j) {
+                    result[i].push_back(hits[j].second);
+                }
+            }
+        }));
+    }
+    executor.sync();
+    return result;
+}
+
+std::unique_ptr<HnswIndex>
+NearestNeighborBenchmarkApp::build_index(uint32_t max_links_per_node, uint32_t neighbors_to_explore_at_insert,
+                                         bool int8_quantization, vespalib::Slime& result) const
+{
+    HnswIndex::Config cfg(max_links_per_node * 2, max_links_per_node, neighbors_to_explore_at_insert, 300, true);
+    std::unique_ptr<QuantizedVectorStore> quantized_vectors;
+    if (int8_quantization) {
+        quantized_vectors = std::make_unique<QuantizedVectorStore>(_metric, _docs.dim_size());
+    }
+    auto index = std::make_unique<HnswIndex>(_docs, search::tensor::make_distance_function(_metric, vespalib::eval::CellType::FLOAT),
+                                             std::make_unique<InvLogLevelGenerator>(max_links_per_node), cfg,
+                                             std::move(quantized_vectors));
+    GenerationHandler gen_handler;
+    vespalib::Timer timer;
+    for (uint32_t docid = 1; docid <= _docs.size(); ++docid) {
+        index->add_document(docid);
+        index->transfer_hold_lists(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        gen_handler.updateFirstUsedGeneration();
+        index->trim_hold_lists(gen_handler.getFirstUsedGeneration());
+    }
+    double build_time = vespalib::to_s(timer.elapsed());
+    auto& obj = result.setObject();
+    obj.setString("phase", "build");
+    obj.setLong("max_links_per_node", max_links_per_node);
+    obj.setLong("neighbors_to_explore_at_insert", neighbors_to_explore_at_insert);
+    obj.setBool("int8_quantization", int8_quantization);
+    obj.setLong("docs", _docs.size());
+    obj.setDouble("build_time_s", build_time);
+    obj.setDouble("docs_per_s", (build_time > 0.0) ? (_docs.size() / build_time) : 0.0);
+    obj.setLong("memory_used_bytes", index->memory_usage().usedBytes());
+    return index;
+}
+
+void
+NearestNeighborBenchmarkApp::run_queries(const HnswIndex& index, const BitVector* filter, FilterTraversal traversal,
+                                         uint32_t explore_k, uint32_t num_threads,
+                                         const std::vector<std::vector<uint32_t>>& ground_truth,
+                                         vespalib::slime::Cursor& result) const
+{
+    uint32_t num_queries = _queries.size();
+    std::vector<double> latencies(num_queries);
+    std::vector<double> recalls(num_queries);
+    std::atomic<uint32_t> next_query(0);
+    vespalib::ThreadStackExecutor executor(num_threads, 128_Ki);
+    vespalib::Timer timer;
+    for (uint32_t thread = 0; thread < num_threads; ++thread) {
+        executor.execute(vespalib::makeLambdaTask([&]() {
+            for (uint32_t i = next_query++; i < num_queries; i = next_query++) {
+                auto query = _queries.get_vector(i + 1);
+                vespalib::Timer query_timer;
+                auto hits = (filter != nullptr)
+                        ? index.find_top_k_with_filter(_target_hits, query, *filter, traversal, explore_k,
+                                                       std::numeric_limits<double>::max())
+                        : index.find_top_k(_target_hits, query, explore_k, std::numeric_limits<double>::max());
+                latencies[i] = vespalib::to_s(query_timer.elapsed()) * 1000.0;
+                const auto& expected = ground_truth[i];
+                size_t k = std::min(size_t(_target_hits), expected.size());
+                uint32_t found = 0;
+                for (const auto& hit : hits) {
+                    if (std::find(expected.begin(), expected.begin() + k, hit.docid) != expected.begin() + k) {
+                        ++found;
+                    }
+                }
+                recalls[i] = (k > 0) ? (double(found) / k) : 1.0;
+            }
+        }));
+    }
+    executor.sync();
+    double total_time = vespalib::to_s(timer.elapsed());
+    std::sort(latencies.begin(), latencies.end());
+    double recall_sum = 0.0;
+    for (double recall : recalls) {
+        recall_sum += recall;
+    }
+    result.setLong("queries", num_queries);
+    result.setDouble("qps", (total_time > 0.0) ? (num_queries / total_time) : 0.0);
+    result.setDouble("latency_avg_ms", (num_queries > 0) ? (std::accumulate(latencies.begin(), latencies.end(), 0.0) / num_queries) : 0.0);
+    result.setDouble("latency_p50_ms", percentile(latencies, 0.50));
+    result.setDouble("latency_p90_ms", percentile(latencies, 0.90));
+    result.setDouble("latency_p99_ms", percentile(latencies, 0.99));
+    result.setDouble("recall", (num_queries > 0) ? (recall_sum / num_queries) : 0.0);
+}
+
+int
+NearestNeighborBenchmarkApp::main(int argc, char** argv)
+{
+    if (!get_options(argc, argv)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (!_docs.load(_base_file, _num_docs) || !_queries.load(_query_file, _num_queries)) {
+        return 1;
+    }
+    if (_docs.dim_size() != _queries.dim_size()) {
+        LOG(error, "Documents have %u dimensions while queries have %u dimensions", _docs.dim_size(), _queries.dim_size());
+        return 1;
+    }
+    if (!_ground_truth_file.empty() && !load_ground_truth(_ground_truth_file, _queries.size(), _file_ground_truth)) {
+        return 1;
+    }
+    if (!_file_ground_truth.empty() && (_file_ground_truth.size() < _queries.size() || _num_docs != std::numeric_limits<uint32_t>::max())) {
+        LOG(warning, "Ground truth file does not match the documents and queries used, using brute force instead");
+        _file_ground_truth.clear();
+    }
+    uint32_t max_threads = *std::max_element(_threads.begin(), _threads.end());
+    auto distance_func = search::tensor::make_distance_function(_metric, vespalib::eval::CellType::FLOAT);
+    // Filters and the corresponding brute force results are shared by all index configurations.
+    std::vector<std::unique_ptr<BitVector>> filters;
+    std::vector<std::vector<std::vector<uint32_t>>> ground_truths;
+    for (double hit_ratio : _filter_hit_ratios) {
+        filters.push_back(make_filter(hit_ratio));
+        if (!filters.back() && !_file_ground_truth.empty()) {
+            ground_truths.push_back(_file_ground_truth);
+        } else {
+            LOG(info, "Calculating brute force results for filter hit ratio %g", hit_ratio);
+            ground_truths.push_back(brute_force(*distance_func, filters.back().get(), max_threads));
+        }
+    }
+    for (uint32_t int8_quantization : _int8_quantization) {
+        for (uint32_t max_links_per_node : _max_links_per_node) {
+            for (uint32_t neighbors_to_explore_at_insert : _neighbors_to_explore_at_insert) {
+                LOG(info, "Building index with max_links_per_node=%u, neighbors_to_explore_at_insert=%u, int8_quantization=%u",
+                    max_links_per_node, neighbors_to_explore_at_insert, int8_quantization);
+                vespalib::Slime build_result;
+                auto index = build_index(max_links_per_node, neighbors_to_explore_at_insert, int8_quantization != 0, build_result);
+                print_result(build_result);
+                for (size_t f = 0; f < filters.size(); ++f) {
+                    std::vector<FilterTraversal> traversals = {FilterTraversal::PLAIN};
+                    if (filters[f]) {
+                        traversals.push_back(FilterTraversal::FILTERED);
+                    }
+                    for (FilterTraversal traversal : traversals) {
+                        for (uint32_t explore_additional_hits : _explore_additional_hits) {
+                            for (uint32_t num_threads : _threads) {
+                                vespalib::Slime slime;
+                                auto& obj = slime.setObject();
+                                obj.setString("phase", "search");
+                                obj.setLong("max_links_per_node", max_links_per_node);
+                                obj.setLong("neighbors_to_explore_at_insert", neighbors_to_explore_at_insert);
+                                obj.setBool("int8_quantization", int8_quantization != 0);
+                                obj.setLong("target_hits", _target_hits);
+                                obj.setLong("explore_additional_hits", explore_additional_hits);
+                                obj.setDouble("filter_hit_ratio", std::min(1.0, _filter_hit_ratios[f]));
+                                obj.setString("filter_traversal", traversal_name(traversal));
+                                obj.setLong("threads", num_threads);
+                                obj.setDouble("estimated_cost",
+                                              index->estimate_search_cost(_target_hits + explore_additional_hits,
+                                                                          filters[f].get(), traversal));
+                                run_queries(*index, filters[f].get(), traversal, _target_hits + explore_additional_hits,
+                                            num_threads, ground_truths[f], obj);
+                                print_result(slime);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    vespalib::SignalHandler::PIPE.ignore();
+    NearestNeighborBenchmarkApp app;
+    return app.main(argc, argv);
+}
@@ -4,14 +4,17 @@
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/attribute.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributefilesavetarget.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/searchlib/attribute/attributememorysavetarget.h>
+#include <vespa/searchlib/attribute/attributesaver.h>
 #include <vespa/searchlib/attribute/multienumattribute.hpp>
 #include <vespa/searchlib/attribute/multistringattribute.h>
 #include <vespa/searchlib/attribute/multivalueattribute.hpp>
 #include <vespa/searchlib/attribute/predicate_attribute.h>
 #include <vespa/searchlib/attribute/singlenumericpostattribute.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
+#include <vespa/searchlib/common/serialnumfileheadercontext.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/weighted_type_test_utils.h>
 #include <vespa/searchlib/util/randomgenerator.h>
@@ -37,6 +40,7 @@ LOG_SETUP("attribute_test");
 using namespace document;
 using std::shared_ptr;
 using search::common::FileHeaderContext;
+using search::common::SerialNumFileHeaderContext;
 using search::index::DummyFileHeaderContext;
 using search::attribute::BasicType;
 using search::attribute::IAttributeVector;
@@ -256,6 +260,9 @@ protected:
 
     void testCreateSerialNum();
 
+    void saveAtSerialNum(std::unique_ptr<AttributeSaver> saver, SerialNum serialNum);
+    void testDeltaSave();
+
     void testPredicateHeaderTags();
 
     template <typename VectorType, typename BufferType>
@@ -1923,6 +1930,76 @@ AttributeTest::testCreateSerialNum()
     EXPECT_EQ(42u, attr2->getCreateSerialNum());
 }
 
+void
+AttributeTest::saveAtSerialNum(std::unique_ptr<AttributeSaver> saver, SerialNum serialNum)
+{
+    ASSERT_TRUE(saver);
+    DummyFileHeaderContext fileHeaderContext;
+    SerialNumFileHeaderContext serialNumFileHeaderContext(fileHeaderContext, serialNum);
+    AttributeFileSaveTarget saveTarget(TuneFileAttributes(), serialNumFileHeaderContext);
+    EXPECT_TRUE(saver->save(saveTarget));
+}
+
+void
+AttributeTest::testDeltaSave()
+{
+    Config cfg(BasicType::INT32);
+    AttributePtr attr = createAttribute("int32_delta", cfg);
+    auto &iattr = static_cast<IntegerAttribute &>(*attr);
+    addDocs(attr, 100);
+    for (uint32_t docId = 1; docId < 100; ++docId) {
+        iattr.update(docId, docId);
+    }
+    attr->commit(CommitParam(10, CommitParam::UpdateStats::FORCE));
+    EXPECT_EQ(0u, attr->getDeltaSaveBaseSerialNum());
+    saveAtSerialNum(attr->initSave(baseFileName("int32_delta_10")), 10);
+    EXPECT_EQ(10u, attr->getDeltaSaveBaseSerialNum());
+    EXPECT_LT(attr->getEstimatedDeltaSaveByteSize(), attr->getEstimatedSaveByteSize());
+
+    iattr.update(5, 500);
+    iattr.clearDoc(7);
+    AttributeVector::DocId docId;
+    for (uint32_t i = 0; i < 20; ++i) {
+        attr->addDoc(docId);
+    }
+    iattr.update(110, 1100);
+    attr->commit(CommitParam(20));
+    saveAtSerialNum(attr->initDeltaSave(baseFileName("int32_delta_20")), 20);
+    // Only the changed documents are saved, the base data file is reused
+    std::filesystem::copy_file(std::filesystem::path(baseFileName("int32_delta_10.dat")),
+                               std::filesystem::path(baseFileName("int32_delta_20.dat")),
+                               std::filesystem::copy_options::overwrite_existing);
+    AttributePtr attr2 = createAttribute("int32_delta_20", cfg);
+    EXPECT_TRUE(attr2->load());
+    EXPECT_EQ(120u, attr2->getCommittedDocIdLimit());
+    EXPECT_EQ(10u, attr2->getDeltaSaveBaseSerialNum());
+    for (uint32_t lid = 1; lid < 120; ++lid) {
+        EXPECT_EQ(attr->getInt(lid), attr2->getInt(lid)) << "lid=" << lid;
+    }
+    EXPECT_EQ(500, attr2->getInt(5));
+    EXPECT_EQ(1100, attr2->getInt(110));
+
+    // Changes loaded from the delta data file are still relative to the base data file
+    static_cast<IntegerAttribute &>(*attr2).update(8, 800);
+    attr2->commit(CommitParam(30));
+    saveAtSerialNum(attr2->initDeltaSave(baseFileName("int32_delta_30")), 30);
+    std::filesystem::copy_file(std::filesystem::path(baseFileName("int32_delta_10.dat")),
+                               std::filesystem::path(baseFileName("int32_delta_30.dat")),
+                               std::filesystem::copy_options::overwrite_existing);
+    AttributePtr attr3 = createAttribute("int32_delta_30", cfg);
+    EXPECT_TRUE(attr3->load());
+    EXPECT_EQ(500, attr3->getInt(5));
+    EXPECT_EQ(800, attr3->getInt(8));
+    EXPECT_EQ(1100, attr3->getInt(110));
+    EXPECT_EQ(attr->getInt(7), attr3->getInt(7));
+
+    // A full save starts over with a new base data file
+    attr3->commit(CommitParam(40));
+    saveAtSerialNum(attr3->initSave(baseFileName("int32_delta_40")), 40);
+    EXPECT_EQ(40u, attr3->getDeltaSaveBaseSerialNum());
+    EXPECT_LT(attr3->getEstimatedDeltaSaveByteSize(), attr->getEstimatedDeltaSaveByteSize());
+}
+
 void
 AttributeTest::testPredicateHeaderTags()
 {
@@ -2481,6 +2558,11 @@ TEST_F(AttributeTest, create_serial_num)
     testCreateSerialNum();
 }
 
+TEST_F(AttributeTest, delta_save)
+{
+    testDeltaSave();
+}
+
 TEST_F(AttributeTest, predicate_header_tags)
 {
     testPredicateHeaderTags();
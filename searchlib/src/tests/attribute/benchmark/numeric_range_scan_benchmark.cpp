@@ -0,0 +1,128 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/time.h>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * Compares evaluating a range term on a single value numeric attribute
+ * without fast-search one document at a time (find() per document) with
+ * the bulk scan used by get_hits() and strict iteration.
+ */
+
+using namespace search;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContext;
+using search::attribute::SearchContextParams;
+using vespalib::count_ms;
+using vespalib::steady_clock;
+using vespalib::steady_time;
+
+namespace {
+
+AttributeVector::SP
+make_attribute(BasicType type, uint32_t num_docs)
+{
+    auto attr = AttributeFactory::createAttribute("bench", Config(type, CollectionType::SINGLE));
+    auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+    attr->addReservedDoc();
+    attr->addDocs(num_docs);
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        int_attr.update(docid, rnd.lrand48() % 100);
+    }
+    attr->commit(true);
+    return attr;
+}
+
+std::unique_ptr<SearchContext>
+make_search(const AttributeVector &attr, uint32_t hit_percent)
+{
+    auto term = vespalib::make_string("[0;%u]", hit_percent - 1);
+    return attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD), SearchContextParams());
+}
+
+template <typename Func>
+void
+run(const char *name, size_t loops, Func func)
+{
+    steady_time start = steady_clock::now();
+    size_t hits = 0;
+    for (size_t i = 0; i < loops; ++i) {
+        hits += func();
+    }
+    double ms = count_ms(steady_clock::now() - start) / double(loops);
+    printf("    %-22s %10.2f ms (%zu hits)\n", name, ms, hits / loops);
+}
+
+void
+benchmark(BasicType type, uint32_t num_docs, size_t loops)
+{
+    auto attr = make_attribute(type, num_docs);
+    uint32_t doc_id_limit = attr->getCommittedDocIdLimit();
+    printf("%s, %u docs\n", type.asString(), num_docs);
+    for (uint32_t hit_percent : {1, 10, 50, 90}) {
+        printf("  %u%% hits\n", hit_percent);
+        auto sc = make_search(*attr, hit_percent);
+        fef::TermFieldMatchData tfmd;
+        run("per document find", loops, [&]() {
+            auto bv = BitVector::create(1, doc_id_limit);
+            for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+                if (sc->matches(docid)) {
+                    bv->setBit(docid);
+                }
+            }
+            bv->invalidateCachedCount();
+            return bv->countTrueBits();
+        });
+        run("bulk get_hits", loops, [&]() {
+            sc->fetchPostings(queryeval::ExecuteInfo::TRUE);
+            auto itr = sc->createIterator(&tfmd, true);
+            itr->initRange(1, doc_id_limit);
+            return itr->get_hits(1)->countTrueBits();
+        });
+        run("bulk strict iteration", loops, [&]() {
+            sc->fetchPostings(queryeval::ExecuteInfo::TRUE);
+            auto itr = sc->createIterator(&tfmd, true);
+            itr->initRange(1, doc_id_limit);
+            size_t hits = 0;
+            for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+                ++hits;
+            }
+            return hits;
+        });
+    }
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t num_docs = 10000000;
+    size_t loops = 5;
+    if (argc > 1) {
+        num_docs = atol(argv[1]);
+    }
+    if (argc > 2) {
+        loops = atol(argv[2]);
+    }
+    for (BasicType type : {BasicType::INT8, BasicType::INT16, BasicType::INT32, BasicType::INT64}) {
+        benchmark(type, num_docs, loops);
+    }
+    return 0;
+}
@@ -177,6 +177,50 @@ TEST_F("Test that compaction of integer array attribute reduces memory usage", F
     EXPECT_LESS(afterStatus.getUsed(), beforeStatus.getUsed());
 }
 
+TEST_F("Compaction steps performed by commit are accounted in attribute status", Fixture({ BasicType::INT64, CollectionType::ARRAY }))
+{
+    DocIdRange range1 = f.addDocs(2000);
+    DocIdRange range2 = f.addDocs(1000);
+    f.populate(range1, 40);
+    f.populate(range2, 40);
+    AttributeStatus beforeStatus = f.getStatus("before");
+    f.clean(range1);
+    AttributeStatus afterStatus = f.getStatus("after");
+    EXPECT_LESS(afterStatus.getUsed(), beforeStatus.getUsed());
+    EXPECT_LESS(beforeStatus.getCompactions(), afterStatus.getCompactions());
+    EXPECT_LESS_EQUAL(beforeStatus.getCompactionTime(), afterStatus.getCompactionTime());
+}
+
+Config fastSearchArrayConfig()
+{
+    Config cfg(BasicType::INT64, CollectionType::ARRAY);
+    cfg.setFastSearch(true);
+    return cfg;
+}
+
+TEST_F("At most one compaction step is performed per commit", Fixture(fastSearchArrayConfig()))
+{
+    DocIdRange range1 = f.addDocs(2000);
+    DocIdRange range2 = f.addDocs(1000);
+    f.populate(range1, 40);
+    f.populate(range2, 40);
+    for (uint32_t docId = range1.begin(); docId < range1.end(); ++docId) {
+        f._v->clearDoc(docId);
+    }
+    uint64_t compactions = f._v->getStatus().getCompactions();
+    uint32_t compacting_commits = 0;
+    for (uint32_t i = 0; i < 20; ++i) {
+        f._v->commit(true);
+        uint64_t new_compactions = f._v->getStatus().getCompactions();
+        EXPECT_LESS_EQUAL(new_compactions, compactions + 1);
+        if (new_compactions > compactions) {
+            ++compacting_commits;
+        }
+        compactions = new_compactions;
+    }
+    EXPECT_LESS(0u, compacting_commits);
+}
+
 TEST_F("Allocated memory is not accumulated in an array attribute when moving between value classes when compaction is active",
        Fixture({BasicType::INT64, CollectionType::ARRAY}))
 {
@@ -3,6 +3,8 @@
 #include <vespa/searchlib/attribute/enumstore.hpp>
 #include <vespa/searchlib/attribute/enum_store_loaders.h>
 #include <vespa/vespalib/test/memory_allocator_observer.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
 #include <vespa/log/log.h>
@@ -607,6 +609,31 @@ TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader)
 
 #pragma GCC diagnostic pop
 
+TEST(LoadedEnumTest, loaded_enums_can_be_sorted_in_parallel)
+{
+    constexpr uint32_t num_used_enums = 1000;
+    // The last enum values have no references.
+    constexpr uint32_t num_enums = num_used_enums + 10;
+    // Just above the size needed to sort in 4 partitions.
+    constexpr uint32_t num_docs = 4 * 256_Ki + 1;
+    attribute::LoadedEnumAttributeVector loaded;
+    for (uint32_t docid = num_docs; docid > 0; --docid) {
+        // Every other document has the same value, to get unbalanced enum value ranges.
+        uint32_t enum_value = ((docid % 2) == 0) ? 7 : (docid * 7919u) % num_used_enums;
+        loaded.push_back(attribute::LoadedEnumAttribute(enum_value, docid, docid % 5));
+    }
+    auto expected = loaded;
+    attribute::sortLoadedByEnum(expected);
+    vespalib::ThreadStackExecutor executor(4, 128_Ki);
+    attribute::sortLoadedByEnum(loaded, num_enums, &executor);
+    ASSERT_EQ(expected.size(), loaded.size());
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        ASSERT_EQ(expected[i].getEnum(), loaded[i].getEnum());
+        ASSERT_EQ(expected[i].getDocId(), loaded[i].getDocId());
+        ASSERT_EQ(expected[i].getWeight(), loaded[i].getWeight());
+    }
+}
+
 template <typename EnumStoreTypeAndDictionaryType>
 class EnumStoreDictionaryTest : public ::testing::Test {
 public:
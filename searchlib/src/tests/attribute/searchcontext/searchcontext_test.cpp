@@ -17,6 +17,7 @@
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/compress.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -248,6 +249,7 @@ private:
     void performFuzzySearch(const StringAttribute & vec, const vespalib::string & term,
                              const DocSet & expected, TermType termType);
     void testFuzzySearch(const AttributePtr & ptr);
+    void testFuzzySearchManyValues(const AttributePtr & ptr);
     void testFuzzySearch();
 
     // test that search is working after clear doc
@@ -282,6 +284,9 @@ private:
     void single_bool_attribute_search_context_handles_true_and_false_queries();
     void single_bool_attribute_search_iterator_handles_true_and_false_queries();
 
+    void verifyBulkHits(SearchContext & sc, uint32_t docIdLimit);
+    void requireThatBulkScanOfSingleNumericAttributeGivesSameHitsAsFind();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -1569,11 +1574,45 @@ SearchContextTest::testFuzzySearch(const AttributePtr & ptr)
     }
 }
 
+void
+SearchContextTest::testFuzzySearchManyValues(const AttributePtr & ptr)
+{
+    LOG(info, "testFuzzySearchManyValues: vector '%s'", ptr->getName().c_str());
+
+    auto & vec = dynamic_cast<StringAttribute &>(*ptr.get());
+
+    // many unique values, to exercise seeking in the dictionary
+    uint32_t numDocs = 1000;
+    addDocs(*ptr.get(), numDocs);
+    std::vector<vespalib::string> values;
+    for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+        vespalib::string value;
+        for (uint32_t i = 0, rest = doc; i < 5; ++i, rest /= 5) {
+            value.push_back(((doc % 3) == 0 ? 'A' : 'a') + (rest % 5));
+        }
+        values.push_back(value);
+        EXPECT_TRUE(vec.update(doc, value));
+    }
+    ptr->commit(true);
+
+    for (const char * term : {"abcde", "EDCBA", "aaaaa", "eeeee", "bad", "abcdeabcde"}) {
+        vespalib::FuzzyMatcher matcher(term, 2, 0, false);
+        DocSet expected;
+        for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+            if (matcher.isMatch(values[doc - 1].c_str())) {
+                expected.put(doc);
+            }
+        }
+        TEST_DO(performFuzzySearch(vec, term, expected, TermType::FUZZYTERM));
+    }
+}
+
 void
 SearchContextTest::testFuzzySearch()
 {
     for (const auto & cfg : _stringCfg) {
         testFuzzySearch(AttributeFactory::createAttribute(cfg.first, cfg.second));
+        testFuzzySearchManyValues(AttributeFactory::createAttribute(cfg.first, cfg.second));
     }
 }
 
@@ -1985,6 +2024,97 @@ SearchContextTest::single_bool_attribute_search_iterator_handles_true_and_false_
     EXPECT_EQUAL(false_exp, f.search_iterator("0", true));
 }
 
+void
+SearchContextTest::verifyBulkHits(SearchContext & sc, uint32_t docIdLimit)
+{
+    std::vector<uint32_t> expected;
+    for (uint32_t docId = 1; docId < docIdLimit; ++docId) {
+        if (sc.matches(docId)) {
+            expected.push_back(docId);
+        }
+    }
+    for (bool strict : {false, true}) {
+        TermFieldMatchData dummy;
+        sc.fetchPostings(queryeval::ExecuteInfo::create(strict, 1.0));
+        SearchBasePtr sb = sc.createIterator(&dummy, strict);
+        sb->initRange(1, docIdLimit);
+        std::vector<uint32_t> hits;
+        for (uint32_t docId = 1; docId < docIdLimit; ++docId) {
+            if (sb->seek(docId)) {
+                hits.push_back(docId);
+            } else if (strict) {
+                // strict iterator is positioned at the next hit
+                docId = sb->getDocId() - 1;
+            }
+        }
+        EXPECT_TRUE(expected == hits);
+
+        for (uint32_t beginId : {1u, 70u}) {
+            std::vector<uint32_t> expectedFrom(std::lower_bound(expected.begin(), expected.end(), beginId), expected.end());
+            sb->initRange(beginId, docIdLimit);
+            auto bv = sb->get_hits(beginId);
+            std::vector<uint32_t> bvHits;
+            bv->foreach_truebit([&](uint32_t docId) { bvHits.push_back(docId); });
+            EXPECT_TRUE(expectedFrom == bvHits);
+            EXPECT_EQUAL(expectedFrom.size(), bv->countTrueBits());
+
+            sb->initRange(beginId, docIdLimit);
+            auto all = BitVector::create(beginId, docIdLimit);
+            all->setInterval(beginId, docIdLimit);
+            sb->and_hits_into(*all, beginId);
+            EXPECT_TRUE(*bv == *all);
+
+            // result may start before beginId, bits before beginId are kept
+            sb->initRange(beginId, docIdLimit);
+            auto fromStart = BitVector::create(1, docIdLimit);
+            fromStart->setInterval(1, docIdLimit);
+            sb->and_hits_into(*fromStart, beginId);
+            std::vector<uint32_t> fromStartHits;
+            fromStart->foreach_truebit([&](uint32_t docId) { fromStartHits.push_back(docId); }, beginId);
+            EXPECT_TRUE(expectedFrom == fromStartHits);
+            EXPECT_EQUAL((beginId - 1) + expectedFrom.size(), fromStart->countTrueBits());
+
+            sb->initRange(beginId, docIdLimit);
+            auto some = BitVector::create(beginId, docIdLimit);
+            some->setBit(docIdLimit - 1);
+            sb->or_hits_into(*some, beginId);
+            bv->setBit(docIdLimit - 1);
+            EXPECT_TRUE(*bv == *some);
+        }
+    }
+}
+
+void
+SearchContextTest::requireThatBulkScanOfSingleNumericAttributeGivesSameHitsAsFind()
+{
+    const uint32_t numDocs = 1000;
+    for (BasicType type : {BasicType::INT8, BasicType::INT16, BasicType::INT32, BasicType::INT64,
+                           BasicType::FLOAT, BasicType::DOUBLE, BasicType::UINT2, BasicType::UINT4})
+    {
+        for (bool isFilter : {false, true}) {
+            Config cfg(type, CollectionType::SINGLE);
+            cfg.setIsFilter(isFilter);
+            AttributePtr ptr = AttributeFactory::createAttribute("bulk", cfg);
+            addDocs(*ptr, numDocs);
+            for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+                uint32_t value = ((docId * 7) % 13) & ((type == BasicType::UINT2) ? 3 : 15);
+                if (ptr->isFloatingPointType()) {
+                    EXPECT_TRUE(dynamic_cast<FloatingPointAttribute &>(*ptr).update(docId, value));
+                } else {
+                    EXPECT_TRUE(dynamic_cast<IntegerAttribute &>(*ptr).update(docId, value));
+                }
+            }
+            ptr->commit(true);
+            for (const char * term : {"3", "[2;5]", "[9;100]", "14"}) {
+                SearchContextPtr sc = getSearch(*ptr, term);
+                TEST_STATE(vespalib::make_string("type=%s, filter=%d, term=%s",
+                                                 type.asString(), isFilter, term).c_str());
+                TEST_DO(verifyBulkHits(*sc, ptr->getCommittedDocIdLimit()));
+            }
+        }
+    }
+}
+
 void
 SearchContextTest::initIntegerConfig()
 {
@@ -2118,6 +2248,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
     TEST_DO(single_bool_attribute_search_context_handles_true_and_false_queries());
     TEST_DO(single_bool_attribute_search_iterator_handles_true_and_false_queries());
+    TEST_DO(requireThatBulkScanOfSingleNumericAttributeGivesSameHitsAsFind());
 
     TEST_DONE();
 }
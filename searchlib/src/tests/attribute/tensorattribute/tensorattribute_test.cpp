@@ -57,6 +57,7 @@ using search::tensor::NearestNeighborIndexSaver;
 using search::tensor::PrepareResult;
 using search::tensor::SerializedFastValueAttribute;
 using search::tensor::TensorAttribute;
+using search::tensor::VectorBundle;
 using vespalib::datastore::CompactionStrategy;
 using vespalib::eval::CellType;
 using vespalib::eval::SimpleValue;
@@ -65,11 +66,13 @@ using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 
 using DoubleVector = std::vector<double>;
+using DocVectorEntries = std::vector<std::pair<uint32_t, DoubleVector>>;
 using generation_t = vespalib::GenerationHandler::generation_t;
 
 vespalib::string sparseSpec("tensor(x{},y{})");
 vespalib::string denseSpec("tensor(x[2],y[3])");
 vespalib::string vec_2d_spec("tensor(x[2])");
+vespalib::string mixed_2d_spec("tensor(m{},x[2])");
 
 Value::UP createTensor(const TensorSpec &spec) {
     return SimpleValue::from_spec(spec);
@@ -81,6 +84,17 @@ vec_2d(double x0, double x1)
     return TensorSpec(vec_2d_spec).add({{"x", 0}}, x0).add({{"x", 1}}, x1);
 }
 
+TensorSpec
+mixed_2d(const std::vector<DoubleVector>& subspaces)
+{
+    TensorSpec result(mixed_2d_spec);
+    for (size_t i = 0; i < subspaces.size(); ++i) {
+        vespalib::string label = std::to_string(i);
+        result.add({{"m", label}, {"x", 0}}, subspaces[i][0]).add({{"m", label}, {"x", 1}}, subspaces[i][1]);
+    }
+    return result;
+}
+
 class MockIndexSaver : public NearestNeighborIndexSaver {
 private:
     int _index_value;
@@ -119,7 +133,6 @@ class MockNearestNeighborIndex : public NearestNeighborIndex {
 private:
     using Entry = std::pair<uint32_t, DoubleVector>;
     using EntryVector = std::vector<Entry>;
-
     const DocVectorAccess& _vectors;
     EntryVector _adds;
     EntryVector _removes;
@@ -129,6 +142,8 @@ private:
     generation_t _trim_gen;
     mutable size_t _memory_usage_cnt;
     int _index_value;
+    double _plain_cost;
+    double _filtered_cost;
 
 public:
     MockNearestNeighborIndex(const DocVectorAccess& vectors)
@@ -140,7 +155,9 @@ public:
           _transfer_gen(std::numeric_limits<generation_t>::max()),
           _trim_gen(std::numeric_limits<generation_t>::max()),
           _memory_usage_cnt(0),
-          _index_value(0)
+          _index_value(0),
+          _plain_cost(0.0),
+          _filtered_cost(0.0)
     {
     }
     void clear() {
@@ -155,6 +172,10 @@ public:
     void save_index_with_value(int value) {
         _index_value = value;
     }
+    void set_search_cost_estimates(double plain, double filtered) {
+        _plain_cost = plain;
+        _filtered_cost = filtered;
+    }
     void expect_empty_add() const {
         EXPECT_TRUE(_adds.empty());
     }
@@ -202,10 +223,11 @@ public:
         _adds.emplace_back(docid, DoubleVector(vector.begin(), vector.end()));
     }
     std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid,
-                                                        vespalib::eval::TypedCells vector,
+                                                        VectorBundle vectors,
                                                         vespalib::GenerationHandler::Guard guard) const override {
         (void) guard;
-        auto d_vector = vector.typify<double>();
+        assert(vectors.subspaces() == 1);
+        auto d_vector = vectors.cells(0).typify<double>();
         _prepare_adds.emplace_back(docid, DoubleVector(d_vector.begin(), d_vector.end()));
         return std::make_unique<MockPrepareResult>(docid);
     }
@@ -260,16 +282,24 @@ public:
         return std::vector<Neighbor>();
     }
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, vespalib::eval::TypedCells vector,
-                                                 const search::BitVector& filter, uint32_t explore_k,
-                                                 double distance_threshold) const override
+                                                 const search::BitVector& filter, FilterTraversal traversal,
+                                                 uint32_t explore_k, double distance_threshold) const override
     {
         (void) k;
         (void) vector;
         (void) explore_k;
         (void) filter;
+        (void) traversal;
         (void) distance_threshold;
         return std::vector<Neighbor>();
     }
+    double estimate_search_cost(uint32_t explore_k, const search::BitVector* filter,
+                                FilterTraversal traversal) const override
+    {
+        (void) explore_k;
+        (void) filter;
+        return (traversal == FilterTraversal::FILTERED) ? _filtered_cost : _plain_cost;
+    }
 
     
     const search::tensor::DistanceFunction *distance_function() const override {
@@ -282,10 +312,14 @@ class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
 
     std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                size_t vector_size,
+                                               bool multi_vector,
                                                CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override {
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override {
         (void) vector_size;
+        (void) multi_vector;
         (void) params;
+        (void) memory_allocator;
         assert(cell_type == CellType::DOUBLE);
         return std::make_unique<MockNearestNeighborIndex>(vectors);
     }
@@ -326,6 +360,13 @@ struct FixtureTraits {
         return *this;
     }
 
+    FixtureTraits mixed_hnsw() && {
+        use_dense_tensor_attribute = false;
+        enable_hnsw_index = true;
+        use_mock_index = false;
+        return *this;
+    }
+
     FixtureTraits direct() && {
         use_dense_tensor_attribute = false;
         use_direct_tensor_attribute = true;
@@ -408,7 +449,7 @@ struct Fixture {
         } else if (_traits.use_direct_tensor_attribute) {
             return std::make_shared<DirectTensorAttribute>(_name, _cfg);
         } else {
-            return std::make_shared<SerializedFastValueAttribute>(_name, _cfg);
+            return std::make_shared<SerializedFastValueAttribute>(_name, _cfg, *_index_factory);
         }
     }
 
@@ -420,8 +461,8 @@ struct Fixture {
 
     template <typename IndexType>
     IndexType& get_nearest_neighbor_index() {
-        assert(as_dense_tensor().nearest_neighbor_index() != nullptr);
-        auto index = dynamic_cast<const IndexType*>(as_dense_tensor().nearest_neighbor_index());
+        assert(_tensorAttr->nearest_neighbor_index() != nullptr);
+        auto index = dynamic_cast<const IndexType*>(_tensorAttr->nearest_neighbor_index());
         assert(index != nullptr);
         return *const_cast<IndexType*>(index);
     }
@@ -844,6 +885,48 @@ TEST_F("Populates address space usage", DenseTensorAttributeHnswIndex)
 }
 
 
+class MixedTensorAttributeHnswIndex : public Fixture {
+public:
+    MixedTensorAttributeHnswIndex() : Fixture(mixed_2d_spec, FixtureTraits().mixed_hnsw()) {}
+};
+
+TEST_F("Hnsw index is integrated in mixed tensor attribute with one node per subspace", MixedTensorAttributeHnswIndex)
+{
+    f.set_tensor(1, mixed_2d({{3, 5}, {7, 9}}));
+    f.set_tensor(2, mixed_2d({{1, 1}}));
+    auto& index_a = f.hnsw_index();
+    EXPECT_TRUE(index_a.config().multi_vector());
+    EXPECT_EQUAL(2u, index_a.get_id_mapping()->get_ids(1).size());
+    EXPECT_EQUAL(1u, index_a.get_id_mapping()->get_ids(2).size());
+
+    // All subspaces of the old tensor are replaced.
+    f.set_tensor(1, mixed_2d({{4, 4}}));
+    EXPECT_EQUAL(1u, index_a.get_id_mapping()->get_ids(1).size());
+    // The distance is calculated to the closest subspace.
+    f.set_tensor(3, mixed_2d({{9, 9}, {4, 5}}));
+    auto query = SimpleValue::from_spec(vec_2d(4, 4));
+    DistanceCalculator calc(*f._tensorAttr, *query);
+    EXPECT_EQUAL(0.0, calc.calc_with_limit(1, std::numeric_limits<double>::max()));
+    EXPECT_EQUAL(1.0, calc.calc_with_limit(3, std::numeric_limits<double>::max()));
+
+    f.save();
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(attr_name + ".mvnnidx")));
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(attr_name + ".nnidx")));
+    f.load();
+    auto& index_b = f.hnsw_index();
+    EXPECT_NOT_EQUAL(&index_a, &index_b);
+    EXPECT_EQUAL(1u, index_b.get_id_mapping()->get_ids(1).size());
+    EXPECT_EQUAL(1u, index_b.get_id_mapping()->get_ids(2).size());
+    EXPECT_EQUAL(2u, index_b.get_id_mapping()->get_ids(3).size());
+    auto result = index_b.find_top_k(2, query->cells(), 10, 10000.0);
+    ASSERT_EQUAL(2u, result.size());
+    EXPECT_EQUAL(1u, result[0].docid);
+    EXPECT_EQUAL(3u, result[1].docid);
+
+    f.clearTensor(3);
+    EXPECT_EQUAL(0u, index_b.get_id_mapping()->get_ids(3).size());
+}
+
 class DenseTensorAttributeMockIndex : public Fixture {
 public:
     DenseTensorAttributeMockIndex() : Fixture(vec_2d_spec, FixtureTraits().mock_hnsw()) {}
@@ -1011,6 +1094,28 @@ TEST_F("onLoad() uses executor if major index parameters are changed", DenseTens
     index.expect_complete_adds({{1, {3, 5}}, {2, {7, 9}}});
 }
 
+TEST_F("onLoad() prepares documents in batches when reconstructing index with executor", DenseTensorAttributeMockIndex)
+{
+    constexpr uint32_t num_docs = 400;
+    DocVectorEntries exp_adds;
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        f.set_tensor(docid, vec_2d(docid, docid + 1));
+        exp_adds.emplace_back(docid, DoubleVector{double(docid), double(docid + 1)});
+    }
+    f.save();
+    f.loadWithExecutor();
+    // The batch size is 1/8 of the completed documents (at least 1), giving 49 batches.
+    // 7 batches (17-31 docs) are prepared in 2 chunks of max 16 docs and 2 batches (35, 39 docs) in 3 chunks.
+    EXPECT_EQUAL(60ul, f._executor.getStats().acceptedTasks);
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        f.assertGetTensor(vec_2d(docid, docid + 1), docid);
+    }
+    auto& index = f.mock_index();
+    index.expect_adds({});
+    index.expect_prepare_adds(exp_adds);
+    index.expect_complete_adds(exp_adds);
+}
+
 TEST_F("onLoad() ignores saved nearest neighbor index if major index parameters are changed", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -1035,6 +1140,19 @@ TEST_F("onLoad() uses saved nearest neighbor index if only minor index parameter
     index.expect_adds({});
 }
 
+TEST_F("onLoad() uses saved nearest neighbor index if int8 quantization or disk resident mode is toggled", DenseTensorAttributeMockIndex)
+{
+    EXPECT_TRUE(HnswIndexParams(4, 20, DistanceMetric::Euclidean) ==
+                HnswIndexParams(4, 20, DistanceMetric::Euclidean, false, true, true));
+    f.save_example_tensors_with_mock_index();
+    f.set_hnsw_index_params(HnswIndexParams(4, 20, DistanceMetric::Euclidean, false, true, true));
+    f.load();
+    f.assert_example_tensors();
+    auto& index = f.mock_index();
+    EXPECT_EQUAL(123, index.get_index_value());
+    index.expect_adds({});
+}
+
 TEST_F("Nearest neighbor index type is added to attribute file header", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -1158,6 +1276,37 @@ TEST_F("NN blueprint handles strong filter triggering exact search", NearestNeig
     EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp->get_algorithm());
 }
 
+TEST_F("NN blueprint uses filtered traversal when estimated to be cheaper than plain traversal", NearestNeighborBlueprintFixture)
+{
+    f.mock_index().set_search_cost_estimates(6.0, 3.0);
+    auto bp = f.make_blueprint();
+    auto filter = search::BitVector::create(11);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        filter->setBit(docid);
+    }
+    filter->invalidateCachedCount();
+    auto medium_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*medium_filter, 0.6);
+    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL, bp->get_algorithm());
+}
+
+TEST_F("NN blueprint uses index above brute force limit even when exact search is estimated to be cheaper", NearestNeighborBlueprintFixture)
+{
+    // Both index cost estimates are above the 7 distance calculations done by exact search.
+    f.mock_index().set_search_cost_estimates(10.0, 8.0);
+    auto bp = f.make_blueprint(true, 0.5);
+    auto filter = search::BitVector::create(11);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        filter->setBit(docid);
+    }
+    filter->invalidateCachedCount();
+    auto medium_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*medium_filter, 0.6);
+    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL, bp->get_algorithm());
+}
+
 TEST_F("NN blueprint wants global filter when having index", NearestNeighborBlueprintFixture)
 {
     auto bp = f.make_blueprint();
@@ -0,0 +1,198 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
+#include <vespa/searchlib/common/compressedbitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+using search::BitVector;
+using search::CompressedBitVector;
+using search::CompressedBitVectorIterator;
+using search::fef::TermFieldMatchData;
+
+namespace {
+
+constexpr uint32_t num_docs = 5 * CompressedBitVector::chunk_size + 1000;
+
+// mix of empty, sparse and dense chunks
+BitVector::UP make_random(uint32_t seed) {
+    vespalib::Rand48 rnd;
+    rnd.srand48(seed);
+    auto bv = BitVector::create(num_docs);
+    const std::vector<uint32_t> per_mille = {0, 2, 100, 600, 20, 1000};
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        uint32_t density = per_mille[(docid / CompressedBitVector::chunk_size) % per_mille.size()];
+        if (uint32_t(rnd.lrand48() % 1000) < density) {
+            bv->setBit(docid);
+        }
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+void verify_same(const BitVector &expect, const CompressedBitVector &actual) {
+    EXPECT_EQUAL(expect.size(), actual.size());
+    EXPECT_EQUAL(expect.countTrueBits(), actual.countTrueBits());
+    for (uint32_t docid = 0; docid < expect.size(); ++docid) {
+        if (expect.testBit(docid) != actual.testBit(docid)) {
+            TEST_ERROR(vespalib::make_string("bit %u differs", docid).c_str());
+            return;
+        }
+    }
+    uint32_t expect_next = expect.getNextTrueBit(0);
+    uint32_t actual_next = actual.getNextTrueBit(0);
+    while (expect_next < expect.size()) {
+        EXPECT_EQUAL(expect_next, actual_next);
+        expect_next = expect.getNextTrueBit(expect_next + 1);
+        actual_next = actual.getNextTrueBit(actual_next + 1);
+    }
+    EXPECT_EQUAL(actual.size(), actual_next);
+}
+
+}
+
+TEST("require that compressed bit vector matches flat bit vector") {
+    auto bv = make_random(1);
+    auto cbv = CompressedBitVector::create(*bv);
+    TEST_DO(verify_same(*bv, *cbv));
+    auto flat = cbv->to_bitvector();
+    EXPECT_TRUE(*bv == *flat);
+}
+
+TEST("require that bits can be set in any order") {
+    auto bv = make_random(2);
+    CompressedBitVector cbv(num_docs);
+    std::vector<uint32_t> docids;
+    bv->foreach_truebit([&docids](uint32_t docid) { docids.push_back(docid); });
+    std::reverse(docids.begin(), docids.end());
+    for (uint32_t docid : docids) {
+        cbv.setBit(docid);
+        cbv.setBit(docid);
+    }
+    TEST_DO(verify_same(*bv, cbv));
+    EXPECT_TRUE(cbv == *CompressedBitVector::create(*bv));
+}
+
+TEST("require that and, or and andNot give same result as flat bit vector") {
+    auto a = make_random(3);
+    auto b = make_random(4);
+    {
+        auto expect = BitVector::create(*a);
+        expect->andWith(*b);
+        auto actual = CompressedBitVector::create(*a);
+        actual->andWith(*CompressedBitVector::create(*b));
+        TEST_DO(verify_same(*expect, *actual));
+    }
+    {
+        auto expect = BitVector::create(*a);
+        expect->orWith(*b);
+        auto actual = CompressedBitVector::create(*a);
+        actual->orWith(*CompressedBitVector::create(*b));
+        TEST_DO(verify_same(*expect, *actual));
+    }
+    {
+        auto expect = BitVector::create(*a);
+        expect->andNotWith(*b);
+        auto actual = CompressedBitVector::create(*a);
+        actual->andNotWith(*CompressedBitVector::create(*b));
+        TEST_DO(verify_same(*expect, *actual));
+    }
+}
+
+TEST("require that compressed bit vector can be combined into flat bit vector") {
+    auto a = make_random(5);
+    auto b = make_random(6);
+    auto cb = CompressedBitVector::create(*b);
+    {
+        auto expect = BitVector::create(*a);
+        expect->andWith(*b);
+        auto actual = BitVector::create(*a);
+        cb->and_into(*actual);
+        EXPECT_TRUE(*expect == *actual);
+        EXPECT_EQUAL(expect->countTrueBits(), actual->countTrueBits());
+    }
+    {
+        auto expect = BitVector::create(*a);
+        expect->orWith(*b);
+        auto actual = BitVector::create(*a);
+        cb->or_into(*actual);
+        EXPECT_TRUE(*expect == *actual);
+        EXPECT_EQUAL(expect->countTrueBits(), actual->countTrueBits());
+    }
+    {
+        auto expect = BitVector::create(*a);
+        expect->andNotWith(*b);
+        auto actual = BitVector::create(*a);
+        cb->and_not_into(*actual);
+        EXPECT_TRUE(*expect == *actual);
+        EXPECT_EQUAL(expect->countTrueBits(), actual->countTrueBits());
+    }
+}
+
+TEST("require that only the index space covered by both vectors is considered") {
+    auto large = make_random(9);
+    auto small = BitVector::create(num_docs - 100);
+    make_random(8)->foreach_truebit([&small](uint32_t docid) { small->setBit(docid); }, 0, small->size());
+    small->invalidateCachedCount();
+    {
+        // bits in the last chunk of the larger vector must not be set beyond the end of the smaller one
+        auto expect = BitVector::create(*small);
+        large->foreach_truebit([&expect](uint32_t docid) { expect->setBit(docid); }, 0, small->size());
+        expect->invalidateCachedCount();
+        auto actual = CompressedBitVector::create(*small);
+        actual->orWith(*CompressedBitVector::create(*large));
+        TEST_DO(verify_same(*expect, *actual));
+    }
+    {
+        // bits in result beyond the end of the compressed vector are left unchanged
+        auto cbv = CompressedBitVector::create(*small);
+        auto actual = BitVector::create(*large);
+        cbv->and_into(*actual);
+        for (uint32_t docid = small->size(); docid < num_docs; ++docid) {
+            EXPECT_EQUAL(large->testBit(docid), actual->testBit(docid));
+        }
+        for (uint32_t docid = 0; docid < small->size(); ++docid) {
+            EXPECT_EQUAL(large->testBit(docid) && small->testBit(docid), actual->testBit(docid));
+        }
+    }
+}
+
+TEST("require that sparse bit vectors use less memory when compressed") {
+    auto bv = BitVector::create(num_docs);
+    for (uint32_t docid = 1; docid < num_docs; docid += 1000) {
+        bv->setBit(docid);
+    }
+    bv->invalidateCachedCount();
+    auto cbv = CompressedBitVector::create(*bv);
+    EXPECT_TRUE(cbv->memory_usage() * 4 < BitVector::getFileBytes(num_docs));
+    EXPECT_TRUE(CompressedBitVector::should_compress(bv->countTrueBits(), num_docs));
+    EXPECT_FALSE(CompressedBitVector::should_compress(num_docs / 10, num_docs));
+    EXPECT_FALSE(CompressedBitVector::should_compress(10, 100));
+}
+
+TEST("require that iterator finds the same hits as the bit vector") {
+    auto bv = make_random(7);
+    auto cbv = CompressedBitVector::create(*bv);
+    for (bool strict : {false, true}) {
+        TermFieldMatchData tfmd;
+        auto search = CompressedBitVectorIterator::create(cbv.get(), num_docs, tfmd, strict);
+        EXPECT_EQUAL(strict, search->is_strict() == vespalib::Trinary::True);
+        search->initRange(1, num_docs);
+        std::vector<uint32_t> hits;
+        for (uint32_t docid = 1; docid < num_docs && !search->isAtEnd(); ++docid) {
+            if (search->seek(docid)) {
+                hits.push_back(docid);
+            }
+        }
+        std::vector<uint32_t> expect;
+        bv->foreach_truebit([&expect](uint32_t docid) { expect.push_back(docid); }, 1);
+        EXPECT_TRUE(expect == hits);
+        search->initRange(1, num_docs);
+        auto hits_bv = search->get_hits(1);
+        EXPECT_EQUAL(bv->countTrueBits(), hits_bv->countTrueBits());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
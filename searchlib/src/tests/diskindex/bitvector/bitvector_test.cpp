@@ -51,7 +51,7 @@ FieldWriterWrapper::open(const std::string &path,
                         const common::FileHeaderContext &fileHeaderContext)
 {
     std::filesystem::create_directory(std::filesystem::path(path));
-    return _writer.open(path, 64, 10000, false, false, schema, indexId, FieldLengthInfo(), tuneFileWrite, fileHeaderContext);
+    return _writer.open(path, 64, 10000, false, false, false, schema, indexId, FieldLengthInfo(), tuneFileWrite, fileHeaderContext);
 }
 
 FieldWriterWrapper &
@@ -87,6 +87,9 @@ public:
     void
     requireThatDictionaryHandlesMultipleEntries(bool directio, bool readmmap);
 
+    void
+    requireThatSparseBitVectorsAreCompressed(bool directio, bool readmmap);
+
     Test();
     int Main() override;
 };
@@ -190,6 +193,55 @@ Test::requireThatDictionaryHandlesMultipleEntries(bool directio, bool readmmap)
     EXPECT_TRUE(*bv5exp == *bv5act);
 }
 
+void
+Test::requireThatSparseBitVectorsAreCompressed(bool directio, bool readmmap)
+{
+    TuneFileSeqWrite tuneFileWrite;
+    TuneFileRandRead tuneFileRead;
+    DummyFileHeaderContext fileHeaderContext;
+
+    if (directio) {
+        tuneFileWrite.setWantDirectIO();
+        tuneFileRead.setWantDirectIO();
+    }
+    if (readmmap)
+        tuneFileRead.setWantMemoryMap();
+    constexpr uint32_t docIdLimit = 1024 * 1024;
+    FieldWriterWrapper fww(docIdLimit, 2);
+    EXPECT_TRUE(fww.open("dump/3/", _schema, _indexId, tuneFileWrite,
+                         fileHeaderContext));
+    // 1/50 of the docs for word 1, above the bitvector limit (1/64) but sparse enough to be compressed
+    BitVector::UP bv1exp(BitVector::create(docIdLimit));
+    fww.newWord("1");
+    for (uint32_t docId = 50; docId < docIdLimit; docId += 50) {
+        fww.add(docId);
+        bv1exp->setBit(docId);
+    }
+    bv1exp->invalidateCachedCount();
+    // 1/4 of the docs for word 2
+    fww.newWord("2");
+    for (uint32_t docId = 4; docId < docIdLimit; docId += 4) {
+        fww.add(docId);
+    }
+    EXPECT_TRUE(fww._writer.close());
+
+    BitVectorDictionary dict;
+    BitVectorKeyScope bvScope(BitVectorKeyScope::PERFIELD_WORDS);
+    EXPECT_TRUE(dict.open("dump/3/", tuneFileRead, bvScope));
+    EXPECT_EQUAL(2u, dict.getEntries().size());
+
+    CompressedBitVector::SP cbv1 = dict.lookup_compressed(1);
+    EXPECT_TRUE(cbv1.get() != NULL);
+    EXPECT_EQUAL(bv1exp->countTrueBits(), cbv1->countTrueBits());
+    EXPECT_TRUE(*bv1exp == *cbv1->to_bitvector());
+    // compressed once when opened, shared by later lookups
+    EXPECT_TRUE(dict.lookup_compressed(1).get() == cbv1.get());
+    EXPECT_LESS(cbv1->memory_usage(), dict.getCompressedMemoryUsage() + 1);
+    EXPECT_LESS(dict.getCompressedMemoryUsage(), BitVector::getFileBytes(docIdLimit));
+    EXPECT_TRUE(dict.lookup_compressed(2).get() == NULL);
+    EXPECT_TRUE(dict.lookup(2).get() != NULL);
+}
+
 Test::Test()
     : _schema(),
       _indexId(0)
@@ -214,6 +266,9 @@ Test::Main()
     TEST_DO(requireThatDictionaryHandlesMultipleEntries(true, false));
     TEST_DO(requireThatDictionaryHandlesNoEntries(false, true));
     TEST_DO(requireThatDictionaryHandlesMultipleEntries(false, true));
+    TEST_DO(requireThatSparseBitVectorsAreCompressed(false, false));
+    TEST_DO(requireThatSparseBitVectorsAreCompressed(true, false));
+    TEST_DO(requireThatSparseBitVectorsAreCompressed(false, true));
 
     TEST_DONE();
 }
@@ -9,6 +9,7 @@
 #include <vespa/searchlib/diskindex/zcposocciterators.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
+#include <vespa/searchlib/queryeval/cost_model.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
@@ -224,6 +225,8 @@ Test::requireThatWeCanReadBitVector()
             BitVector::UP bv = _index->readBitVector(*r);
             EXPECT_TRUE(bv.get() != NULL);
             EXPECT_TRUE(*bv == *exp);
+            // too dense to be compressed
+            EXPECT_TRUE(_index->readCompressedBitVector(*r).get() == NULL);
         }
     }
 }
@@ -269,6 +272,7 @@ Test::requireThatBlueprintCanCreateSearchIterators()
     SearchIterator::UP s;
     { // bit vector due to isFilter
         b = _index->createBlueprint(_requestContext, FieldSpec("f2", 0, 0, true), makeTerm("w2"));
+        EXPECT_EQUAL(CostModel::bitvector_seek_cost, b->getState().cost());
         b->fetchPostings(queryeval::ExecuteInfo::TRUE);
         s = (dynamic_cast<LeafBlueprint *>(b.get()))->createLeafSearch(mda, true);
         EXPECT_TRUE(dynamic_cast<BitVectorIterator *>(s.get()) != NULL);
@@ -297,6 +301,7 @@ Test::requireThatBlueprintCanCreateSearchIterators()
     }
     { // posting list iterator
         b = _index->createBlueprint(_requestContext, FieldSpec("f1", 0, 0), makeTerm("w1"));
+        EXPECT_EQUAL(CostModel::posting_seek_cost, b->getState().cost());
         b->fetchPostings(queryeval::ExecuteInfo::TRUE);
         s = (dynamic_cast<LeafBlueprint *>(b.get()))->createLeafSearch(mda, true);
         ASSERT_TRUE((dynamic_cast<ZcRareWordPosOccIterator<true, false> *>(s.get()) != NULL));
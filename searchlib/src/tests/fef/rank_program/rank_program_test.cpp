@@ -4,6 +4,7 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/features/valuefeature.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
+#include <vespa/searchlib/fef/batch_inputs.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
@@ -15,6 +16,7 @@
 #include <vespa/searchlib/fef/test/test_features.h>
 #include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 
 using namespace search::fef;
 using namespace search::fef::test;
@@ -373,6 +375,52 @@ TEST_F("require that interpreted ranking expressions are pure", Fixture()) {
     EXPECT_EQUAL(f1.get(), 7.0);
 }
 
+TEST_F("require that compiled ranking expressions support batch execution", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "if(docid<10,ivalue(1)+docid,ivalue(2)*docid)").compile();
+    LazyValue seed = f1.program.get_seeds().resolve(0);
+    FeatureExecutor *executor = seed.get_executor();
+    ASSERT_TRUE(executor != nullptr);
+    ASSERT_TRUE(executor->supports_batch());
+    std::vector<uint32_t> docids = {1, 5, 9, 10, 20};
+    BatchInputs batch_inputs(*executor, 8);
+    EXPECT_EQUAL(8u, batch_inputs.column_stride());
+    for (size_t i = 0; i < docids.size(); ++i) {
+        batch_inputs.collect(docids[i], i);
+    }
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQUAL(double(docids[i]), batch_inputs.columns()[i]);
+    }
+    std::vector<double> scores(docids.size());
+    executor->execute_batch(batch_inputs.columns(), batch_inputs.column_stride(), scores.data(), docids.size());
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQUAL(f1.get(docids[i]), scores[i]);
+    }
+    EXPECT_EQUAL(std::vector<double>({2.0, 6.0, 10.0, 20.0, 40.0}), scores);
+}
+
+TEST_F("require that batch inputs fill in constant inputs up front", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid+value(3)").compile();
+    FeatureExecutor *executor = f1.program.get_seeds().resolve(0).get_executor();
+    ASSERT_TRUE(executor != nullptr);
+    ASSERT_EQUAL(2u, executor->inputs().size());
+    EXPECT_TRUE(executor->inputs().get_bound()[1].is_const());
+    BatchInputs batch_inputs(*executor, 4);
+    batch_inputs.collect(7, 0);
+    batch_inputs.collect(8, 1);
+    EXPECT_EQUAL(std::vector<double>({7.0, 8.0, 0.0, 0.0, 3.0, 3.0, 3.0, 3.0}),
+                 std::vector<double>(batch_inputs.columns(), batch_inputs.columns() + 8));
+    std::vector<double> scores(2);
+    executor->execute_batch(batch_inputs.columns(), batch_inputs.column_stride(), scores.data(), 2);
+    EXPECT_EQUAL(std::vector<double>({10.0, 11.0}), scores);
+}
+
+TEST_F("require that lazy compiled ranking expressions do not support batch execution", Fixture()) {
+    f1.lazy_expressions(true).add_expr("rank", "ivalue(1)+docid").compile();
+    LazyValue seed = f1.program.get_seeds().resolve(0);
+    ASSERT_TRUE(seed.get_executor() != nullptr);
+    EXPECT_FALSE(seed.get_executor()->supports_batch());
+}
+
 const vespalib::string tree_expr = "if(value(1)<2,1,2)+if(value(2)<1,10,20)";
 
 TEST_F("require that fast-forest gbdt evaluation can be enabled", Fixture()) {
@@ -3,6 +3,7 @@
 #include <vespa/document/repo/fixedtyperepo.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/index/field_length_calculator.h>
+#include <vespa/searchlib/index/phrase_bigram.h>
 #include <vespa/searchlib/memoryindex/field_index_remover.h>
 #include <vespa/searchlib/memoryindex/field_inverter.h>
 #include <vespa/searchlib/memoryindex/word_store.h>
@@ -142,17 +143,27 @@ struct FieldInverterTest : public ::testing::Test {
     std::vector<std::unique_ptr<IOrderedFieldIndexInserter>> _inserters;
     std::vector<std::unique_ptr<FieldInverter> > _inverters;
 
-    static Schema makeSchema() {
+    static Schema makeSchema(bool phrase_bigrams) {
+        std::vector<vespalib::string> common_words({"bar2", "baz", "foo", "y"});
         Schema schema;
-        schema.addIndexField(Schema::IndexField("f0", DataType::STRING));
-        schema.addIndexField(Schema::IndexField("f1", DataType::STRING));
-        schema.addIndexField(Schema::IndexField("f2", DataType::STRING, CollectionType::ARRAY));
-        schema.addIndexField(Schema::IndexField("f3", DataType::STRING, CollectionType::WEIGHTEDSET));
+        schema.addIndexField(Schema::IndexField("f0", DataType::STRING).set_phrase_bigrams(phrase_bigrams).
+                             set_phrase_bigram_words(common_words));
+        schema.addIndexField(Schema::IndexField("f1", DataType::STRING).set_phrase_bigrams(phrase_bigrams).
+                             set_phrase_bigram_words(common_words));
+        schema.addIndexField(Schema::IndexField("f2", DataType::STRING, CollectionType::ARRAY).set_phrase_bigrams(phrase_bigrams).
+                             set_phrase_bigram_words(common_words));
+        schema.addIndexField(Schema::IndexField("f3", DataType::STRING, CollectionType::WEIGHTEDSET).set_phrase_bigrams(phrase_bigrams).
+                             set_phrase_bigram_words(common_words));
         return schema;
     }
 
     FieldInverterTest()
-        : _schema(makeSchema()),
+        : FieldInverterTest(false)
+    {
+    }
+
+    explicit FieldInverterTest(bool phrase_bigrams)
+        : _schema(makeSchema(phrase_bigrams)),
           _b(_schema),
           _word_store(),
           _remover(_word_store),
@@ -203,6 +214,17 @@ struct FieldInverterTest : public ::testing::Test {
 
 };
 
+struct FieldInverterPhraseBigramsTest : public FieldInverterTest {
+    FieldInverterPhraseBigramsTest()
+        : FieldInverterTest(true)
+    {
+    }
+
+    static vespalib::string bigram(vespalib::stringref first, vespalib::stringref second) {
+        return PhraseBigram::make(first, second);
+    }
+};
+
 TEST_F(FieldInverterTest, require_that_fresh_insert_works)
 {
     invertDocument(10, *makeDoc10(_b));
@@ -412,6 +434,48 @@ TEST_F(FieldInverterTest, require_that_word_with_NUL_byte_is_dropped_when_trunca
               _inserter_backend.toStr());
 }
 
+TEST_F(FieldInverterPhraseBigramsTest, require_that_adjacent_words_with_common_word_in_same_element_are_indexed_as_bigrams)
+{
+    invertDocument(17, *makeDoc17(_b));
+    _inserter_backend.setVerbose();
+    pushDocuments();
+    EXPECT_EQ("f=1,"
+              "w=bar0,a=17(e=0,w=1,l=2[1]),"
+              "w=foo0,a=17(e=0,w=1,l=2[0]),"
+              "f=2,"
+              "w=" + bigram("foo", "bar") + ",a=17(e=0,w=1,l=2[0]),"
+              "w=bar,a=17(e=0,w=1,l=2[1],e=1,w=1,l=1[0]),"
+              "w=foo,a=17(e=0,w=1,l=2[0]),"
+              "f=3,"
+              "w=" + bigram("foo2", "bar2") + ",a=17(e=0,w=3,l=2[0]),"
+              "w=bar2,a=17(e=0,w=3,l=2[1],e=1,w=4,l=1[0]),"
+              "w=foo2,a=17(e=0,w=3,l=2[0])",
+              _inserter_backend.toStr());
+    assert_calculator(2, 3.0, 1);
+}
+
+TEST_F(FieldInverterPhraseBigramsTest, require_that_bigrams_are_made_for_all_words_with_common_word_at_adjacent_positions)
+{
+    invertDocument(16, *makeDoc16(_b));
+    _inserter_backend.setVerbose();
+    pushDocuments();
+    EXPECT_EQ("f=0,"
+              "w=" + bigram("altbaz", "y") + ",a=16(e=0,w=1,l=5[2]),"
+              "w=" + bigram("bar", "baz") + ",a=16(e=0,w=1,l=5[1]),"
+              "w=" + bigram("baz", "alty") + ",a=16(e=0,w=1,l=5[2]),"
+              "w=" + bigram("baz", "y") + ",a=16(e=0,w=1,l=5[2]),"
+              "w=" + bigram("foo", "bar") + ",a=16(e=0,w=1,l=5[0]),"
+              "w=" + bigram("y", "z") + ",a=16(e=0,w=1,l=5[3]),"
+              "w=altbaz,a=16(e=0,w=1,l=5[2]),"
+              "w=alty,a=16(e=0,w=1,l=5[3]),"
+              "w=bar,a=16(e=0,w=1,l=5[1]),"
+              "w=baz,a=16(e=0,w=1,l=5[2]),"
+              "w=foo,a=16(e=0,w=1,l=5[0]),"
+              "w=y,a=16(e=0,w=1,l=5[3]),"
+              "w=z,a=16(e=0,w=1,l=5[4])",
+              _inserter_backend.toStr());
+}
+
 }
 }
 
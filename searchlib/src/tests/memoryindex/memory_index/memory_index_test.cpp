@@ -48,6 +48,11 @@ struct MySetup : public IFieldLengthInspector {
         schema.addIndexField(Schema::IndexField(name, DataType::STRING));
         return *this;
     }
+    MySetup &phrase_bigrams_field(const std::string &name, std::vector<vespalib::string> common_words) {
+        schema.addIndexField(Schema::IndexField(name, DataType::STRING).set_phrase_bigrams(true).
+                             set_phrase_bigram_words(std::move(common_words)));
+        return *this;
+    }
     MySetup& field_length(const vespalib::string& field_name, const FieldLengthInfo& info) {
         field_lengths[field_name] = info;
         return *this;
@@ -225,6 +230,12 @@ Node::UP makePhrase(const std::string &term1, const std::string &term2) {
     phrase->append(Node::UP(new SimpleStringTerm(makeTerm(term2))));
     return node;
 }
+
+Node::UP makePhrase(const std::string &term1, const std::string &term2, const std::string &term3) {
+    Node::UP node = makePhrase(term1, term2);
+    static_cast<SimplePhrase &>(*node).append(Node::UP(new SimpleStringTerm(makeTerm(term3))));
+    return node;
+}
 }  // namespace
 
 // tests basic usage; index some documents in docid order and perform
@@ -279,6 +290,56 @@ TEST(MemoryIndexTest, test_index_and_search)
 
 }
 
+TEST(MemoryIndexTest, require_that_phrases_are_searched_using_phrase_bigrams)
+{
+    Index index(MySetup().phrase_bigrams_field(title, {foo, bar}));
+    index.doc(1)
+        .field(title).add(foo).add(bar).add(foo)
+        .commit();
+    index.doc(2)
+        .field(title).add(bar).add(foo)
+        .commit();
+
+    // single words are unaffected by the extra bigram words
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(0).pos(2)
+                            .doc(2).len(2).pos(1),
+                            index.index, title, makeTerm(foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(1)
+                            .doc(2).len(2).pos(0),
+                            index.index, title, *makePhrase(bar, foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(0),
+                            index.index, title, *makePhrase(foo, bar)));
+    // estimate is based on bigram posting lists
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(0),
+                            index.index, title, *makePhrase(foo, bar, foo)));
+    EXPECT_TRUE(verifyResult(FakeResult(),
+                            index.index, title, *makePhrase(bar, bar, foo)));
+}
+
+TEST(MemoryIndexTest, require_that_phrases_mix_words_and_phrase_bigrams_with_common_words)
+{
+    Index index(MySetup().phrase_bigrams_field(title, {foo}));
+    index.doc(1)
+        .field(title).add(bar).add(bar).add(foo).add(bar)
+        .commit();
+
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(4).pos(0),
+                            index.index, title, *makePhrase(bar, bar)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(4).pos(0),
+                            index.index, title, *makePhrase(bar, bar, foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(4).pos(1),
+                            index.index, title, *makePhrase(bar, foo, bar)));
+    EXPECT_TRUE(verifyResult(FakeResult(),
+                            index.index, title, *makePhrase(foo, bar, bar)));
+}
+
 // tests index update behavior; remove/update and unordered docid
 // indexing.
 TEST(MemoryIndexTest, require_that_documents_can_be_removed_and_updated)
@@ -5,12 +5,15 @@
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/queryeval/iblock_max_search.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <cinttypes>
+#include <limits>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
+using search::queryeval::IBlockMaxSearch;
 using search::queryeval::SearchIterator;
 
 using namespace search::index;
@@ -35,6 +38,53 @@ validate_posting_list_for_word(const FakePosting& posting, const FakeWord& word)
     }
 }
 
+std::unique_ptr<SearchIterator>
+make_iterator(const FakePosting& posting, TermFieldMatchData& md)
+{
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    md.setNeedNormalFeatures(posting.enable_unpack_normal_features());
+    md.setNeedInterleavedFeatures(posting.enable_unpack_interleaved_features());
+    return std::unique_ptr<SearchIterator>(posting.createIterator(tfmda));
+}
+
+void
+validate_block_max_for_word(const FakePosting& posting, const FakeWord& word)
+{
+    TermFieldMatchData md;
+    TermFieldMatchData block_md;
+    auto iterator = make_iterator(posting, md);
+    auto block_iterator = make_iterator(posting, block_md);
+    auto* block_max = dynamic_cast<IBlockMaxSearch*>(block_iterator.get());
+    if (block_max == nullptr || !block_max->has_interleaved_features()) {
+        return;
+    }
+    auto* features = dynamic_cast<IBlockMaxSearch*>(iterator.get());
+    iterator->initFullRange();
+    block_iterator->initFullRange();
+    uint32_t known_blocks = 0;
+    uint32_t prev_last_doc_id = 0;
+    for (const auto& posting_entry : word._postings) {
+        uint32_t doc_id = posting_entry._docId;
+        ASSERT_TRUE(iterator->seek(doc_id));
+        auto block = block_max->seek_block(doc_id);
+        EXPECT_LE(doc_id, block.last_doc_id);
+        EXPECT_LE(features->get_num_occs(), block.max_num_occs);
+        EXPECT_GE(features->get_field_length(), block.min_field_length);
+        if (block.last_doc_id != prev_last_doc_id && block.max_num_occs != std::numeric_limits<uint32_t>::max()) {
+            ++known_blocks;
+        }
+        prev_last_doc_id = block.last_doc_id;
+        // Shallow seek must not skip past the document
+        ASSERT_TRUE(block_iterator->seek(doc_id));
+    }
+    auto end_block = block_max->seek_block(word._postings.back()._docId + 1);
+    EXPECT_EQ(0u, end_block.max_num_occs);
+    if (posting.l1SkipBitSize() != 0 && posting.getName().find(".bm") != std::string::npos) {
+        EXPECT_LT(0u, known_blocks);
+    }
+}
+
 void
 test_fake(const std::string& posting_type,
           const Schema& schema,
@@ -55,6 +105,7 @@ test_fake(const std::string& posting_type,
            static_cast<int>(posting->l4SkipBitSize()));
 
     validate_posting_list_for_word(*posting, word);
+    validate_block_max_for_word(*posting, word);
 }
 
 struct PostingListTest : public ::testing::Test {
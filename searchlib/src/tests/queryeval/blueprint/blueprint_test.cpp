@@ -672,6 +672,8 @@ getExpectedBlueprint()
            "    estimate: HitEstimate {\n"
            "        empty: false\n"
            "        estHits: 9\n"
+           "        cost: 1\n"
+           "        strict_cost: 1\n"
            "        cost_tier: 1\n"
            "        tree_size: 2\n"
            "        allow_termwise_eval: 0\n"
@@ -691,6 +693,8 @@ getExpectedBlueprint()
            "            estimate: HitEstimate {\n"
            "                empty: false\n"
            "                estHits: 9\n"
+           "                cost: 1\n"
+           "                strict_cost: 1\n"
            "                cost_tier: 1\n"
            "                tree_size: 1\n"
            "                allow_termwise_eval: 1\n"
@@ -720,6 +724,8 @@ getExpectedSlimeBlueprint() {
            "        '[type]': 'HitEstimate',"
            "        empty: false,"
            "        estHits: 9,"
+           "        cost: 1.0,"
+           "        strict_cost: 1.0,"
            "        cost_tier: 1,"
            "        tree_size: 2,"
            "        allow_termwise_eval: 0"
@@ -744,6 +750,8 @@ getExpectedSlimeBlueprint() {
            "                '[type]': 'HitEstimate',"
            "                empty: false,"
            "                estHits: 9,"
+           "                cost: 1.0,"
+           "                strict_cost: 1.0,"
            "                cost_tier: 1,"
            "                tree_size: 1,"
            "                allow_termwise_eval: 1"
@@ -1462,6 +1462,70 @@ TEST("require that intermediate cost tier is minimum cost tier of children") {
     EXPECT_EQUAL(bp2->getState().cost_tier(), 2u);
 }
 
+TEST("require that AND and OR calculate expected cost") {
+    Blueprint::UP my_and(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(100).create())).
+               addChild(ap(MyLeafSpec(200).create()))));
+    Blueprint::UP my_or(
+            ap((new OrBlueprint())->
+               addChild(ap(MyLeafSpec(200).create())).
+               addChild(ap(MyLeafSpec(100).create()))));
+    my_and->setDocIdLimit(1000);
+    my_or->setDocIdLimit(1000);
+    EXPECT_APPROX(1.1, my_and->cost(), 1e-6);
+    EXPECT_APPROX(0.2, my_and->strict_cost(), 1e-6);
+    EXPECT_APPROX(1.8, my_or->cost(), 1e-6);
+    EXPECT_APPROX(0.3, my_or->strict_cost(), 1e-6);
+}
+
+TEST("require that leaf without posting list has scan cost when strict") {
+    Blueprint::UP leaf(ap(MyLeafSpec(10).scan_cost(0.6).create()));
+    leaf->setDocIdLimit(1000);
+    EXPECT_APPROX(0.6, leaf->cost(), 1e-6);
+    EXPECT_APPROX(0.6, leaf->strict_cost(), 1e-6);
+}
+
+TEST("require that strict AND child is selected by expected cost") {
+    //-------------------------------------------------------------------------
+    Blueprint::UP top_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(10).scan_cost(0.6).create())).
+               addChild(ap(MyLeafSpec(100).create()))));
+    top_up->setDocIdLimit(1000);
+    //-------------------------------------------------------------------------
+    Blueprint::UP expect_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(100).create())).
+               addChild(ap(MyLeafSpec(10).scan_cost(0.6).create()))));
+    expect_up->setDocIdLimit(1000);
+    //-------------------------------------------------------------------------
+    top_up = Blueprint::optimize(std::move(top_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+}
+
+TEST("require that non-strict AND children are ordered by expected cost") {
+    //-------------------------------------------------------------------------
+    Blueprint::UP top_up(
+            ap((new AndNotBlueprint())->
+               addChild(ap(MyLeafSpec(5).create())).
+               addChild(ap((new AndBlueprint())->
+                           addChild(ap(MyLeafSpec(100).create())).
+                           addChild(ap(MyLeafSpec(10).scan_cost(0.6).create()))))));
+    top_up->setDocIdLimit(1000);
+    //-------------------------------------------------------------------------
+    Blueprint::UP expect_up(
+            ap((new AndNotBlueprint())->
+               addChild(ap(MyLeafSpec(5).create())).
+               addChild(ap((new AndBlueprint())->
+                           addChild(ap(MyLeafSpec(10).scan_cost(0.6).create())).
+                           addChild(ap(MyLeafSpec(100).create()))))));
+    expect_up->setDocIdLimit(1000);
+    //-------------------------------------------------------------------------
+    top_up = Blueprint::optimize(std::move(top_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+}
+
 void verify_or_est(const std::vector<Blueprint::HitEstimate> &child_estimates, Blueprint::HitEstimate expect) {
     OrBlueprint my_or;
     my_or.setDocIdLimit(32);
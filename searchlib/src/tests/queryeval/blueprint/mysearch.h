@@ -126,6 +126,10 @@ public:
         set_cost_tier(value);
         return *this;
     }
+    MyLeaf &scan_cost(double value) {
+        set_scan_cost(value);
+        return *this;
+    }
     void set_global_filter(const GlobalFilter &, double) override {
         _got_global_filter = true;
     }
@@ -142,11 +146,12 @@ private:
     FieldSpecBaseList      _fields;
     Blueprint::HitEstimate _estimate;
     uint32_t               _cost_tier;
+    double                 _scan_cost;
     bool                   _want_global_filter;
 
 public:
     explicit MyLeafSpec(uint32_t estHits, bool empty = false)
-        : _fields(), _estimate(estHits, empty), _cost_tier(0), _want_global_filter(false) {}
+        : _fields(), _estimate(estHits, empty), _cost_tier(0), _scan_cost(0.0), _want_global_filter(false) {}
 
     MyLeafSpec &addField(uint32_t fieldId, uint32_t handle) {
         _fields.add(FieldSpecBase(fieldId, handle));
@@ -157,6 +162,10 @@ public:
         _cost_tier = value;
         return *this;
     }
+    MyLeafSpec &scan_cost(double value) {
+        _scan_cost = value;
+        return *this;
+    }
     MyLeafSpec &want_global_filter() {
         _want_global_filter = true;
         return *this;
@@ -171,6 +180,9 @@ public:
         if (_cost_tier > 0) {
             leaf->cost_tier(_cost_tier);
         }
+        if (_scan_cost > 0.0) {
+            leaf->scan_cost(_scan_cost);
+        }
         leaf->set_want_global_filter(_want_global_filter);
         return leaf;
     }
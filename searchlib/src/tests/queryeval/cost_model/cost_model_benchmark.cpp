@@ -0,0 +1,203 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/singlenumericattribute.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/cost_model.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/test/fakedata/fakeposting.h>
+#include <vespa/searchlib/test/fakedata/fakeword.h>
+#include <vespa/searchlib/test/fakedata/fakewordset.h>
+#include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <functional>
+
+using namespace search::attribute;
+using namespace search::fakedata;
+using namespace search::queryeval;
+using search::AttributeFactory;
+using search::BitVector;
+using search::BitVectorIterator;
+using search::IntegerAttribute;
+using search::IntegerAttributeTemplate;
+using search::QueryTermSimple;
+using search::SingleValueNumericAttribute;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using vespalib::BenchmarkTimer;
+
+/**
+ * Measures the relative costs used by CostModel. Run it after
+ * changing the underlying iterators and update cost_model.h with the
+ * reported numbers.
+ **/
+
+namespace {
+
+constexpr uint32_t num_docs = 1000000;
+constexpr uint32_t candidate_stride = 7;
+constexpr double budget = 1.0;
+const std::vector<double> hit_ratios = {0.001, 0.01, 0.1, 0.5};
+
+std::vector<uint32_t> make_docids(double hit_ratio, vespalib::Rand48 &rnd) {
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if (rnd.lrand48() % 1000000 < uint32_t(hit_ratio * 1000000)) {
+            docids.push_back(docid);
+        }
+    }
+    return docids;
+}
+
+// cost per candidate when evaluated non-strict
+double measure_seek(const std::function<std::unique_ptr<SearchIterator>(bool)> &factory) {
+    auto iterator = factory(false);
+    uint32_t candidates = 0;
+    double seconds = BenchmarkTimer::benchmark([&]() {
+            iterator->initRange(1, num_docs);
+            candidates = 0;
+            for (uint32_t docid = 1; docid < num_docs; docid += candidate_stride) {
+                if (iterator->seek(docid)) {
+                    iterator->unpack(docid);
+                }
+                ++candidates;
+            }
+        }, budget);
+    return seconds / candidates;
+}
+
+// cost per hit when evaluated strict
+double measure_next(const std::function<std::unique_ptr<SearchIterator>(bool)> &factory) {
+    auto iterator = factory(true);
+    uint32_t hits = 0;
+    double seconds = BenchmarkTimer::benchmark([&]() {
+            iterator->initRange(1, num_docs);
+            hits = 0;
+            for (uint32_t docid = iterator->seekFirst(1); !iterator->isAtEnd(docid); docid = iterator->seekNext(docid + 1)) {
+                iterator->unpack(docid);
+                ++hits;
+            }
+        }, budget);
+    return seconds / std::max(hits, 1u);
+}
+
+struct Costs {
+    double posting_seek = 0.0;
+    double posting_next = 0.0;
+    double bitvector_seek = 0.0;
+    double bitvector_next = 0.0;
+    double attribute_seek = 0.0;
+    double attribute_posting_seek = 0.0;
+    double attribute_posting_next = 0.0;
+};
+
+Costs measure(double hit_ratio) {
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    auto docids = make_docids(hit_ratio, rnd);
+    Costs costs;
+
+    FakeWordSet word_set;
+    word_set.setupParams(false, false);
+    FakeWord word(num_docs, docids, "word", word_set.getFieldsParams(), word_set.getPackedIndex());
+    std::unique_ptr<FPFactory> factory(getFPFactory("Zc4SkipPosOccBE.cf.nnu", word_set.getSchema()));
+    factory->setup(std::vector<const FakeWord *>({&word}));
+    auto posting = factory->make(word);
+    TermFieldMatchData posting_md;
+    posting_md.setNeedNormalFeatures(posting->enable_unpack_normal_features());
+    posting_md.setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+    auto posting_factory = [&](bool) {
+        TermFieldMatchDataArray tfmda;
+        tfmda.add(&posting_md);
+        return std::unique_ptr<SearchIterator>(posting->createIterator(tfmda));
+    };
+    costs.posting_seek = measure_seek(posting_factory);
+    costs.posting_next = measure_next(posting_factory);
+
+    auto bv = BitVector::create(num_docs);
+    for (uint32_t docid : docids) {
+        bv->setBit(docid);
+    }
+    bv->invalidateCachedCount();
+    TermFieldMatchData bv_md;
+    auto bv_factory = [&](bool strict) {
+        return BitVectorIterator::create(bv.get(), num_docs, bv_md, strict);
+    };
+    costs.bitvector_seek = measure_seek(bv_factory);
+    costs.bitvector_next = measure_next(bv_factory);
+
+    // attribute without posting lists (no fast-search)
+    SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t>> attr("a", Config(BasicType::INT32, CollectionType::SINGLE));
+    attr.addReservedDoc();
+    attr.addDocs(num_docs - 1);
+    for (uint32_t docid : docids) {
+        attr.update(docid, 1);
+    }
+    attr.commit();
+    auto search_context = attr.createSearchContext(std::make_unique<QueryTermSimple>("1", QueryTermSimple::Type::WORD), SearchContextParams());
+    TermFieldMatchData attr_md;
+    costs.attribute_seek = measure_seek([&](bool strict) {
+            return search_context->createIterator(&attr_md, strict);
+        });
+
+    // attribute with posting lists (fast-search)
+    Config fast_search_cfg(BasicType::INT32, CollectionType::SINGLE);
+    fast_search_cfg.setFastSearch(true);
+    auto posting_attr = AttributeFactory::createAttribute("b", fast_search_cfg);
+    posting_attr->addReservedDoc();
+    posting_attr->addDocs(num_docs - 1);
+    auto &posting_int_attr = dynamic_cast<IntegerAttribute &>(*posting_attr);
+    for (uint32_t docid : docids) {
+        posting_int_attr.update(docid, 1);
+    }
+    posting_attr->commit();
+    auto posting_search_context = posting_attr->createSearchContext(std::make_unique<QueryTermSimple>("1", QueryTermSimple::Type::WORD), SearchContextParams());
+    posting_search_context->fetchPostings(ExecuteInfo::TRUE);
+    auto attr_posting_factory = [&](bool strict) {
+        return posting_search_context->createIterator(&attr_md, strict);
+    };
+    costs.attribute_posting_seek = measure_seek(attr_posting_factory);
+    costs.attribute_posting_next = measure_next(attr_posting_factory);
+    return costs;
+}
+
+}
+
+TEST(CostModelBenchmark, measure_relative_costs)
+{
+    Costs sum;
+    for (double hit_ratio: hit_ratios) {
+        Costs costs = measure(hit_ratio);
+        fprintf(stderr, "hit_ratio %g: posting seek %.2f ns, posting next %.2f ns, bitvector seek %.2f ns, bitvector next %.2f ns, "
+                "attribute seek %.2f ns, attribute posting seek %.2f ns, attribute posting next %.2f ns\n",
+                hit_ratio, costs.posting_seek * 1e9, costs.posting_next * 1e9,
+                costs.bitvector_seek * 1e9, costs.bitvector_next * 1e9, costs.attribute_seek * 1e9,
+                costs.attribute_posting_seek * 1e9, costs.attribute_posting_next * 1e9);
+        sum.posting_seek += costs.posting_seek;
+        sum.posting_next += costs.posting_next;
+        sum.bitvector_seek += costs.bitvector_seek;
+        sum.bitvector_next += costs.bitvector_next;
+        sum.attribute_seek += costs.attribute_seek;
+        sum.attribute_posting_seek += costs.attribute_posting_seek;
+        sum.attribute_posting_next += costs.attribute_posting_next;
+    }
+    EXPECT_GT(sum.posting_seek, 0.0);
+    fprintf(stderr, "relative costs (current CostModel in parentheses):\n");
+    fprintf(stderr, "  posting_next_cost:           %.2f (%.2f)\n", sum.posting_next / sum.posting_seek, CostModel::posting_next_cost);
+    fprintf(stderr, "  bitvector_seek_cost:         %.2f (%.2f)\n", sum.bitvector_seek / sum.posting_seek, CostModel::bitvector_seek_cost);
+    fprintf(stderr, "  bitvector_next_cost:         %.2f (%.2f)\n", sum.bitvector_next / sum.posting_seek, CostModel::bitvector_next_cost);
+    fprintf(stderr, "  attribute_seek_cost:         %.2f (%.2f)\n", sum.attribute_seek / sum.posting_seek, CostModel::attribute_seek_cost);
+    fprintf(stderr, "  attribute_posting_seek_cost: %.2f (%.2f)\n", sum.attribute_posting_seek / sum.posting_seek, CostModel::attribute_posting_seek_cost);
+    fprintf(stderr, "  attribute_posting_next_cost: %.2f (%.2f)\n", sum.attribute_posting_next / sum.posting_seek, CostModel::attribute_posting_next_cost);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,124 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/docid_intersection_search.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/rand48.h>
+
+using namespace search::attribute;
+using namespace search::queryeval;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+using vespalib::BenchmarkTimer;
+
+/**
+ * Compares strict AND over attribute posting lists evaluated with
+ * AndSearchStrict (leapfrogging with seek) and with
+ * DocidIntersectionSearch (block decoding and array intersection).
+ **/
+
+namespace {
+
+constexpr uint32_t num_docs = 1000000;
+constexpr double budget = 1.0;
+const std::vector<double> hit_ratios = {0.001, 0.01, 0.1, 0.5};
+
+// one fast-search attribute per term, where each term matches a
+// random subset of the documents
+struct Term {
+    AttributeVector::SP attr;
+    std::unique_ptr<ISearchContext> context;
+    TermFieldMatchData md;
+
+    Term(const vespalib::string &name, double hit_ratio, vespalib::Rand48 &rnd)
+        : attr(), context(), md()
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setFastSearch(true);
+        attr = AttributeFactory::createAttribute(name, cfg);
+        attr->addReservedDoc();
+        attr->addDocs(num_docs - 1);
+        auto &int_attr = static_cast<IntegerAttribute &>(*attr);
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (rnd.lrand48() % 1000000 < uint32_t(hit_ratio * 1000000)) {
+                int_attr.update(docid, 1);
+            }
+        }
+        attr->commit();
+        context = attr->createSearchContext(std::make_unique<QueryTermSimple>("1", QueryTermSimple::Type::WORD), SearchContextParams());
+        context->fetchPostings(ExecuteInfo::TRUE);
+    }
+};
+
+MultiSearch::Children make_children(std::vector<std::unique_ptr<Term>> &terms) {
+    MultiSearch::Children children;
+    for (auto &term : terms) {
+        children.push_back(term->context->createIterator(&term->md, true));
+    }
+    return children;
+}
+
+std::pair<double, uint32_t> measure(SearchIterator &search) {
+    uint32_t hits = 0;
+    double seconds = BenchmarkTimer::benchmark([&]() {
+            search.initRange(1, num_docs);
+            hits = 0;
+            for (uint32_t docid = search.seekFirst(1); !search.isAtEnd(docid); docid = search.seekNext(docid + 1)) {
+                ++hits;
+            }
+        }, budget);
+    return {seconds, hits};
+}
+
+void benchmark(const std::vector<double> &term_hit_ratios) {
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    std::vector<std::unique_ptr<Term>> terms;
+    vespalib::string desc;
+    for (double hit_ratio : term_hit_ratios) {
+        terms.push_back(std::make_unique<Term>("t" + std::to_string(terms.size()), hit_ratio, rnd));
+        desc += (desc.empty() ? "" : " AND ") + std::to_string(hit_ratio);
+    }
+    auto leapfrog = AndSearch::create(make_children(terms), true);
+    auto children = make_children(terms);
+    ASSERT_TRUE(DocidIntersectionSearch::can_intersect(children));
+    DocidIntersectionSearch intersection(std::move(children));
+    auto leapfrog_result = measure(*leapfrog);
+    auto intersection_result = measure(intersection);
+    EXPECT_EQ(leapfrog_result.second, intersection_result.second);
+    fprintf(stderr, "%s: hits %u, AndSearchStrict %.3f ms, DocidIntersectionSearch %.3f ms (speedup %.2f)\n",
+            desc.c_str(), leapfrog_result.second, leapfrog_result.first * 1000.0,
+            intersection_result.first * 1000.0, leapfrog_result.first / intersection_result.first);
+}
+
+}
+
+TEST(DocidIntersectionBenchmark, two_terms)
+{
+    for (double first : hit_ratios) {
+        for (double second : hit_ratios) {
+            if (second >= first) {
+                benchmark({first, second});
+            }
+        }
+    }
+}
+
+TEST(DocidIntersectionBenchmark, three_terms)
+{
+    for (double first : hit_ratios) {
+        benchmark({first, 0.1, 0.5});
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,264 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/docid_intersection_search.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/idocid_block_search.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <algorithm>
+
+using namespace search::attribute;
+using namespace search::queryeval;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+
+namespace {
+
+constexpr uint32_t num_docs = 20000;
+
+std::vector<uint32_t> make_docids(uint32_t limit, double hit_ratio, vespalib::Rand48 &rnd) {
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid < limit; ++docid) {
+        if (rnd.lrand48() % 10000 < uint32_t(hit_ratio * 10000)) {
+            docids.push_back(docid);
+        }
+    }
+    return docids;
+}
+
+std::vector<uint32_t> expected_intersection(const std::vector<std::vector<uint32_t>> &lists) {
+    std::vector<uint32_t> result = lists[0];
+    for (size_t i = 1; i < lists.size(); ++i) {
+        std::vector<uint32_t> tmp;
+        std::set_intersection(result.begin(), result.end(), lists[i].begin(), lists[i].end(), std::back_inserter(tmp));
+        result = std::move(tmp);
+    }
+    return result;
+}
+
+// posting list backed by a docid array
+class ArrayIterator : public SearchIterator, public IDocidBlockSearch {
+private:
+    const std::vector<uint32_t> &_docids;
+    size_t _pos;
+    std::vector<uint32_t> _fetch_starts;
+    void update() {
+        if (_pos < _docids.size() && !isAtEnd(_docids[_pos])) {
+            setDocId(_docids[_pos]);
+        } else {
+            setAtEnd();
+        }
+    }
+public:
+    ArrayIterator(const std::vector<uint32_t> &docids) : _docids(docids), _pos(0), _fetch_starts() {}
+    // docid the iterator was positioned at for each call to fetch_docids
+    const std::vector<uint32_t> &fetch_starts() const { return _fetch_starts; }
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = std::lower_bound(_docids.begin(), _docids.end(), begin) - _docids.begin();
+        update();
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _docids.size() && _docids[_pos] < docid) {
+            ++_pos;
+        }
+        update();
+    }
+    void doUnpack(uint32_t) override {}
+    Trinary is_strict() const override { return Trinary::True; }
+    uint32_t fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids) override {
+        if (isAtEnd()) {
+            return 0;
+        }
+        _fetch_starts.push_back(getDocId());
+        end_id = std::min(end_id, getEndId());
+        uint32_t num = 0;
+        while (num < max_docids && _pos < _docids.size() && _docids[_pos] < end_id) {
+            dst[num++] = _docids[_pos++];
+        }
+        update();
+        return num;
+    }
+};
+
+MultiSearch::Children make_children(const std::vector<std::vector<uint32_t>> &lists) {
+    MultiSearch::Children children;
+    for (const auto &list : lists) {
+        children.push_back(std::make_unique<ArrayIterator>(list));
+    }
+    return children;
+}
+
+std::vector<uint32_t> search_strict(SearchIterator &search, uint32_t limit) {
+    search::queryeval::SimpleResult result;
+    result.searchStrict(search, limit);
+    std::vector<uint32_t> hits;
+    for (uint32_t i = 0; i < result.getHitCount(); ++i) {
+        hits.push_back(result.getHit(i));
+    }
+    return hits;
+}
+
+}
+
+TEST(DocidIntersectionTest, intersect_docids_matches_set_intersection)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    // covers both block merge and galloping
+    std::vector<std::pair<double, double>> ratios = {{0.5, 0.5}, {0.1, 0.9}, {0.01, 0.5}, {0.001, 0.9}, {0.5, 0.01}};
+    for (const auto &ratio : ratios) {
+        auto a = make_docids(num_docs, ratio.first, rnd);
+        auto b = make_docids(num_docs, ratio.second, rnd);
+        auto expect = expected_intersection({a, b});
+        std::vector<uint32_t> dst(a.size());
+        uint32_t num = intersect_docids(a.data(), a.size(), b.data(), b.size(), dst.data());
+        EXPECT_EQ(expect, std::vector<uint32_t>(dst.begin(), dst.begin() + num));
+        // in place
+        num = intersect_docids(a.data(), a.size(), b.data(), b.size(), a.data());
+        EXPECT_EQ(expect, std::vector<uint32_t>(a.begin(), a.begin() + num));
+    }
+}
+
+TEST(DocidIntersectionTest, intersect_docids_handles_empty_arrays)
+{
+    std::vector<uint32_t> a = {1, 2, 3};
+    std::vector<uint32_t> dst(3);
+    EXPECT_EQ(0u, intersect_docids(a.data(), a.size(), nullptr, 0, dst.data()));
+    EXPECT_EQ(0u, intersect_docids(nullptr, 0, a.data(), a.size(), dst.data()));
+}
+
+TEST(DocidIntersectionTest, search_gives_same_hits_as_strict_and)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(7);
+    std::vector<std::vector<double>> setups = {{0.001, 0.5}, {0.01, 0.1}, {0.1, 0.5, 0.9}, {0.5, 0.5}, {0.9, 0.95, 0.99}, {0.3, 0.0}};
+    for (const auto &setup : setups) {
+        std::vector<std::vector<uint32_t>> lists;
+        for (double hit_ratio : setup) {
+            lists.push_back(make_docids(num_docs, hit_ratio, rnd));
+        }
+        auto children = make_children(lists);
+        ASSERT_TRUE(DocidIntersectionSearch::can_intersect(children));
+        DocidIntersectionSearch search(std::move(children));
+        auto reference = AndSearch::create(make_children(lists), true);
+        auto expect = expected_intersection(lists);
+        EXPECT_EQ(expect, search_strict(*reference, num_docs));
+        EXPECT_EQ(expect, search_strict(search, num_docs));
+        // sub-range
+        std::vector<uint32_t> expect_range;
+        std::copy_if(expect.begin(), expect.end(), std::back_inserter(expect_range),
+                     [](uint32_t docid) { return docid >= 5000 && docid < 15000; });
+        search.initRange(5000, 15000);
+        std::vector<uint32_t> hits;
+        for (uint32_t docid = search.seekFirst(5000); !search.isAtEnd(docid); docid = search.seekNext(docid + 1)) {
+            hits.push_back(docid);
+        }
+        EXPECT_EQ(expect_range, hits);
+    }
+}
+
+TEST(DocidIntersectionTest, search_handles_skipping_seeks)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(11);
+    std::vector<std::vector<uint32_t>> lists = {make_docids(num_docs, 0.5, rnd), make_docids(num_docs, 0.7, rnd)};
+    auto expect = expected_intersection(lists);
+    DocidIntersectionSearch search(make_children(lists));
+    search.initRange(1, num_docs);
+    for (uint32_t docid = 1; docid < num_docs; docid += 97) {
+        auto pos = std::lower_bound(expect.begin(), expect.end(), docid);
+        EXPECT_EQ(pos != expect.end() && *pos == docid, search.seek(docid));
+        if (pos == expect.end()) {
+            EXPECT_TRUE(search.isAtEnd());
+        } else {
+            EXPECT_EQ(*pos, search.getDocId());
+        }
+    }
+}
+
+TEST(DocidIntersectionTest, density_of_child_is_refreshed_while_seeking)
+{
+    // second child is dense in the first part of the docid space, and sparse in the rest
+    constexpr uint32_t limit = 200000;
+    constexpr uint32_t sparse_begin = 50000;
+    std::vector<std::vector<uint32_t>> lists(2);
+    for (uint32_t docid = 1; docid < limit; ++docid) {
+        if ((docid % 10) == 0) {
+            lists[0].push_back(docid);
+        }
+        if ((docid < sparse_begin) || ((docid % 100) == 0)) {
+            lists[1].push_back(docid);
+        }
+    }
+    auto children = make_children(lists);
+    const auto &second = dynamic_cast<const ArrayIterator &>(*children[1]);
+    DocidIntersectionSearch search(std::move(children));
+    EXPECT_EQ(expected_intersection(lists), search_strict(search, limit));
+    // the dense part makes the second child be seeked, but its docids are decoded
+    // again after a bounded number of blocks, and then for each block in the sparse part
+    uint32_t sparse_blocks = (limit - sparse_begin) / 10 / DocidIntersectionSearch::block_size;
+    auto sparse_fetches = std::count_if(second.fetch_starts().begin(), second.fetch_starts().end(),
+                                        [](uint32_t docid) { return docid >= sparse_begin; });
+    EXPECT_GE(uint32_t(sparse_fetches), sparse_blocks - 16);
+}
+
+TEST(DocidIntersectionTest, search_gives_same_hits_as_strict_and_for_bitvector_apis)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(3);
+    std::vector<std::vector<uint32_t>> lists = {make_docids(num_docs, 0.2, rnd), make_docids(num_docs, 0.6, rnd)};
+    DocidIntersectionSearch search(make_children(lists));
+    auto reference = AndSearch::create(make_children(lists), true);
+    search.initRange(1, num_docs);
+    reference->initRange(1, num_docs);
+    auto hits = search.get_hits(1);
+    auto expect = reference->get_hits(1);
+    EXPECT_TRUE(*expect == *hits);
+}
+
+TEST(DocidIntersectionTest, attribute_posting_lists_can_be_intersected)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(5);
+    std::vector<AttributeVector::SP> attrs;
+    std::vector<std::vector<uint32_t>> lists;
+    for (double hit_ratio : {0.05, 0.5}) {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setFastSearch(true);
+        auto attr = AttributeFactory::createAttribute("a" + std::to_string(attrs.size()), cfg);
+        attr->addReservedDoc();
+        attr->addDocs(num_docs - 1);
+        auto docids = make_docids(num_docs, hit_ratio, rnd);
+        for (uint32_t docid : docids) {
+            static_cast<IntegerAttribute &>(*attr).update(docid, 1);
+        }
+        attr->commit();
+        attrs.push_back(attr);
+        lists.push_back(std::move(docids));
+    }
+    std::vector<std::unique_ptr<search::attribute::ISearchContext>> contexts;
+    TermFieldMatchData md;
+    MultiSearch::Children children;
+    for (const auto &attr : attrs) {
+        contexts.push_back(attr->createSearchContext(std::make_unique<QueryTermSimple>("1", QueryTermSimple::Type::WORD), SearchContextParams()));
+        contexts.back()->fetchPostings(ExecuteInfo::TRUE);
+        children.push_back(contexts.back()->createIterator(&md, true));
+    }
+    ASSERT_TRUE(DocidIntersectionSearch::can_intersect(children));
+    DocidIntersectionSearch search(std::move(children));
+    EXPECT_EQ(expected_intersection(lists), search_strict(search, num_docs));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
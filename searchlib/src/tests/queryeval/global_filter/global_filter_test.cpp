@@ -0,0 +1,66 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace search::queryeval;
+using vespalib::SimpleThreadBundle;
+using vespalib::ThreadBundle;
+
+SimpleResult
+make_result(uint32_t docid_limit, uint32_t step)
+{
+    SimpleResult result;
+    for (uint32_t docid = 1; docid < docid_limit; docid += step) {
+        result.addHit(docid);
+    }
+    return result;
+}
+
+void
+expect_same_filter(const GlobalFilter &expect, const GlobalFilter &actual, uint32_t docid_limit)
+{
+    ASSERT_TRUE(expect.has_filter());
+    ASSERT_TRUE(actual.has_filter());
+    EXPECT_EQ(expect.filter()->countTrueBits(), actual.filter()->countTrueBits());
+    uint32_t mismatches = 0;
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (expect.filter()->testBit(docid) != actual.filter()->testBit(docid)) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(0u, mismatches);
+}
+
+TEST(GlobalFilterTest, small_docid_space_is_calculated_by_a_single_thread)
+{
+    SimpleBlueprint blueprint(SimpleResult().addHit(3).addHit(5).addHit(7));
+    SimpleThreadBundle thread_bundle(4);
+    auto filter = GlobalFilter::calculate(blueprint, 10, thread_bundle);
+    ASSERT_TRUE(filter->has_filter());
+    EXPECT_EQ(3u, filter->filter()->countTrueBits());
+    EXPECT_TRUE(filter->filter()->testBit(3));
+    EXPECT_TRUE(filter->filter()->testBit(5));
+    EXPECT_TRUE(filter->filter()->testBit(7));
+}
+
+TEST(GlobalFilterTest, parallel_calculation_gives_same_filter_as_single_threaded)
+{
+    for (uint32_t docid_limit: {300001u, 262144u, 262145u, 1000000u}) {
+        for (uint32_t step: {1u, 3u, 63u, 64u, 65u, 1000u}) {
+            SCOPED_TRACE(testing::Message() << "docid_limit=" << docid_limit << ", step=" << step);
+            SimpleBlueprint blueprint(make_result(docid_limit, step));
+            auto expect = GlobalFilter::calculate(blueprint, docid_limit, ThreadBundle::trivial());
+            for (size_t threads: {2, 3, 7}) {
+                SimpleThreadBundle thread_bundle(threads);
+                auto actual = GlobalFilter::calculate(blueprint, docid_limit, thread_bundle);
+                expect_same_filter(*expect, *actual, docid_limit);
+            }
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
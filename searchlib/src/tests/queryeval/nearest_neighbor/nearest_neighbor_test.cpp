@@ -12,6 +12,7 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_calculator.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -268,6 +269,124 @@ TEST(NnsIndexIteratorTest, require_that_iterator_sets_expected_rawscore) {
     verify_iterator_sets_expected_rawscore(denseSpecFloat, denseSpecFloat);
 }
 
+std::vector<uint32_t>
+collect_hits(SearchIterator &search, uint32_t begin_id, uint32_t end_id)
+{
+    std::vector<uint32_t> hits;
+    search.initRange(begin_id, end_id);
+    uint32_t docid = begin_id;
+    while (docid < end_id) {
+        if (search.seek(docid)) {
+            search.unpack(docid);
+            hits.push_back(docid);
+        }
+        docid = std::max(search.getDocId(), docid + 1);
+    }
+    return hits;
+}
+
+TEST(NnsIndexIteratorTest, require_that_exact_search_shares_distance_threshold_across_docid_ranges) {
+    Fixture fixture(denseSpecFloat);
+    fixture.ensureSpace(100);
+    for (uint32_t docid = 1; docid <= 100; ++docid) {
+        fixture.setTensor(docid, docid, 0.0);
+    }
+    auto nullTensor = createTensor(denseSpecFloat, 0.0, 0.0);
+    auto md = MatchData::makeTestInstance(2, 2);
+    auto &tfmd = *(md->resolveTermField(0));
+    DistanceCalculator dist_calc(*fixture._tensorAttr, *nullTensor, fixture.dist_fun());
+    NearestNeighborDistanceHeap dh(2);
+    // Each iterator handles a docid range, as done by separate match threads
+    auto first = NearestNeighborIterator::create(true, tfmd, dist_calc, dh, nullptr);
+    auto second = NearestNeighborIterator::create(true, tfmd, dist_calc, dh, nullptr);
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), collect_hits(*first, 1, 51));
+    EXPECT_EQ(std::vector<uint32_t>(), collect_hits(*second, 51, 101));
+    EXPECT_EQ(4.0, dh.distanceLimit());
+}
+
+TEST(NnsIndexIteratorTest, require_that_exact_search_reports_distances_calculated_and_pruned) {
+    Fixture fixture(denseSpecFloat);
+    fixture.ensureSpace(100);
+    for (uint32_t docid = 1; docid <= 100; ++docid) {
+        fixture.setTensor(docid, docid, 0.0);
+    }
+    auto nullTensor = createTensor(denseSpecFloat, 0.0, 0.0);
+    auto md = MatchData::makeTestInstance(2, 2);
+    auto &tfmd = *(md->resolveTermField(0));
+    DistanceCalculator dist_calc(*fixture._tensorAttr, *nullTensor, fixture.dist_fun());
+    NearestNeighborDistanceHeap dh(2);
+    auto search = NearestNeighborIterator::create(true, tfmd, dist_calc, dh, nullptr);
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), collect_hits(*search, 1, 101));
+    // This is what the match thread adds to the trace after matching
+    vespalib::Slime slime;
+    vespalib::slime::SlimeInserter inserter(slime);
+    search->asSlime(inserter);
+    EXPECT_EQ(100, slime.get()["distances_calculated"].asLong());
+    EXPECT_EQ(98, slime.get()["distances_pruned"].asLong());
+}
+
+TEST(NnsIndexIteratorTest, require_that_strict_exact_search_only_calculates_seek_targets_when_driven_by_other_iterator) {
+    Fixture fixture(denseSpecFloat);
+    fixture.ensureSpace(100);
+    for (uint32_t docid = 1; docid <= 100; ++docid) {
+        fixture.setTensor(docid, docid, 0.0);
+    }
+    auto nullTensor = createTensor(denseSpecFloat, 0.0, 0.0);
+    auto md = MatchData::makeTestInstance(2, 2);
+    auto &tfmd = *(md->resolveTermField(0));
+    DistanceCalculator dist_calc(*fixture._tensorAttr, *nullTensor, fixture.dist_fun());
+    NearestNeighborDistanceHeap dh(100);
+    auto search = NearestNeighborIterator::create(true, tfmd, dist_calc, dh, nullptr);
+    search->initRange(1, 101);
+    // Seeks as done by a strict AND where a more selective iterator leads
+    for (uint32_t docid = 10; docid <= 100; docid += 10) {
+        EXPECT_TRUE(search->seek(docid));
+        search->unpack(docid);
+    }
+    vespalib::Slime slime;
+    vespalib::slime::SlimeInserter inserter(slime);
+    search->asSlime(inserter);
+    EXPECT_EQ(10, slime.get()["distances_calculated"].asLong());
+    EXPECT_EQ(0, slime.get()["distances_pruned"].asLong());
+}
+
+TEST(NnsIndexIteratorTest, require_that_batched_distances_exit_early_when_limit_is_given) {
+    Fixture fixture(denseSpecDouble);
+    fixture.ensureSpace(2);
+    fixture.setTensor(1, 1.0, 1.0);
+    fixture.setTensor(2, 10.0, 5.0);
+    auto nullTensor = createTensor(denseSpecDouble, 0.0, 0.0);
+    DistanceCalculator dist_calc(*fixture._tensorAttr, *nullTensor, fixture.dist_fun());
+    uint32_t docids[2] = {1, 2};
+    vespalib::eval::TypedCells cells[2];
+    double distances[2];
+    dist_calc.calc_batch(docids, 2, cells, distances);
+    EXPECT_EQ(2.0, distances[0]);
+    EXPECT_EQ(125.0, distances[1]);
+    // The distance of the second document is above the limit after the first cell
+    dist_calc.calc_batch(docids, 2, cells, distances, 4.0);
+    EXPECT_EQ(2.0, distances[0]);
+    EXPECT_EQ(100.0, distances[1]);
+}
+
+TEST(NnsIndexIteratorTest, require_that_strict_and_non_strict_exact_search_give_same_hits) {
+    Fixture fixture(denseSpecDouble);
+    fixture.ensureSpace(200);
+    std::vector<uint32_t> filter;
+    for (uint32_t docid = 1; docid <= 200; ++docid) {
+        fixture.setTensor(docid, (docid * 37) % 101, (docid * 11) % 7);
+        if ((docid % 3) != 0) {
+            filter.push_back(docid);
+        }
+    }
+    auto queryTensor = createTensor(denseSpecDouble, 50.0, 3.0);
+    auto expected = find_matches<false>(fixture, *queryTensor);
+    EXPECT_EQ(expected, find_matches<true>(fixture, *queryTensor));
+    fixture.setFilter(filter);
+    expected = find_matches<false>(fixture, *queryTensor);
+    EXPECT_EQ(expected, find_matches<true>(fixture, *queryTensor));
+}
+
 TEST(NnsIndexIteratorTest, require_that_iterator_works_as_expected) {
     std::vector<NnsIndexIterator::Hit> hits{{2,4.0}, {3,9.0}, {5,1.0}, {8,16.0}, {9,36.0}};
     auto md = MatchData::makeTestInstance(2, 2);
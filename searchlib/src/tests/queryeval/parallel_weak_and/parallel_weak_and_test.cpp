@@ -593,6 +593,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "    estimate: HitEstimate {\n"
                               "        empty: false\n"
                               "        estHits: 2\n"
+                              "        cost: 1\n"
+                              "        strict_cost: 1\n"
                               "        cost_tier: 1\n"
                               "        tree_size: 2\n"
                               "        allow_termwise_eval: 0\n"
@@ -615,6 +617,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "            estimate: HitEstimate {\n"
                               "                empty: false\n"
                               "                estHits: 2\n"
+                              "                cost: 1\n"
+                              "                strict_cost: 1\n"
                               "                cost_tier: 1\n"
                               "                tree_size: 1\n"
                               "                allow_termwise_eval: 1\n"
@@ -0,0 +1,111 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/orsearch.h>
+#include <vespa/searchlib/queryeval/profiled_iterator.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <map>
+
+using namespace search::queryeval;
+using vespalib::ExecutionProfiler;
+using vespalib::Slime;
+using vespalib::slime::Inspector;
+
+namespace {
+
+SearchIterator::UP make_leaf(std::vector<uint32_t> docids) {
+    SimpleResult result;
+    for (uint32_t docid : docids) {
+        result.addHit(docid);
+    }
+    return std::make_unique<SimpleSearch>(result);
+}
+
+// (a OR b) AND c
+SearchIterator::UP make_tree() {
+    MultiSearch::Children or_children;
+    or_children.push_back(make_leaf({1, 3, 5, 7}));
+    or_children.push_back(make_leaf({2, 3, 9}));
+    MultiSearch::Children and_children;
+    and_children.push_back(OrSearch::create(std::move(or_children), true));
+    and_children.push_back(make_leaf({3, 5, 9}));
+    return AndSearch::create(std::move(and_children), true);
+}
+
+void collect(const Inspector &node, std::map<vespalib::string, size_t> &counts) {
+    counts[node["name"].asString().make_string()] += node["count"].asLong();
+    for (size_t i = 0; i < node["children"].entries(); ++i) {
+        collect(node["children"][i], counts);
+    }
+}
+
+std::map<vespalib::string, size_t> report(const ExecutionProfiler &profiler) {
+    Slime slime;
+    profiler.report(slime.setObject());
+    std::map<vespalib::string, size_t> counts;
+    for (size_t i = 0; i < slime.get()["roots"].entries(); ++i) {
+        collect(slime.get()["roots"][i], counts);
+    }
+    return counts;
+}
+
+size_t count_matching(const std::map<vespalib::string, size_t> &counts, const vespalib::string &prefix, const vespalib::string &suffix) {
+    size_t sum = 0;
+    for (const auto &[name, count] : counts) {
+        if (name.find(prefix) == 0 && name.size() >= suffix.size() &&
+            name.find(suffix, name.size() - suffix.size()) != vespalib::string::npos)
+        {
+            sum += count;
+        }
+    }
+    return sum;
+}
+
+}
+
+TEST(ProfiledIteratorTest, profiled_tree_gives_same_hits) {
+    ExecutionProfiler profiler(64);
+    auto plain = make_tree();
+    auto profiled = ProfiledIterator::profile(profiler, make_tree());
+    SimpleResult expect;
+    SimpleResult actual;
+    expect.searchStrict(*plain, 20);
+    actual.searchStrict(*profiled, 20);
+    EXPECT_EQ(expect, actual);
+    EXPECT_EQ(expect, SimpleResult().addHit(3).addHit(5).addHit(9));
+}
+
+TEST(ProfiledIteratorTest, all_iterators_in_tree_are_profiled) {
+    ExecutionProfiler profiler(64);
+    auto search = ProfiledIterator::profile(profiler, make_tree());
+    search->initRange(1, 20);
+    for (uint32_t docid = search->seekFirst(1); !search->isAtEnd(docid); docid = search->seekNext(docid + 1)) {
+        search->unpack(docid);
+    }
+    auto counts = report(profiler);
+    EXPECT_EQ(count_matching(counts, "/AndSearch", "::initRange"), 1u);
+    EXPECT_EQ(count_matching(counts, "/0/OrLikeSearch", "::initRange"), 1u);
+    EXPECT_EQ(count_matching(counts, "/0/0/SimpleSearch", "::initRange"), 1u);
+    EXPECT_EQ(count_matching(counts, "/0/1/SimpleSearch", "::initRange"), 1u);
+    EXPECT_EQ(count_matching(counts, "/1/SimpleSearch", "::initRange"), 1u);
+    EXPECT_EQ(count_matching(counts, "/AndSearch", "::unpack"), 3u);
+    EXPECT_GT(count_matching(counts, "/AndSearch", "::seek"), 0u);
+    EXPECT_GT(count_matching(counts, "/1/SimpleSearch", "::seek"), 0u);
+    EXPECT_GT(count_matching(counts, "/0/0/SimpleSearch", "::unpack"), 0u);
+}
+
+TEST(ProfiledIteratorTest, termwise_evaluation_is_profiled) {
+    ExecutionProfiler profiler(64);
+    auto search = ProfiledIterator::profile(profiler, make_tree());
+    search->initRange(1, 20);
+    auto hits = search->get_hits(1);
+    EXPECT_EQ(hits->countTrueBits(), 3u);
+    auto counts = report(profiler);
+    EXPECT_EQ(count_matching(counts, "/AndSearch", "::termwise"), 1u);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/queryeval/fake_search.h>
+#include <vespa/searchlib/queryeval/iblock_max_search.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/simplesearch.h>
@@ -8,6 +9,8 @@
 #include <vespa/searchlib/queryeval/test/leafspec.h>
 #include <vespa/searchlib/queryeval/test/wandspec.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
+#include <vespa/vespalib/util/priority_queue.h>
+#include <random>
 
 using namespace search::fef;
 using namespace search::queryeval;
@@ -52,6 +55,147 @@ struct AdvancedWandFixture {
     }
 };
 
+struct BlockMaxPosting {
+    uint32_t docid;
+    uint32_t num_occs;
+    uint32_t field_length;
+};
+
+using BlockMaxPostings = std::vector<BlockMaxPosting>;
+
+/**
+ * Posting list iterator exposing block max info for fixed size blocks.
+ * Counts the number of postings visited by regular seeks.
+ */
+class MyBlockMaxSearch : public SearchIterator, public IBlockMaxSearch
+{
+    const BlockMaxPostings &_postings;
+    uint32_t                _block_size;
+    size_t                  _pos;
+    size_t                 &_visited;
+
+    void update_docid() {
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].docid);
+        } else {
+            setAtEnd();
+        }
+    }
+public:
+    MyBlockMaxSearch(const BlockMaxPostings &postings, uint32_t block_size, size_t &visited)
+        : _postings(postings), _block_size(block_size), _pos(0), _visited(visited)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _postings.size() && _postings[_pos].docid < docid) {
+            ++_pos;
+            ++_visited;
+        }
+        update_docid();
+    }
+    void doUnpack(uint32_t) override {}
+    Block seek_block(uint32_t docid) override {
+        size_t block_start = (_pos / _block_size) * _block_size;
+        while (block_start < _postings.size() &&
+               _postings[std::min(block_start + _block_size, _postings.size()) - 1].docid < docid)
+        {
+            block_start += _block_size;
+        }
+        if (block_start >= _postings.size()) {
+            _pos = _postings.size();
+            setAtEnd();
+            return Block{search::endDocId, 0, 1};
+        }
+        _pos = std::max(_pos, block_start);
+        update_docid();
+        size_t block_end = std::min(block_start + _block_size, _postings.size());
+        Block block{_postings[block_end - 1].docid, 0, std::numeric_limits<uint32_t>::max()};
+        for (size_t i = block_start; i < block_end; ++i) {
+            block.max_num_occs = std::max(block.max_num_occs, _postings[i].num_occs);
+            block.min_field_length = std::min(block.min_field_length, _postings[i].field_length);
+        }
+        return block;
+    }
+    uint32_t get_num_occs() const override { return _postings[_pos].num_occs; }
+    uint32_t get_field_length() const override { return _postings[_pos].field_length; }
+    bool has_interleaved_features() const override { return true; }
+};
+
+struct BlockMaxFixture {
+    std::vector<BlockMaxPostings> postings;
+    std::vector<int32_t>          weights;
+    uint32_t                      docid_limit;
+    size_t                        visited;
+
+    BlockMaxFixture() : postings(), weights(), docid_limit(20000), visited(0) {
+        std::mt19937 gen(42);
+        std::vector<double> density = {0.5, 0.1, 0.02};
+        for (size_t t = 0; t < density.size(); ++t) {
+            std::bernoulli_distribution has_doc(density[t]);
+            std::geometric_distribution<uint32_t> num_occs(0.6);
+            std::uniform_int_distribution<uint32_t> field_length(1, 300);
+            BlockMaxPostings list;
+            for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+                if (has_doc(gen)) {
+                    list.push_back({docid, 1 + num_occs(gen), field_length(gen)});
+                }
+            }
+            postings.push_back(std::move(list));
+            weights.push_back(100);
+        }
+    }
+    wand::Terms make_terms(uint32_t block_size) {
+        wand::Terms terms;
+        for (size_t t = 0; t < postings.size(); ++t) {
+            terms.emplace_back(new MyBlockMaxSearch(postings[t], block_size, visited), weights[t], postings[t].size());
+        }
+        return terms;
+    }
+    SimpleResult search(uint32_t n, uint32_t block_size, bool strict) {
+        SearchIterator::UP search = WeakAndSearch::create_block_max(make_terms(block_size), n, strict,
+                                                                    WeakAndSearch::BlockMaxParams());
+        SimpleResult result;
+        if (strict) {
+            result.search(*search);
+        } else {
+            result.search(*search, docid_limit);
+        }
+        return result;
+    }
+    SimpleResult brute_force(uint32_t n) {
+        WeakAndSearch::BlockMaxParams params;
+        wand::Bm25TermFrequencyScorer scorer(params.k1, params.b, params.avg_field_length);
+        std::vector<size_t> pos(postings.size(), 0);
+        vespalib::PriorityQueue<wand::score_t> scores;
+        wand::score_t threshold = 1;
+        SimpleResult result;
+        for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+            wand::score_t score = 0;
+            for (size_t t = 0; t < postings.size(); ++t) {
+                if (pos[t] < postings[t].size() && postings[t][pos[t]].docid == docid) {
+                    wand::score_t max_score = wand::TermFrequencyScorer::calculateMaxScore(postings[t].size(), weights[t]) + 1;
+                    const auto &posting = postings[t][pos[t]++];
+                    score += scorer.calculate_score(max_score, posting.num_occs, posting.field_length);
+                }
+            }
+            if (score > 0 && score >= threshold) {
+                result.addHit(docid);
+                scores.push(score);
+                if (scores.size() > n) {
+                    scores.pop_front();
+                }
+                if (scores.size() == n) {
+                    threshold = scores.front();
+                }
+            }
+        }
+        return result;
+    }
+};
+
 struct WeightOrder {
     bool operator()(const wand::Term &t1, const wand::Term &t2) const {
         return (t1.weight < t2.weight);
@@ -99,6 +243,24 @@ TEST("require that initial docid for subsearches are taken into account") {
                  history);
 }
 
+TEST_F("require that block-max wand gives same hits as brute force", BlockMaxFixture) {
+    SimpleResult expect = f.brute_force(10);
+    EXPECT_LESS(0u, expect.getHitCount());
+    EXPECT_EQUAL(expect, f.search(10, 8, true));
+    EXPECT_EQUAL(expect, f.search(10, 8, false));
+    EXPECT_EQUAL(expect, f.search(10, 1000000, true));
+}
+
+TEST_F("require that block-max wand skips postings using block max info", BlockMaxFixture) {
+    f.visited = 0;
+    SimpleResult single_block = f.search(10, 1000000, true);
+    size_t single_block_visited = f.visited;
+    f.visited = 0;
+    SimpleResult small_blocks = f.search(10, 8, true);
+    EXPECT_EQUAL(single_block, small_blocks);
+    EXPECT_LESS(f.visited, single_block_visited);
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 private:
     SearchIterator::UP create(bool strict) const override {
@@ -116,4 +278,21 @@ TEST("verify search iterator conformance") {
     verifier.verify();
 }
 
+class BlockMaxIteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
+private:
+    SearchIterator::UP create(bool strict) const override {
+        wand::Terms terms;
+        for (size_t i = 0; i < _num_children; ++i) {
+            terms.emplace_back(createIterator(_split_lists[i], strict).release(),
+                               100, _split_lists[i].size());
+        }
+        return WeakAndSearch::create_block_max(terms, -1, strict, WeakAndSearch::BlockMaxParams());
+    }
+};
+
+TEST("verify block-max search iterator conformance") {
+    BlockMaxIteratorChildrenVerifier verifier;
+    verifier.verify();
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
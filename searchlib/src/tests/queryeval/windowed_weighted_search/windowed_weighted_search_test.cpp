@@ -0,0 +1,177 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/queryeval/windowed_weighted_search.h>
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataposition.h>
+#include <vespa/searchlib/queryeval/dot_product_search.h>
+#include <vespa/searchlib/queryeval/weighted_set_term_search.h>
+#include <vespa/searchlib/test/weightedchildrenverifiers.h>
+#include <vespa/vespalib/util/rand48.h>
+
+using namespace search;
+using namespace search::attribute;
+using namespace search::fef;
+using namespace search::queryeval;
+
+namespace {
+
+constexpr uint32_t num_docs = 3 * WindowedWeightedSearch::window_size + 100;
+constexpr uint32_t num_keys = 200;
+
+// weighted set attribute where each document holds a few random keys
+struct Fixture {
+    AttributeVector::SP attr;
+    const IDocumentWeightAttribute *dwa;
+    std::vector<int32_t> weights;
+
+    Fixture() : attr(), dwa(nullptr), weights() {
+        Config cfg(BasicType::INT64, CollectionType::WSET);
+        cfg.setFastSearch(true);
+        attr = AttributeFactory::createAttribute("my_attribute", cfg);
+        attr->addReservedDoc();
+        attr->addDocs(num_docs - 1);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        vespalib::Rand48 rnd;
+        rnd.srand48(42);
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (docid % 1000 < 500) {
+                // leave gaps larger than a window without any hits
+                continue;
+            }
+            uint32_t num_values = rnd.lrand48() % 4;
+            for (uint32_t i = 0; i < num_values; ++i) {
+                int_attr.append(docid, rnd.lrand48() % num_keys, 1 + rnd.lrand48() % 10);
+            }
+        }
+        attr->commit();
+        dwa = attr->asDocumentWeightAttribute();
+        ASSERT_TRUE(dwa != nullptr);
+        for (uint32_t key = 0; key < num_keys; ++key) {
+            weights.push_back(int32_t(key % 7) - 3);
+        }
+    }
+    ~Fixture();
+
+    std::vector<DocumentWeightIterator> make_iterators() const {
+        std::vector<DocumentWeightIterator> iterators;
+        for (uint32_t key = 0; key < num_keys; ++key) {
+            auto result = dwa->lookup(vespalib::make_string("%u", key), dwa->get_dictionary_snapshot());
+            dwa->create(result.posting_idx, iterators);
+        }
+        return iterators;
+    }
+};
+
+Fixture::~Fixture() = default;
+
+struct Hit {
+    uint32_t docid;
+    double score;
+    std::vector<int32_t> weights;
+    bool operator==(const Hit &rhs) const {
+        return (docid == rhs.docid) && (score == rhs.score) && (weights == rhs.weights);
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const Hit &hit) {
+    os << "{" << hit.docid << "," << hit.score << ",[";
+    for (int32_t weight : hit.weights) {
+        os << weight << ",";
+    }
+    return os << "]}";
+}
+
+std::vector<Hit> collect(SearchIterator &search, TermFieldMatchData &tfmd, uint32_t begin, uint32_t end, uint32_t step) {
+    std::vector<Hit> hits;
+    search.initRange(begin, end);
+    for (uint32_t docid = search.seekFirst(begin); !search.isAtEnd(docid); docid = search.seekNext(docid + step)) {
+        search.unpack(docid);
+        EXPECT_EQUAL(tfmd.getDocId(), docid);
+        Hit hit{docid, tfmd.getRawScore(), {}};
+        for (const TermFieldMatchDataPosition &pos : tfmd) {
+            hit.weights.push_back(pos.getElementWeight());
+        }
+        hits.push_back(hit);
+    }
+    return hits;
+}
+
+void verify_same_hits(SearchIterator &expect, SearchIterator &actual, TermFieldMatchData &expect_tfmd, TermFieldMatchData &actual_tfmd) {
+    for (uint32_t step : {1u, 7u, 5000u}) {
+        for (auto range : std::vector<std::pair<uint32_t, uint32_t>>{{1, num_docs}, {600, 4700}, {5000, 9000}}) {
+            auto expect_hits = collect(expect, expect_tfmd, range.first, range.second, step);
+            auto actual_hits = collect(actual, actual_tfmd, range.first, range.second, step);
+            EXPECT_TRUE(!expect_hits.empty());
+            EXPECT_EQUAL(expect_hits.size(), actual_hits.size());
+            EXPECT_TRUE(expect_hits == actual_hits);
+        }
+    }
+}
+
+}
+
+TEST_F("require that windowed weighted set gives same result as heap based weighted set", Fixture) {
+    TermFieldMatchData expect_tfmd;
+    TermFieldMatchData actual_tfmd;
+    auto expect = WeightedSetTermSearch::create(expect_tfmd, false, f.weights, f.make_iterators());
+    auto actual = WindowedWeightedSearch::create_weighted_set(actual_tfmd, false, f.weights, f.make_iterators());
+    verify_same_hits(*expect, *actual, expect_tfmd, actual_tfmd);
+}
+
+TEST_F("require that windowed dot product gives same result as heap based dot product", Fixture) {
+    TermFieldMatchData expect_tfmd;
+    TermFieldMatchData actual_tfmd;
+    auto expect = DotProductSearch::create(expect_tfmd, false, f.weights, f.make_iterators());
+    auto actual = WindowedWeightedSearch::create_dot_product(actual_tfmd, false, f.weights, f.make_iterators());
+    verify_same_hits(*expect, *actual, expect_tfmd, actual_tfmd);
+}
+
+TEST_F("require that windowed search exposes hits as bitvector", Fixture) {
+    TermFieldMatchData expect_tfmd;
+    TermFieldMatchData actual_tfmd;
+    auto expect = DotProductSearch::create(expect_tfmd, true, f.weights, f.make_iterators());
+    auto actual = WindowedWeightedSearch::create_dot_product(actual_tfmd, true, f.weights, f.make_iterators());
+    expect->initRange(1, num_docs);
+    actual->initRange(1, num_docs);
+    auto expect_bv = expect->get_hits(1);
+    auto actual_bv = actual->get_hits(1);
+    EXPECT_TRUE(*expect_bv == *actual_bv);
+}
+
+TEST("require that windowed search is only used for many terms with dense postings") {
+    EXPECT_FALSE(WindowedWeightedSearch::should_use(100, 10000000, 1000000));
+    EXPECT_FALSE(WindowedWeightedSearch::should_use(1000, 1000, 1000000));
+    EXPECT_TRUE(WindowedWeightedSearch::should_use(1000, 1000000, 1000000));
+}
+
+class WeightedSetVerifier : public search::test::DwaIteratorChildrenVerifier {
+private:
+    SearchIterator::UP create(std::vector<DocumentWeightIterator> && children) const override {
+        return WindowedWeightedSearch::create_weighted_set(_tfmd, false, _weights, std::move(children));
+    }
+};
+
+class DotProductVerifier : public search::test::DwaIteratorChildrenVerifier {
+private:
+    SearchIterator::UP create(std::vector<DocumentWeightIterator> && children) const override {
+        return WindowedWeightedSearch::create_dot_product(_tfmd, false, _weights, std::move(children));
+    }
+};
+
+TEST("verify search iterator conformance for windowed weighted set") {
+    WeightedSetVerifier verifier;
+    verifier.verify();
+}
+
+TEST("verify search iterator conformance for windowed dot product") {
+    DotProductVerifier verifier;
+    verifier.verify();
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
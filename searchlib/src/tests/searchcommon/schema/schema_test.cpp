@@ -33,6 +33,9 @@ assertIndexField(const Schema::IndexField& exp,
     assertField(exp, act);
     EXPECT_EQ(exp.getAvgElemLen(), act.getAvgElemLen());
     EXPECT_EQ(exp.use_interleaved_features(), act.use_interleaved_features());
+    EXPECT_EQ(exp.use_phrase_bigrams(), act.use_phrase_bigrams());
+    EXPECT_EQ(exp.use_block_max(), act.use_block_max());
+    EXPECT_EQ(exp.get_phrase_bigram_words(), act.get_phrase_bigram_words());
 }
 
 void
@@ -183,7 +186,8 @@ TEST(SchemaTest, test_load_and_save)
         EXPECT_EQ(3u, s.getNumIndexFields());
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
         assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
-        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true), s.getIndexField(2));
+        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true).set_phrase_bigrams(true).set_block_max(true).
+                         set_phrase_bigram_words({"and", "of"}), s.getIndexField(2));
 
         EXPECT_EQ(9u, s.getNumAttributeFields());
         assertField(SAF("a", SDT::STRING, SCT::SINGLE),
@@ -386,11 +390,26 @@ TEST(SchemaTest, require_that_index_field_is_loaded_with_default_values_when_pro
     ASSERT_EQ(1, index_fields.size());
     assertIndexField(SIF("foo", DataType::STRING, CollectionType::SINGLE).
                              setAvgElemLen(512).
-                             set_interleaved_features(false),
+                             set_interleaved_features(false).
+                             set_phrase_bigrams(false).
+                             set_block_max(false),
                      index_fields[0]);
     assertIndexField(SIF("foo", DataType::STRING, CollectionType::SINGLE), index_fields[0]);
 }
 
+TEST(SchemaTest, require_that_phrase_bigrams_are_selected_by_common_words)
+{
+    auto field = SIF("foo", DataType::STRING).set_phrase_bigram_words({"the", "of", "the"});
+    EXPECT_EQ(std::vector<vespalib::string>({"of", "the"}), field.get_phrase_bigram_words());
+    EXPECT_FALSE(field.has_phrase_bigram("the", "cat"));
+    field.set_phrase_bigrams(true);
+    EXPECT_TRUE(field.has_phrase_bigram("the", "cat"));
+    EXPECT_TRUE(field.has_phrase_bigram("cat", "of"));
+    EXPECT_TRUE(field.has_phrase_bigram("of", "the"));
+    EXPECT_FALSE(field.has_phrase_bigram("cat", "sat"));
+    EXPECT_FALSE(field.has_phrase_bigram("", "th"));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -5,12 +5,15 @@
 #include <vespa/searchlib/tensor/distance_functions.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <limits>
 #include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP("distance_function_test");
 
 using namespace search::tensor;
+using vespalib::BFloat16;
 using vespalib::eval::Int8Float;
 using vespalib::eval::TypedCells;
 using search::attribute::DistanceMetric;
@@ -252,6 +255,104 @@ TEST(DistanceFunctionsTest, hamming_gives_expected_score)
     EXPECT_EQ(hamming->calc(TypedCells(bytes_a), TypedCells(bytes_b)), 12.0);
 }
 
+template <typename T>
+void verify_batch_matches_single(DistanceMetric metric)
+{
+    auto dist_fun = make_distance_function(metric, vespalib::eval::get_cell_type<T>());
+    std::vector<T> query{0.6, 0.8, 0.0};
+    std::vector<std::vector<T>> docs{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.6, 0.8, 0.0}, {0.0, 0.0, -1.0}};
+    std::vector<TypedCells> rhs;
+    for (const auto& doc : docs) {
+        rhs.push_back(t(doc));
+    }
+    std::vector<double> result(rhs.size());
+    dist_fun->calc_batch(t(query), rhs.data(), rhs.size(), result.data());
+    for (size_t i = 0; i < rhs.size(); ++i) {
+        EXPECT_DOUBLE_EQ(dist_fun->calc(t(query), rhs[i]), result[i]);
+    }
+}
+
+TEST(DistanceFunctionsTest, batch_calculation_gives_same_distances_as_single_calculation)
+{
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct}) {
+        SCOPED_TRACE(static_cast<int>(metric));
+        verify_batch_matches_single<double>(metric);
+        verify_batch_matches_single<float>(metric);
+        verify_batch_matches_single<BFloat16>(metric);
+    }
+}
+
+template <typename T>
+void verify_hw_matches_generic(DistanceMetric metric, const DistanceFunction &generic)
+{
+    auto dist_fun = make_distance_function(metric, vespalib::eval::get_cell_type<T>());
+    // lengths both shorter and longer than a full vector register
+    for (size_t sz : {3, 17, 100, 333}) {
+        std::vector<T> a;
+        std::vector<T> b;
+        for (size_t i = 0; i < sz; ++i) {
+            a.emplace_back(float(int(i % 19) - 9));
+            b.emplace_back(float(int((i * 7) % 23) - 11));
+        }
+        EXPECT_DOUBLE_EQ(generic.calc(t(a), t(b)), dist_fun->calc(t(a), t(b)));
+    }
+}
+
+TEST(DistanceFunctionsTest, hw_accelerated_bfloat16_and_int8_match_generic_calculation)
+{
+    SquaredEuclideanDistance euclid(vespalib::eval::CellType::FLOAT);
+    AngularDistance angular(vespalib::eval::CellType::FLOAT);
+    InnerProductDistance innerproduct(vespalib::eval::CellType::FLOAT);
+    verify_hw_matches_generic<BFloat16>(DistanceMetric::Euclidean, euclid);
+    verify_hw_matches_generic<BFloat16>(DistanceMetric::Angular, angular);
+    verify_hw_matches_generic<BFloat16>(DistanceMetric::InnerProduct, innerproduct);
+    verify_hw_matches_generic<Int8Float>(DistanceMetric::Euclidean, euclid);
+    verify_hw_matches_generic<Int8Float>(DistanceMetric::Angular, angular);
+    verify_hw_matches_generic<Int8Float>(DistanceMetric::InnerProduct, innerproduct);
+}
+
+template <typename T>
+void verify_float_query_matches_generic(DistanceMetric metric, const DistanceFunction &generic)
+{
+    auto dist_fun = make_distance_function(metric, vespalib::eval::get_cell_type<T>());
+    // the query is not converted to the (less precise) cell type of the stored vectors
+    EXPECT_EQ(vespalib::eval::CellType::FLOAT, dist_fun->expected_cell_type());
+    for (size_t sz : {3, 17, 100, 333}) {
+        std::vector<float> query;
+        std::vector<std::vector<T>> docs(3);
+        for (size_t i = 0; i < sz; ++i) {
+            query.push_back(float(int(i % 13) - 6) * 0.37f + 0.011f);
+            for (size_t j = 0; j < docs.size(); ++j) {
+                docs[j].emplace_back(float(int((i * (j + 5)) % 23) - 11));
+            }
+        }
+        std::vector<TypedCells> rhs;
+        for (const auto& doc : docs) {
+            rhs.push_back(t(doc));
+        }
+        std::vector<double> result(rhs.size());
+        dist_fun->calc_batch(t(query), rhs.data(), rhs.size(), result.data());
+        for (size_t j = 0; j < rhs.size(); ++j) {
+            double expected = generic.calc(t(query), rhs[j]);
+            EXPECT_EQ(expected, dist_fun->calc(t(query), rhs[j]));
+            EXPECT_EQ(expected, dist_fun->calc_with_limit(t(query), rhs[j], std::numeric_limits<double>::max()));
+            EXPECT_EQ(expected, result[j]);
+        }
+    }
+}
+
+TEST(DistanceFunctionsTest, float_query_against_bfloat16_and_int8_vectors_matches_generic_calculation)
+{
+    SquaredEuclideanDistance euclid(vespalib::eval::CellType::FLOAT);
+    AngularDistance angular(vespalib::eval::CellType::FLOAT);
+    InnerProductDistance innerproduct(vespalib::eval::CellType::FLOAT);
+    verify_float_query_matches_generic<BFloat16>(DistanceMetric::Euclidean, euclid);
+    verify_float_query_matches_generic<BFloat16>(DistanceMetric::Angular, angular);
+    verify_float_query_matches_generic<BFloat16>(DistanceMetric::InnerProduct, innerproduct);
+    verify_float_query_matches_generic<Int8Float>(DistanceMetric::Angular, angular);
+    verify_float_query_matches_generic<Int8Float>(DistanceMetric::InnerProduct, innerproduct);
+}
+
 TEST(GeoDegreesTest, gives_expected_score)
 {
     auto ct = vespalib::eval::CellType::DOUBLE;
@@ -10,6 +10,7 @@
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vector>
 
@@ -24,6 +25,8 @@ using vespalib::Slime;
 using search::BitVector;
 using vespalib::datastore::CompactionSpec;
 using vespalib::datastore::CompactionStrategy;
+using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MmapFileAllocator;
 
 template <typename FloatType>
 class MyDocVectorAccess : public DocVectorAccess {
@@ -31,22 +34,39 @@ private:
     using Vector = std::vector<FloatType>;
     using ArrayRef = vespalib::ConstArrayRef<FloatType>;
     std::vector<Vector> _vectors;
+    std::vector<uint32_t> _subspaces;
 
 public:
-    MyDocVectorAccess() : _vectors() {}
+    MyDocVectorAccess() : _vectors(), _subspaces() {}
     MyDocVectorAccess& set(uint32_t docid, const Vector& vec) {
+        return set_multi(docid, {vec});
+    }
+    MyDocVectorAccess& set_multi(uint32_t docid, const std::vector<Vector>& vecs) {
         if (docid >= _vectors.size()) {
             _vectors.resize(docid + 1);
+            _subspaces.resize(docid + 1);
+        }
+        _vectors[docid].clear();
+        for (const auto& vec : vecs) {
+            _vectors[docid].insert(_vectors[docid].end(), vec.begin(), vec.end());
         }
-        _vectors[docid] = vec;
+        _subspaces[docid] = vecs.size();
         return *this;
     }
     vespalib::eval::TypedCells get_vector(uint32_t docid) const override {
         ArrayRef ref(_vectors[docid]);
         return vespalib::eval::TypedCells(ref);
     }
+    VectorBundle get_vectors(uint32_t docid) const override {
+        auto cells = get_vector(docid);
+        uint32_t subspaces = _subspaces[docid];
+        return VectorBundle(cells.data, cells.type, subspaces, (subspaces != 0) ? (cells.size / subspaces) : 0);
+    }
 
-    void clear() { _vectors.clear(); }
+    void clear() {
+        _vectors.clear();
+        _subspaces.clear();
+    }
 };
 
 struct LevelGenerator : public RandomLevelGenerator {
@@ -57,11 +77,14 @@ struct LevelGenerator : public RandomLevelGenerator {
 
 using FloatVectors = MyDocVectorAccess<float>;
 using HnswIndexUP = std::unique_ptr<HnswIndex>;
+using FilterTraversal = NearestNeighborIndex::FilterTraversal;
 
 class HnswIndexTest : public ::testing::Test {
 public:
     FloatVectors vectors;
     std::unique_ptr<BitVector> global_filter;
+    FilterTraversal filter_traversal;
+    bool multi_vector;
     LevelGenerator* level_generator;
     GenerationHandler gen_handler;
     HnswIndexUP index;
@@ -69,6 +92,8 @@ public:
     HnswIndexTest()
         : vectors(),
           global_filter(),
+          filter_traversal(FilterTraversal::PLAIN),
+          multi_vector(false),
           level_generator(),
           gen_handler(),
           index()
@@ -80,12 +105,19 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    void init(bool heuristic_select_neighbors, bool int8_quantization = false,
+              std::shared_ptr<MemoryAllocator> link_memory_allocator = {}) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
+        std::unique_ptr<QuantizedVectorStore> quantized_vectors;
+        if (int8_quantization) {
+            quantized_vectors = std::make_unique<QuantizedVectorStore>(search::attribute::DistanceMetric::Euclidean, 2);
+        }
         index = std::make_unique<HnswIndex>(vectors, std::make_unique<SquaredEuclideanDistance>(vespalib::eval::CellType::FLOAT),
                                             std::move(generator),
-                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors, multi_vector),
+                                            std::move(quantized_vectors),
+                                            std::move(link_memory_allocator));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -142,7 +174,7 @@ public:
     void expect_top_3(uint32_t docid, std::vector<uint32_t> exp_hits) {
         uint32_t k = 3;
         auto qv = vectors.get_vector(docid);
-        auto rv = index->top_k_candidates(qv, k, global_filter.get()).peek();
+        auto rv = index->top_k_candidates(qv, k, global_filter.get(), filter_traversal).peek();
         std::sort(rv.begin(), rv.end(), LesserDistance());
         size_t idx = 0;
         for (const auto & hit : rv) {
@@ -163,13 +195,13 @@ public:
     void check_with_distance_threshold(uint32_t docid) {
         auto qv = vectors.get_vector(docid);
         uint32_t k = 3;
-        auto rv = index->top_k_candidates(qv, k, global_filter.get()).peek();
+        auto rv = index->top_k_candidates(qv, k, global_filter.get(), filter_traversal).peek();
         std::sort(rv.begin(), rv.end(), LesserDistance());
         EXPECT_EQ(rv.size(), 3);
         EXPECT_LE(rv[0].distance, rv[1].distance);
         double thr = (rv[0].distance + rv[1].distance) * 0.5;
         auto got_by_docid = (global_filter)
-            ? index->find_top_k_with_filter(k, qv, *global_filter, k, thr)
+            ? index->find_top_k_with_filter(k, qv, *global_filter, filter_traversal, k, thr)
             : index->find_top_k(k, qv, k, thr);
         EXPECT_EQ(got_by_docid.size(), 1);
         EXPECT_EQ(got_by_docid[0].docid, rv[0].docid);
@@ -249,6 +281,88 @@ TEST_F(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_select_ne
     expect_top_3(9, {3, 2});
 }
 
+TEST_F(HnswIndexTest, 2d_vectors_searched_using_filtered_traversal)
+{
+    init(false);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    filter_traversal = FilterTraversal::FILTERED;
+
+    set_filter({2,3,4,6});
+    expect_top_3(2, {2, 3});
+    expect_top_3(4, {4, 3});
+    expect_top_3(5, {6, 2});
+    expect_top_3(6, {6, 2});
+    expect_top_3(7, {3, 2});
+    expect_top_3(8, {4, 3});
+    expect_top_3(9, {3, 2});
+
+    // Doc 5 and 7 are only reachable via neighbors (1, 2 and 3) not matching the filter.
+    set_filter({4,5,7});
+    expect_top_3(8, {4, 7});
+    expect_top_3(9, {7, 4});
+}
+
+TEST_F(HnswIndexTest, filtered_traversal_is_estimated_to_be_cheaper_than_plain_traversal_only_for_restrictive_filters)
+{
+    init(false);
+    for (uint32_t docid = 1; docid < 1000; ++docid) {
+        vectors.set(docid, {float(docid % 32), float(docid / 32)});
+        add_document(docid);
+    }
+    auto make_filter = [](uint32_t step) {
+        auto filter = BitVector::create(1000);
+        for (uint32_t docid = 0; docid < 1000; docid += step) {
+            filter->setBit(docid);
+        }
+        filter->invalidateCachedCount();
+        return filter;
+    };
+    auto restrictive_filter = make_filter(4);
+    auto full_filter = make_filter(1);
+    // 5 links * 3 neighbors + 100 = 115 distance calculations, and 23 link arrays read.
+    EXPECT_NEAR(126.5, index->estimate_search_cost(3, nullptr, FilterTraversal::PLAIN), 0.01);
+    // The filter hit ratio is 0.25: 460 distance calculations and 92 link arrays read.
+    EXPECT_NEAR(506.0, index->estimate_search_cost(3, restrictive_filter.get(), FilterTraversal::PLAIN), 0.01);
+    // 1.25 of 2 wanted direct neighbors match, giving 0.6 extra expansions for each of the 57.5 expanded nodes.
+    EXPECT_NEAR(170.2, index->estimate_search_cost(3, restrictive_filter.get(), FilterTraversal::FILTERED), 0.01);
+    // When (almost) all documents match, the extra filter checks make filtered traversal more expensive.
+    EXPECT_LT(index->estimate_search_cost(3, full_filter.get(), FilterTraversal::PLAIN),
+              index->estimate_search_cost(3, full_filter.get(), FilterTraversal::FILTERED));
+}
+
+TEST_F(HnswIndexTest, 2d_vectors_searched_using_int8_quantized_vectors)
+{
+    init(false, true);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    ASSERT_TRUE(index->get_quantized_vectors() != nullptr);
+
+    expect_top_3(1, {1});
+    expect_top_3(2, {2, 1, 3});
+    expect_top_3(3, {3});
+    expect_top_3(4, {4, 1, 3});
+    expect_top_3(5, {5, 6, 2});
+    expect_top_3(6, {6, 5, 2});
+    expect_top_3(7, {7, 3, 2});
+    expect_top_3(8, {4, 3, 1});
+    expect_top_3(9, {7, 3, 2});
+
+    // Distances of the returned candidates are calculated using the full precision vectors.
+    auto rv = index->top_k_candidates(vectors.get_vector(8), 3, nullptr).peek();
+    std::sort(rv.begin(), rv.end(), LesserDistance());
+    EXPECT_EQ(2.0, rv[0].distance);
+    EXPECT_EQ(4.0, rv[1].distance);
+    EXPECT_EQ(5.0, rv[2].distance);
+
+    auto mem_usage = commit_and_update_stat();
+    remove_document(2);
+    expect_top_3(5, {5, 6, 7});
+    EXPECT_LT(0, mem_usage.usedBytes());
+}
+
 TEST_F(HnswIndexTest, 2d_vectors_inserted_and_removed)
 {
     init(false);
@@ -656,6 +770,197 @@ TEST_F(HnswIndexTest, hnsw_graph_is_compacted)
     EXPECT_LT(mem_3.usedBytes(), mem_2.usedBytes());
 }
 
+TEST_F(HnswIndexTest, link_arrays_can_be_allocated_in_memory_mapped_file)
+{
+    auto link_memory_allocator = std::make_shared<MmapFileAllocator>("hnsw-link-arrays-mmap-file");
+    init(true, true, link_memory_allocator);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    EXPECT_LT(0u, link_memory_allocator->get_end_offset());
+    expect_top_3(2, {2, 1, 3});
+    expect_top_3(5, {5, 6, 2});
+    expect_top_3(8, {4, 3, 1});
+
+    remove_document(3);
+    commit_and_update_stat();
+    CompactionSpec compaction_spec(true, false);
+    index->compact_link_arrays(compaction_spec, CompactionStrategy());
+    commit_and_update_stat();
+    expect_top_3(8, {4, 1, 2});
+    EXPECT_TRUE(index->check_link_symmetry());
+    Slime state;
+    index->get_state(SlimeInserter(state));
+    EXPECT_TRUE(state.get()["cfg"]["disk_resident"].asBool());
+}
+
+TEST_F(HnswIndexTest, multi_vector_search_returns_best_subspace_per_document)
+{
+    vectors.clear();
+    vectors.set_multi(1, {{2, 2}, {8, 3}}).set_multi(2, {{3, 2}})
+           .set_multi(3, {{7, 2}, {0, 3}}).set_multi(4, {{3, 5}});
+    multi_vector = true;
+    init(true);
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        add_document(docid);
+    }
+    EXPECT_EQ(2u, index->get_id_mapping()->get_ids(1).size());
+    EXPECT_EQ(1u, index->get_id_mapping()->get_ids(2).size());
+    EXPECT_TRUE(index->check_link_symmetry());
+
+    std::vector<float> query = {8, 3};
+    vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+    auto result = index->find_top_k(2, qv, 10, 10000.0);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(1u, result[0].docid);
+    EXPECT_DOUBLE_EQ(0.0, result[0].distance);
+    EXPECT_EQ(3u, result[1].docid);
+    EXPECT_DOUBLE_EQ(2.0, result[1].distance);
+
+    result = index->find_top_k(3, qv, 10, 10000.0);
+    ASSERT_EQ(3u, result.size());
+    EXPECT_EQ(2u, result[1].docid);
+    EXPECT_DOUBLE_EQ(26.0, result[1].distance);
+
+    set_filter({2, 4});
+    result = index->find_top_k_with_filter(3, qv, *global_filter, filter_traversal, 10, 10000.0);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(2u, result[0].docid);
+    EXPECT_EQ(4u, result[1].docid);
+    EXPECT_DOUBLE_EQ(29.0, result[1].distance);
+}
+
+TEST_F(HnswIndexTest, multi_vector_document_is_removed_with_all_subspaces)
+{
+    vectors.clear();
+    vectors.set_multi(1, {{2, 2}, {8, 3}}).set_multi(2, {{3, 2}})
+           .set_multi(3, {{7, 2}, {0, 3}}).set_multi(4, {{3, 5}});
+    multi_vector = true;
+    init(true);
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        add_document(docid);
+    }
+    auto old_ids = index->get_id_mapping()->get_ids(1);
+    std::vector<uint32_t> doc1_nodeids(old_ids.begin(), old_ids.end());
+    remove_document(1);
+    EXPECT_EQ(0u, index->get_id_mapping()->get_ids(1).size());
+    for (uint32_t nodeid : doc1_nodeids) {
+        expect_empty_level_0(nodeid);
+    }
+    EXPECT_TRUE(index->check_link_symmetry());
+
+    std::vector<float> query = {8, 3};
+    vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+    auto result = index->find_top_k(3, qv, 10, 10000.0);
+    ASSERT_EQ(3u, result.size());
+    EXPECT_EQ(2u, result[0].docid);
+    EXPECT_EQ(3u, result[1].docid);
+    EXPECT_DOUBLE_EQ(2.0, result[1].distance);
+    EXPECT_EQ(4u, result[2].docid);
+
+    // The node ids of the removed document are reused when no longer on hold.
+    vectors.set_multi(5, {{8, 4}, {1, 1}});
+    vespalib::GenerationHandler::Guard no_guard;
+    auto prepared = index->prepare_add_document(5, vectors.get_vectors(5), no_guard);
+    index->complete_add_document(5, std::move(prepared));
+    commit();
+    auto new_ids = index->get_id_mapping()->get_ids(5);
+    std::vector<uint32_t> doc5_nodeids(new_ids.begin(), new_ids.end());
+    std::sort(doc5_nodeids.begin(), doc5_nodeids.end());
+    EXPECT_EQ(doc1_nodeids, doc5_nodeids);
+    result = index->find_top_k(1, qv, 10, 10000.0);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(5u, result[0].docid);
+    EXPECT_DOUBLE_EQ(1.0, result[0].distance);
+    EXPECT_TRUE(index->check_link_symmetry());
+    Slime state;
+    index->get_state(SlimeInserter(state));
+    EXPECT_TRUE(state.get()["cfg"]["multi_vector"].asBool());
+}
+
+TEST_F(HnswIndexTest, multi_vector_two_phase_add_gives_same_graph_as_single_phase_add)
+{
+    vectors.clear();
+    vectors.set_multi(1, {{2, 2}, {8, 3}}).set_multi(2, {{3, 2}})
+           .set_multi(3, {{7, 2}, {0, 3}}).set_multi(4, {{3, 5}, {2, 3}, {7, 3}});
+    multi_vector = true;
+    std::vector<HnswNode::LevelArray> single_phase_nodes;
+    for (bool two_phase : {false, true}) {
+        init(true);
+        for (uint32_t docid = 1; docid < 4; ++docid) {
+            add_document(docid);
+        }
+        if (two_phase) {
+            auto prepared = index->prepare_add_document(4, vectors.get_vectors(4), take_read_guard());
+            index->complete_add_document(4, std::move(prepared));
+            commit();
+        } else {
+            add_document(4);
+        }
+        EXPECT_EQ(3u, index->get_id_mapping()->get_ids(4).size());
+        EXPECT_TRUE(index->check_link_symmetry());
+        std::vector<HnswNode::LevelArray> nodes;
+        for (uint32_t nodeid = 1; nodeid < 9; ++nodeid) {
+            nodes.push_back(index->get_node(nodeid).levels());
+        }
+        if (two_phase) {
+            EXPECT_EQ(single_phase_nodes, nodes);
+        } else {
+            single_phase_nodes = std::move(nodes);
+        }
+    }
+}
+
+TEST_F(HnswIndexTest, multi_vector_search_handles_nodes_of_subspaces_no_longer_in_document)
+{
+    vectors.clear();
+    vectors.set_multi(1, {{2, 2}, {8, 3}}).set_multi(2, {{3, 2}}).set_multi(3, {{7, 2}, {0, 3}});
+    multi_vector = true;
+    init(true);
+    for (uint32_t docid = 1; docid < 4; ++docid) {
+        add_document(docid);
+    }
+    // Simulates that document 1 is updated to have fewer subspaces while the graph still has nodes for the old ones.
+    vectors.set_multi(1, {{2, 2}});
+    std::vector<float> query = {8, 3};
+    vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+    auto result = index->find_top_k(2, qv, 10, 10000.0);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(2u, result[0].docid);
+    EXPECT_DOUBLE_EQ(26.0, result[0].distance);
+    EXPECT_EQ(3u, result[1].docid);
+    EXPECT_DOUBLE_EQ(2.0, result[1].distance);
+}
+
+TEST_F(HnswIndexTest, multi_vector_search_returns_k_documents_when_nearest_nodes_share_document)
+{
+    vectors.clear();
+    vectors.set_multi(1, {{8, 3}, {8, 4}, {9, 3}, {9, 4}}).set_multi(2, {{5, 5}})
+           .set_multi(3, {{0, 0}, {1, 0}});
+    multi_vector = true;
+    init(true);
+    for (uint32_t docid = 1; docid < 4; ++docid) {
+        add_document(docid);
+    }
+    std::vector<float> query = {8, 3};
+    vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+    // The 2 nearest nodes both belong to document 1.
+    auto result = index->find_top_k(2, qv, 2, 10000.0);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(1u, result[0].docid);
+    EXPECT_DOUBLE_EQ(0.0, result[0].distance);
+    EXPECT_EQ(2u, result[1].docid);
+    EXPECT_DOUBLE_EQ(13.0, result[1].distance);
+    // All documents are returned when there are fewer than k.
+    result = index->find_top_k(5, qv, 2, 10000.0);
+    ASSERT_EQ(3u, result.size());
+    EXPECT_EQ(3u, result[2].docid);
+    EXPECT_DOUBLE_EQ(58.0, result[2].distance);
+    // The distance threshold still applies.
+    result = index->find_top_k(5, qv, 2, 20.0);
+    EXPECT_EQ(2u, result.size());
+}
+
 TEST(LevelGeneratorTest, gives_various_levels)
 {
     InvLogLevelGenerator generator(4);
@@ -716,7 +1021,7 @@ public:
         level_generator->level = max_level;
         vespalib::GenerationHandler::Guard dummy;
         auto vector = vectors.get_vector(docid);
-        return index->prepare_add_document(docid, vector, dummy);
+        return index->prepare_add_document(docid, VectorBundle(vector), dummy);
     }
     void complete_add(uint32_t docid, UP up) {
         index->complete_add_document(docid, std::move(up));
@@ -177,7 +177,7 @@ public:
         }
         void run() override {
             auto v = vespalib::eval::TypedCells(vec);
-            auto up = parent.index->prepare_add_document(docid, v, read_guard);
+            auto up = parent.index->prepare_add_document(docid, VectorBundle(v), read_guard);
             result_promise.set_value(std::move(up));
         }
     };
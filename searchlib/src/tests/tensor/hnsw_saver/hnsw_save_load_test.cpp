@@ -3,9 +3,11 @@
 #include <vespa/searchlib/tensor/hnsw_graph.h>
 #include <vespa/searchlib/tensor/hnsw_index_saver.h>
 #include <vespa/searchlib/tensor/hnsw_index_loader.hpp>
+#include <vespa/searchlib/tensor/hnsw_nodeid_mapping.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
 #include <vector>
 
 #include <vespa/log/log.h>
@@ -112,14 +114,14 @@ public:
         }
     }
 
-    std::vector<char> save_original() const {
-        HnswIndexSaver saver(original);
+    std::vector<char> save_original(const HnswNodeidMapping* id_mapping = nullptr) const {
+        HnswIndexSaver saver(original, id_mapping);
         VectorBufferWriter vector_writer;
         saver.save(vector_writer);
         return vector_writer.output;
     }
-    void load_copy(std::vector<char> data) {
-        HnswIndexLoader<VectorBufferReader> loader(copy, std::make_unique<VectorBufferReader>(data));
+    void load_copy(std::vector<char> data, HnswNodeidMapping* id_mapping = nullptr) {
+        HnswIndexLoader<VectorBufferReader> loader(copy, std::make_unique<VectorBufferReader>(data), id_mapping);
         while (loader.load_next()) {}
     }
 
@@ -163,4 +165,46 @@ TEST_F(CopyGraphTest, later_changes_ignored)
     expect_copy_as_populated();
 }
 
+TEST_F(CopyGraphTest, reconstructs_nodeid_mapping)
+{
+    populate(original);
+    HnswNodeidMapping original_mapping;
+    original_mapping.allocate_ids(7, 2); // node ids 1 and 2
+    original_mapping.allocate_ids(3, 1); // node id 3
+    original_mapping.allocate_ids(8, 1); // node id 4
+    original_mapping.allocate_ids(5, 1); // node id 5
+    original_mapping.allocate_ids(9, 1); // node id 6
+    // Node ids 3 and 5 are not in the graph.
+    original_mapping.free_ids(3);
+    original_mapping.free_ids(5);
+    auto data = save_original(&original_mapping);
+    HnswNodeidMapping copy_mapping;
+    load_copy(data, &copy_mapping);
+    expect_copy_as_populated();
+
+    EXPECT_EQ(V({1, 2}), V(copy_mapping.get_ids(7).begin(), copy_mapping.get_ids(7).end()));
+    EXPECT_EQ(V({4}), V(copy_mapping.get_ids(8).begin(), copy_mapping.get_ids(8).end()));
+    EXPECT_EQ(V({6}), V(copy_mapping.get_ids(9).begin(), copy_mapping.get_ids(9).end()));
+    EXPECT_TRUE(copy_mapping.get_ids(3).empty());
+    EXPECT_EQ(7, copy_mapping.get_docid(2));
+    EXPECT_EQ(1, copy_mapping.get_subspace(2));
+    EXPECT_EQ(9, copy_mapping.get_docid(6));
+    EXPECT_EQ(0, copy_mapping.get_subspace(6));
+    // Node ids not in the graph are reused before new node ids are allocated.
+    auto ids = copy_mapping.allocate_ids(10, 3);
+    EXPECT_EQ(V({3, 5, 7}), V(ids.begin(), ids.end()));
+}
+
+TEST_F(CopyGraphTest, multi_vector_format_version_is_verified)
+{
+    populate(original);
+    HnswNodeidMapping original_mapping;
+    original_mapping.allocate_ids(1, 7);
+    auto data = save_original(&original_mapping);
+    uint32_t format_version = HnswIndexSaver::multi_vector_format_version + 1;
+    std::memcpy(data.data(), &format_version, sizeof(uint32_t));
+    HnswNodeidMapping copy_mapping;
+    EXPECT_THROW(load_copy(data, &copy_mapping), std::runtime_error);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,133 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
+#include <vespa/vespalib/datastore/compaction_strategy.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <limits>
+#include <vector>
+
+using search::attribute::DistanceMetric;
+using search::tensor::QuantizedVectorStore;
+using search::tensor::make_distance_function;
+using vespalib::GenerationHandler;
+using vespalib::datastore::CompactionStrategy;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+
+using FloatVector = std::vector<float>;
+
+TypedCells
+cells(const FloatVector& vector)
+{
+    return TypedCells(vespalib::ConstArrayRef<float>(vector));
+}
+
+class QuantizedVectorStoreTest : public ::testing::TestWithParam<DistanceMetric> {
+protected:
+    QuantizedVectorStore store;
+    GenerationHandler gen_handler;
+
+    QuantizedVectorStoreTest()
+        : store(GetParam(), 4),
+          gen_handler()
+    {
+    }
+    ~QuantizedVectorStoreTest() override;
+    void commit() {
+        store.transfer_hold_lists(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        gen_handler.updateFirstUsedGeneration();
+        store.trim_hold_lists(gen_handler.getFirstUsedGeneration());
+    }
+    double exact_distance(const FloatVector& lhs, const FloatVector& rhs) const {
+        auto func = make_distance_function(GetParam(), CellType::FLOAT);
+        return func->calc(cells(lhs), cells(rhs));
+    }
+    double approx_distance(const FloatVector& query, uint32_t docid) const {
+        return store.calc_distance(store.prepare_query(cells(query)), docid);
+    }
+};
+
+QuantizedVectorStoreTest::~QuantizedVectorStoreTest() = default;
+
+TEST_P(QuantizedVectorStoreTest, approximate_distance_is_close_to_exact_distance)
+{
+    FloatVector doc = {0.5, -0.25, 0.125, 1.0};
+    FloatVector query = {0.25, 0.5, -0.75, 0.5};
+    store.set_vector(1, cells(doc));
+    commit();
+    EXPECT_NEAR(exact_distance(query, doc), approx_distance(query, 1), 0.02);
+    EXPECT_NEAR(exact_distance(doc, doc), approx_distance(doc, 1), 0.02);
+}
+
+TEST_P(QuantizedVectorStoreTest, approximate_distance_preserves_ordering)
+{
+    FloatVector query = {1.0, 2.0, 3.0, 4.0};
+    FloatVector near = {1.1, 2.1, 2.9, 4.0};
+    FloatVector far = {-4.0, 3.0, -2.0, 1.0};
+    store.set_vector(1, cells(far));
+    store.set_vector(2, cells(near));
+    commit();
+    EXPECT_LT(approx_distance(query, 2), approx_distance(query, 1));
+}
+
+TEST_P(QuantizedVectorStoreTest, removed_vector_has_max_distance)
+{
+    FloatVector doc = {1.0, 2.0, 3.0, 4.0};
+    store.set_vector(1, cells(doc));
+    commit();
+    store.remove_vector(1);
+    commit();
+    EXPECT_EQ(std::numeric_limits<double>::max(), approx_distance(doc, 1));
+}
+
+TEST_P(QuantizedVectorStoreTest, memory_is_reused_when_vectors_are_replaced)
+{
+    FloatVector doc = {1.0, 2.0, 3.0, 4.0};
+    store.set_vector(1, cells(doc));
+    commit();
+    store.set_vector(1, cells(doc));
+    commit();
+    auto before = store.memory_usage();
+    for (uint32_t i = 0; i < 10; ++i) {
+        store.set_vector(1, cells(doc));
+        commit();
+    }
+    auto after = store.memory_usage();
+    EXPECT_EQ(before.usedBytes(), after.usedBytes());
+    EXPECT_EQ(0, after.allocatedBytesOnHold());
+}
+
+TEST_P(QuantizedVectorStoreTest, memory_from_removed_vectors_is_reclaimed_by_compaction)
+{
+    constexpr uint32_t num_docs = 20000;
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        store.set_vector(docid, cells({float(docid), 2.0, 3.0, 4.0}));
+    }
+    commit();
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        if ((docid % 10) != 0) {
+            store.remove_vector(docid);
+        }
+    }
+    commit();
+    FloatVector query = {10.0, 2.0, 3.0, 4.0};
+    double distance_before = approx_distance(query, 10);
+    auto before = store.update_stat(CompactionStrategy());
+    EXPECT_LT(0, store.address_space_usage().used());
+    EXPECT_TRUE(store.consider_compact());
+    commit();
+    EXPECT_FALSE(store.consider_compact());
+    auto after = store.update_stat(CompactionStrategy());
+    EXPECT_LT(after.usedBytes(), before.usedBytes());
+    EXPECT_LT(after.deadBytes(), before.deadBytes());
+    EXPECT_EQ(std::numeric_limits<double>::max(), approx_distance(query, 1));
+    EXPECT_EQ(distance_before, approx_distance(query, 10));
+}
+
+INSTANTIATE_TEST_SUITE_P(DistanceMetrics, QuantizedVectorStoreTest,
+                         ::testing::Values(DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct));
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -17,23 +17,38 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    // Whether an int8 quantized copy of the vectors is used for graph traversal.
+    bool _int8_quantization;
+    // Whether the link arrays of the graph are allocated using the (paged) memory allocator of the attribute.
+    bool _disk_resident;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false) noexcept
+                    bool multi_threaded_indexing_in = false,
+                    bool int8_quantization_in = false,
+                    bool disk_resident_in = false) noexcept
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _int8_quantization(int8_quantization_in),
+              _disk_resident(disk_resident_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
-
+    bool int8_quantization() const { return _int8_quantization; }
+    bool disk_resident() const { return _disk_resident; }
+
+    /**
+     * int8 quantization and disk resident mode are not compared, as they are applied when the index
+     * is instantiated on load (quantized vectors are built from the saved graph, and link arrays are
+     * loaded into the selected allocator) and do not require the graph to be rebuilt.
+     */
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
@@ -18,6 +18,8 @@ Status::Status()
       _onHold               (0),
       _onHoldMax            (0),
       _lastSyncToken        (0),
+      _compactions          (0),
+      _compactionTime       (0),
       _updates              (0),
       _nonIdempotentUpdates (0),
       _bitVectors(0)
@@ -35,6 +37,8 @@ Status::Status(const Status& rhs)
       _onHold(load_relaxed(rhs._onHold)),
       _onHoldMax(load_relaxed(rhs._onHoldMax)),
       _lastSyncToken(rhs.getLastSyncToken()),
+      _compactions(load_relaxed(rhs._compactions)),
+      _compactionTime(load_relaxed(rhs._compactionTime)),
       _updates(rhs._updates),
       _nonIdempotentUpdates(rhs._nonIdempotentUpdates),
       _bitVectors(rhs._bitVectors)
@@ -54,6 +58,8 @@ Status::operator=(const Status& rhs)
     store_relaxed(_onHold,          load_relaxed(rhs._onHold));
     store_relaxed(_onHoldMax,       load_relaxed(rhs._onHoldMax));
     setLastSyncToken(rhs.getLastSyncToken());
+    store_relaxed(_compactions,     load_relaxed(rhs._compactions));
+    store_relaxed(_compactionTime,  load_relaxed(rhs._compactionTime));
     _updates = rhs._updates;
     _nonIdempotentUpdates = rhs._nonIdempotentUpdates;
     _bitVectors = rhs._bitVectors;
@@ -83,4 +89,11 @@ Status::updateStatistics(uint64_t numValues, uint64_t numUniqueValue, uint64_t a
     store_relaxed(_onHoldMax,       std::max(load_relaxed(_onHoldMax), onHold));
 }
 
+void
+Status::addCompaction(vespalib::duration time)
+{
+    store_relaxed(_compactions,    load_relaxed(_compactions) + 1);
+    store_relaxed(_compactionTime, load_relaxed(_compactionTime) + time.count());
+}
+
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 
 namespace search::attribute {
@@ -30,6 +31,11 @@ public:
     uint64_t getUpdateCount()              const { return _updates; }
     uint64_t getNonIdempotentUpdateCount() const { return _nonIdempotentUpdates; }
     uint32_t getBitVectors() const { return _bitVectors; }
+    // Number of compaction steps performed by the writer thread, and the time spent on them.
+    uint64_t getCompactions()              const { return _compactions.load(std::memory_order_relaxed); }
+    vespalib::duration getCompactionTime() const {
+        return vespalib::duration(_compactionTime.load(std::memory_order_relaxed));
+    }
 
     void setNumDocs(uint64_t v)                  { _numDocs.store(v, std::memory_order_relaxed); }
     void incNumDocs()                            { _numDocs.store(_numDocs.load(std::memory_order_relaxed) + 1u,
@@ -39,6 +45,7 @@ public:
     void incNonIdempotentUpdates(uint64_t v = 1) { _nonIdempotentUpdates += v; }
     void incBitVectors() { ++_bitVectors; }
     void decBitVectors() { --_bitVectors; }
+    void addCompaction(vespalib::duration time);
 
     static vespalib::string
     createName(vespalib::stringref index, vespalib::stringref attr);
@@ -53,6 +60,8 @@ private:
     std::atomic<uint64_t> _onHold;
     std::atomic<uint64_t> _onHoldMax;
     std::atomic<uint64_t> _lastSyncToken;
+    std::atomic<uint64_t> _compactions;
+    std::atomic<vespalib::duration::rep> _compactionTime;
     uint64_t _updates;
     uint64_t _nonIdempotentUpdates;
     uint32_t _bitVectors;
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "schema.h"
+#include <algorithm>
 #include <fstream>
 #include <vespa/config/common/configparser.h>
 #include <vespa/vespalib/stllike/asciistream.h>
@@ -54,6 +55,20 @@ struct FieldName {
     }
 };
 
+std::vector<vespalib::string>
+sortedWords(std::vector<vespalib::string> words)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+bool
+containsWord(const std::vector<vespalib::string> &words, vespalib::stringref word)
+{
+    return std::binary_search(words.begin(), words.end(), word);
+}
+
 template <typename T>
 uint32_t
 getFieldId(vespalib::stringref name, const T &map)
@@ -127,7 +142,10 @@ Schema::Field::operator!=(const Field &rhs) const
 Schema::IndexField::IndexField(vespalib::stringref name, DataType dt) noexcept
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _phrase_bigrams(false),
+      _block_max(false),
+      _phrase_bigram_words()
 {
 }
 
@@ -135,14 +153,20 @@ Schema::IndexField::IndexField(vespalib::stringref name, DataType dt,
                                CollectionType ct) noexcept
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _phrase_bigrams(false),
+      _block_max(false),
+      _phrase_bigram_words()
 {
 }
 
 Schema::IndexField::IndexField(const config::StringVector &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _phrase_bigrams(ConfigParser::parse<bool>("phrasebigrams", lines, false)),
+      _block_max(ConfigParser::parse<bool>("blockmax", lines, false)),
+      _phrase_bigram_words(sortedWords(ConfigParser::parseArray<std::vector<vespalib::string>>("phrasebigramword", lines)))
 {
 }
 
@@ -151,12 +175,32 @@ Schema::IndexField & Schema::IndexField::operator = (const IndexField &) noexcep
 Schema::IndexField::IndexField(IndexField &&) noexcept = default;
 Schema::IndexField & Schema::IndexField::operator = (IndexField &&) noexcept = default;
 
+Schema::IndexField &
+Schema::IndexField::set_phrase_bigram_words(std::vector<vespalib::string> words)
+{
+    _phrase_bigram_words = sortedWords(std::move(words));
+    return *this;
+}
+
+bool
+Schema::IndexField::has_phrase_bigram(vespalib::stringref first, vespalib::stringref second) const
+{
+    return _phrase_bigrams &&
+           (containsWord(_phrase_bigram_words, first) || containsWord(_phrase_bigram_words, second));
+}
+
 void
 Schema::IndexField::write(vespalib::asciistream & os, vespalib::stringref prefix) const
 {
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "phrasebigrams " << (_phrase_bigrams ? "true" : "false") << "\n";
+    os << prefix << "blockmax " << (_block_max ? "true" : "false") << "\n";
+    os << prefix << "phrasebigramword[" << _phrase_bigram_words.size() << "]\n";
+    for (size_t i = 0; i < _phrase_bigram_words.size(); ++i) {
+        os << prefix << "phrasebigramword[" << i << "] \"" << _phrase_bigram_words[i] << "\"\n";
+    }
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -169,7 +213,10 @@ Schema::IndexField::operator==(const IndexField &rhs) const
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _phrase_bigrams == rhs._phrase_bigrams &&
+            _block_max == rhs._block_max &&
+            _phrase_bigram_words == rhs._phrase_bigram_words;
 }
 
 bool
@@ -177,7 +224,10 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _phrase_bigrams != rhs._phrase_bigrams ||
+            _block_max != rhs._block_max ||
+            _phrase_bigram_words != rhs._phrase_bigram_words;
 }
 
 Schema::FieldSet::FieldSet(const config::StringVector & lines) :
@@ -79,6 +79,9 @@ public:
         uint32_t _avgElemLen;
         // TODO: Remove when posting list format with interleaved features is made default
         bool _interleaved_features;
+        bool _phrase_bigrams;
+        bool _block_max;
+        std::vector<vespalib::string> _phrase_bigram_words;
 
     public:
         IndexField(vespalib::stringref name, DataType dt) noexcept;
@@ -97,12 +100,39 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_phrase_bigrams(bool value) {
+            _phrase_bigrams = value;
+            return *this;
+        }
+        IndexField &set_block_max(bool value) {
+            _block_max = value;
+            return *this;
+        }
+        IndexField &set_phrase_bigram_words(std::vector<vespalib::string> words);
 
         void write(vespalib::asciistream &os,
                    vespalib::stringref prefix) const override;
 
         uint32_t getAvgElemLen() const { return _avgElemLen; }
         bool use_interleaved_features() const { return _interleaved_features; }
+        /**
+         * Whether adjacent word pairs are indexed as extra words, to speed up phrase search.
+         **/
+        bool use_phrase_bigrams() const { return _phrase_bigrams; }
+        /**
+         * The sorted set of common words selecting which adjacent word pairs are indexed.
+         **/
+        const std::vector<vespalib::string> &get_phrase_bigram_words() const { return _phrase_bigram_words; }
+        /**
+         * Whether the word pair (first, second) is indexed as a phrase bigram,
+         * i.e. phrase bigrams are used and one of the words is a common word.
+         **/
+        bool has_phrase_bigram(vespalib::stringref first, vespalib::stringref second) const;
+        /**
+         * Whether L1 skip entries store max num occs and min field length
+         * for their block. Only used with interleaved features.
+         **/
+        bool use_block_max() const { return _interleaved_features && _block_max; }
 
         bool operator==(const IndexField &rhs) const;
         bool operator!=(const IndexField &rhs) const;
@@ -277,6 +307,12 @@ public:
         return _indexFields[fieldId];
     }
 
+    IndexField &
+    getIndexField(uint32_t fieldId)
+    {
+        return _indexFields[fieldId];
+    }
+
     /**
      * Returns const view of the index fields.
      */
@@ -144,7 +144,10 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
         schema.addIndexField(Schema::IndexField(f.name, convertIndexDataType(f.datatype),
                                                 convertIndexCollectionType(f.collectiontype)).
                 setAvgElemLen(f.averageelementlen).
-                set_interleaved_features(f.interleavedfeatures));
+                set_interleaved_features(f.interleavedfeatures).
+                set_phrase_bigrams(f.phrasebigrams).
+                set_block_max(f.blockmax).
+                set_phrase_bigram_words(f.phrasebigramword));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset &fs = cfg.fieldset[i];
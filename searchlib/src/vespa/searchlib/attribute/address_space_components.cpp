@@ -21,5 +21,6 @@ const vespalib::string AddressSpaceComponents::tensor_store = "tensor-store";
 const vespalib::string AddressSpaceComponents::shared_string_repo = "shared-string-repo";
 const vespalib::string AddressSpaceComponents::hnsw_node_store = "hnsw-node-store";
 const vespalib::string AddressSpaceComponents::hnsw_link_store = "hnsw-link-store";
+const vespalib::string AddressSpaceComponents::hnsw_quantized_vector_store = "hnsw-quantized-vector-store";
 
 }
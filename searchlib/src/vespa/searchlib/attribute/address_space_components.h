@@ -20,6 +20,7 @@ public:
     static const vespalib::string shared_string_repo;
     static const vespalib::string hnsw_node_store;
     static const vespalib::string hnsw_link_store;
+    static const vespalib::string hnsw_quantized_vector_store;
 };
 
 }
@@ -33,6 +33,7 @@
 #include <vespa/searchlib/queryeval/wand/parallel_weak_and_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_search.h>
+#include <vespa/searchlib/queryeval/windowed_weighted_search.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/vespalib/util/regexp.h>
@@ -67,6 +68,7 @@ using search::queryeval::AndBlueprint;
 using search::queryeval::AndSearchStrict;
 using search::queryeval::Blueprint;
 using search::queryeval::ComplexLeafBlueprint;
+using search::queryeval::CostModel;
 using search::queryeval::CreateBlueprintVisitorHelper;
 using search::queryeval::DotProductBlueprint;
 using search::queryeval::FieldSpec;
@@ -126,6 +128,12 @@ private:
         uint32_t estHits = _search_context->approximateHits();
         HitEstimate estimate(estHits, estHits == 0);
         setEstimate(estimate);
+        if (attribute.getIsFastSearch()) {
+            set_cost(CostModel::attribute_posting_seek_cost, CostModel::attribute_posting_next_cost);
+        } else {
+            // no posting lists; strict evaluation scans all documents
+            set_scan_cost(CostModel::attribute_seek_cost);
+        }
     }
 
     AttributeFieldBlueprint(const FieldSpec &field, const IAttributeVector &attribute,
@@ -420,7 +428,7 @@ public:
 
 template <typename SearchType>
 SearchIterator::UP
-DirectWeightedSetBlueprint<SearchType>::createLeafSearch(const TermFieldMatchDataArray &tfmda, bool) const
+DirectWeightedSetBlueprint<SearchType>::createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const
 {
     assert(tfmda.size() == 1);
     assert(getState().numFields() == 1);
@@ -434,6 +442,13 @@ DirectWeightedSetBlueprint<SearchType>::createLeafSearch(const TermFieldMatchDat
         _attr.create(r.posting_idx, iterators);
     }
     bool field_is_filter = getState().fields()[0].isFilter();
+    if (strict && queryeval::WindowedWeightedSearch::should_use(numChildren, _estimate.estHits, get_docid_limit())) {
+        if constexpr (std::is_same_v<SearchType, queryeval::DotProductSearch>) {
+            return queryeval::WindowedWeightedSearch::create_dot_product(*tfmda[0], field_is_filter, _weights, std::move(iterators));
+        } else {
+            return queryeval::WindowedWeightedSearch::create_weighted_set(*tfmda[0], field_is_filter, _weights, std::move(iterators));
+        }
+    }
     return SearchType::create(*tfmda[0], field_is_filter, _weights, std::move(iterators));
 }
 
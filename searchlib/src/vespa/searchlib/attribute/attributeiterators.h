@@ -4,6 +4,7 @@
 
 #include "dociditerator.h"
 #include "postinglisttraits.h"
+#include <vespa/searchlib/queryeval/idocid_block_search.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchcommon/attribute/i_search_context.h>
@@ -175,7 +176,8 @@ public:
  *
  * @param PL the posting list iterator type to work as an iterator over
  */
-class AttributePostingListIterator : public AttributeIteratorBase
+class AttributePostingListIterator : public AttributeIteratorBase,
+                                     public queryeval::IDocidBlockSearch
 {
 public:
     AttributePostingListIterator(const attribute::ISearchContext &baseSearchCtx,
@@ -189,7 +191,8 @@ protected:
 };
 
 
-class FilterAttributePostingListIterator : public AttributeIteratorBase
+class FilterAttributePostingListIterator : public AttributeIteratorBase,
+                                           public queryeval::IDocidBlockSearch
 {
 public:
     FilterAttributePostingListIterator(const attribute::ISearchContext &baseSearchCtx, fef::TermFieldMatchData *matchData)
@@ -226,6 +229,7 @@ private:
     void and_hits_into(BitVector &result, uint32_t begin_id) override;
 
 public:
+    uint32_t fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids) override;
     template <typename... Args>
     AttributePostingListIteratorT(const attribute::ISearchContext &baseSearchCtx,
                                   bool hasWeight, fef::TermFieldMatchData *matchData,
@@ -242,6 +246,7 @@ public:
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
     void or_hits_into(BitVector &result, uint32_t begin_id) override;
     void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    uint32_t fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids) override;
 
 private:
     queryeval::MinMaxPostingInfo           _postingInfo;
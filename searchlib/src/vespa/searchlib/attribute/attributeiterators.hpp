@@ -18,11 +18,47 @@ bool matches(const SC & sc, uint32_t doc) {
     return sc.find(doc, 0) >= 0;
 }
 
+/*
+ * Search contexts that can evaluate many documents at a time provide
+ * or_hits_into(result, begin_id, end_id) and find_next_hit(docid, end_id).
+ */
+template <typename SC, typename = std::void_t<>>
+struct has_bulk_hits : std::false_type {};
+
+template <typename SC>
+struct has_bulk_hits<SC, std::void_t<decltype(std::declval<const SC &>().find_next_hit(0u, 0u))>> : std::true_type {};
+
+template <typename SC>
+inline constexpr bool has_bulk_hits_v = has_bulk_hits<SC>::value;
+
+template <typename PL>
+uint32_t fetch_posting_docids(PL & iterator, uint32_t end_id, uint32_t *dst, uint32_t max_docids) {
+    uint32_t num = 0;
+    while (num < max_docids && iterator.valid() && iterator.getKey() < end_id) {
+        dst[num++] = iterator.getKey();
+        ++iterator;
+    }
+    return num;
+}
+
 }
 
 template <typename SC>
 void
 AttributeIteratorBase::and_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
+    if constexpr (has_bulk_hits_v<SC>) {
+        // The hits must cover the start of result. Bits before begin_id are kept, as below.
+        uint32_t start_id = result.getStartIndex();
+        uint32_t end_id = std::max(getEndId(), start_id);
+        begin_id = std::min(std::max(begin_id, start_id), end_id);
+        BitVector::UP hits = BitVector::create(start_id, end_id);
+        if (start_id < begin_id) {
+            hits->setInterval(start_id, begin_id);
+        }
+        sc.or_hits_into(*hits, begin_id, end_id);
+        result.andWith(*hits);
+        return;
+    }
     result.foreach_truebit([&](uint32_t key) { if ( ! matches(sc, key)) { result.clearBit(key); }}, begin_id);
     result.invalidateCachedCount();
 }
@@ -30,6 +66,10 @@ AttributeIteratorBase::and_hits_into(const SC & sc, BitVector & result, uint32_t
 template <typename SC>
 void
 AttributeIteratorBase::or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
+    if constexpr (has_bulk_hits_v<SC>) {
+        sc.or_hits_into(result, begin_id, std::min(getEndId(), result.size()));
+        return;
+    }
     result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
     result.invalidateCachedCount();
 }
@@ -39,6 +79,10 @@ template <typename SC>
 std::unique_ptr<BitVector>
 AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
     BitVector::UP result = BitVector::create(begin_id, getEndId());
+    if constexpr (has_bulk_hits_v<SC>) {
+        sc.or_hits_into(*result, std::max(begin_id, getDocId()), getEndId());
+        return result;
+    }
     for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
         if (matches(sc, docId)) {
             result->setBit(docId);
@@ -110,6 +154,38 @@ AttributePostingListIteratorT<PL>::doSeek(uint32_t docId)
     }
 }
 
+template <typename PL>
+uint32_t
+AttributePostingListIteratorT<PL>::fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids)
+{
+    if (isAtEnd()) {
+        return 0;
+    }
+    uint32_t num = fetch_posting_docids(_iterator, std::min(end_id, getEndId()), dst, max_docids);
+    if (_iterator.valid() && !isAtEnd(_iterator.getKey())) {
+        setDocId(_iterator.getKey());
+    } else {
+        setAtEnd();
+    }
+    return num;
+}
+
+template <typename PL>
+uint32_t
+FilterAttributePostingListIteratorT<PL>::fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids)
+{
+    if (isAtEnd()) {
+        return 0;
+    }
+    uint32_t num = fetch_posting_docids(_iterator, std::min(end_id, getEndId()), dst, max_docids);
+    if (_iterator.valid() && !isAtEnd(_iterator.getKey())) {
+        setDocId(_iterator.getKey());
+    } else {
+        setAtEnd();
+    }
+    return num;
+}
+
 namespace {
 
 template <typename> struct is_tree_iterator;
@@ -429,6 +505,21 @@ template <typename SC>
 void
 AttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
+    if constexpr (has_bulk_hits_v<SC>) {
+        // check the first document on its own, as dense hits are common
+        if (!isAtEnd(docId) && !this->matches(docId, _weight)) {
+            docId = _concreteSearchCtx.find_next_hit(docId + 1, this->getEndId());
+            if (!isAtEnd(docId)) {
+                this->matches(docId, _weight);
+            }
+        }
+        if (isAtEnd(docId)) {
+            setAtEnd();
+        } else {
+            setDocId(docId);
+        }
+        return;
+    }
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
         if (this->matches(nextId, _weight)) {
             setDocId(nextId);
@@ -442,6 +533,17 @@ template <typename SC>
 void
 FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
+    if constexpr (has_bulk_hits_v<SC>) {
+        if (!isAtEnd(docId) && !this->matches(docId)) {
+            docId = _concreteSearchCtx.find_next_hit(docId + 1, this->getEndId());
+        }
+        if (isAtEnd(docId)) {
+            setAtEnd();
+        } else {
+            setDocId(docId);
+        }
+        return;
+    }
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
         if (this->matches(nextId)) {
             setDocId(nextId);
@@ -191,6 +191,14 @@ AttributeVector::incGeneration()
     removeAllOldGenerations();
 }
 
+void
+AttributeVector::finish_compaction_step(vespalib::steady_time compaction_start)
+{
+    incGeneration();
+    _status.addCompaction(vespalib::steady_clock::now() - compaction_start);
+    updateStat(true);
+}
+
 void
 AttributeVector::updateStatistics(uint64_t numValues, uint64_t numUniqueValue, uint64_t allocated,
                                   uint64_t used, uint64_t dead, uint64_t onHold)
@@ -565,6 +573,31 @@ AttributeVector::onInitSave(vespalib::stringref)
     return std::unique_ptr<AttributeSaver>();
 }
 
+uint64_t
+AttributeVector::getDeltaSaveBaseSerialNum() const
+{
+    return 0;
+}
+
+uint64_t
+AttributeVector::getEstimatedDeltaSaveByteSize() const
+{
+    return getEstimatedSaveByteSize();
+}
+
+std::unique_ptr<AttributeSaver>
+AttributeVector::initDeltaSave(vespalib::stringref fileName)
+{
+    commit();
+    return onInitDeltaSave(fileName);
+}
+
+std::unique_ptr<AttributeSaver>
+AttributeVector::onInitDeltaSave(vespalib::stringref)
+{
+    return std::unique_ptr<AttributeSaver>();
+}
+
 bool
 AttributeVector::hasActiveEnumGuards()
 {
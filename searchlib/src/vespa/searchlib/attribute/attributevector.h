@@ -126,6 +126,20 @@ protected:
 
     void performCompactionWarning();
 
+    /**
+     * Called from onCommit() when a compaction step has been performed.
+     * Bumps the generation, updates statistics and accounts the time
+     * spent since compaction_start as compaction time on the write path.
+     *
+     * At most one compaction step should be performed per commit, so a
+     * commit never stalls feed for several steps back to back. Remaining
+     * compaction is considered again by later commits. A single step is
+     * not split up: it still moves all live entries of the buffers
+     * selected by the compaction strategy, so the latency of one step is
+     * the same as before.
+     */
+    void finish_compaction_step(vespalib::steady_time compaction_start);
+
     AttributeVector(vespalib::stringref baseFileName, const Config & c);
 
     void checkSetMaxValueCount(int index) {
@@ -502,6 +516,18 @@ public:
     virtual std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName);
     virtual uint64_t getEstimatedSaveByteSize() const;
 
+    /**
+     * Delta save support. An attribute vector supporting it tracks the
+     * documents changed since it was loaded from or fully saved to its base
+     * data file, and can save only those documents. The base data file is
+     * identified by the serial number it was saved at, 0 means that delta
+     * save is not possible.
+     */
+    virtual uint64_t getDeltaSaveBaseSerialNum() const;
+    virtual uint64_t getEstimatedDeltaSaveByteSize() const;
+    std::unique_ptr<AttributeSaver> initDeltaSave(vespalib::stringref fileName);
+    virtual std::unique_ptr<AttributeSaver> onInitDeltaSave(vespalib::stringref fileName);
+
     static bool isEnumerated(const vespalib::GenericHeader &header);
 
     virtual vespalib::MemoryUsage getChangeVectorMemoryUsage() const;
@@ -0,0 +1,39 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "changed_docs_tracker.h"
+#include <algorithm>
+
+namespace search::attribute {
+
+ChangedDocsTracker::ChangedDocsTracker() noexcept
+    : _changed(),
+      _num_changed(0),
+      _base_serial_num(0)
+{
+}
+
+ChangedDocsTracker::~ChangedDocsTracker() = default;
+
+void
+ChangedDocsTracker::reset(uint64_t base_serial_num)
+{
+    std::vector<bool>().swap(_changed);
+    _num_changed.store(0, std::memory_order_relaxed);
+    _base_serial_num.store(base_serial_num, std::memory_order_relaxed);
+}
+
+std::vector<uint32_t>
+ChangedDocsTracker::changed_docs(uint32_t doc_id_limit) const
+{
+    std::vector<uint32_t> result;
+    result.reserve(num_changed());
+    uint32_t end = std::min(doc_id_limit, uint32_t(_changed.size()));
+    for (uint32_t docid = 0; docid < end; ++docid) {
+        if (_changed[docid]) {
+            result.push_back(docid);
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,55 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search::attribute {
+
+/*
+ * Tracks which documents have changed since an attribute vector was
+ * loaded from or fully saved to its base data file, to support saving only
+ * the changed documents (delta save).
+ *
+ * Tracking is only active when the serial number of the base data file is
+ * known. Changes are tracked by the attribute write thread, while the
+ * number of changes and the base serial number can be read by any thread.
+ */
+class ChangedDocsTracker {
+    std::vector<bool>     _changed;
+    std::atomic<uint32_t> _num_changed;
+    std::atomic<uint64_t> _base_serial_num;
+
+public:
+    ChangedDocsTracker() noexcept;
+    ~ChangedDocsTracker();
+
+    /*
+     * Forget all changes and start tracking changes relative to the base
+     * data file saved at the given serial number (0 disables tracking).
+     */
+    void reset(uint64_t base_serial_num);
+
+    void mark_changed(uint32_t docid) {
+        if (_base_serial_num.load(std::memory_order_relaxed) != 0) {
+            if (docid >= _changed.size()) {
+                _changed.resize(docid + 1);
+            }
+            if (!_changed[docid]) {
+                _changed[docid] = true;
+                _num_changed.store(_num_changed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    uint64_t base_serial_num() const noexcept { return _base_serial_num.load(std::memory_order_relaxed); }
+    uint32_t num_changed() const noexcept { return _num_changed.load(std::memory_order_relaxed); }
+    // changed documents below doc_id_limit, in increasing order
+    std::vector<uint32_t> changed_docs(uint32_t doc_id_limit) const;
+    size_t memory_usage() const noexcept { return _changed.capacity() / 8; }
+};
+
+}
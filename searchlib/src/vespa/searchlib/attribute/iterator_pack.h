@@ -26,6 +26,11 @@ public:
         return _children[ref].valid() ? _children[ref].getKey() : endDocId;
     }
 
+    uint32_t next(uint16_t ref) {
+        ++_children[ref];
+        return get_docid(ref);
+    }
+
     uint32_t seek(uint16_t ref, uint32_t docid) {
         _children[ref].linearSeek(docid);
         if (__builtin_expect(_children[ref].valid(), true)) {
@@ -48,11 +53,6 @@ public:
             child.lower_bound(begin);
         }
     }
-private:
-    uint32_t next(uint16_t ref) {
-        ++_children[ref];
-        return get_docid(ref);
-    }
 };
 
 
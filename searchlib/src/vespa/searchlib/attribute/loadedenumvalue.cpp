@@ -2,19 +2,98 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+
+using vespalib::CpuUsage;
 
 namespace search::attribute {
 
+namespace {
+
+// Smallest number of loaded values worth sorting as a separate task.
+constexpr size_t min_partition_size = 256_Ki;
+constexpr uint32_t max_partitions = 64;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sort_range(LoadedEnumAttribute *values, size_t num_values)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   loaded.data(), loaded.size(), 16);
+                   values, num_values, 16);
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+{
+    sort_range(loaded.data(), loaded.size());
 }
 
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, uint32_t num_enums, vespalib::Executor *executor)
+{
+    size_t num_values = loaded.size();
+    uint32_t num_partitions = std::min(size_t(max_partitions), num_values / min_partition_size);
+    if (executor == nullptr || num_partitions < 2 || num_enums < 2) {
+        sortLoadedByEnum(loaded);
+        return;
+    }
+    // Assign consecutive enum value ranges with roughly the same number of values to each partition.
+    std::vector<uint32_t> enum_to_partition(num_enums, 0);
+    for (const auto &elem : loaded) {
+        assert(elem.getEnum() < num_enums);
+        ++enum_to_partition[elem.getEnum()];
+    }
+    std::vector<size_t> partition_start(num_partitions + 1, 0);
+    size_t values_before = 0;
+    for (auto &entry : enum_to_partition) {
+        // Enum values without references after the last referenced one would otherwise get partition num_partitions.
+        uint32_t partition = std::min(uint32_t((values_before * num_partitions) / num_values), num_partitions - 1);
+        values_before += entry;
+        partition_start[partition + 1] += entry;
+        entry = partition;
+    }
+    for (uint32_t partition = 0; partition < num_partitions; ++partition) {
+        partition_start[partition + 1] += partition_start[partition];
+    }
+    // Move values into their partitions in place, one permutation cycle at a time.
+    std::vector<size_t> next(partition_start.begin(), partition_start.end() - 1);
+    for (uint32_t partition = 0; partition < num_partitions; ++partition) {
+        while (next[partition] < partition_start[partition + 1]) {
+            LoadedEnumAttribute value = loaded[next[partition]];
+            uint32_t dest = enum_to_partition[value.getEnum()];
+            while (dest != partition) {
+                std::swap(value, loaded[next[dest]++]);
+                dest = enum_to_partition[value.getEnum()];
+            }
+            loaded[next[partition]++] = value;
+        }
+    }
+    std::vector<uint32_t>().swap(enum_to_partition);
+    // Sort the partitions in parallel, the last one in this thread.
+    vespalib::CountDownLatch latch(num_partitions - 1);
+    for (uint32_t partition = 0; partition + 1 < num_partitions; ++partition) {
+        LoadedEnumAttribute *values = loaded.data() + partition_start[partition];
+        size_t partition_size = partition_start[partition + 1] - partition_start[partition];
+        auto task = vespalib::makeLambdaTask([values, partition_size, &latch]() {
+            sort_range(values, partition_size);
+            latch.countDown();
+        });
+        auto rejected = executor->execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    sort_range(loaded.data() + partition_start[num_partitions - 1], num_values - partition_start[num_partitions - 1]);
+    latch.await();
 }
 
+}
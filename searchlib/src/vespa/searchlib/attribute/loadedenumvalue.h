@@ -7,6 +7,8 @@
 #include <cassert>
 #include <limits>
 
+namespace vespalib { class Executor; }
+
 namespace search::attribute {
 
 /**
@@ -139,4 +141,11 @@ public:
 
 void sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
 
+/*
+ * Sort loaded enumerated values by enum value and docid, using the given
+ * executor (if any) to sort disjoint enum value ranges in parallel.
+ * All enum values must be less than num_enums.
+ */
+void sortLoadedByEnum(LoadedEnumAttributeVector &loaded, uint32_t num_enums, vespalib::Executor *executor);
+
 }
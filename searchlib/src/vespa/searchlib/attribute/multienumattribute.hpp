@@ -148,31 +148,32 @@ MultiValueEnumAttribute<B, M>::onCommit()
     this->freezeEnumDictionary();
     std::atomic_thread_fence(std::memory_order_release);
     this->removeAllOldGenerations();
+    // At most one compaction step per commit, see AttributeVector::finish_compaction_step()
+    auto compaction_start = vespalib::steady_clock::now();
     if (this->_mvMapping.considerCompact(this->getConfig().getCompactionStrategy())) {
-        this->incGeneration();
-        this->updateStat(true);
+        this->finish_compaction_step(compaction_start);
+        return;
     }
     auto remapper = this->_enumStore.consider_compact_values(this->getConfig().getCompactionStrategy());
     if (remapper) {
         multienumattribute::remap_enum_store_refs(*remapper, *this, this->_mvMapping);
         remapper->done();
         remapper.reset();
-        this->incGeneration();
-        this->updateStat(true);
+        this->finish_compaction_step(compaction_start);
+        return;
     }
     if (this->_enumStore.consider_compact_dictionary(this->getConfig().getCompactionStrategy())) {
-        this->incGeneration();
-        this->updateStat(true);
+        this->finish_compaction_step(compaction_start);
+        return;
     }
     auto *pab = this->getIPostingListAttributeBase();
     if (pab != nullptr) {
         if (pab->consider_compact_worst_btree_nodes(this->getConfig().getCompactionStrategy())) {
-            this->incGeneration();
-            this->updateStat(true);
+            this->finish_compaction_step(compaction_start);
+            return;
         }
         if (pab->consider_compact_worst_buffers(this->getConfig().getCompactionStrategy())) {
-            this->incGeneration();
-            this->updateStat(true);
+            this->finish_compaction_step(compaction_start);
         }
     }
 }
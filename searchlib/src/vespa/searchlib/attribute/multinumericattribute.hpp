@@ -66,9 +66,9 @@ MultiValueNumericAttribute<B, M>::onCommit()
     this->removeAllOldGenerations();
 
     this->_changes.clear();
+    auto compaction_start = vespalib::steady_clock::now();
     if (this->_mvMapping.considerCompact(this->getConfig().getCompactionStrategy())) {
-        this->incGeneration();
-        this->updateStat(true);
+        this->finish_compaction_step(compaction_start);
     }
 }
 
@@ -0,0 +1,68 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/util/optimized.h>
+#include <algorithm>
+
+namespace search::attribute {
+
+/*
+ * Helpers for evaluating a query term on a single value numeric attribute
+ * by comparing the values of many documents at a time instead of calling
+ * find() per document.
+ *
+ * The scanner is called as scanner(begin_id, num_docs, dest) and must set
+ * bit i (bit i%64 of dest[i/64]) for each matching document begin_id + i,
+ * keeping the other bits in dest.
+ */
+template <typename Scanner>
+void
+or_scanned_hits_into(const Scanner &scanner, BitVector &result, uint32_t begin_id, uint32_t end_id)
+{
+    constexpr uint32_t word_bits = 64;
+    if (begin_id >= end_id) {
+        return;
+    }
+    uint32_t aligned_id = std::min(end_id, (begin_id + word_bits - 1) & ~(word_bits - 1));
+    if (begin_id < aligned_id) {
+        uint64_t bits = 0;
+        scanner(begin_id, aligned_id - begin_id, &bits);
+        for (; bits != 0; bits &= (bits - 1)) {
+            result.setBit(begin_id + vespalib::Optimized::lsbIdx(bits));
+        }
+    }
+    if (aligned_id < end_id) {
+        // the remaining words are updated in place
+        scanner(aligned_id, end_id - aligned_id, static_cast<uint64_t *>(result.getStart()) + aligned_id / word_bits);
+    }
+    result.invalidateCachedCount();
+}
+
+/*
+ * Returns the first matching document in [docid, end_id), or end_id if
+ * there is none. Starts with scanning a single word, as the next hit is
+ * often close, and then doubles the number of words scanned at a time.
+ */
+template <typename Scanner>
+uint32_t
+find_next_scanned_hit(const Scanner &scanner, uint32_t docid, uint32_t end_id)
+{
+    constexpr uint32_t max_chunk_words = 16;
+    uint64_t bits[max_chunk_words];
+    for (uint32_t chunk_words = 1; docid < end_id; chunk_words = std::min(chunk_words * 2, max_chunk_words)) {
+        uint32_t chunk_docs = std::min(end_id - docid, chunk_words * 64);
+        std::fill(bits, bits + chunk_words, 0);
+        scanner(docid, chunk_docs, bits);
+        for (uint32_t i = 0; i < chunk_words; ++i) {
+            if (bits[i] != 0) {
+                return docid + i * 64 + vespalib::Optimized::lsbIdx(bits[i]);
+            }
+        }
+        docid += chunk_docs;
+    }
+    return end_id;
+}
+
+}
@@ -22,6 +22,9 @@ protected:
     NumericMatcher(const QueryTermSimple& queryTerm, bool avoidUndefinedInRange);
     bool isValid() const { return _valid; }
     bool match(T v) const { return v == _value; }
+    // closed interval of matching values, used when scanning many values at a time
+    T getLow() const { return _value; }
+    T getHigh() const { return _value; }
     Int64Range getRange() const {
         return Int64Range(static_cast<int64_t>(_value));
     }
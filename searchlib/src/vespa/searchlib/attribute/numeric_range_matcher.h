@@ -31,6 +31,9 @@ protected:
     }
     bool isValid() const { return _valid; }
     bool match(T v) const { return (_low <= v) && (v <= _high); }
+    // closed interval of matching values, used when scanning many values at a time
+    T getLow() const { return _low; }
+    T getHigh() const { return _high; }
     int getRangeLimit() const { return _limit; }
     size_t getMaxPerGroup() const { return _max_per_group; }
 
@@ -61,6 +61,14 @@ protected:
         (void) it;
         return true;
     }
+    /**
+     * Step past a dictionary entry rejected by useThis(). The iterator
+     * might be moved further ahead, past entries that can not be used
+     * either, but never beyond _upperDictItr.
+     */
+    virtual void skipUnused(DictionaryConstIterator & it) const {
+        ++it;
+    }
 
     float calculateFilteringCost() const {
         // filtering search time (ms) ~ FSTC * numValues; (FSTC =
@@ -183,6 +191,7 @@ private:
     using RegexpUtil = vespalib::RegexpUtil;
     using Parent::_enumStore;
     bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override;
+    void skipUnused(PostingListSearchContext::DictionaryConstIterator & it) const override;
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
 };
@@ -306,6 +315,30 @@ StringPostingSearchContext<BaseSC, AttrT, DataT>::useThis(const PostingListSearc
     return true;
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+void
+StringPostingSearchContext<BaseSC, AttrT, DataT>::skipUnused(PostingListSearchContext::DictionaryConstIterator & it) const {
+    const auto &fuzzy = this->getFuzzyMatcher();
+    // The lowercased successor can only be used to seek when the dictionary
+    // is ordered by folded values alone.
+    if (!this->isFuzzy() || !fuzzy.hasSuccessor() || fuzzy.is_cased() || !_enumStore.is_folded()) {
+        ++it;
+        return;
+    }
+    vespalib::string successor;
+    if (fuzzy.matchOrSuccessor(_enumStore.get_value(it.getKey().load_acquire()), successor)) {
+        ++it;
+    } else if (successor.empty()) {
+        it = this->_upperDictItr;
+    } else {
+        auto comp = _enumStore.make_folded_comparator(successor.c_str());
+        it.seek(vespalib::datastore::AtomicEntryRef(), comp);
+        if (!it.valid() || (this->_upperDictItr.valid() && (it.position() >= this->_upperDictItr.position()))) {
+            it = this->_upperDictItr;
+        }
+    }
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 NumericPostingSearchContext<BaseSC, AttrT, DataT>::
 NumericPostingSearchContext(BaseSC&& base_sc, const Params & params_in, const AttrT &toBeSearched)
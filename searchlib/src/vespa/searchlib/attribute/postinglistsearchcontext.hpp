@@ -64,9 +64,12 @@ size_t
 PostingListSearchContextT<DataT>::countHits() const
 {
     size_t sum(0);
-    for (auto it(_lowerDictItr); it != _upperDictItr; ++it) {
+    for (auto it(_lowerDictItr); it != _upperDictItr; ) {
         if (useThis(it)) {
             sum += _postingList.frozenSize(it.getData().load_acquire());
+            ++it;
+        } else {
+            skipUnused(it);
         }
     }
     return sum;
@@ -77,10 +80,13 @@ template <typename DataT>
 void
 PostingListSearchContextT<DataT>::fillArray()
 {
-    for (auto it(_lowerDictItr); it != _upperDictItr; ++it) {
+    for (auto it(_lowerDictItr); it != _upperDictItr; ) {
         if (useThis(it)) {
             _merger.addToArray(PostingListTraverser<PostingList>(_postingList,
                                                                  it.getData().load_acquire()));
+            ++it;
+        } else {
+            skipUnused(it);
         }
     }
     _merger.merge();
@@ -91,10 +97,13 @@ template <typename DataT>
 void
 PostingListSearchContextT<DataT>::fillBitVector()
 {
-    for (auto it(_lowerDictItr); it != _upperDictItr; ++it) {
+    for (auto it(_lowerDictItr); it != _upperDictItr; ) {
         if (useThis(it)) {
             _merger.addToBitVector(PostingListTraverser<PostingList>(_postingList,
                                                                      it.getData().load_acquire()));
+            ++it;
+        } else {
+            skipUnused(it);
         }
     }
 }
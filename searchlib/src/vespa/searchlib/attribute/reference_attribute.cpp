@@ -183,13 +183,14 @@ ReferenceAttribute::onCommit()
 {
     // Note: Cost can be reduced if unneeded generation increments are dropped
     incGeneration();
+    // At most one compaction step per commit, see AttributeVector::finish_compaction_step()
+    auto compaction_start = vespalib::steady_clock::now();
     if (consider_compact_values(getConfig().getCompactionStrategy())) {
-        incGeneration();
-        updateStat(true);
+        finish_compaction_step(compaction_start);
+        return;
     }
     if (consider_compact_dictionary(getConfig().getCompactionStrategy())) {
-        incGeneration();
-        updateStat(true);
+        finish_compaction_step(compaction_start);
     }
 }
 
@@ -300,7 +301,7 @@ ReferenceAttribute::getReference(DocId doc) const
 bool
 ReferenceAttribute::consider_compact_values(const CompactionStrategy &compactionStrategy)
 {
-    if (_compaction_spec.values()) {
+    if (!_store.get_data_store().has_held_buffers() && _compaction_spec.values()) {
         compact_worst_values(compactionStrategy);
         return true;
     }
@@ -0,0 +1,51 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "iattributesavetarget.h"
+#include "single_numeric_delta_attribute_saver.h"
+#include <vespa/searchlib/util/file_settings.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <cassert>
+#include <cstring>
+
+namespace search {
+
+SingleValueNumericDeltaAttributeSaver::
+SingleValueNumericDeltaAttributeSaver(const attribute::AttributeHeader &header,
+                                      const std::vector<uint32_t> &docs,
+                                      const void *data, size_t value_size)
+  : AttributeSaver(vespalib::GenerationHandler::Guard(), header),
+    _buf()
+{
+    size_t size = docs.size() * entry_size(value_size);
+    _buf = std::make_unique<BufferBuf>(size, FileSettings::DIRECTIO_ALIGNMENT);
+    assert(_buf->getFreeLen() >= size);
+    const char *values = static_cast<const char *>(data);
+    char *dst = _buf->getFree();
+    for (uint32_t docid : docs) {
+        memcpy(dst, &docid, sizeof(docid));
+        memcpy(dst + sizeof(docid), values + size_t(docid) * value_size, value_size);
+        dst += entry_size(value_size);
+    }
+    _buf->moveFreeToData(size);
+    assert(_buf->getDataLen() == size);
+}
+
+SingleValueNumericDeltaAttributeSaver::~SingleValueNumericDeltaAttributeSaver() = default;
+
+vespalib::string
+SingleValueNumericDeltaAttributeSaver::file_suffix()
+{
+    return "ddat";
+}
+
+bool
+SingleValueNumericDeltaAttributeSaver::onSave(IAttributeSaveTarget &saveTarget)
+{
+    if (!saveTarget.setup_writer(file_suffix(), "Attribute vector delta data file")) {
+        return false;
+    }
+    saveTarget.get_writer(file_suffix()).writeBuf(std::move(_buf));
+    return true;
+}
+
+}  // namespace search
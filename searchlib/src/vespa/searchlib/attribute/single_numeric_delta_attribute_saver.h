@@ -0,0 +1,40 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "attributesaver.h"
+#include "iattributefilewriter.h"
+#include <vector>
+
+namespace search {
+
+/*
+ * Class for saving only the changed documents of a single value numeric
+ * attribute (delta save).
+ *
+ * The delta data file contains a (docid, value) pair per changed document,
+ * in increasing docid order. The doc id limit in its header replaces the
+ * doc id limit of the base data file when loading.
+ */
+class SingleValueNumericDeltaAttributeSaver : public AttributeSaver
+{
+public:
+    using Buffer = IAttributeFileWriter::Buffer;
+
+private:
+    Buffer _buf;
+    using BufferBuf = IAttributeFileWriter::BufferBuf;
+
+    bool onSave(IAttributeSaveTarget &saveTarget) override;
+public:
+    SingleValueNumericDeltaAttributeSaver(const attribute::AttributeHeader &header,
+                                          const std::vector<uint32_t> &docs,
+                                          const void *data, size_t value_size);
+
+    ~SingleValueNumericDeltaAttributeSaver() override;
+
+    static size_t entry_size(size_t value_size) { return sizeof(uint32_t) + value_size; }
+    static vespalib::string file_suffix();
+};
+
+} // namespace search
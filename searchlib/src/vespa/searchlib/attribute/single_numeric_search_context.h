@@ -5,6 +5,8 @@
 #include "numeric_search_context.h"
 #include <vespa/vespalib/util/atomic.h>
 
+namespace search { class BitVector; }
+
 namespace search::attribute {
 
 /*
@@ -26,6 +28,9 @@ private:
         return find(docId, elemId);
     }
 
+    // Set bit i in dest for each matching document begin_id + i
+    void scan(uint32_t begin_id, uint32_t num_docs, uint64_t* dest) const;
+
 public:
     SingleNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched, const T* data);
     int32_t find(DocId docId, int32_t elemId, int32_t& weight) const {
@@ -41,6 +46,18 @@ public:
         return this->match(v) ? 0 : -1;
     }
 
+    /**
+     * Set the bits for all documents in [begin_id, end_id) with a matching
+     * value. The values are compared many at a time using simd instructions.
+     */
+    void or_hits_into(BitVector& result, uint32_t begin_id, uint32_t end_id) const;
+
+    /**
+     * Returns the first document in [docid, end_id) with a matching value,
+     * or end_id if there is none.
+     */
+    uint32_t find_next_hit(uint32_t docid, uint32_t end_id) const;
+
     std::unique_ptr<queryeval::SearchIterator>
     createFilterIterator(fef::TermFieldMatchData* matchData, bool strict) override;
 };
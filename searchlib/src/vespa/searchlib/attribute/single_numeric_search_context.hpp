@@ -4,7 +4,9 @@
 
 #include "single_numeric_search_context.h"
 #include "attributeiterators.hpp"
+#include "numeric_bulk_scan.h"
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search::attribute {
 
@@ -15,6 +17,41 @@ SingleNumericSearchContext<T, M>::SingleNumericSearchContext(std::unique_ptr<Que
 {
 }
 
+template <typename T, typename M>
+void
+SingleNumericSearchContext<T, M>::scan(uint32_t begin_id, uint32_t num_docs, uint64_t* dest) const
+{
+    // The values are copied to a local buffer using relaxed atomic loads, as they might be
+    // updated concurrently by the writer thread (cf. find()), before being compared using simd.
+    constexpr uint32_t chunk_docs = 1024; // Multiple of 64, keeping the chunks aligned with the words in dest
+    T values[chunk_docs];
+    const auto& accelerator = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+    for (uint32_t offset = 0; offset < num_docs; offset += chunk_docs) {
+        uint32_t docs = std::min(chunk_docs, num_docs - offset);
+        const T* src = _data + begin_id + offset;
+        for (uint32_t i = 0; i < docs; ++i) {
+            values[i] = vespalib::atomic::load_ref_relaxed(src[i]);
+        }
+        accelerator.orInRange(values, docs, this->getLow(), this->getHigh(), dest + offset / 64);
+    }
+}
+
+template <typename T, typename M>
+void
+SingleNumericSearchContext<T, M>::or_hits_into(BitVector& result, uint32_t begin_id, uint32_t end_id) const
+{
+    auto scanner = [this](uint32_t begin, uint32_t num_docs, uint64_t* dest) { scan(begin, num_docs, dest); };
+    or_scanned_hits_into(scanner, result, begin_id, end_id);
+}
+
+template <typename T, typename M>
+uint32_t
+SingleNumericSearchContext<T, M>::find_next_hit(uint32_t docid, uint32_t end_id) const
+{
+    auto scanner = [this](uint32_t begin, uint32_t num_docs, uint64_t* dest) { scan(begin, num_docs, dest); };
+    return find_next_scanned_hit(scanner, docid, end_id);
+}
+
 template <typename T, typename M>
 std::unique_ptr<queryeval::SearchIterator>
 SingleNumericSearchContext<T, M>::createFilterIterator(fef::TermFieldMatchData* matchData, bool strict)
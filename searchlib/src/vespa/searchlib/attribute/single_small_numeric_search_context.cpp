@@ -2,7 +2,9 @@
 
 #include "single_small_numeric_search_context.h"
 #include "attributeiterators.hpp"
+#include "numeric_bulk_scan.h"
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search::attribute {
 
@@ -16,6 +18,38 @@ SingleSmallNumericSearchContext::SingleSmallNumericSearchContext(std::unique_ptr
 {
 }
 
+void
+SingleSmallNumericSearchContext::scan(uint32_t begin_id, uint32_t num_docs, uint64_t* dest) const
+{
+    constexpr uint32_t chunk_docs = 1024;
+    const auto& accel = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+    T values[chunk_docs];
+    for (uint32_t offset = 0; offset < num_docs; offset += chunk_docs) {
+        uint32_t num = std::min(num_docs - offset, chunk_docs);
+        for (uint32_t i = 0; i < num; ++i) {
+            DocId docId = begin_id + offset + i;
+            Word word = vespalib::atomic::load_ref_relaxed(_wordData[docId >> _wordShift]);
+            uint32_t valueShift = (docId & _valueShiftMask) << _valueShiftShift;
+            values[i] = (word >> valueShift) & _valueMask;
+        }
+        accel.orInRange(values, num, getLow(), getHigh(), dest + offset / 64);
+    }
+}
+
+void
+SingleSmallNumericSearchContext::or_hits_into(BitVector& result, uint32_t begin_id, uint32_t end_id) const
+{
+    auto scanner = [this](uint32_t begin, uint32_t num_docs, uint64_t* dest) { scan(begin, num_docs, dest); };
+    or_scanned_hits_into(scanner, result, begin_id, end_id);
+}
+
+uint32_t
+SingleSmallNumericSearchContext::find_next_hit(uint32_t docid, uint32_t end_id) const
+{
+    auto scanner = [this](uint32_t begin, uint32_t num_docs, uint64_t* dest) { scan(begin, num_docs, dest); };
+    return find_next_scanned_hit(scanner, docid, end_id);
+}
+
 std::unique_ptr<queryeval::SearchIterator>
 SingleSmallNumericSearchContext::createFilterIterator(fef::TermFieldMatchData* matchData, bool strict)
 {
@@ -6,6 +6,8 @@
 #include "numeric_range_matcher.h"
 #include <vespa/vespalib/util/atomic.h>
 
+namespace search { class BitVector; }
+
 namespace search::attribute {
 
 /*
@@ -31,6 +33,9 @@ private:
         return find(docId, elementId);
     }
 
+    // Set bit i in dest for each matching document begin_id + i
+    void scan(uint32_t begin_id, uint32_t num_docs, uint64_t* dest) const;
+
 public:
     SingleSmallNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched, const Word* word_data, Word value_mask, uint32_t value_shift_shift, uint32_t value_shift_mask, uint32_t word_shift);
 
@@ -51,6 +56,19 @@ public:
         return match(v) ? 0 : -1;
     }
 
+    /**
+     * Set the bits for all documents in [begin_id, end_id) with a matching
+     * value. The values are unpacked and compared many at a time using
+     * simd instructions.
+     */
+    void or_hits_into(BitVector& result, uint32_t begin_id, uint32_t end_id) const;
+
+    /**
+     * Returns the first document in [docid, end_id) with a matching value,
+     * or end_id if there is none.
+     */
+    uint32_t find_next_hit(uint32_t docid, uint32_t end_id) const;
+
     std::unique_ptr<queryeval::SearchIterator>
     createFilterIterator(fef::TermFieldMatchData* matchData, bool strict) override;
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "changed_docs_tracker.h"
 #include "integerbase.h"
 #include "floatbase.h"
 #include "search_context.h"
@@ -28,6 +29,7 @@ private:
     using B::getGenerationHolder;
 
     DataVector _data;
+    attribute::ChangedDocsTracker _changedDocs;
 
     T getFromEnum(EnumHandle e) const override {
         (void) e;
@@ -61,12 +63,14 @@ public:
     bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadDelta();
 
     std::unique_ptr<attribute::SearchContext>
     getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
 
     void set(DocId doc, T v) {
         vespalib::atomic::store_ref_relaxed(_data[doc], v);
+        _changedDocs.mark_changed(doc);
     }
 
     T getFast(DocId doc) const {
@@ -122,6 +126,9 @@ public:
     void clearDocs(DocId lidLow, DocId lidLimit, bool in_shrink_lid_space) override;
     void onShrinkLidSpace() override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
+    uint64_t getDeltaSaveBaseSerialNum() const override { return _changedDocs.base_serial_num(); }
+    uint64_t getEstimatedDeltaSaveByteSize() const override;
+    std::unique_ptr<AttributeSaver> onInitDeltaSave(vespalib::stringref fileName) override;
 };
 
 }
@@ -8,10 +8,13 @@
 #include "primitivereader.h"
 #include "singlenumericattribute.h"
 #include "singlenumericattributesaver.h"
+#include "single_numeric_delta_attribute_saver.h"
 #include "single_numeric_search_context.h"
 #include "valuemodifier.h"
 #include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/util/file_settings.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/data/fileheader.h>
 
 namespace search {
 
@@ -26,7 +29,8 @@ template <typename B>
 SingleValueNumericAttribute<B>::
 SingleValueNumericAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c)
     : B(baseFileName, c),
-      _data(c.getGrowStrategy(), getGenerationHolder(), this->get_initial_alloc())
+      _data(c.getGrowStrategy(), getGenerationHolder(), this->get_initial_alloc()),
+      _changedDocs()
 { }
 
 template <typename B>
@@ -47,10 +51,13 @@ SingleValueNumericAttribute<B>::onCommit()
         for (const auto & change : this->_changes.getInsertOrder()) {
             if (change._type == ChangeBase::UPDATE) {
                 vespalib::atomic::store_ref_relaxed(_data[change._doc], change._data);
+                _changedDocs.mark_changed(change._doc);
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
                 vespalib::atomic::store_ref_relaxed(_data[change._doc], this->template applyArithmetic<T, typename B::Change::DataType>(_data[change._doc], change._data.getArithOperand(), change._type));
+                _changedDocs.mark_changed(change._doc);
             } else if (change._type == ChangeBase::CLEARDOC) {
                 vespalib::atomic::store_ref_relaxed(_data[change._doc], this->_defaultValue._data);
+                _changedDocs.mark_changed(change._doc);
             }
         }
     }
@@ -67,6 +74,8 @@ SingleValueNumericAttribute<B>::onUpdateStat()
     vespalib::MemoryUsage usage = _data.getMemoryUsage();
     usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     usage.merge(this->getChangeVectorMemoryUsage());
+    usage.incAllocatedBytes(_changedDocs.memory_usage());
+    usage.incUsedBytes(_changedDocs.memory_usage());
     this->updateStatistics(_data.size(), _data.size(),
                            usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
 }
@@ -85,6 +94,8 @@ SingleValueNumericAttribute<B>::addDoc(DocId & doc) {
     std::atomic_thread_fence(std::memory_order_release);
     B::incNumDocs();
     doc = B::getNumDocs() - 1;
+    // The base data file might have a stale value for a doc id reused after shrinking lid space
+    _changedDocs.mark_changed(doc);
     this->updateUncommittedDocIdLimit(doc);
     if (incGen) {
         this->incGeneration();
@@ -138,21 +149,59 @@ SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
         return false;
 
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
+    const auto &datHeader = attrReader.getDatHeader();
+    _changedDocs.reset(datHeader.hasTag("serialNum") ? datHeader.getTag("serialNum").asInteger() : 0);
 
-    if (attrReader.getEnumerated())
-        return onLoadEnumerated(attrReader);
-    
-    const size_t sz(attrReader.getDataCount());
-    getGenerationHolder().clearHoldLists();
-    _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
-    }
+    if (attrReader.getEnumerated()) {
+        ok = onLoadEnumerated(attrReader);
+    } else {
+        const size_t sz(attrReader.getDataCount());
+        getGenerationHolder().clearHoldLists();
+        _data.reset();
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
 
-    B::setNumDocs(sz);
-    B::setCommittedDocIdLimit(sz);
+        B::setNumDocs(sz);
+        B::setCommittedDocIdLimit(sz);
+    }
+    if (ok && attribute::LoadUtils::file_exists(*this, SingleValueNumericDeltaAttributeSaver::file_suffix())) {
+        ok = onLoadDelta();
+    }
+    return ok;
+}
 
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::onLoadDelta()
+{
+    auto buffer = attribute::LoadUtils::loadFile(*this, SingleValueNumericDeltaAttributeSaver::file_suffix());
+    const uint32_t docIdLimit = attribute::AttributeHeader::extractTags(buffer->getHeader(), this->getBaseFileName()).getNumDocs();
+    const size_t entrySize = SingleValueNumericDeltaAttributeSaver::entry_size(sizeof(T));
+    if ((buffer->size() % entrySize) != 0) {
+        return false;
+    }
+    if (docIdLimit < _data.size()) {
+        _data.shrink(docIdLimit);
+    }
+    while (_data.size() < docIdLimit) {
+        _data.push_back(B::defaultValue());
+    }
+    for (const char *entry = buffer->c_str(), *end = entry + buffer->size(); entry != end; entry += entrySize) {
+        uint32_t docid;
+        T value;
+        memcpy(&docid, entry, sizeof(docid));
+        memcpy(&value, entry + sizeof(docid), sizeof(value));
+        if (docid >= docIdLimit) {
+            return false;
+        }
+        _data[docid] = value;
+        _changedDocs.mark_changed(docid);
+    }
+    getGenerationHolder().clearHoldLists();
+    B::setNumDocs(docIdLimit);
+    B::setCommittedDocIdLimit(docIdLimit);
     return true;
 }
 
@@ -209,9 +258,33 @@ SingleValueNumericAttribute<B>::onInitSave(vespalib::stringref fileName)
 {
     const uint32_t numDocs(this->getCommittedDocIdLimit());
     assert(numDocs <= _data.size());
+    // The saved data file becomes the new base for delta save. The caller
+    // has committed with the serial number the data file is saved at.
+    _changedDocs.reset(this->getStatus().getLastSyncToken());
     return std::make_unique<SingleValueNumericAttributeSaver>
         (this->createAttributeHeader(fileName), &_data[0], numDocs * sizeof(T));
 }
 
+template <typename B>
+uint64_t
+SingleValueNumericAttribute<B>::getEstimatedDeltaSaveByteSize() const
+{
+    return FileSettings::DIRECTIO_ALIGNMENT +
+        uint64_t(_changedDocs.num_changed()) * SingleValueNumericDeltaAttributeSaver::entry_size(sizeof(T));
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueNumericAttribute<B>::onInitDeltaSave(vespalib::stringref fileName)
+{
+    if (_changedDocs.base_serial_num() == 0) {
+        return std::unique_ptr<AttributeSaver>();
+    }
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    assert(numDocs <= _data.size());
+    return std::make_unique<SingleValueNumericDeltaAttributeSaver>
+        (this->createAttributeHeader(fileName), _changedDocs.changed_docs(numDocs), &_data[0], sizeof(T));
+}
+
 }
 
@@ -184,7 +184,7 @@ StringAttribute::apply(DocId, const ArithmeticValueUpdate & )
 }
 
 bool
-StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
+StringAttribute::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -207,6 +207,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
 
     if (hasPostings()) {
         auto loader = this->getEnumStoreBase()->make_enumerated_postings_loader();
+        loader.set_executor(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         load_enumerated_data(attrReader, loader, numValues);
@@ -224,7 +225,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
 }
 
 bool
-StringAttribute::onLoad(vespalib::Executor *)
+StringAttribute::onLoad(vespalib::Executor *executor)
 {
     ReaderBase attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -236,7 +237,7 @@ StringAttribute::onLoad(vespalib::Executor *)
     setCreateSerialNum(attrReader.getCreateSerialNum());
 
     assert(attrReader.getEnumerated());
-    return onLoadEnumerated(attrReader);
+    return onLoadEnumerated(attrReader, executor);
 }
 
 bool
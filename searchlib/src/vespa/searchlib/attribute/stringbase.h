@@ -66,7 +66,7 @@ protected:
     Change _defaultValue;
     bool onLoad(vespalib::Executor *executor) override;
 
-    bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor);
 
     bool onAddDoc(DocId doc) override;
 
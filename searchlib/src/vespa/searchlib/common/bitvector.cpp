@@ -91,6 +91,15 @@ BitVector::clearInterval(Index start, Index end)
     invalidateCachedCount();
 }
 
+void
+BitVector::copyWordsFrom(const BitVector &src, Index start, Index end)
+{
+    if (end > start) {
+        Index num_words = wordNum(end - 1) - wordNum(start) + 1;
+        memcpy(getWordIndex(start), src.getWordIndex(start), num_words * sizeof(Word));
+    }
+}
+
 void
 BitVector::clearIntervalNoInvalidation(Range range_in)
 {
@@ -177,6 +177,18 @@ public:
      */
     void setInterval(Index start, Index end);
 
+    /**
+     * Copy the words covering the bits in [..> from another bit vector
+     * that covers the same bits. Other bits sharing the first and last
+     * word are copied as well, so ranges copied by different threads
+     * must be word aligned. Does not invalidate the cached count.
+     *
+     * @param src bit vector to copy from
+     * @param start first bit to be copied
+     * @param end limit
+     */
+    void copyWordsFrom(const BitVector &src, Index start, Index end);
+
     /**
      * Sets a bit and maintains count of number of bits set.
      * @param idx
@@ -0,0 +1,492 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressedbitvector.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace search {
+
+namespace {
+
+using Word = uint64_t;
+
+constexpr uint32_t word_num(uint32_t offset) { return offset >> 6; }
+constexpr Word word_mask(uint32_t offset) { return Word(1) << (offset & 63); }
+
+// per chunk overhead of the container bookkeeping
+constexpr size_t container_overhead = 64;
+
+}
+
+bool
+CompressedBitVector::Container::test(uint16_t offset) const
+{
+    if (is_bitmap()) {
+        return (bitmap[word_num(offset)] & word_mask(offset)) != 0;
+    }
+    return std::binary_search(array.begin(), array.end(), offset);
+}
+
+uint32_t
+CompressedBitVector::Container::next(uint32_t offset) const
+{
+    if (offset >= chunk_size) {
+        return chunk_size;
+    }
+    if (is_bitmap()) {
+        uint32_t word = word_num(offset);
+        Word bits = bitmap[word] & (~Word(0) << (offset & 63));
+        while (bits == 0) {
+            if (++word == bitmap_words) {
+                return chunk_size;
+            }
+            bits = bitmap[word];
+        }
+        return (word << 6) + __builtin_ctzl(bits);
+    }
+    auto pos = std::lower_bound(array.begin(), array.end(), offset);
+    return (pos != array.end()) ? *pos : chunk_size;
+}
+
+void
+CompressedBitVector::Container::to_bitmap()
+{
+    if (is_bitmap()) {
+        return;
+    }
+    bitmap.assign(bitmap_words, 0);
+    for (uint16_t offset : array) {
+        bitmap[word_num(offset)] |= word_mask(offset);
+    }
+    std::vector<uint16_t>().swap(array);
+}
+
+void
+CompressedBitVector::Container::truncate(uint32_t offset)
+{
+    if (is_bitmap()) {
+        uint32_t word = word_num(offset);
+        if ((offset & 63) != 0) {
+            bitmap[word++] &= ~(~Word(0) << (offset & 63));
+        }
+        std::fill(bitmap.begin() + word, bitmap.end(), 0);
+    } else {
+        array.erase(std::lower_bound(array.begin(), array.end(), offset), array.end());
+    }
+    optimize();
+}
+
+void
+CompressedBitVector::Container::optimize()
+{
+    if (is_bitmap()) {
+        count = 0;
+        for (Word word : bitmap) {
+            count += __builtin_popcountl(word);
+        }
+        if (count <= max_array_size) {
+            array.clear();
+            array.reserve(count);
+            foreach([this](uint32_t offset) { array.push_back(offset); });
+            std::vector<Word>().swap(bitmap);
+        }
+    } else {
+        count = array.size();
+        if (count > max_array_size) {
+            to_bitmap();
+        } else if (array.capacity() > 2 * array.size()) {
+            array.shrink_to_fit();
+        }
+    }
+}
+
+size_t
+CompressedBitVector::Container::memory_usage() const
+{
+    return sizeof(Container) + array.capacity() * sizeof(uint16_t) + bitmap.capacity() * sizeof(Word);
+}
+
+template <typename Func>
+void
+CompressedBitVector::Container::foreach(Func func) const
+{
+    if (is_bitmap()) {
+        for (uint32_t word = 0; word < bitmap_words; ++word) {
+            for (Word bits = bitmap[word]; bits != 0; bits &= (bits - 1)) {
+                func((word << 6) + __builtin_ctzl(bits));
+            }
+        }
+    } else {
+        for (uint16_t offset : array) {
+            func(offset);
+        }
+    }
+}
+
+CompressedBitVector::CompressedBitVector(Index sz)
+    : _containers(),
+      _size(sz)
+{
+}
+
+CompressedBitVector::CompressedBitVector(CompressedBitVector &&) noexcept = default;
+CompressedBitVector &CompressedBitVector::operator=(CompressedBitVector &&) noexcept = default;
+CompressedBitVector::~CompressedBitVector() = default;
+
+CompressedBitVector::UP
+CompressedBitVector::create(const BitVector &bv)
+{
+    auto result = std::make_unique<CompressedBitVector>(bv.size());
+    Container *container = nullptr;
+    bv.foreach_truebit([&](Index idx) {
+            uint32_t key = idx >> chunk_bits;
+            if (container == nullptr || container->key != key) {
+                if (container != nullptr) {
+                    container->optimize();
+                }
+                container = &result->_containers.emplace_back(key);
+            }
+            uint16_t offset = idx & (chunk_size - 1);
+            if (container->is_bitmap()) {
+                container->bitmap[word_num(offset)] |= word_mask(offset);
+            } else {
+                container->array.push_back(offset);
+                if (container->array.size() > max_array_size) {
+                    container->to_bitmap();
+                }
+            }
+        }, bv.getStartIndex(), bv.size());
+    if (container != nullptr) {
+        container->optimize();
+    }
+    return result;
+}
+
+bool
+CompressedBitVector::should_compress(Index num_true_bits, Index sz)
+{
+    size_t flat_bytes = BitVector::getFileBytes(sz);
+    size_t num_chunks = (size_t(sz) + chunk_size - 1) >> chunk_bits;
+    // worst case, all chunks are used
+    size_t compressed_bytes = num_true_bits * sizeof(uint16_t) + std::min(size_t(num_true_bits), num_chunks) * container_overhead;
+    return (compressed_bytes * 2 < flat_bytes);
+}
+
+const CompressedBitVector::Container *
+CompressedBitVector::find(uint32_t key) const
+{
+    auto pos = std::lower_bound(_containers.begin(), _containers.end(), key,
+                                [](const Container &c, uint32_t k) { return c.key < k; });
+    return ((pos != _containers.end()) && (pos->key == key)) ? &*pos : nullptr;
+}
+
+CompressedBitVector::Container &
+CompressedBitVector::get_or_add(uint32_t key)
+{
+    if (_containers.empty() || _containers.back().key < key) {
+        return _containers.emplace_back(key);
+    }
+    auto pos = std::lower_bound(_containers.begin(), _containers.end(), key,
+                                [](const Container &c, uint32_t k) { return c.key < k; });
+    if ((pos != _containers.end()) && (pos->key == key)) {
+        return *pos;
+    }
+    return *_containers.emplace(pos, key);
+}
+
+CompressedBitVector::Index
+CompressedBitVector::countTrueBits() const
+{
+    Index sum = 0;
+    for (const auto &container : _containers) {
+        sum += container.count;
+    }
+    return sum;
+}
+
+bool
+CompressedBitVector::testBit(Index idx) const
+{
+    const Container *container = find(idx >> chunk_bits);
+    return (container != nullptr) && container->test(idx & (chunk_size - 1));
+}
+
+CompressedBitVector::Index
+CompressedBitVector::getNextTrueBit(Index start) const
+{
+    if (start >= _size) {
+        return _size;
+    }
+    uint32_t key = start >> chunk_bits;
+    auto pos = std::lower_bound(_containers.begin(), _containers.end(), key,
+                                [](const Container &c, uint32_t k) { return c.key < k; });
+    for (; pos != _containers.end(); ++pos) {
+        uint32_t offset = (pos->key == key) ? (start & (chunk_size - 1)) : 0;
+        uint32_t found = pos->next(offset);
+        if (found < chunk_size) {
+            return std::min(_size, (pos->key << chunk_bits) + found);
+        }
+    }
+    return _size;
+}
+
+void
+CompressedBitVector::setBit(Index idx)
+{
+    assert(idx < _size);
+    Container &container = get_or_add(idx >> chunk_bits);
+    uint16_t offset = idx & (chunk_size - 1);
+    if (container.is_bitmap()) {
+        Word &word = container.bitmap[word_num(offset)];
+        if ((word & word_mask(offset)) == 0) {
+            word |= word_mask(offset);
+            ++container.count;
+        }
+        return;
+    }
+    auto &array = container.array;
+    if (array.empty() || array.back() < offset) {
+        array.push_back(offset);
+    } else {
+        auto pos = std::lower_bound(array.begin(), array.end(), offset);
+        if (*pos == offset) {
+            return;
+        }
+        array.insert(pos, offset);
+    }
+    if (++container.count > max_array_size) {
+        container.to_bitmap();
+    }
+}
+
+template <typename BitmapOp, typename ArrayOp>
+void
+CompressedBitVector::combine(Container &lhs, const Container &rhs, BitmapOp bitmap_op, ArrayOp array_op)
+{
+    if (!lhs.is_bitmap() && !rhs.is_bitmap()) {
+        std::vector<uint16_t> result;
+        result.reserve(lhs.array.size() + rhs.array.size());
+        array_op(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(result));
+        lhs.array.swap(result);
+    } else {
+        lhs.to_bitmap();
+        if (rhs.is_bitmap()) {
+            for (uint32_t i = 0; i < bitmap_words; ++i) {
+                lhs.bitmap[i] = bitmap_op(lhs.bitmap[i], rhs.bitmap[i]);
+            }
+        } else {
+            std::vector<Word> tmp(bitmap_words, 0);
+            for (uint16_t offset : rhs.array) {
+                tmp[word_num(offset)] |= word_mask(offset);
+            }
+            for (uint32_t i = 0; i < bitmap_words; ++i) {
+                lhs.bitmap[i] = bitmap_op(lhs.bitmap[i], tmp[i]);
+            }
+        }
+    }
+    lhs.optimize();
+}
+
+void
+CompressedBitVector::andWith(const CompressedBitVector &right)
+{
+    std::vector<Container> result;
+    auto rhs = right._containers.begin();
+    for (auto &lhs : _containers) {
+        while ((rhs != right._containers.end()) && (rhs->key < lhs.key)) {
+            ++rhs;
+        }
+        if ((rhs != right._containers.end()) && (rhs->key == lhs.key)) {
+            combine(lhs, *rhs, [](Word a, Word b) { return a & b; },
+                    [](auto a, auto a_end, auto b, auto b_end, auto out) { std::set_intersection(a, a_end, b, b_end, out); });
+            if (lhs.count > 0) {
+                result.push_back(std::move(lhs));
+            }
+        }
+    }
+    _containers.swap(result);
+}
+
+void
+CompressedBitVector::orWith(const CompressedBitVector &right)
+{
+    std::vector<Container> result;
+    result.reserve(_containers.size() + right._containers.size());
+    auto lhs = _containers.begin();
+    for (const auto &rhs : right._containers) {
+        if ((rhs.key << chunk_bits) >= _size) {
+            break;
+        }
+        while ((lhs != _containers.end()) && (lhs->key < rhs.key)) {
+            result.push_back(std::move(*lhs++));
+        }
+        if ((lhs != _containers.end()) && (lhs->key == rhs.key)) {
+            combine(*lhs, rhs, [](Word a, Word b) { return a | b; },
+                    [](auto a, auto a_end, auto b, auto b_end, auto out) { std::set_union(a, a_end, b, b_end, out); });
+            result.push_back(std::move(*lhs++));
+        } else {
+            result.push_back(rhs);
+        }
+    }
+    while (lhs != _containers.end()) {
+        result.push_back(std::move(*lhs++));
+    }
+    if (!result.empty()) {
+        // the last chunk from right might cross the end of this vector
+        Container &last = result.back();
+        Index base = last.key << chunk_bits;
+        if (base + chunk_size > _size) {
+            last.truncate(_size - base);
+            if (last.count == 0) {
+                result.pop_back();
+            }
+        }
+    }
+    _containers.swap(result);
+}
+
+void
+CompressedBitVector::andNotWith(const CompressedBitVector &right)
+{
+    std::vector<Container> result;
+    auto rhs = right._containers.begin();
+    for (auto &lhs : _containers) {
+        while ((rhs != right._containers.end()) && (rhs->key < lhs.key)) {
+            ++rhs;
+        }
+        if ((rhs != right._containers.end()) && (rhs->key == lhs.key)) {
+            combine(lhs, *rhs, [](Word a, Word b) { return a & ~b; },
+                    [](auto a, auto a_end, auto b, auto b_end, auto out) { std::set_difference(a, a_end, b, b_end, out); });
+        }
+        if (lhs.count > 0) {
+            result.push_back(std::move(lhs));
+        }
+    }
+    _containers.swap(result);
+}
+
+void
+CompressedBitVector::or_into(BitVector &result) const
+{
+    Index begin = result.getStartIndex();
+    Index end = std::min(result.size(), _size);
+    for (const auto &container : _containers) {
+        Index base = container.key << chunk_bits;
+        if (base >= end) {
+            break;
+        }
+        if (base + chunk_size <= begin) {
+            continue;
+        }
+        container.foreach([&](uint32_t offset) {
+                Index idx = base + offset;
+                if ((idx >= begin) && (idx < end)) {
+                    result.setBit(idx);
+                }
+            });
+    }
+    result.invalidateCachedCount();
+}
+
+void
+CompressedBitVector::and_into(BitVector &result) const
+{
+    Index begin = result.getStartIndex();
+    Index end = std::min(result.size(), _size);
+    Index cleared = begin;
+    for (const auto &container : _containers) {
+        Index base = container.key << chunk_bits;
+        if (base >= end) {
+            break;
+        }
+        Index chunk_end = std::min(base + chunk_size, end);
+        if (chunk_end <= begin) {
+            continue;
+        }
+        if (cleared < base) {
+            result.clearInterval(cleared, base);
+        }
+        // walk the set bits of result, clearing the ones not in this chunk
+        for (Index idx = result.getNextTrueBit(std::max(base, begin)); idx < chunk_end; idx = result.getNextTrueBit(idx + 1)) {
+            if (!container.test(idx - base)) {
+                result.clearBit(idx);
+            }
+        }
+        cleared = chunk_end;
+    }
+    if (cleared < end) {
+        result.clearInterval(cleared, end);
+    }
+    result.invalidateCachedCount();
+}
+
+void
+CompressedBitVector::and_not_into(BitVector &result) const
+{
+    Index begin = result.getStartIndex();
+    Index end = std::min(result.size(), _size);
+    for (const auto &container : _containers) {
+        Index base = container.key << chunk_bits;
+        if (base >= end) {
+            break;
+        }
+        if (base + chunk_size <= begin) {
+            continue;
+        }
+        container.foreach([&](uint32_t offset) {
+                Index idx = base + offset;
+                if ((idx >= begin) && (idx < end)) {
+                    result.clearBit(idx);
+                }
+            });
+    }
+    result.invalidateCachedCount();
+}
+
+BitVector::UP
+CompressedBitVector::to_bitvector() const
+{
+    BitVector::UP result = BitVector::create(_size);
+    or_into(*result);
+    return result;
+}
+
+size_t
+CompressedBitVector::memory_usage() const
+{
+    size_t usage = sizeof(CompressedBitVector) + (_containers.capacity() - _containers.size()) * sizeof(Container);
+    for (const auto &container : _containers) {
+        usage += container.memory_usage();
+    }
+    return usage;
+}
+
+bool
+CompressedBitVector::operator==(const CompressedBitVector &rhs) const
+{
+    if ((_size != rhs._size) || (_containers.size() != rhs._containers.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < _containers.size(); ++i) {
+        const Container &a = _containers[i];
+        const Container &b = rhs._containers[i];
+        if ((a.key != b.key) || (a.count != b.count)) {
+            return false;
+        }
+        if (a.is_bitmap() == b.is_bitmap()) {
+            if ((a.array != b.array) || (a.bitmap != b.bitmap)) {
+                return false;
+            }
+        } else {
+            bool same = true;
+            a.foreach([&](uint32_t offset) { same = same && b.test(offset); });
+            if (!same) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bitvector.h"
+#include <memory>
+#include <vector>
+
+namespace search {
+
+/**
+ * Compressed bit vector using the hybrid container layout known from
+ * roaring bitmaps.
+ *
+ * The index space is split into chunks of 2^16 bits. Only chunks with
+ * at least one bit set are stored. A chunk with few bits set is stored
+ * as a sorted array of 16-bit offsets; a chunk with many bits set is
+ * stored as a flat 8kB bitmap. Memory usage is thus bounded by about
+ * 2 bytes per set bit for sparse data and by size/8 bytes (the same as
+ * a flat BitVector) for dense data.
+ **/
+class CompressedBitVector
+{
+public:
+    using Index = BitVector::Index;
+    using UP = std::unique_ptr<CompressedBitVector>;
+    using SP = std::shared_ptr<const CompressedBitVector>;
+
+    static constexpr uint32_t chunk_bits = 16;
+    static constexpr uint32_t chunk_size = 1u << chunk_bits;
+    static constexpr uint32_t bitmap_words = chunk_size / 64;
+    // chunks with more bits set than this are stored as bitmaps
+    static constexpr uint32_t max_array_size = 4096;
+
+private:
+    struct Container {
+        uint32_t              key;
+        uint32_t              count;
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bitmap;
+
+        explicit Container(uint32_t key_in) noexcept : key(key_in), count(0), array(), bitmap() {}
+        bool is_bitmap() const { return !bitmap.empty(); }
+        bool test(uint16_t offset) const;
+        // returns chunk_size if there is no bit set at or after offset
+        uint32_t next(uint32_t offset) const;
+        void to_bitmap();
+        // clear all bits at or after offset
+        void truncate(uint32_t offset);
+        void optimize();
+        size_t memory_usage() const;
+        template <typename Func> void foreach(Func func) const;
+    };
+
+    std::vector<Container> _containers;
+    Index                  _size;
+
+    const Container *find(uint32_t key) const;
+    Container &get_or_add(uint32_t key);
+
+    template <typename BitmapOp, typename ArrayOp>
+    static void combine(Container &lhs, const Container &rhs, BitmapOp bitmap_op, ArrayOp array_op);
+
+public:
+    explicit CompressedBitVector(Index sz);
+    CompressedBitVector(CompressedBitVector &&) noexcept;
+    CompressedBitVector &operator=(CompressedBitVector &&) noexcept;
+    CompressedBitVector(const CompressedBitVector &) = delete;
+    CompressedBitVector &operator=(const CompressedBitVector &) = delete;
+    ~CompressedBitVector();
+
+    static UP create(Index sz) { return std::make_unique<CompressedBitVector>(sz); }
+    static UP create(const BitVector &bv);
+
+    /**
+     * Check if a bit vector with the given number of bits set should
+     * be stored compressed. The compressed layout is only picked when
+     * it is expected to use well below half the memory of a flat
+     * BitVector, since random access is slower.
+     **/
+    static bool should_compress(Index num_true_bits, Index sz);
+
+    Index size() const { return _size; }
+    Index countTrueBits() const;
+    bool hasTrueBits() const { return !_containers.empty(); }
+    bool testBit(Index idx) const;
+
+    /**
+     * @return the first index >= start with its bit set, or size() if
+     *         there is none.
+     **/
+    Index getNextTrueBit(Index start) const;
+
+    /**
+     * Set a bit. Setting bits in increasing order is cheap; setting
+     * bits in random order is slower for sparse chunks.
+     **/
+    void setBit(Index idx);
+
+    void andWith(const CompressedBitVector &right);
+    void orWith(const CompressedBitVector &right);
+    void andNotWith(const CompressedBitVector &right);
+
+    /**
+     * Combine this with a flat bit vector, storing the result in the
+     * flat bit vector. Only the part of the index space covered by
+     * both vectors is considered.
+     **/
+    void or_into(BitVector &result) const;
+    void and_into(BitVector &result) const;
+    void and_not_into(BitVector &result) const;
+
+    BitVector::UP to_bitvector() const;
+    size_t memory_usage() const;
+
+    bool operator==(const CompressedBitVector &rhs) const;
+};
+
+}
@@ -0,0 +1,117 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressedbitvectoriterator.h"
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <cassert>
+
+namespace search {
+
+using fef::TermFieldMatchData;
+using vespalib::Trinary;
+
+CompressedBitVectorIterator::CompressedBitVectorIterator(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData) :
+    _docIdLimit(std::min(docIdLimit, bv.size())),
+    _bv(bv),
+    _tfmd(matchData)
+{
+    assert(docIdLimit <= bv.size());
+    _tfmd.reset(0);
+}
+
+void
+CompressedBitVectorIterator::initRange(uint32_t begin, uint32_t end)
+{
+    SearchIterator::initRange(begin, end);
+    if (begin >= _docIdLimit) {
+        setAtEnd();
+    }
+}
+
+void
+CompressedBitVectorIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    SearchIterator::visitMembers(visitor);
+    visit(visitor, "docIdLimit", _docIdLimit);
+    visit(visitor, "numTrueBits", _bv.countTrueBits());
+    visit(visitor, "termfieldmatchdata.fieldId", _tfmd.getFieldId());
+    visit(visitor, "termfieldmatchdata.docid", _tfmd.getDocId());
+}
+
+BitVector::UP
+CompressedBitVectorIterator::get_hits(uint32_t begin_id)
+{
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    _bv.or_into(*result);
+    if (begin_id < getDocId()) {
+        result->clearInterval(begin_id, getDocId());
+    }
+    return result;
+}
+
+void
+CompressedBitVectorIterator::or_hits_into(BitVector &result, uint32_t)
+{
+    _bv.or_into(result);
+}
+
+void
+CompressedBitVectorIterator::and_hits_into(BitVector &result, uint32_t)
+{
+    _bv.and_into(result);
+}
+
+namespace {
+
+class NonStrictIterator : public CompressedBitVectorIterator {
+public:
+    NonStrictIterator(const CompressedBitVector &bv, uint32_t docIdLimit, TermFieldMatchData &matchData)
+        : CompressedBitVectorIterator(bv, docIdLimit, matchData)
+    {}
+    void doSeek(uint32_t docId) override {
+        if (__builtin_expect(docId >= _docIdLimit, false)) {
+            setAtEnd();
+        } else if (_bv.testBit(docId)) {
+            setDocId(docId);
+        }
+    }
+};
+
+class StrictIterator : public CompressedBitVectorIterator {
+public:
+    StrictIterator(const CompressedBitVector &bv, uint32_t docIdLimit, TermFieldMatchData &matchData)
+        : CompressedBitVectorIterator(bv, docIdLimit, matchData)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        CompressedBitVectorIterator::initRange(begin, end);
+        if (!isAtEnd()) {
+            doSeek(begin);
+        }
+    }
+    void doSeek(uint32_t docId) override {
+        docId = (docId < _docIdLimit) ? _bv.getNextTrueBit(docId) : _docIdLimit;
+        if (__builtin_expect(docId >= _docIdLimit, false)) {
+            setAtEnd();
+        } else {
+            setDocId(docId);
+        }
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+}
+
+queryeval::SearchIterator::UP
+CompressedBitVectorIterator::create(const CompressedBitVector *const bv, uint32_t docIdLimit,
+                                    TermFieldMatchData &matchData, bool strict)
+{
+    if (bv == nullptr) {
+        return std::make_unique<queryeval::EmptySearch>();
+    } else if (strict) {
+        return std::make_unique<StrictIterator>(*bv, docIdLimit, matchData);
+    } else {
+        return std::make_unique<NonStrictIterator>(*bv, docIdLimit, matchData);
+    }
+}
+
+} // namespace search
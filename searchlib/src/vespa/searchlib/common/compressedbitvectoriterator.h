@@ -0,0 +1,40 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "compressedbitvector.h"
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+namespace search {
+
+/**
+ * Search iterator over a CompressedBitVector. This is the compressed
+ * counterpart of BitVectorIterator.
+ **/
+class CompressedBitVectorIterator : public queryeval::SearchIterator
+{
+protected:
+    CompressedBitVectorIterator(const CompressedBitVector &bv, uint32_t docIdLimit, fef::TermFieldMatchData &matchData);
+    void initRange(uint32_t begin, uint32_t end) override;
+
+    uint32_t                    _docIdLimit;
+    const CompressedBitVector & _bv;
+private:
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    void doUnpack(uint32_t docId) override final {
+        _tfmd.resetOnlyDocId(docId);
+    }
+    fef::TermFieldMatchData  &_tfmd;
+public:
+    BitVector::UP get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+
+    Trinary is_strict() const override { return Trinary::False; }
+    uint32_t getDocIdLimit() const { return _docIdLimit; }
+    static UP create(const CompressedBitVector *const other, uint32_t docIdLimit,
+                     fef::TermFieldMatchData &matchData, bool strict);
+};
+
+} // namespace search
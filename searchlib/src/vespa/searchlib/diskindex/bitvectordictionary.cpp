@@ -13,6 +13,7 @@ namespace search::diskindex {
 BitVectorDictionary::BitVectorDictionary()
     : _docIdLimit(),
       _entries(),
+      _compressed(),
       _vectorSize(),
       _datFile(),
       _datHeaderLen(0u)
@@ -77,9 +78,30 @@ BitVectorDictionary::open(const vespalib::string &pathPrefix,
     _datHeaderLen = datHeader.readFile(*_datFile);
     assert(_datFile->GetSize() >=
            static_cast<int64_t>(_vectorSize * _entries.size() + _datHeaderLen));
+    compressSparse();
     return true;
 }
 
+BitVector::UP
+BitVectorDictionary::read(size_t pos) const
+{
+    return BitVector::create(_docIdLimit, *_datFile,
+                             ((int64_t) _vectorSize) * pos + _datHeaderLen,
+                             _entries[pos]._numDocs);
+}
+
+void
+BitVectorDictionary::compressSparse()
+{
+    _compressed.clear();
+    _compressed.resize(_entries.size());
+    for (size_t pos = 0; pos < _entries.size(); ++pos) {
+        if (CompressedBitVector::should_compress(_entries[pos]._numDocs, _docIdLimit)) {
+            _compressed[pos] = CompressedBitVector::create(*read(pos));
+        }
+    }
+}
+
 
 BitVector::UP
 BitVectorDictionary::lookup(uint64_t wordNum)
@@ -91,10 +113,40 @@ BitVectorDictionary::lookup(uint64_t wordNum)
     if (itr == _entries.end() || key < *itr) {
         return BitVector::UP();
     }
-    int64_t pos = &*itr - &_entries[0];
-    return BitVector::create(_docIdLimit, *_datFile,
-                                 ((int64_t) _vectorSize) * pos + _datHeaderLen,
-                                 itr->_numDocs);
+    return read(itr - _entries.begin());
+}
+
+CompressedBitVector::SP
+BitVectorDictionary::lookup_compressed(uint64_t wordNum) const
+{
+    WordSingleKey key;
+    key._wordNum = wordNum;
+    auto itr = std::lower_bound(_entries.begin(), _entries.end(), key);
+    if (itr == _entries.end() || key < *itr) {
+        return CompressedBitVector::SP();
+    }
+    return _compressed[itr - _entries.begin()];
+}
+
+size_t
+BitVectorDictionary::getCompressedMemoryUsage() const
+{
+    size_t usage = _compressed.capacity() * sizeof(CompressedBitVector::SP);
+    for (const auto &cbv : _compressed) {
+        if (cbv) {
+            usage += cbv->memory_usage();
+        }
+    }
+    return usage;
+}
+
+bool
+BitVectorDictionary::hasBitVector(uint64_t wordNum) const
+{
+    WordSingleKey key;
+    key._wordNum = wordNum;
+    auto itr = std::lower_bound(_entries.begin(), _entries.end(), key);
+    return (itr != _entries.end() && !(key < *itr));
 }
 
 }
@@ -3,6 +3,7 @@
 
 #include "bitvectorkeyscope.h"
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/index/bitvectorkeys.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/vespalib/stllike/string.h>
@@ -22,10 +23,15 @@ private:
 
     uint32_t                              _docIdLimit;
     std::vector<WordSingleKey>            _entries;
+    // Sparse bit vectors, compressed when opened. Indexed as _entries, null for dense bit vectors.
+    std::vector<CompressedBitVector::SP>  _compressed;
     size_t                                _vectorSize;
     std::unique_ptr<FastOS_FileInterface> _datFile;
     uint32_t                              _datHeaderLen;
 
+    BitVector::UP read(size_t pos) const;
+    void compressSparse();
+
 public:
     typedef std::shared_ptr<BitVectorDictionary> SP;
     BitVectorDictionary(const BitVectorDictionary &rhs) = delete;
@@ -36,7 +42,8 @@ public:
     /**
      * Open this dictionary using the following path prefix to where
      * the files are located.  The boolocc idx file is loaded into
-     * memory while the dat file is just opened.
+     * memory while the dat file is just opened. Bit vectors that are
+     * sparse enough are read once and kept resident in compressed form.
      *
      * @param pathPrefix the path prefix to where the boolocc files
      *                   are located.
@@ -56,6 +63,26 @@ public:
      **/
     BitVector::UP lookup(uint64_t wordNum);
 
+    /**
+     * Lookup the given word number and return the associated resident
+     * compressed bit vector, if it was sparse enough to be compressed.
+     *
+     * @param wordNum the word number to lookup a bit vector for.
+     * @return the compressed bit vector or nullptr if not found or not
+     *         sparse enough.
+     **/
+    CompressedBitVector::SP lookup_compressed(uint64_t wordNum) const;
+
+    /**
+     * Returns the number of bytes used by the resident compressed bit vectors.
+     **/
+    size_t getCompressedMemoryUsage() const;
+
+    /**
+     * Check if there is a bit vector for the given word number, without loading it.
+     **/
+    bool hasBitVector(uint64_t wordNum) const;
+
     uint32_t getDocIdLimit() const { return _docIdLimit; }
 
     const std::vector<WordSingleKey> & getEntries() const { return _entries; }
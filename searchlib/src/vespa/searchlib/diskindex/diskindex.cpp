@@ -108,16 +108,20 @@ DiskIndex::openField(const vespalib::string &fieldDir,
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
-            fileHeader.getFormats()[0] ==
-            DiskPostingFileDynamicKReal::getIdentifier() &&
+            (fileHeader.getFormats()[0] ==
+             DiskPostingFileDynamicKReal::getIdentifier(false) ||
+             fileHeader.getFormats()[0] ==
+             DiskPostingFileDynamicKReal::getIdentifier(true)) &&
             fileHeader.getFormats()[1] ==
             DiskPostingFileDynamicKReal::getSubIdentifier()) {
             dynamicK = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
-                   fileHeader.getFormats()[0] ==
-                   DiskPostingFileReal::getIdentifier() &&
+                   (fileHeader.getFormats()[0] ==
+                    DiskPostingFileReal::getIdentifier(false) ||
+                    fileHeader.getFormats()[0] ==
+                    DiskPostingFileReal::getIdentifier(true)) &&
                    fileHeader.getFormats()[1] ==
                    DiskPostingFileReal::getSubIdentifier()) {
             dynamicK = false;
@@ -321,6 +325,25 @@ DiskIndex::readBitVector(const LookupResult &lookupRes) const
     return dict->lookup(lookupRes.wordNum);
 }
 
+CompressedBitVector::SP
+DiskIndex::readCompressedBitVector(const LookupResult &lookupRes) const
+{
+    SchemaUtil::IndexIterator it(_schema, lookupRes.indexId);
+    BitVectorDictionary * dict = _bitVectorDicts[it.getIndex()].get();
+    if (dict == nullptr) {
+        return CompressedBitVector::SP();
+    }
+    return dict->lookup_compressed(lookupRes.wordNum);
+}
+
+bool
+DiskIndex::hasBitVector(const LookupResult &lookupRes) const
+{
+    SchemaUtil::IndexIterator it(_schema, lookupRes.indexId);
+    const BitVectorDictionary * dict = _bitVectorDicts[it.getIndex()].get();
+    return (dict != nullptr) && dict->hasBitVector(lookupRes.wordNum);
+}
+
 void
 DiskIndex::calculateSize()
 {
@@ -369,6 +392,13 @@ private:
     const FieldSpec  &_field;
     const uint32_t    _fieldId;
 
+    bool usePhraseBigrams() const override {
+        return _diskIndex.getSchema().getIndexField(_fieldId).use_phrase_bigrams();
+    }
+    bool hasPhraseBigram(vespalib::stringref first, vespalib::stringref second) const override {
+        return _diskIndex.getSchema().getIndexField(_fieldId).has_phrase_bigram(first, second);
+    }
+
 public:
     CreateBlueprintVisitor(LookupCache & cache, DiskIndex &diskIndex,
                            const IRequestContext & requestContext,
@@ -133,6 +133,22 @@ public:
      */
     BitVector::UP readBitVector(const LookupResult &lookupRes) const;
 
+    /**
+     * Get the resident compressed bit vector corresponding to the given
+     * lookup result, if it was sparse enough to be compressed when the
+     * bit vector dictionary was opened.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     * @return the compressed bit vector or nullptr if no bit vector exists
+     *         for the word in the lookup result or it should not be compressed.
+     */
+    CompressedBitVector::SP readCompressedBitVector(const LookupResult &lookupRes) const;
+
+    /**
+     * Check if a bit vector exists for the word in the given lookup result.
+     */
+    bool hasBitVector(const LookupResult &lookupRes) const;
+
     std::unique_ptr<queryeval::Blueprint> createBlueprint(const queryeval::IRequestContext & requestContext,
                                                           const queryeval::FieldSpec &field,
                                                           const query::Node &term) override;
@@ -2,6 +2,8 @@
 
 #include "disktermblueprint.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/common/compressedbitvectoriterator.h>
+#include <vespa/searchlib/queryeval/cost_model.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
@@ -11,9 +13,12 @@
 LOG_SETUP(".diskindex.disktermblueprint");
 
 using search::BitVectorIterator;
+using search::CompressedBitVectorIterator;
+using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::index::Schema;
 using search::queryeval::BooleanMatchIteratorWrapper;
+using search::queryeval::CostModel;
 using search::queryeval::FieldSpecBase;
 using search::queryeval::FieldSpecBaseList;
 using search::queryeval::SearchIterator;
@@ -43,10 +48,15 @@ DiskTermBlueprint::DiskTermBlueprint(const FieldSpecBase & field,
     _useBitVector(useBitVector),
     _fetchPostingsDone(false),
     _postingHandle(),
-    _bitVector()
+    _bitVector(),
+    _compressedBitVector()
 {
     setEstimate(HitEstimate(_lookupRes->counts._numDocs,
                             _lookupRes->counts._numDocs == 0));
+    if (_useBitVector && _diskIndex.hasBitVector(*_lookupRes)) {
+        // the bit vector is searched instead of the posting list (see createLeafSearch)
+        set_cost(CostModel::bitvector_seek_cost, CostModel::bitvector_next_cost);
+    }
 }
 
 void
@@ -54,21 +64,35 @@ DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
 {
     (void) execInfo;
     if (!_fetchPostingsDone) {
-        _bitVector = _diskIndex.readBitVector(*_lookupRes);
-        if (!_useBitVector || !_bitVector) {
+        // Sparse bit vectors are shared from the compressed copies kept resident by the dictionary.
+        _compressedBitVector = _diskIndex.readCompressedBitVector(*_lookupRes);
+        if (!_compressedBitVector) {
+            _bitVector = _diskIndex.readBitVector(*_lookupRes);
+        }
+        if (!_useBitVector || !hasBitVector()) {
             _postingHandle = _diskIndex.readPostingList(*_lookupRes);
         }
     }
     _fetchPostingsDone = true;
 }
 
+SearchIterator::UP
+DiskTermBlueprint::createBitVectorIterator(TermFieldMatchData &tfmd, bool strict) const
+{
+    if (_compressedBitVector) {
+        return CompressedBitVectorIterator::create(_compressedBitVector.get(), _compressedBitVector->size(), tfmd, strict);
+    }
+    return BitVectorIterator::create(_bitVector.get(), tfmd, strict);
+}
+
 SearchIterator::UP
 DiskTermBlueprint::createLeafSearch(const TermFieldMatchDataArray & tfmda, bool strict) const
 {
-    if (_bitVector && (_useBitVector || tfmda[0]->isNotNeeded())) {
-        LOG(debug, "Return BitVectorIterator: %s, wordNum(%" PRIu64 "), docCount(%" PRIu64 ")",
+    if (hasBitVector() && (_useBitVector || tfmda[0]->isNotNeeded())) {
+        LOG(debug, "Return %s: %s, wordNum(%" PRIu64 "), docCount(%" PRIu64 ")",
+            (_compressedBitVector ? "CompressedBitVectorIterator" : "BitVectorIterator"),
             getName(_lookupRes->indexId).c_str(), _lookupRes->wordNum, _lookupRes->counts._numDocs);
-        return BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict);
+        return createBitVectorIterator(*tfmda[0], strict);
     }
     SearchIterator::UP search(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
     if (_useBitVector) {
@@ -86,8 +110,8 @@ DiskTermBlueprint::createFilterSearch(bool strict, FilterConstraint) const
 {
     auto wrapper = std::make_unique<queryeval::FilterWrapper>(getState().numFields());
     auto & tfmda = wrapper->tfmda();
-    if (_bitVector) {
-        wrapper->wrap(BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict));
+    if (hasBitVector()) {
+        wrapper->wrap(createBitVectorIterator(*tfmda[0], strict));
     } else {
         wrapper->wrap(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
     }
@@ -5,6 +5,8 @@
 #include "diskindex.h"
 #include <vespa/searchlib/queryeval/blueprint.h>
 
+namespace search::fef { class TermFieldMatchData; }
+
 namespace search::diskindex {
 
 /**
@@ -20,6 +22,10 @@ private:
     bool                             _fetchPostingsDone;
     index::PostingListHandle::UP     _postingHandle;
     BitVector::UP                    _bitVector;
+    CompressedBitVector::SP          _compressedBitVector;
+
+    bool hasBitVector() const { return _bitVector || _compressedBitVector; }
+    std::unique_ptr<queryeval::SearchIterator> createBitVectorIterator(fef::TermFieldMatchData &tfmd, bool strict) const;
 
 public:
     /**
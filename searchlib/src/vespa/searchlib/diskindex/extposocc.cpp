@@ -87,16 +87,20 @@ makePosOccRead(const vespalib::string &name,
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
-            fileHeader.getFormats()[0] ==
-            Zc4PosOccSeqRead::getIdentifier(true) &&
+            (fileHeader.getFormats()[0] ==
+             Zc4PosOccSeqRead::getIdentifier(true, false) ||
+             fileHeader.getFormats()[0] ==
+             Zc4PosOccSeqRead::getIdentifier(true, true)) &&
             fileHeader.getFormats()[1] ==
             ZcPosOccSeqRead::getSubIdentifier()) {
             posOccRead = std::make_unique<ZcPosOccSeqRead>(posOccCountRead);
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
-                   fileHeader.getFormats()[0] ==
-                   Zc4PosOccSeqRead::getIdentifier(false) &&
+                   (fileHeader.getFormats()[0] ==
+                    Zc4PosOccSeqRead::getIdentifier(false, false) ||
+                    fileHeader.getFormats()[0] ==
+                    Zc4PosOccSeqRead::getIdentifier(false, true)) &&
                    fileHeader.getFormats()[1] ==
                    Zc4PosOccSeqRead::getSubIdentifier()) {
             posOccRead = std::make_unique<Zc4PosOccSeqRead>(posOccCountRead);
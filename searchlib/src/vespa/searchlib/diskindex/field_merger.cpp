@@ -322,7 +322,7 @@ FieldMerger::open_field_writer()
     }
     SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
     if (!_writer->open(_field_dir + "/", 64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
-                       index.use_interleaved_features(), index.getSchema(),
+                       index.use_interleaved_features(), index.use_block_max(), index.getSchema(),
                        index.getIndex(),
                        field_length_info,
                        _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
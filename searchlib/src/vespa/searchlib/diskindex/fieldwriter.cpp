@@ -39,6 +39,7 @@ FieldWriter::open(const vespalib::string &prefix,
                   uint32_t minChunkDocs,
                   bool dynamicKPosOccFormat,
                   bool encode_interleaved_features,
+                  bool encode_block_max,
                   const Schema &schema,
                   const uint32_t indexId,
                   const FieldLengthInfo &field_length_info,
@@ -64,6 +65,9 @@ FieldWriter::open(const vespalib::string &prefix,
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        if (encode_block_max) {
+            params.set("block_max", encode_block_max);
+        }
     }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
@@ -64,8 +64,9 @@ Fusion::Fusion(const Schema& schema, const vespalib::string& dir,
                const std::vector<vespalib::string>& sources, const SelectorArray& selector,
                const TuneFileIndexing& tuneFileIndexing,
                const FileHeaderContext& fileHeaderContext)
-    : _old_indexes(createInputIndexes(sources, selector)),
-      _fusion_out_index(schema, dir, _old_indexes, calc_trimmed_doc_id_limit(selector, sources), tuneFileIndexing, fileHeaderContext)
+    : _schema(schema),
+      _old_indexes(createInputIndexes(sources, selector)),
+      _fusion_out_index(_schema, dir, _old_indexes, calc_trimmed_doc_id_limit(selector, sources), tuneFileIndexing, fileHeaderContext)
 {
 }
 
@@ -93,6 +94,33 @@ Fusion::checkSchemaCompat()
     return true;
 }
 
+void
+Fusion::adjust_phrase_bigrams()
+{
+    // Phrase bigrams can not be synthesized from source indexes without them,
+    // or with bigrams selected by other common words.
+    for (uint32_t field_id = 0; field_id < _schema.getNumIndexFields(); ++field_id) {
+        auto& field = _schema.getIndexField(field_id);
+        if (!field.use_phrase_bigrams()) {
+            continue;
+        }
+        for (const auto& old_index : _old_indexes) {
+            const Schema& old_schema = old_index.getSchema();
+            uint32_t old_field_id = old_schema.getIndexFieldId(field.getName());
+            if (old_field_id == Schema::UNKNOWN_FIELD_ID) {
+                continue;
+            }
+            auto& old_field = old_schema.getIndexField(old_field_id);
+            if (!old_field.use_phrase_bigrams() || old_field.get_phrase_bigram_words() != field.get_phrase_bigram_words()) {
+                LOG(info, "Disabling phrase bigrams for field '%s', not matching source index '%s'",
+                    field.getName().c_str(), old_index.getPath().c_str());
+                field.set_phrase_bigrams(false);
+                break;
+            }
+        }
+    }
+}
+
 bool
 Fusion::readSchemaFiles()
 {
@@ -126,7 +154,6 @@ Fusion::merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken>
     }
 
     std::filesystem::create_directory(std::filesystem::path(_fusion_out_index.get_path()));
-    _fusion_out_index.get_schema().saveToFile(_fusion_out_index.get_path() + "/schema.txt");
     if (!DocumentSummary::writeDocIdLimit(_fusion_out_index.get_path(), _fusion_out_index.get_doc_id_limit())) {
         LOG(error, "Could not write docsum count in dir %s: %s", _fusion_out_index.get_path().c_str(), getLastErrorString().c_str());
         return false;
@@ -139,6 +166,8 @@ Fusion::merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken>
         if (!readSchemaFiles()) {
             throw IllegalArgumentException("Cannot read schema files for source indexes");
         }
+        adjust_phrase_bigrams();
+        _schema.saveToFile(_fusion_out_index.get_path() + "/schema.txt");
         return mergeFields(shared_executor, flush_token);
     } catch (const std::exception & e) {
         LOG(error, "%s", e.what());
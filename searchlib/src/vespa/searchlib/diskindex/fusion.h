@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fusion_output_index.h"
+#include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/executor.h>
 
 namespace search {
@@ -28,9 +29,11 @@ private:
     bool mergeFields(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
     bool readSchemaFiles();
     bool checkSchemaCompat();
+    void adjust_phrase_bigrams();
 
     const Schema &getSchema() const { return _fusion_out_index.get_schema(); }
 
+    Schema _schema;
     std::vector<FusionInputIndex> _old_indexes;
     FusionOutputIndex _fusion_out_index;
 public:
@@ -107,6 +107,7 @@ FileHandle::open(vespalib::stringref dir,
 
     if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
                             index.use_interleaved_features(),
+                            index.use_block_max(),
                             index.getSchema(), index.getIndex(),
                             field_length_info,
                             tuneFileWrite, fileHeaderContext)) {
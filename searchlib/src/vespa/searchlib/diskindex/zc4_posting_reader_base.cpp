@@ -3,6 +3,7 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -69,6 +70,40 @@ Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
     assert(_zc_buf._valI < _zc_buf._valE);
 }
 
+Zc4PostingReaderBase::BlockMax::BlockMax()
+    : _max_num_occs(0),
+      _min_field_length(std::numeric_limits<uint32_t>::max())
+{
+}
+
+void
+Zc4PostingReaderBase::BlockMax::reset()
+{
+    _max_num_occs = 0;
+    _min_field_length = std::numeric_limits<uint32_t>::max();
+}
+
+void
+Zc4PostingReaderBase::BlockMax::add(const NoSkip &no_skip)
+{
+    _max_num_occs = std::max(_max_num_occs, no_skip.get_num_occs());
+    _min_field_length = std::min(_min_field_length, no_skip.get_field_length());
+}
+
+void
+Zc4PostingReaderBase::BlockMax::read(ZcBuf &zc_buf)
+{
+    _max_num_occs = zc_buf.decode() + 1;
+    _min_field_length = zc_buf.decode() + 1;
+}
+
+void
+Zc4PostingReaderBase::BlockMax::check(const BlockMax &block_max) const
+{
+    assert(_max_num_occs == block_max._max_num_occs);
+    assert(_min_field_length == block_max._min_field_length);
+}
+
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
       _l1_skip_pos(0)
@@ -187,6 +222,8 @@ Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
       _l2_skip(),
       _l3_skip(),
       _l4_skip(),
+      _l1_block_max(),
+      _block_max(),
       _chunkNo(0),
       _features_size(0),
       _counts(),
@@ -203,6 +240,10 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
 {
     // Split docid & features.
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
+        if (_posting_params._encode_block_max) {
+            _l1_block_max.check(_block_max);
+            _block_max.reset();
+        }
         _no_skip.set_features_pos(decode_context.getReadOffset());
         _l1_skip.check(_no_skip, true, _posting_params._encode_features);
         if (_no_skip.get_doc_id() >= _l2_skip.get_doc_id()) {
@@ -218,9 +259,16 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
             _l2_skip.next_skip_entry();
         }
         _l1_skip.next_skip_entry();
+        read_l1_block_max();
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
+    if (_posting_params._encode_block_max) {
+        _block_max.add(_no_skip);
+    }
     if (_residue == 1) {
+        if (_posting_params._encode_block_max && !_l1_block_max.empty()) {
+            _l1_block_max.check(_block_max);
+        }
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
@@ -231,6 +279,14 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
     }
 }
 
+void
+Zc4PostingReaderBase::read_l1_block_max()
+{
+    if (_posting_params._encode_block_max) {
+        _l1_skip.read_block_max(_l1_block_max);
+    }
+}
+
 void
 Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_context, const Zc4PostingHeader &header)
 {
@@ -250,6 +306,9 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
+    if (header._l1_skip_size != 0) {
+        read_l1_block_max();
+    }
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
     _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
@@ -288,6 +347,8 @@ Zc4PostingReaderBase::read_word_start(DecodeContext64Base &decode_context)
            _num_docs >= _posting_params._min_chunk_docs ||
            _has_more);
 
+    _l1_block_max.reset();
+    _block_max.reset();
     if (_num_docs >= _posting_params._min_skip_docs || _has_more) {
         read_word_start_with_skip(decode_context, header);
     }
@@ -52,6 +52,18 @@ protected:
         void set_field_length(uint32_t field_length) { _field_length = field_length; }
         void set_num_occs(uint32_t num_occs)         { _num_occs = num_occs; }
     };
+    // Helper class for block max info stored in L1 skip entries
+    class BlockMax {
+        uint32_t _max_num_occs;
+        uint32_t _min_field_length;
+    public:
+        BlockMax();
+        void reset();
+        void add(const NoSkip &no_skip);
+        void read(ZcBuf &zc_buf);
+        void check(const BlockMax &block_max) const;
+        bool empty() const { return _max_num_occs == 0; }
+    };
     // Helper class for L1 skip info
     class L1Skip : public NoSkipBase {
     protected:
@@ -61,6 +73,7 @@ protected:
         void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
         void next_skip_entry();
+        void read_block_max(BlockMax &block_max) { block_max.read(_zc_buf); }
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip
@@ -102,6 +115,8 @@ protected:
     L2Skip _l2_skip;
     L3Skip _l3_skip;
     L4Skip _l4_skip;
+    BlockMax _l1_block_max;  // block max from current L1 skip entry
+    BlockMax _block_max;     // block max calculated from docs read in current L1 skip block
 
     uint64_t _numWords;     // Number of words in file
     uint32_t _chunkNo;      // Chunk number
@@ -112,6 +127,7 @@ protected:
 
     uint32_t _residue;            // Number of unread documents after word header
     void read_common_word_doc_id(bitcompression::DecodeContext64Base &decode_context);
+    void read_l1_block_max();
     void read_word_start_with_skip(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingHeader &header);
     void read_word_start(bitcompression::DecodeContext64Base &decode_context);
 public:
@@ -3,6 +3,7 @@
 #include "zc4_posting_writer_base.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <limits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -33,12 +34,41 @@ public:
     uint32_t get_feature_pos() const { return _feature_pos; }
 };
 
+/*
+ * Tracks max num occs and min field length for the documents in the
+ * current L1 skip block.
+ */
+class BlockMaxTracker {
+    uint32_t _max_num_occs;
+    uint32_t _min_field_length;
+
+public:
+    BlockMaxTracker()
+        : _max_num_occs(0u),
+          _min_field_length(std::numeric_limits<uint32_t>::max())
+    {
+    }
+
+    void add(const Zc4PostingWriterBase::DocIdAndFeatureSize &doc_id_and_feature_size) {
+        _max_num_occs = std::max(_max_num_occs, doc_id_and_feature_size._num_occs);
+        _min_field_length = std::min(_min_field_length, doc_id_and_feature_size._field_length);
+    }
+    void encode(ZcBuf &zc_buf) {
+        assert(_max_num_occs > 0);
+        zc_buf.encode(_max_num_occs - 1);
+        zc_buf.encode(_min_field_length - 1);
+        *this = BlockMaxTracker();
+    }
+};
+
 class L1SkipEncoder : public DocIdEncoder {
 protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
     const bool _encode_features;
 
+    void encode_skip_doc_id(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
+    void encode_skip_positions(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
 public:
     L1SkipEncoder(bool encode_features)
         : DocIdEncoder(),
@@ -49,10 +79,11 @@ public:
     }
 
     void encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
-    void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
+    void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder, BlockMaxTracker *block_max);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
     void dec_stride_check() { --_stride_check; }
     void write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id);
+    void write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id, BlockMaxTracker *block_max);
     uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
 };
 
@@ -116,7 +147,7 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
 }
 
 void
-L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
+L1SkipEncoder::encode_skip_doc_id(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
     _stride_check = 0;
     // doc id
@@ -124,6 +155,11 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+}
+
+void
+L1SkipEncoder::encode_skip_positions(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
+{
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -135,9 +171,21 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 }
 
 void
-L1SkipEncoder::write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
+L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
-    encode_skip(zc_buf, doc_id_encoder);
+    encode_skip_doc_id(zc_buf, doc_id_encoder);
+    encode_skip_positions(zc_buf, doc_id_encoder);
+}
+
+void
+L1SkipEncoder::write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder, BlockMaxTracker *block_max)
+{
+    encode_skip_doc_id(zc_buf, doc_id_encoder);
+    if (block_max != nullptr) {
+        // block max for the block ending at this skip entry
+        block_max->encode(zc_buf);
+    }
+    encode_skip_positions(zc_buf, doc_id_encoder);
     _l1_skip_pos = zc_buf.size();
 }
 
@@ -149,6 +197,17 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
     }
 }
 
+void
+L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id, BlockMaxTracker *block_max)
+{
+    if (zc_buf.size() > 0) {
+        zc_buf.encode(doc_id - _doc_id - 1);
+        if (block_max != nullptr) {
+            block_max->encode(zc_buf);
+        }
+    }
+}
+
 void
 L2SkipEncoder::encode_skip(ZcBuf &zc_buf, const L1SkipEncoder &l1_skip)
 {
@@ -207,6 +266,7 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -241,6 +301,8 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
+    BlockMaxTracker block_max_tracker;
+    BlockMaxTracker *block_max = get_encode_block_max() ? &block_max_tracker : nullptr;
     l1_skip_encoder.dec_stride_check();
     if (!_counts._segments.empty()) {
         uint32_t doc_id = _counts._segments.back()._lastDoc;
@@ -252,7 +314,7 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     }
     for (const auto &doc_id_and_feature_size : _docIds) {
         if (l1_skip_encoder.should_write_skip(L1SKIPSTRIDE)) {
-            l1_skip_encoder.write_skip(_l1Skip, doc_id_encoder);
+            l1_skip_encoder.write_skip(_l1Skip, doc_id_encoder, block_max);
             if (l2_skip_encoder.should_write_skip(L2SKIPSTRIDE)) {
                 l2_skip_encoder.write_skip(_l2Skip, l1_skip_encoder);
                 if (l3_skip_encoder.should_write_skip(L3SKIPSTRIDE)) {
@@ -264,9 +326,12 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
             }
         }
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        if (block_max != nullptr) {
+            block_max->add(doc_id_and_feature_size);
+        }
     }
     // Extra partial entries for skip tables to simplify iterator during search
-    l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
+    l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id(), block_max);
     l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
     l3_skip_encoder.write_partial_skip(_l3Skip, doc_id_encoder.get_doc_id());
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
@@ -289,6 +354,7 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max", _encode_block_max);
 }
 
 }
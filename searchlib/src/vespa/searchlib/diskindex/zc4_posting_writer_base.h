@@ -44,6 +44,7 @@ protected:
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
     bool _encode_interleaved_features;
+    bool _encode_block_max; // Store max num occs and min field length per L1 skip block
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
     ZcBuf _l2Skip;      // L2 skip info
@@ -73,8 +74,11 @@ public:
     uint64_t get_num_words() const { return _numWords; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    // Block max info is derived from the interleaved features
+    bool get_encode_block_max() const { return _encode_block_max && _encode_interleaved_features; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
+    void set_encode_block_max(bool encode_block_max) { _encode_block_max = encode_block_max; }
     void set_posting_list_params(const index::PostingListParams &params);
 };
 
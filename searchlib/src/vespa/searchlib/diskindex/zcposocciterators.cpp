@@ -37,10 +37,10 @@ ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
                  bool unpack_normal_features, bool unpack_interleaved_features,
                  uint32_t minChunkDocs, const PostingListCounts &counts,
                  const PosOccFieldsParams *fieldsParams,
-                 TermFieldMatchDataArray matchData)
+                 TermFieldMatchDataArray matchData, bool decode_block_max)
     : ZcPostingIterator<bigEndian>(minChunkDocs, dynamic_k, counts, std::move(matchData), start, docIdLimit,
                                    decode_normal_features, decode_interleaved_features,
-                                   unpack_normal_features, unpack_interleaved_features),
+                                   unpack_normal_features, unpack_interleaved_features, decode_block_max),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
     assert(!this->_matchData.valid() || (fieldsParams->getNumFields() == this->_matchData.size()));
@@ -75,11 +75,13 @@ create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Posit
         if (posting_params._dynamic_k) {
             return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit,
                     posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
-                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data),
+                    posting_params._encode_block_max);
         } else {
             return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit,
                     posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
-                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data),
+                    posting_params._encode_block_max);
         }
     }
 }
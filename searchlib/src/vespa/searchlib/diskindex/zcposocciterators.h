@@ -42,7 +42,7 @@ public:
                      bool unpack_normal_features, bool unpack_interleaved_features,
                      uint32_t minChunkDocs, const index::PostingListCounts &counts,
                      const bitcompression::PosOccFieldsParams *fieldsParams,
-                     fef::TermFieldMatchDataArray matchData);
+                     fef::TermFieldMatchDataArray matchData, bool decode_block_max = false);
 };
 
 std::unique_ptr<search::queryeval::SearchIterator>
@@ -26,7 +26,10 @@ namespace {
 
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
+vespalib::string myId4BlockMax("Zc.4.blockmax");
+vespalib::string myId5BlockMax("Zc.5.blockmax");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max("block_max");
 
 }
 
@@ -181,7 +184,7 @@ ZcPosOccRandRead::close()
 
 template <typename DecodeContext>
 void
-ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
+ZcPosOccRandRead::readHeader(const vespalib::string &identifier, const vespalib::string &block_max_identifier)
 {
     DecodeContext d(&_fieldsParams);
     ComprFileReadContext drc(d);
@@ -207,7 +210,8 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     assert(header.hasTag("minSkipDocs"));
     assert(header.getTag("frozen").asInteger() != 0);
     _fileBitSize = header.getTag("fileBitSize").asInteger();
-    assert(header.getTag("format.0").asString() == identifier);
+    const vespalib::string &format = header.getTag("format.0").asString();
+    assert(format == identifier || format == block_max_identifier);
     assert(header.getTag("format.1").asString() == d.getIdentifier());
     _numWords = header.getTag("numWords").asInteger();
     _posting_params._min_chunk_docs = header.getTag("minChunkDocs").asInteger();
@@ -216,6 +220,10 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    if (format == block_max_identifier) {
+        assert(header.hasTag(block_max) && header.getTag(block_max).asInteger() != 0);
+        _posting_params._encode_block_max = true;
+    }
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -228,13 +236,13 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
 void
 ZcPosOccRandRead::readHeader()
 {
-    readHeader<EGPosOccDecodeContext<true>>(myId5);
+    readHeader<EGPosOccDecodeContext<true>>(myId5, myId5BlockMax);
 }
 
 const vespalib::string &
-ZcPosOccRandRead::getIdentifier()
+ZcPosOccRandRead::getIdentifier(bool block_max)
 {
-    return myId5;
+    return block_max ? myId5BlockMax : myId5;
 }
 
 
@@ -263,13 +271,13 @@ Zc4PosOccRandRead()
 void
 Zc4PosOccRandRead::readHeader()
 {
-    readHeader<EG2PosOccDecodeContext<true> >(myId4);
+    readHeader<EG2PosOccDecodeContext<true> >(myId4, myId4BlockMax);
 }
 
 const vespalib::string &
-Zc4PosOccRandRead::getIdentifier()
+Zc4PosOccRandRead::getIdentifier(bool block_max)
 {
-    return myId4;
+    return block_max ? myId4BlockMax : myId4;
 }
 
 const vespalib::string &
@@ -46,9 +46,9 @@ public:
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
     template <typename DecodeContext>
-    void readHeader(const vespalib::string &identifier);
+    void readHeader(const vespalib::string &identifier, const vespalib::string &block_max_identifier);
     virtual void readHeader();
-    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getIdentifier(bool block_max);
     static const vespalib::string &getSubIdentifier();
     const index::FieldLengthInfo &get_field_length_info() const override;
 };
@@ -61,7 +61,7 @@ public:
 
     void readHeader() override;
 
-    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getIdentifier(bool block_max);
     static const vespalib::string &getSubIdentifier();
 };
 
@@ -16,7 +16,10 @@ namespace {
 
 vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
+vespalib::string myId5BlockMax("Zc.5.blockmax");
+vespalib::string myId4BlockMax("Zc.4.blockmax");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max("block_max");
 
 }
 
@@ -121,6 +124,7 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max, _reader.get_posting_params()._encode_block_max);
 }
 
 
@@ -136,8 +140,6 @@ Zc4PostingSeqRead::readHeader()
 {
     FeatureDecodeContextBE &d = _reader.get_decode_features();
     auto &posting_params = _reader.get_posting_params();
-    const vespalib::string &myId = posting_params._dynamic_k ? myId5 : myId4;
-
     vespalib::FileHeader header;
     d.readHeader(header, _file.getSize());
     uint32_t headerLen = header.getSize();
@@ -157,8 +159,9 @@ Zc4PostingSeqRead::readHeader()
     assert(completed);
     (void) completed;
     assert(_fileBitSize >= 8 * headerLen);
-    assert(header.getTag("format.0").asString() == myId);
-    (void) myId;
+    const vespalib::string &format = header.getTag("format.0").asString();
+    bool encode_block_max = (format == getIdentifier(posting_params._dynamic_k, true));
+    assert(encode_block_max || format == getIdentifier(posting_params._dynamic_k, false));
     assert(header.getTag("format.1").asString() == d.getIdentifier());
     _numWords = header.getTag("numWords").asInteger();
     posting_params._min_chunk_docs = header.getTag("minChunkDocs").asInteger();
@@ -167,6 +170,10 @@ Zc4PostingSeqRead::readHeader()
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
        posting_params._encode_interleaved_features = true;
     }
+    if (encode_block_max) {
+       assert(header.hasTag(block_max) && header.getTag(block_max).asInteger() != 0);
+       posting_params._encode_block_max = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -178,8 +185,11 @@ Zc4PostingSeqRead::readHeader()
 
 
 const vespalib::string &
-Zc4PostingSeqRead::getIdentifier(bool dynamic_k)
+Zc4PostingSeqRead::getIdentifier(bool dynamic_k, bool block_max)
 {
+    if (block_max) {
+        return (dynamic_k ? myId5BlockMax : myId4BlockMax);
+    }
     return (dynamic_k ? myId5 : myId4);
 }
 
@@ -224,7 +234,8 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     EncodeContext &e = _writer.get_encode_context();
     ComprFileWriteContext &wce = _writer.get_write_context();
 
-    const vespalib::string &myId = _writer.get_dynamic_k() ? myId5 : myId4;
+    // Files with block max info get their own format id since older readers would misparse the L1 skip entries
+    const vespalib::string &myId = Zc4PostingSeqRead::getIdentifier(_writer.get_dynamic_k(), _writer.get_encode_block_max());
     vespalib::FileHeader header;
 
     typedef vespalib::GenericHeader::Tag Tag;
@@ -234,6 +245,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag("block_max", _writer.get_encode_block_max() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -355,6 +367,7 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max, _writer.get_encode_block_max());
 }
 
 
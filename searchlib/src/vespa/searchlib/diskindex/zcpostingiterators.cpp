@@ -158,6 +158,18 @@ void ZcRareWordPostingIteratorBase<bigEndian>::rewind(Position start)
     _decodeContext->setPosition(start);
 }
 
+template <bool bigEndian>
+queryeval::IBlockMaxSearch::Block
+ZcRareWordPostingIteratorBase<bigEndian>::seek_block(uint32_t docId)
+{
+    // No skip info, but posting list is short. Use a single document block with exact bounds.
+    seek(docId);
+    if (isAtEnd()) {
+        return Block{search::endDocId, 0u, 1u};
+    }
+    return Block{getDocId(), _num_occs, _field_length};
+}
+
 template <bool bigEndian, bool dynamic_k>
 void
 ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLimit)
@@ -189,7 +201,8 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
-                                             bool unpack_normal_features, bool unpack_interleaved_features)
+                                             bool unpack_normal_features, bool unpack_interleaved_features,
+                                             bool decode_block_max)
     : ZcIteratorBase(std::move(matchData), start, docIdLimit),
       _valI(nullptr),
       _valIBase(nullptr),
@@ -205,6 +218,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _decode_block_max(decode_block_max && decode_interleaved_features),
       _chunkNo(0),
       _field_length(0),
       _num_occs(0)
@@ -219,10 +233,12 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   search::fef::TermFieldMatchDataArray matchData,
                   Position start, uint32_t docIdLimit,
                   bool decode_normal_features, bool decode_interleaved_features,
-                  bool unpack_normal_features, bool unpack_interleaved_features)
+                  bool unpack_normal_features, bool unpack_interleaved_features,
+                  bool decode_block_max)
     : ZcPostingIteratorBase(std::move(matchData), start, docIdLimit,
                             decode_normal_features, decode_interleaved_features,
-                            unpack_normal_features, unpack_interleaved_features),
+                            unpack_normal_features, unpack_interleaved_features,
+                            decode_block_max),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -311,6 +327,7 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
+    _l1.setupBlockMax(_decode_block_max);
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
     _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
@@ -385,7 +402,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    _l1.nextDocIdAndBlockMax(_decode_block_max);
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +451,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    _l1.nextDocIdAndBlockMax(_decode_block_max);
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -478,7 +495,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    _l1.nextDocIdAndBlockMax(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -504,7 +521,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry(_decode_normal_features);
-        _l1.nextDocId();
+        _l1.nextDocIdAndBlockMax(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -526,6 +543,18 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
 }
 
 
+queryeval::IBlockMaxSearch::Block
+ZcPostingIteratorBase::seek_block(uint32_t docId)
+{
+    if (docId > _l1._skipDocId) {
+        doL1SkipSeek(docId);
+    }
+    if (isAtEnd()) {
+        return Block{search::endDocId, 0u, 1u};
+    }
+    return Block{_l1._skipDocId, _l1._maxNumOccs, _l1._minFieldLength};
+}
+
 void
 ZcPostingIteratorBase::doSeek(uint32_t docId)
 {
@@ -5,6 +5,8 @@
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/iblock_max_search.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -55,7 +57,8 @@ private:
 };
 
 template <bool bigEndian>
-class ZcRareWordPostingIteratorBase : public ZcIteratorBase
+class ZcRareWordPostingIteratorBase : public ZcIteratorBase,
+                                      public queryeval::IBlockMaxSearch
 {
 private:
     typedef ZcIteratorBase ParentClass;
@@ -80,6 +83,10 @@ public:
 
     void doUnpack(uint32_t docId) override;
     void rewind(Position start) override;
+    Block seek_block(uint32_t docId) override;
+    uint32_t get_num_occs() const override { return _num_occs; }
+    uint32_t get_field_length() const override { return _field_length; }
+    bool has_interleaved_features() const override { return _decode_interleaved_features; }
 };
 
 template <bool dynamic_k> class ZcPostingDocIdKParam;
@@ -134,7 +141,8 @@ public:
     void readWordStart(uint32_t docIdLimit) override;
 };
 
-class ZcPostingIteratorBase : public ZcIteratorBase
+class ZcPostingIteratorBase : public ZcIteratorBase,
+                              public queryeval::IBlockMaxSearch
 {
 protected:
     const uint8_t *_valI;     // docid deltas
@@ -150,13 +158,18 @@ protected:
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
         const uint8_t *_valIBase;
+        // Block max for block ending at _skipDocId, only used at L1
+        uint32_t _maxNumOccs;
+        uint32_t _minFieldLength;
 
         L1Skip()
             : _skipDocId(0),
               _valI(nullptr),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
-              _valIBase(nullptr)
+              _valIBase(nullptr),
+              _maxNumOccs(std::numeric_limits<uint32_t>::max()),
+              _minFieldLength(1)
         {
         }
 
@@ -184,6 +197,25 @@ protected:
         void nextDocId() {
             ZCDECODE(_valI, _skipDocId += 1 +);
         }
+        void decodeBlockMax() {
+            ZCDECODE(_valI, _maxNumOccs = 1 +);
+            ZCDECODE(_valI, _minFieldLength = 1 +);
+        }
+        void nextDocIdAndBlockMax(bool decode_block_max) {
+            nextDocId();
+            if (decode_block_max) {
+                decodeBlockMax();
+            }
+        }
+        void setupBlockMax(bool decode_block_max) {
+            if (decode_block_max && _valI != nullptr) {
+                decodeBlockMax();
+            } else {
+                // Unknown bounds
+                _maxNumOccs = std::numeric_limits<uint32_t>::max();
+                _minFieldLength = 1;
+            }
+        }
     };
 
     // Helper class for L2 skip info
@@ -278,6 +310,7 @@ protected:
     bool     _decode_interleaved_features;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
+    bool     _decode_block_max;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
@@ -301,7 +334,12 @@ protected:
 public:
     ZcPostingIteratorBase(fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features);
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          bool decode_block_max);
+    Block seek_block(uint32_t docId) override;
+    uint32_t get_num_occs() const override { return _num_occs; }
+    uint32_t get_field_length() const override { return _field_length; }
+    bool has_interleaved_features() const override { return _decode_interleaved_features; }
 };
 
 template <bool bigEndian>
@@ -330,7 +368,8 @@ public:
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       search::fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                       bool decode_normal_features, bool decode_interleaved_features,
-                      bool unpack_normal_features, bool unpack_interleaved_features);
+                      bool unpack_normal_features, bool unpack_interleaved_features,
+                      bool decode_block_max = false);
 
 
     void doUnpack(uint32_t docId) override;
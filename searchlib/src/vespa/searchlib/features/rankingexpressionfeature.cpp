@@ -76,6 +76,8 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(const double *columns, size_t column_stride, double *result, size_t num_rows) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -195,6 +197,17 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(const double *columns, size_t column_stride, double *result, size_t num_rows)
+{
+    for (size_t row = 0; row < num_rows; ++row) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = columns[i * column_stride + row];
+        }
+        result[row] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
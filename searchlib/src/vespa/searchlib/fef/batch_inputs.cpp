@@ -0,0 +1,31 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch_inputs.h"
+#include <algorithm>
+
+namespace search::fef {
+
+BatchInputs::BatchInputs(const FeatureExecutor &executor, size_t max_rows)
+    : _max_rows(max_rows),
+      _columns(executor.inputs().size() * max_rows, 0.0),
+      _executors(),
+      _copies()
+{
+    auto inputs = executor.inputs().get_bound();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        feature_t *column = &_columns[i * _max_rows];
+        if (inputs[i].is_const()) {
+            std::fill(column, column + _max_rows, inputs[i].get_raw()->as_number);
+        } else {
+            FeatureExecutor *input_executor = inputs[i].get_executor();
+            if (std::find(_executors.begin(), _executors.end(), input_executor) == _executors.end()) {
+                _executors.push_back(input_executor);
+            }
+            _copies.push_back(Copy{inputs[i].get_raw(), column});
+        }
+    }
+}
+
+BatchInputs::~BatchInputs() = default;
+
+}
@@ -0,0 +1,45 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+#include <vector>
+
+namespace search::fef {
+
+/**
+ * Collects the inputs of a feature executor supporting batch
+ * execution for up to max_rows documents, storing them in one column
+ * buffer per input as expected by FeatureExecutor::execute_batch.
+ *
+ * Constant inputs are filled in up front. For each document, every
+ * distinct executor producing inputs is run once, after which all
+ * input values are copied into their columns in a single pass.
+ **/
+class BatchInputs {
+private:
+    struct Copy {
+        const NumberOrObject *src;
+        feature_t            *dst;
+    };
+    size_t                         _max_rows;
+    std::vector<feature_t>         _columns;
+    std::vector<FeatureExecutor *> _executors;
+    std::vector<Copy>              _copies;
+
+public:
+    BatchInputs(const FeatureExecutor &executor, size_t max_rows);
+    ~BatchInputs();
+    void collect(uint32_t docid, size_t row) {
+        for (FeatureExecutor *executor: _executors) {
+            executor->lazy_execute(docid);
+        }
+        for (const Copy &copy: _copies) {
+            copy.dst[row] = copy.src->as_number;
+        }
+    }
+    const feature_t *columns() const { return _columns.data(); }
+    size_t column_stride() const { return _max_rows; }
+};
+
+}
@@ -3,6 +3,9 @@
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".fef.featureexecutor");
+
 namespace search::fef {
 
 FeatureExecutor::FeatureExecutor() = default;
@@ -20,6 +23,18 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(const feature_t *, size_t, feature_t *, size_t)
+{
+    LOG_ABORT("should not be reached");
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
@@ -31,6 +31,8 @@ public:
     bool is_same(const LazyValue &rhs) const {
         return ((_value == rhs._value) && (_executor == rhs._executor));
     }
+    FeatureExecutor *get_executor() const { return _executor; }
+    const NumberOrObject *get_raw() const { return _value; }
     inline double as_number(uint32_t docid) const;
     inline vespalib::eval::Value::CREF as_object(uint32_t docid) const;
 };
@@ -53,7 +55,9 @@ public:
         uint32_t get_docid() const { return _docid; }
         void bind(vespalib::ConstArrayRef<LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
+        inline feature_t get_number(size_t idx, uint32_t docid) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        vespalib::ConstArrayRef<LazyValue> get_bound() const { return _inputs; }
         size_t size() const { return _inputs.size(); }
     };
 
@@ -150,6 +154,32 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor supports batch execution. An
+     * executor supporting batch execution calculates a single number
+     * from numeric inputs only, and is able to do so for multiple
+     * documents in a single call to execute_batch. This is used to
+     * reduce per-document overhead when ranking.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Calculate the output of this executor for multiple documents
+     * whose inputs were collected with BatchInputs. Input values are
+     * stored in one column per input; the value of input i for row j
+     * is found at columns[i * column_stride + j]. Only called if
+     * supports_batch returns true.
+     *
+     * @param columns input values for all documents
+     * @param column_stride distance between the start of each column
+     * @param result where to store the output for each document
+     * @param num_rows number of documents
+     **/
+    virtual void execute_batch(const feature_t *columns, size_t column_stride,
+                               feature_t *result, size_t num_rows);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -187,6 +217,10 @@ feature_t FeatureExecutor::Inputs::get_number(size_t idx) const {
     return _inputs[idx].as_number(_docid);
 }
 
+feature_t FeatureExecutor::Inputs::get_number(size_t idx, uint32_t docid) const {
+    return _inputs[idx].as_number(docid);
+}
+
 vespalib::eval::Value::CREF FeatureExecutor::Inputs::get_object(size_t idx) const {
     return _inputs[idx].as_object(_docid);
 }
@@ -419,6 +419,28 @@ GlobalFilterUpperLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string WeakAndBlockMax::NAME("vespa.matching.weakand.block_max");
+const bool WeakAndBlockMax::DEFAULT_VALUE(false);
+bool WeakAndBlockMax::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const vespalib::string WeakAndAverageFieldLength::NAME("vespa.matching.weakand.average_field_length");
+
+const double WeakAndAverageFieldLength::DEFAULT_VALUE(100.0);
+
+double
+WeakAndAverageFieldLength::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+WeakAndAverageFieldLength::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
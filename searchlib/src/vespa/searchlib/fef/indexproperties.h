@@ -318,6 +318,29 @@ namespace matching {
         static double lookup(const Properties &props);
         static double lookup(const Properties &props, double defaultValue);
     };
+
+    /**
+     * When enabled, weakAnd is evaluated as block-max WAND, skipping
+     * posting list blocks that cannot produce a hit. Only disk index
+     * fields with block max info in the posting lists benefit.
+     **/
+    struct WeakAndBlockMax {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * The average field length used by block-max weakAnd when
+     * normalizing term frequencies.
+     **/
+    struct WeakAndAverageFieldLength {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
 }
 
 namespace softtimeout {
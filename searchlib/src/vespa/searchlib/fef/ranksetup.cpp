@@ -68,6 +68,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutFactor(0.5),
       _global_filter_lower_limit(0.0),
       _global_filter_upper_limit(1.0),
+      _weak_and_block_max(false),
+      _weak_and_average_field_length(100.0),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
       _mutateOnSecondPhase(),
@@ -122,6 +124,8 @@ RankSetup::configure()
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_upper_limit(matching::GlobalFilterUpperLimit::lookup(_indexEnv.getProperties()));
+    set_weak_and_block_max(matching::WeakAndBlockMax::check(_indexEnv.getProperties()));
+    set_weak_and_average_field_length(matching::WeakAndAverageFieldLength::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
@@ -78,6 +78,8 @@ private:
     double                   _softTimeoutFactor;
     double                   _global_filter_lower_limit;
     double                   _global_filter_upper_limit;
+    bool                     _weak_and_block_max;
+    double                   _weak_and_average_field_length;
     MutateOperation          _mutateOnMatch;
     MutateOperation          _mutateOnFirstPhase;
     MutateOperation          _mutateOnSecondPhase;
@@ -413,6 +415,11 @@ public:
     void set_global_filter_upper_limit(double v) { _global_filter_upper_limit = v; }
     double get_global_filter_upper_limit() const { return _global_filter_upper_limit; }
 
+    void set_weak_and_block_max(bool v) { _weak_and_block_max = v; }
+    bool get_weak_and_block_max() const { return _weak_and_block_max; }
+    void set_weak_and_average_field_length(double v) { _weak_and_average_field_length = v; }
+    double get_weak_and_average_field_length() const { return _weak_and_average_field_length; }
+
     /**
      * This method may be used to indicate that certain features
      * should be dumped during a full feature dump.
@@ -0,0 +1,38 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search::index {
+
+/**
+ * Synthetic words used to index adjacent word pairs for index fields
+ * with phrase bigrams enabled.
+ *
+ * Only pairs where at least one of the words is a configured common word
+ * are indexed (see Schema::IndexField::has_phrase_bigram), as these are the
+ * pairs with long posting lists for the original words.
+ *
+ * A bigram is indexed at the word position of its first word. A phrase
+ * can thus be evaluated with each such pair replaced by its bigram, with
+ * far shorter posting lists than the original common words.
+ *
+ * The bigram word starts with a separator character that is never part
+ * of a tokenized word, so bigrams can not be matched by ordinary terms.
+ */
+struct PhraseBigram {
+    static constexpr char separator = '\x1f';
+
+    static vespalib::string make(vespalib::stringref first, vespalib::stringref second) {
+        vespalib::string word;
+        word.reserve(first.size() + second.size() + 2);
+        word.push_back(separator);
+        word.append(first);
+        word.push_back(separator);
+        word.append(second);
+        return word;
+    }
+};
+
+}
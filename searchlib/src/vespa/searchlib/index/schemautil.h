@@ -87,6 +87,10 @@ public:
             return _schema.getIndexField(_index).use_interleaved_features();
         }
 
+        bool use_block_max() const {
+            return _schema.getIndexField(_index).use_block_max();
+        }
+
         IndexIterator &operator++() {
             if (_index < _schema.getNumIndexFields()) {
                 ++_index;
@@ -15,6 +15,7 @@
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/searchlib/index/phrase_bigram.h>
 #include <vespa/searchlib/util/url.h>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -46,6 +47,7 @@ using document::StringFieldValue;
 using document::StructFieldValue;
 using document::WeightedSetFieldValue;
 using index::DocIdAndPosOccFeatures;
+using index::PhraseBigram;
 using index::Schema;
 using search::index::schema::CollectionType;
 using search::util::URL;
@@ -134,6 +136,7 @@ FieldInverter::processAnnotations(const StringFieldValue &value)
         }
     }
     std::sort(_terms.begin(), _terms.end());
+    uint32_t firstPosIdx = _positions.size();
     SpanTermVector::const_iterator it  = _terms.begin();
     SpanTermVector::const_iterator ite = _terms.end();
     uint32_t wordRef;
@@ -160,6 +163,39 @@ FieldInverter::processAnnotations(const StringFieldValue &value)
             mustStep = false;
         }
     }
+    if (_phrase_bigrams) {
+        addPhraseBigrams(firstPosIdx);
+    }
+}
+
+void
+FieldInverter::addPhraseBigrams(uint32_t firstPosIdx)
+{
+    // Positions for the current element are ordered by word position,
+    // with all alternatives (e.g. stems) at a given position adjacent.
+    // Only pairs involving a configured common word are indexed.
+    const auto & field = _schema.getIndexField(_fieldId);
+    uint32_t endPosIdx = _positions.size();
+    uint32_t nextPosIdx = firstPosIdx;
+    for (uint32_t i = firstPosIdx; i < endPosIdx; ++i) {
+        uint32_t wordPos = _positions[i]._wordPos;
+        while (nextPosIdx < endPosIdx && _positions[nextPosIdx]._wordPos <= wordPos) {
+            ++nextPosIdx;
+        }
+        for (uint32_t j = nextPosIdx; j < endPosIdx && _positions[j]._wordPos == wordPos + 1; ++j) {
+            vespalib::stringref first = getWordFromRef(_positions[i]._wordNum);
+            vespalib::stringref second = getWordFromRef(_positions[j]._wordNum);
+            if (!field.has_phrase_bigram(first, second)) {
+                continue;
+            }
+            // Word buffer might be reallocated by saveWord(), copy the bigram first.
+            vespalib::string bigram = PhraseBigram::make(first, second);
+            uint32_t wordRef = saveWord(bigram);
+            if (wordRef != 0u) {
+                _positions.emplace_back(wordRef, _docId, _elem, wordPos, _elems.size() - 1);
+            }
+        }
+    }
 }
 
 void
@@ -357,6 +393,7 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _docId(0),
       _oldPosSize(0),
       _schema(schema),
+      _phrase_bigrams(schema.getIndexField(fieldId).use_phrase_bigrams()),
       _words(),
       _elems(),
       _positions(),
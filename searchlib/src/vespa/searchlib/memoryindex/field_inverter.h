@@ -173,6 +173,7 @@ private:
     uint32_t                       _oldPosSize;
 
     const index::Schema           &_schema;
+    bool                           _phrase_bigrams;
 
     WordBuffer                     _words;
     ElemInfoVec                    _elems;
@@ -249,6 +250,12 @@ private:
 
     void stepWordPos() { ++_wpos; }
 
+    /**
+     * Add phrase bigrams for adjacent words in the current element,
+     * based on the positions added starting at the given index.
+     */
+    VESPA_DLL_LOCAL void addPhraseBigrams(uint32_t firstPosIdx);
+
 public:
     VESPA_DLL_LOCAL void
     processAnnotations(const document::StringFieldValue &value);
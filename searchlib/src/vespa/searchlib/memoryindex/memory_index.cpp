@@ -139,17 +139,25 @@ private:
     const FieldSpec &_field;
     const uint32_t   _fieldId;
     FieldIndexCollection &_fieldIndexes;
+    const Schema::IndexField &_indexField;
+
+    bool usePhraseBigrams() const override { return _indexField.use_phrase_bigrams(); }
+    bool hasPhraseBigram(vespalib::stringref first, vespalib::stringref second) const override {
+        return _indexField.has_phrase_bigram(first, second);
+    }
 
 public:
     CreateBlueprintVisitor(Searchable &searchable,
                            const IRequestContext & requestContext,
                            const FieldSpec &field,
                            uint32_t fieldId,
-                           FieldIndexCollection &fieldIndexes)
+                           FieldIndexCollection &fieldIndexes,
+                           const Schema::IndexField &indexField)
         : CreateBlueprintVisitorHelper(searchable, field, requestContext),
           _field(field),
           _fieldId(fieldId),
-          _fieldIndexes(fieldIndexes) {}
+          _fieldIndexes(fieldIndexes),
+          _indexField(indexField) {}
 
     template <class TermNode>
     void visitTerm(TermNode &n) {
@@ -190,7 +198,8 @@ MemoryIndex::createBlueprint(const IRequestContext & requestContext,
     if (fieldId == Schema::UNKNOWN_FIELD_ID || _hiddenFields[fieldId]) {
         return std::make_unique<EmptyBlueprint>(field);
     }
-    CreateBlueprintVisitor visitor(*this, requestContext, field, fieldId, *_fieldIndexes);
+    CreateBlueprintVisitor visitor(*this, requestContext, field, fieldId, *_fieldIndexes,
+                                   _schema.getIndexField(fieldId));
     const_cast<Node &>(term).accept(visitor);
     return visitor.getResult();
 }
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "posting_iterator.h"
+#include <vespa/searchlib/queryeval/idocid_block_search.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/vespalib/btree/btreeiterator.hpp>
@@ -21,7 +22,8 @@ namespace search::memoryindex {
  * The template parameter specifies whether the wrapped posting list has interleaved features or not.
  */
 template <bool interleaved_features>
-class PostingIteratorBase : public queryeval::RankedSearchIteratorBase {
+class PostingIteratorBase : public queryeval::RankedSearchIteratorBase,
+                            public queryeval::IDocidBlockSearch {
 protected:
     using FieldIndexType = FieldIndex<interleaved_features>;
     using PostingListIteratorType = typename FieldIndexType::PostingList::ConstIterator;
@@ -39,6 +41,7 @@ public:
     void doSeek(uint32_t docId) override;
     void initRange(uint32_t begin, uint32_t end) override;
     Trinary is_strict() const override { return Trinary::True; }
+    uint32_t fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids) override;
 };
 
 template <bool interleaved_features>
@@ -86,6 +89,30 @@ PostingIteratorBase<interleaved_features>::doSeek(uint32_t docId)
     }
 }
 
+template <bool interleaved_features>
+uint32_t
+PostingIteratorBase<interleaved_features>::fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids)
+{
+    if (isAtEnd()) {
+        return 0;
+    }
+    if (getUnpacked()) {
+        clearUnpacked();
+    }
+    end_id = std::min(end_id, getEndId());
+    uint32_t num = 0;
+    while (num < max_docids && _itr.valid() && _itr.getKey() < end_id) {
+        dst[num++] = _itr.getKey();
+        ++_itr;
+    }
+    if (!_itr.valid() || isAtEnd(_itr.getKey())) {
+        setAtEnd();
+    } else {
+        setDocId(_itr.getKey());
+    }
+    return num;
+}
+
 /**
  * Search iterator over memory field index posting list.
  *
@@ -15,6 +15,7 @@
 #include <vespa/vespalib/objects/object2slime.h>
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <limits>
 #include <map>
 
 #include <vespa/log/log.h>
@@ -87,6 +88,8 @@ Blueprint::sat_sum(const std::vector<HitEstimate> &data, uint32_t docid_limit)
 Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
+      _cost(CostModel::posting_seek_cost),
+      _strict_cost(0.0),
       _cost_tier(COST_TIER_NORMAL),
       _tree_size(1),
       _allow_termwise_eval(true),
@@ -110,6 +113,7 @@ Blueprint::UP
 Blueprint::optimize(Blueprint::UP bp) {
     Blueprint *root = bp.release();
     root->optimize(root);
+    root->optimize_strict_order(true);
     return Blueprint::UP(root);
 }
 
@@ -118,6 +122,25 @@ Blueprint::optimize_self()
 {
 }
 
+void
+Blueprint::optimize_strict_order(bool)
+{
+}
+
+double
+Blueprint::cost_per_miss() const
+{
+    double miss_ratio = 1.0 - hit_ratio();
+    return (miss_ratio > 0.0) ? (cost() / miss_ratio) : std::numeric_limits<double>::max();
+}
+
+double
+Blueprint::cost_per_hit() const
+{
+    double ratio = hit_ratio();
+    return (ratio > 0.0) ? (cost() / ratio) : std::numeric_limits<double>::max();
+}
+
 Blueprint::UP
 Blueprint::get_replacement()
 {
@@ -232,6 +255,8 @@ Blueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     visitor.openStruct("estimate", "HitEstimate");
     visitor.visitBool("empty", state.estimate().empty);
     visitor.visitInt("estHits", state.estimate().estHits);
+    visitor.visitFloat("cost", state.cost());
+    visitor.visitFloat("strict_cost", state.strict_cost());
     visitor.visitInt("cost_tier", state.cost_tier());
     visitor.visitInt("tree_size", state.tree_size());
     visitor.visitInt("allow_termwise_eval", state.allow_termwise_eval());
@@ -278,6 +303,7 @@ IntermediateBlueprint::setDocIdLimit(uint32_t limit)
     for (Blueprint * child : _children) {
         child->setDocIdLimit(limit);
     }
+    notifyChange();
 }
 
 Blueprint::HitEstimate
@@ -301,6 +327,26 @@ IntermediateBlueprint::calculate_cost_tier() const
     return cost_tier;
 }
 
+double
+IntermediateBlueprint::calculate_cost() const
+{
+    double cost = 0.0;
+    for (const Blueprint * child : _children) {
+        cost += child->cost();
+    }
+    return cost;
+}
+
+double
+IntermediateBlueprint::calculate_strict_cost() const
+{
+    double cost = 0.0;
+    for (size_t i = 0; i < _children.size(); ++i) {
+        cost += inheritStrict(i) ? _children[i]->strict_cost() : _children[i]->cost();
+    }
+    return cost;
+}
+
 uint32_t
 IntermediateBlueprint::calculate_tree_size() const
 {
@@ -398,6 +444,8 @@ IntermediateBlueprint::calculateState() const
 {
     State state(exposeFields());
     state.estimate(calculateEstimate());
+    state.cost(calculate_cost());
+    state.strict_cost(calculate_strict_cost());
     state.cost_tier(calculate_cost_tier());
     state.allow_termwise_eval(infer_allow_termwise_eval());
     state.want_global_filter(infer_want_global_filter());
@@ -440,6 +488,21 @@ IntermediateBlueprint::optimize(Blueprint* &self)
     maybe_eliminate_self(self, get_replacement());
 }
 
+void
+IntermediateBlueprint::optimize_strict_order(bool strict)
+{
+    sort(_children);
+    if (strict) {
+        sort_strict(_children);
+    }
+    notifyChange();
+    if (should_optimize_children()) {
+        for (size_t i = 0; i < _children.size(); ++i) {
+            _children[i]->optimize_strict_order(strict && inheritStrict(i));
+        }
+    }
+}
+
 void
 IntermediateBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
@@ -587,7 +650,9 @@ IntermediateBlueprint::calculateUnpackInfo(const fef::MatchData & md) const
 //-----------------------------------------------------------------------------
 
 LeafBlueprint::LeafBlueprint(const FieldSpecBaseList &fields, bool allow_termwise_eval)
-    : _state(fields)
+    : _state(fields),
+      _next_cost(CostModel::posting_next_cost),
+      _scan(false)
 {
     _state.allow_termwise_eval(allow_termwise_eval);
 }
@@ -626,10 +691,43 @@ LeafBlueprint::optimize(Blueprint* &self)
     maybe_eliminate_self(self, get_replacement());
 }
 
+void
+LeafBlueprint::update_strict_cost()
+{
+    _state.strict_cost(_scan ? _state.cost() : (hit_ratio() * _next_cost));
+}
+
+void
+LeafBlueprint::setDocIdLimit(uint32_t limit)
+{
+    Blueprint::setDocIdLimit(limit);
+    update_strict_cost();
+}
+
 void
 LeafBlueprint::setEstimate(HitEstimate est)
 {
     _state.estimate(est);
+    update_strict_cost();
+    notifyChange();
+}
+
+void
+LeafBlueprint::set_cost(double cost, double next_cost)
+{
+    _state.cost(cost);
+    _next_cost = next_cost;
+    _scan = false;
+    update_strict_cost();
+    notifyChange();
+}
+
+void
+LeafBlueprint::set_scan_cost(double cost)
+{
+    _state.cost(cost);
+    _scan = true;
+    update_strict_cost();
     notifyChange();
 }
 
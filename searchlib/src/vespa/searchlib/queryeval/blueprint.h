@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "cost_model.h"
 #include "field_spec.h"
 #include "unpackinfo.h"
 #include "executeinfo.h"
@@ -65,6 +66,8 @@ public:
     private:
         FieldSpecBaseList _fields;
         HitEstimate       _estimate;
+        double            _cost;
+        double            _strict_cost;
         uint32_t          _cost_tier;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
@@ -103,6 +106,12 @@ public:
             uint32_t total_docs = std::max(total_hits, docid_limit);
             return (total_docs == 0) ? 0.0 : double(total_hits) / double(total_docs);
         }
+        // expected cost of checking a single candidate document (non-strict)
+        void cost(double value) { _cost = value; }
+        double cost() const { return _cost; }
+        // expected cost of producing all hits (strict), normalized by docid limit
+        void strict_cost(double value) { _strict_cost = value; }
+        double strict_cost() const { return _strict_cost; }
         void tree_size(uint32_t value) { _tree_size = value; }
         uint32_t tree_size() const { return _tree_size; }
         void allow_termwise_eval(bool value) { _allow_termwise_eval = value; }
@@ -149,6 +158,42 @@ public:
         }
     };
 
+    // utility to sort children of AND-like operators first by cost
+    // tier and then by expected cost per eliminated candidate
+    struct TieredLessCostPerMiss {
+        bool operator () (Blueprint * const &a, Blueprint * const &b) const {
+            const auto &lhs = a->getState();
+            const auto &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            double lhs_rank = a->cost_per_miss();
+            double rhs_rank = b->cost_per_miss();
+            if (lhs_rank != rhs_rank) {
+                return (lhs_rank < rhs_rank);
+            }
+            return (lhs.estimate() < rhs.estimate());
+        }
+    };
+
+    // utility to sort children of OR-like operators first by cost
+    // tier and then by expected cost per accepted candidate
+    struct TieredLessCostPerHit {
+        bool operator () (Blueprint * const &a, Blueprint * const &b) const {
+            const auto &lhs = a->getState();
+            const auto &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            double lhs_rank = a->cost_per_hit();
+            double rhs_rank = b->cost_per_hit();
+            if (lhs_rank != rhs_rank) {
+                return (lhs_rank < rhs_rank);
+            }
+            return (rhs.estimate() < lhs.estimate());
+        }
+    };
+
 private:
     Blueprint *_parent;
     uint32_t   _sourceId;
@@ -197,6 +242,9 @@ public:
     static Blueprint::UP optimize(Blueprint::UP bp);
     virtual void optimize(Blueprint* &self) = 0;
     virtual void optimize_self();
+    // Strictness flows from the root, so children to be evaluated
+    // strict are selected top-down after the tree has been optimized.
+    virtual void optimize_strict_order(bool strict);
     virtual Blueprint::UP get_replacement();
     virtual bool should_optimize_children() const { return true; }
 
@@ -218,6 +266,12 @@ public:
     const Blueprint &root() const;
 
     double hit_ratio() const { return getState().hit_ratio(_docid_limit); }        
+    double cost() const { return getState().cost(); }
+    double strict_cost() const { return getState().strict_cost(); }
+    // expected cost to eliminate a candidate when used as an AND child
+    double cost_per_miss() const;
+    // expected cost to accept a candidate when used as an OR child
+    double cost_per_hit() const;
 
     virtual void fetchPostings(const ExecuteInfo &execInfo) = 0;
     virtual void freeze() = 0;
@@ -285,6 +339,8 @@ private:
     HitEstimate calculateEstimate() const;
     uint32_t calculate_cost_tier() const;
     uint32_t calculate_tree_size() const;
+    virtual double calculate_cost() const;
+    virtual double calculate_strict_cost() const;
     bool infer_allow_termwise_eval() const;
     bool infer_want_global_filter() const;
 
@@ -312,6 +368,7 @@ public:
     void setDocIdLimit(uint32_t limit) final;
 
     void optimize(Blueprint* &self) final;
+    void optimize_strict_order(bool strict) final;
     void set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio) override;
 
     IndexList find(const IPredicate & check) const;
@@ -326,6 +383,8 @@ public:
     virtual HitEstimate combine(const std::vector<HitEstimate> &data) const = 0;
     virtual FieldSpecBaseList exposeFields() const = 0;
     virtual void sort(std::vector<Blueprint*> &children) const = 0;
+    // re-arrange sorted children when this blueprint is evaluated strict
+    virtual void sort_strict(std::vector<Blueprint*> &children) const { (void) children; }
     virtual bool inheritStrict(size_t i) const = 0;
     virtual SearchIteratorUP
     createIntermediateSearch(MultiSearch::Children subSearches,
@@ -343,11 +402,18 @@ public:
 class LeafBlueprint : public Blueprint
 {
 private:
-    State _state;
+    State  _state;
+    double _next_cost;
+    bool   _scan;
+    void update_strict_cost();
 
 protected:
     void optimize(Blueprint* &self) final;
     void setEstimate(HitEstimate est);
+    // cost of checking a candidate and of producing each hit when strict
+    void set_cost(double cost, double next_cost);
+    // strict evaluation needs to check every document (no posting list)
+    void set_scan_cost(double cost);
     void set_cost_tier(uint32_t value);
     void set_allow_termwise_eval(bool value);
     void set_want_global_filter(bool value);
@@ -357,7 +423,7 @@ protected:
 public:
     ~LeafBlueprint() override;
     const State &getState() const final { return _state; }
-    void setDocIdLimit(uint32_t limit) final { Blueprint::setDocIdLimit(limit); }
+    void setDocIdLimit(uint32_t limit) final;
     void fetchPostings(const ExecuteInfo &execInfo) override;
     void freeze() final;
     SearchIteratorUP createSearch(fef::MatchData &md, bool strict) const override;
@@ -0,0 +1,39 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+namespace search::queryeval {
+
+/**
+ * Relative costs used by blueprints to estimate how expensive it is
+ * to evaluate a query tree. The unit is the cost of checking whether
+ * a single candidate document is part of a posting list
+ * (non-strict seek). The numbers were measured with the cost model
+ * benchmark in searchlib/src/tests/queryeval/cost_model (1M docs,
+ * every 7th docid as candidate for non-strict seek, hit ratios 0.001,
+ * 0.01, 0.1 and 0.5, times summed over hit ratios and normalized by
+ * posting seek), median of 3 runs on a single cpu x86_64 host with
+ * -O2, rounded. Re-run the benchmark when the iterators change.
+ *
+ * Non-strict cost is the expected cost of checking a single
+ * candidate document. Strict cost is the expected cost of producing
+ * all hits, normalized by the size of the docid space.
+ **/
+struct CostModel {
+    // checking a candidate document against a posting list
+    static constexpr double posting_seek_cost = 1.0;
+    // producing the next hit from a posting list (strict iteration)
+    static constexpr double posting_next_cost = 1.0;
+    // checking a candidate document against a bitvector
+    static constexpr double bitvector_seek_cost = 0.4;
+    // producing the next hit from a bitvector (strict iteration)
+    static constexpr double bitvector_next_cost = 0.7;
+    // checking a candidate document against an attribute without posting lists
+    static constexpr double attribute_seek_cost = 0.4;
+    // checking a candidate document against attribute posting lists (fast-search)
+    static constexpr double attribute_posting_seek_cost = 0.75;
+    // producing the next hit from attribute posting lists (strict iteration)
+    static constexpr double attribute_posting_next_cost = 0.5;
+};
+
+}
@@ -9,6 +9,7 @@
 #include "simple_phrase_blueprint.h"
 #include "weighted_set_term_blueprint.h"
 #include "split_float.h"
+#include <vespa/searchlib/index/phrase_bigram.h>
 
 namespace search::queryeval {
 
@@ -29,8 +30,53 @@ CreateBlueprintVisitorHelper::getResult()
         : std::make_unique<EmptyBlueprint>(_field);
 }
 
+bool
+CreateBlueprintVisitorHelper::allTermsAreStrings(const query::Phrase &n) const {
+    for (const query::Node * child : n.getChildren()) {
+        if (dynamic_cast<const query::StringTerm *>(child) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+CreateBlueprintVisitorHelper::visitPhraseBigrams(query::Phrase &n) {
+    // Bigram i is indexed at the position of word i. Word i is kept where
+    // pair i has no bigram, and the last word is kept when the last pair
+    // has no bigram, so the terms are at consecutive positions and cover
+    // all words of a matching phrase.
+    const auto & children = n.getChildren();
+    auto phrase = std::make_unique<SimplePhraseBlueprint>(_field, n.is_expensive());
+    bool covered_last = false;
+    for (size_t i = 1; i < children.size(); ++i) {
+        const auto & first = static_cast<const query::StringTerm &>(*children[i - 1]);
+        const auto & second = static_cast<const query::StringTerm &>(*children[i]);
+        FieldSpecList fields;
+        fields.add(phrase->getNextChildField(_field));
+        covered_last = hasPhraseBigram(first.getTerm(), second.getTerm());
+        if (covered_last) {
+            query::SimpleStringTerm node(index::PhraseBigram::make(first.getTerm(), second.getTerm()),
+                                         n.getView(), 0, query::Weight(0));
+            phrase->addTerm(_searchable.createBlueprint(_requestContext, fields, node));
+        } else {
+            phrase->addTerm(_searchable.createBlueprint(_requestContext, fields, first));
+        }
+    }
+    if (!covered_last) {
+        FieldSpecList fields;
+        fields.add(phrase->getNextChildField(_field));
+        phrase->addTerm(_searchable.createBlueprint(_requestContext, fields, *children.back()));
+    }
+    setResult(std::move(phrase));
+}
+
 void
 CreateBlueprintVisitorHelper::visitPhrase(query::Phrase &n) {
+    if (usePhraseBigrams() && (n.getChildren().size() > 1) && allTermsAreStrings(n)) {
+        visitPhraseBigrams(n);
+        return;
+    }
     auto phrase = std::make_unique<SimplePhraseBlueprint>(_field, n.is_expensive());
     for (const query::Node * child : n.getChildren()) {
         FieldSpecList fields;
@@ -24,9 +24,21 @@ private:
     FieldSpec               _field;
     std::unique_ptr<Blueprint>  _result;
 
+    bool allTermsAreStrings(const query::Phrase &n) const;
+    void visitPhraseBigrams(query::Phrase &n);
+
 protected:
     const IRequestContext & getRequestContext() const { return _requestContext; }
 
+    /**
+     * Override to return true when the index field has phrase bigrams
+     * (see index::PhraseBigram). Phrases are then searched as phrases
+     * over bigrams instead of over the original words, for the word
+     * pairs accepted by hasPhraseBigram().
+     **/
+    virtual bool usePhraseBigrams() const { return false; }
+    virtual bool hasPhraseBigram(vespalib::stringref, vespalib::stringref) const { return false; }
+
 public:
     CreateBlueprintVisitorHelper(Searchable &searchable, const FieldSpec &field, const IRequestContext & requestContext);
     ~CreateBlueprintVisitorHelper() override;
@@ -0,0 +1,250 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "docid_intersection_search.h"
+#include "idocid_block_search.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace search::queryeval {
+
+namespace {
+
+// gallop through b when it is much larger than a
+constexpr uint32_t gallop_ratio = 32;
+
+// max docids decoded from a non-first child per docid in the current block
+constexpr uint32_t child_fetch_factor = 8;
+constexpr uint32_t child_fetch_slack = 64;
+
+// blocks checked by seeking a non-first child before its docids are decoded again to refresh its density
+constexpr uint32_t density_refresh_interval = 16;
+
+using v8u32 = uint32_t __attribute__((vector_size(32)));
+
+uint32_t
+intersect_galloping(const uint32_t *a, uint32_t a_size, const uint32_t *b, uint32_t b_size, uint32_t *dst)
+{
+    uint32_t num = 0;
+    const uint32_t *pos = b;
+    const uint32_t *end = b + b_size;
+    for (uint32_t i = 0; i < a_size; ++i) {
+        uint32_t key = a[i];
+        const uint32_t *lo = pos;
+        size_t step = 1;
+        while (lo + step < end && lo[step] < key) {
+            lo += step;
+            step <<= 1;
+        }
+        pos = std::lower_bound(lo, std::min(lo + step, end), key);
+        if (pos == end) {
+            break;
+        }
+        if (*pos == key) {
+            dst[num++] = key;
+        }
+    }
+    return num;
+}
+
+uint32_t
+intersect_blocks(const uint32_t *a, uint32_t a_size, const uint32_t *b, uint32_t b_size, uint32_t *dst)
+{
+    uint32_t num = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < a_size && j + 8 <= b_size) {
+        uint32_t key = a[i];
+        if (b[j + 7] < key) {
+            j += 8;
+            continue;
+        }
+        // key is present iff it is in this block; compare all lanes at once
+        v8u32 block;
+        memcpy(&block, b + j, sizeof(block));
+        v8u32 keys = {key, key, key, key, key, key, key, key};
+        v8u32 eq = (v8u32)(block == keys);
+        uint32_t any = 0;
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            any |= eq[lane];
+        }
+        dst[num] = key;
+        num += (any & 1);
+        ++i;
+    }
+    while (i < a_size && j < b_size) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            dst[num++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return num;
+}
+
+}
+
+uint32_t
+intersect_docids(const uint32_t *a, uint32_t a_size, const uint32_t *b, uint32_t b_size, uint32_t *dst)
+{
+    if (b_size > gallop_ratio * a_size) {
+        return intersect_galloping(a, a_size, b, b_size, dst);
+    }
+    return intersect_blocks(a, a_size, b, b_size, dst);
+}
+
+bool
+DocidIntersectionSearch::can_intersect(const Children &children)
+{
+    if (children.size() < 2) {
+        return false;
+    }
+    return std::all_of(children.begin(), children.end(), [](const auto &child) {
+        return dynamic_cast<IDocidBlockSearch *>(child.get()) != nullptr;
+    });
+}
+
+DocidIntersectionSearch::DocidIntersectionSearch(Children children)
+    : AndSearch(std::move(children)),
+      _block_children(),
+      _density(),
+      _seek_blocks(),
+      _hits(block_size),
+      _buf(child_fetch_factor * block_size + child_fetch_slack),
+      _num_hits(0),
+      _pos(0)
+{
+    for (const auto &child : getChildren()) {
+        _block_children.push_back(dynamic_cast<IDocidBlockSearch *>(child.get()));
+        assert(_block_children.back() != nullptr);
+    }
+    _density.resize(_block_children.size(), 0.0);
+    _seek_blocks.resize(_block_children.size(), 0);
+}
+
+DocidIntersectionSearch::~DocidIntersectionSearch() = default;
+
+uint32_t
+DocidIntersectionSearch::seek_child(SearchIterator &child, uint32_t begin, uint32_t end, uint32_t num)
+{
+    for (uint32_t i = begin; i < end; ++i) {
+        if (child.seek(_hits[i])) {
+            _hits[num++] = _hits[i];
+        }
+    }
+    return num;
+}
+
+uint32_t
+DocidIntersectionSearch::intersect_child(size_t idx, uint32_t num_hits)
+{
+    SearchIterator &child = *getChildren()[idx];
+    uint32_t first = _hits[0];
+    uint32_t last = _hits[num_hits - 1];
+    child.seek(first);
+    if (child.isAtEnd()) {
+        return 0;
+    }
+    uint32_t max_docids = std::min(child_fetch_factor * num_hits + child_fetch_slack, uint32_t(_buf.size()));
+    if ((_density[idx] * (last - first + 1) > max_docids) && (++_seek_blocks[idx] < density_refresh_interval)) {
+        // child is much denser than the current hits; seeking is cheaper than decoding
+        return seek_child(child, 0, num_hits, 0);
+    }
+    _seek_blocks[idx] = 0;
+    uint32_t num_docids = _block_children[idx]->fetch_docids(last + 1, _buf.data(), max_docids);
+    if (child.isAtEnd() || child.getDocId() > last) {
+        _density[idx] = double(num_docids) / (last - first + 1);
+        return intersect_docids(_hits.data(), num_hits, _buf.data(), num_docids, _hits.data());
+    }
+    // could not decode the full range; intersect the decoded part
+    // and check the remaining hits using seek
+    _density[idx] = double(num_docids) / std::max(child.getDocId() - first, 1u);
+    uint32_t split = std::lower_bound(_hits.data(), _hits.data() + num_hits, child.getDocId()) - _hits.data();
+    uint32_t num = intersect_docids(_hits.data(), split, _buf.data(), num_docids, _hits.data());
+    return seek_child(child, split, num_hits, num);
+}
+
+bool
+DocidIntersectionSearch::fill(uint32_t docid)
+{
+    const Children &children = getChildren();
+    SearchIterator &first = *children[0];
+    first.seek(docid);
+    for (;;) {
+        for (const auto &child : children) {
+            if (child->isAtEnd()) {
+                return false;
+            }
+        }
+        uint32_t num = _block_children[0]->fetch_docids(getEndId(), _hits.data(), block_size);
+        for (size_t i = 1; num > 0 && i < children.size(); ++i) {
+            num = intersect_child(i, num);
+        }
+        if (num > 0) {
+            _num_hits = num;
+            _pos = 0;
+            return true;
+        }
+    }
+}
+
+void
+DocidIntersectionSearch::doSeek(uint32_t docid)
+{
+    _pos = std::lower_bound(_hits.data() + _pos, _hits.data() + _num_hits, docid) - _hits.data();
+    if (_pos < _num_hits) {
+        setDocId(_hits[_pos]);
+    } else if (fill(docid)) {
+        setDocId(_hits[0]);
+    } else {
+        _num_hits = 0;
+        _pos = 0;
+        setAtEnd();
+    }
+}
+
+void
+DocidIntersectionSearch::doUnpack(uint32_t)
+{
+}
+
+SearchIterator::UP
+DocidIntersectionSearch::andWith(UP filter, uint32_t)
+{
+    // children run ahead of this iterator, so they cannot take filters
+    return filter;
+}
+
+void
+DocidIntersectionSearch::initRange(uint32_t begin, uint32_t end)
+{
+    AndSearch::initRange(begin, end);
+    _num_hits = 0;
+    _pos = 0;
+    doSeek(begin);
+}
+
+std::unique_ptr<BitVector>
+DocidIntersectionSearch::get_hits(uint32_t begin_id)
+{
+    return SearchIterator::get_hits(begin_id);
+}
+
+void
+DocidIntersectionSearch::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    SearchIterator::or_hits_into(result, begin_id);
+}
+
+void
+DocidIntersectionSearch::and_hits_into(BitVector &result, uint32_t begin_id)
+{
+    SearchIterator::and_hits_into(result, begin_id);
+}
+
+}
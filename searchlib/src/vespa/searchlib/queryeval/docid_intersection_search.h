@@ -0,0 +1,70 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "andsearch.h"
+#include <vector>
+
+namespace search::queryeval {
+
+struct IDocidBlockSearch;
+
+/**
+ * Intersect two sorted docid arrays. The result is written to dst,
+ * which may be the same array as a (but not b). Selects between a
+ * vectorized block merge and galloping search depending on the
+ * relative sizes of the arrays.
+ *
+ * @return number of docids written to dst
+ **/
+uint32_t intersect_docids(const uint32_t *a, uint32_t a_size,
+                          const uint32_t *b, uint32_t b_size,
+                          uint32_t *dst);
+
+/**
+ * Strict AND over children that are able to decode blocks of docids
+ * (see IDocidBlockSearch). Docids are decoded from the first child
+ * in blocks and intersected with the corresponding docid ranges of
+ * the other children using array kernels, avoiding the per-document
+ * virtual seek calls done by AndSearchStrict. Children are never
+ * unpacked, so this is only used when no child needs unpacking.
+ **/
+class DocidIntersectionSearch : public AndSearch
+{
+private:
+    std::vector<IDocidBlockSearch *> _block_children;
+    std::vector<double>              _density;
+    std::vector<uint32_t>            _seek_blocks;
+    std::vector<uint32_t>            _hits;
+    std::vector<uint32_t>            _buf;
+    uint32_t                         _num_hits;
+    uint32_t                         _pos;
+
+    bool fill(uint32_t docid);
+    uint32_t seek_child(SearchIterator &child, uint32_t begin, uint32_t end, uint32_t num);
+    uint32_t intersect_child(size_t idx, uint32_t num_hits);
+
+protected:
+    void doSeek(uint32_t docid) override;
+    void doUnpack(uint32_t docid) override;
+    UP andWith(UP filter, uint32_t estimate) override;
+    Trinary is_strict() const override { return Trinary::True; }
+
+public:
+    static constexpr uint32_t block_size = 256;
+
+    // true if all children can decode blocks of docids
+    static bool can_intersect(const Children &children);
+
+    explicit DocidIntersectionSearch(Children children);
+    ~DocidIntersectionSearch() override;
+
+    void initRange(uint32_t begin, uint32_t end) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    // children are also accessed through their block interface
+    void transform_children(const ChildTransform &) override {}
+};
+
+}
@@ -1,3 +1,67 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "global_filter.h"
+#include "blueprint.h"
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
+
+namespace search::queryeval {
+
+namespace {
+
+// Avoid splitting the docid space into ranges too small to be worth a thread.
+constexpr uint32_t min_docs_per_thread = 64 * 1024;
+
+std::unique_ptr<SearchIterator>
+make_filter_iterator(const Blueprint &blueprint, uint32_t begin_id, uint32_t end_id)
+{
+    auto filter_iterator = blueprint.createFilterSearch(true, Blueprint::FilterConstraint::UPPER_BOUND);
+    filter_iterator->initRange(begin_id, end_id);
+    return filter_iterator;
+}
+
+struct MakePart : vespalib::Runnable {
+    const Blueprint &blueprint;
+    uint32_t begin_id;
+    uint32_t end_id;
+    BitVector &result;
+    MakePart(const Blueprint &blueprint_in, uint32_t begin_id_in, uint32_t end_id_in, BitVector &result_in) noexcept
+      : blueprint(blueprint_in), begin_id(begin_id_in), end_id(end_id_in), result(result_in) {}
+    void run() override {
+        auto part = make_filter_iterator(blueprint, begin_id, end_id)->get_hits(begin_id);
+        result.copyWordsFrom(*part, begin_id, end_id);
+    }
+};
+
+}
+
+std::shared_ptr<GlobalFilter>
+GlobalFilter::calculate(const Blueprint &blueprint, uint32_t docid_limit, vespalib::ThreadBundle &thread_bundle)
+{
+    uint32_t num_docs = (docid_limit > 1) ? (docid_limit - 1) : 0;
+    size_t num_threads = std::min(thread_bundle.size(), size_t(num_docs / min_docs_per_thread));
+    if (num_threads <= 1) {
+        return create(make_filter_iterator(blueprint, 1, docid_limit)->get_hits(1));
+    }
+    // Range sizes are rounded up to whole words, so that all threads write disjoint words.
+    constexpr uint32_t word_bits = 64;
+    uint32_t per_thread = (docid_limit + num_threads - 1) / num_threads;
+    per_thread = ((per_thread + word_bits - 1) / word_bits) * word_bits;
+    auto result = BitVector::create(docid_limit);
+    std::vector<MakePart> parts;
+    parts.reserve(num_threads);
+    for (uint32_t begin_id = 1; begin_id < docid_limit; ) {
+        uint32_t end_id = std::min(docid_limit, ((begin_id / per_thread) + 1) * per_thread);
+        parts.emplace_back(blueprint, begin_id, end_id, *result);
+        begin_id = end_id;
+    }
+    std::vector<vespalib::Runnable*> targets;
+    for (auto &part : parts) {
+        targets.push_back(&part);
+    }
+    thread_bundle.run(targets);
+    result->invalidateCachedCount();
+    return create(std::move(result));
+}
+
+}
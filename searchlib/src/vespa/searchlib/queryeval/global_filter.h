@@ -5,8 +5,12 @@
 #include <memory>
 #include <vespa/searchlib/common/bitvector.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace search::queryeval {
 
+class Blueprint;
+
 /**
  * Hold ownership of a global filter that can be taken
  * into account by adaptive query operators.  The owned
@@ -38,6 +42,16 @@ public:
         return std::make_shared<GlobalFilter>(ctor_tag(), std::forward<Params>(params)...);
     }
 
+    /**
+     * Create a global filter by evaluating the filter part of the
+     * given blueprint for all documents in [1, docid_limit>. The
+     * docid space is split into word aligned ranges that are
+     * evaluated in parallel by the threads in the given bundle, each
+     * writing directly into its own part of the resulting bitvector.
+     **/
+    static std::shared_ptr<GlobalFilter> calculate(const Blueprint &blueprint, uint32_t docid_limit,
+                                                   vespalib::ThreadBundle &thread_bundle);
+
     const search::BitVector *filter() const { return bit_vector.get(); }
 
     bool has_filter() const { return bool(bit_vector); }
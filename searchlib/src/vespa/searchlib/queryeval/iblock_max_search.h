@@ -0,0 +1,41 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Interface implemented by search iterators over posting lists that
+ * store score bounds per block of documents (block-max metadata).
+ *
+ * Used by block-max WAND to skip entire blocks that cannot contain a
+ * document scoring above the current threshold.
+ */
+struct IBlockMaxSearch {
+    /**
+     * Score bounds for the documents in the block ending at last_doc_id.
+     * max_num_occs == 0 means that no documents remain.
+     */
+    struct Block {
+        uint32_t last_doc_id;
+        uint32_t max_num_occs;
+        uint32_t min_field_length;
+    };
+    virtual ~IBlockMaxSearch() = default;
+    /**
+     * Shallow seek to the block containing the given docid. The
+     * iterator might move forward to the start of that block, but
+     * never past the first document >= docid. Documents inside the
+     * block are not decoded.
+     */
+    virtual Block seek_block(uint32_t docid) = 0;
+    // Interleaved features for the current document
+    virtual uint32_t get_num_occs() const = 0;
+    virtual uint32_t get_field_length() const = 0;
+    // False if posting list lacks interleaved features, other methods are then unusable
+    virtual bool has_interleaved_features() const = 0;
+};
+
+}
@@ -0,0 +1,32 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Interface implemented by strict search iterators over posting
+ * lists that can decode blocks of docids into a flat array without
+ * going through seek for each document. Seeking must always leave
+ * the iterator at the first docid not less than the seek target,
+ * also when the iterator is not strict.
+ *
+ * Used by DocidIntersectionSearch to intersect posting lists with
+ * array kernels instead of leapfrogging with seek.
+ */
+struct IDocidBlockSearch {
+    virtual ~IDocidBlockSearch() = default;
+    /**
+     * Decode up to max_docids docids, starting at the current docid
+     * of the iterator and stopping before end_id. The iterator is
+     * left positioned at the first docid not returned (or at end).
+     * Match data is not unpacked for the returned docids.
+     *
+     * @return number of docids written to dst
+     */
+    virtual uint32_t fetch_docids(uint32_t end_id, uint32_t *dst, uint32_t max_docids) = 0;
+};
+
+}
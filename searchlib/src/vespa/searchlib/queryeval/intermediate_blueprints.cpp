@@ -3,6 +3,7 @@
 #include "intermediate_blueprints.h"
 #include "andnotsearch.h"
 #include "andsearch.h"
+#include "docid_intersection_search.h"
 #include "orsearch.h"
 #include "nearsearch.h"
 #include "ranksearch.h"
@@ -11,6 +12,7 @@
 #include "isourceselector.h"
 #include "field_spec.hpp"
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <algorithm>
 
 namespace search::queryeval {
 
@@ -69,6 +71,61 @@ void optimize_source_blenders(IntermediateBlueprint &self, size_t begin_idx) {
     }
 }
 
+// non-strict cost of children[begin..] when all children see all candidates
+double sum_cost(const std::vector<Blueprint*> &children, size_t begin) {
+    double cost = 0.0;
+    for (size_t i = begin; i < children.size(); ++i) {
+        cost += children[i]->cost();
+    }
+    return cost;
+}
+
+// expected non-strict cost of children[begin..] when each child only
+// sees candidates accepted by all previous children (skipping one child)
+double and_cost(const std::vector<Blueprint*> &children, size_t begin, size_t skip = -1) {
+    double cost = 0.0;
+    double pass = 1.0;
+    for (size_t i = begin; i < children.size(); ++i) {
+        if (i != skip) {
+            cost += pass * children[i]->cost();
+            pass *= children[i]->hit_ratio();
+        }
+    }
+    return cost;
+}
+
+// expected non-strict cost of children[begin..] when each child only
+// sees candidates rejected by all previous children
+double or_cost(const std::vector<Blueprint*> &children, size_t begin) {
+    double cost = 0.0;
+    double pass = 1.0;
+    for (size_t i = begin; i < children.size(); ++i) {
+        cost += pass * children[i]->cost();
+        pass *= (1.0 - children[i]->hit_ratio());
+    }
+    return cost;
+}
+
+// move the child that is cheapest to evaluate strict (driving the
+// evaluation of the remaining children) to the front. Only children
+// in the lowest cost tier are considered.
+void select_strict_and_child(std::vector<Blueprint*> &children) {
+    if (children.size() < 2) {
+        return;
+    }
+    uint32_t cost_tier = children[0]->getState().cost_tier();
+    size_t best_idx = 0;
+    double best_cost = 0.0;
+    for (size_t i = 0; i < children.size() && children[i]->getState().cost_tier() == cost_tier; ++i) {
+        double cost = children[i]->strict_cost() + children[i]->hit_ratio() * and_cost(children, 0, i);
+        if (i == 0 || cost < best_cost) {
+            best_idx = i;
+            best_cost = cost;
+        }
+    }
+    std::rotate(children.begin(), children.begin() + best_idx, children.begin() + best_idx + 1);
+}
+
 void
 need_normal_features_for_children(const IntermediateBlueprint &blueprint, fef::MatchData &md)
 {
@@ -149,7 +206,7 @@ void
 AndNotBlueprint::sort(std::vector<Blueprint*> &children) const
 {
     if (children.size() > 2) {
-        std::sort(children.begin() + 1, children.end(), TieredGreaterEstimate());
+        std::sort(children.begin() + 1, children.end(), TieredLessCostPerHit());
     }
 }
 
@@ -159,6 +216,26 @@ AndNotBlueprint::inheritStrict(size_t i) const
     return (i == 0);
 }
 
+double
+AndNotBlueprint::calculate_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->cost() + children[0]->hit_ratio() * or_cost(children, 1);
+}
+
+double
+AndNotBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->strict_cost() + children[0]->hit_ratio() * or_cost(children, 1);
+}
+
 SearchIterator::UP
 AndNotBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                           bool strict, search::fef::MatchData &md) const
@@ -250,7 +327,13 @@ AndBlueprint::get_replacement()
 void
 AndBlueprint::sort(std::vector<Blueprint*> &children) const
 {
-    std::sort(children.begin(), children.end(), TieredLessEstimate());
+    std::sort(children.begin(), children.end(), TieredLessCostPerMiss());
+}
+
+void
+AndBlueprint::sort_strict(std::vector<Blueprint*> &children) const
+{
+    select_strict_and_child(children);
 }
 
 bool
@@ -259,6 +342,22 @@ AndBlueprint::inheritStrict(size_t i) const
     return (i == 0);
 }
 
+double
+AndBlueprint::calculate_cost() const
+{
+    return and_cost(get_children(), 0);
+}
+
+double
+AndBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->strict_cost() + children[0]->hit_ratio() * and_cost(children, 1);
+}
+
 SearchIterator::UP
 AndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                        bool strict, search::fef::MatchData & md) const
@@ -276,6 +375,8 @@ AndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
         } else {
             search = AndSearch::create(std::move(rearranged), strict, helper.termwise_unpack);
         }
+    } else if (strict && unpack_info.empty() && DocidIntersectionSearch::can_intersect(sub_searches)) {
+        search = std::make_unique<DocidIntersectionSearch>(std::move(sub_searches));
     } else {
         search = AndSearch::create(std::move(sub_searches), strict, unpack_info);
     }
@@ -341,7 +442,13 @@ OrBlueprint::get_replacement()
 void
 OrBlueprint::sort(std::vector<Blueprint*> &children) const
 {
-    std::sort(children.begin(), children.end(), TieredGreaterEstimate());
+    std::sort(children.begin(), children.end(), TieredLessCostPerHit());
+}
+
+double
+OrBlueprint::calculate_cost() const
+{
+    return or_cost(get_children(), 0);
 }
 
 bool
@@ -434,6 +541,11 @@ WeakAndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                    _weights[i],
                                    getChild(i).getState().estimate().estHits));
     }
+    if (_use_block_max) {
+        WeakAndSearch::BlockMaxParams params;
+        params.avg_field_length = _avg_field_length;
+        return WeakAndSearch::create_block_max(terms, _n, strict, params);
+    }
     return WeakAndSearch::create(terms, _n, strict);
 }
 
@@ -464,7 +576,23 @@ NearBlueprint::exposeFields() const
 void
 NearBlueprint::sort(std::vector<Blueprint*> &children) const
 {
-    std::sort(children.begin(), children.end(), TieredLessEstimate());
+    std::sort(children.begin(), children.end(), TieredLessCostPerMiss());
+}
+
+double
+NearBlueprint::calculate_cost() const
+{
+    return and_cost(get_children(), 0);
+}
+
+double
+NearBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->strict_cost() + children[0]->hit_ratio() * and_cost(children, 1);
 }
 
 bool
@@ -613,6 +741,26 @@ RankBlueprint::inheritStrict(size_t i) const
     return (i == 0);
 }
 
+double
+RankBlueprint::calculate_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->cost() + children[0]->hit_ratio() * sum_cost(children, 1);
+}
+
+double
+RankBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    if (children.empty()) {
+        return 0.0;
+    }
+    return children[0]->strict_cost() + children[0]->hit_ratio() * sum_cost(children, 1);
+}
+
 SearchIterator::UP
 RankBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                         bool strict, search::fef::MatchData & md) const
@@ -676,6 +824,17 @@ SourceBlenderBlueprint::inheritStrict(size_t) const
     return true;
 }
 
+double
+SourceBlenderBlueprint::calculate_cost() const
+{
+    // each candidate is only checked against the child for its source
+    double cost = 0.0;
+    for (const Blueprint * child : get_children()) {
+        cost = std::max(cost, child->cost());
+    }
+    return cost;
+}
+
 class FindSource : public Blueprint::IPredicate
 {
 public:
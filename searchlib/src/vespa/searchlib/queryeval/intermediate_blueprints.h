@@ -29,6 +29,8 @@ public:
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
 private:
     bool isPositive(size_t index) const override { return index == 0; }
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -44,6 +46,7 @@ public:
     bool isAnd() const override { return true; }
     Blueprint::UP get_replacement() override;
     void sort(std::vector<Blueprint*> &children) const override;
+    void sort_strict(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
     createIntermediateSearch(MultiSearch::Children subSearches,
@@ -52,6 +55,8 @@ public:
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
 private:
     double computeNextHitRate(const Blueprint & child, double hitRate) const override;
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -74,6 +79,8 @@ public:
                              bool strict, fef::MatchData &md) const override;
     SearchIterator::UP
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
+private:
+    double calculate_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -83,6 +90,8 @@ class WeakAndBlueprint : public IntermediateBlueprint
 private:
     uint32_t              _n;
     std::vector<uint32_t> _weights;
+    bool                  _use_block_max;
+    double                _avg_field_length;
 
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -95,7 +104,7 @@ public:
                              bool strict, fef::MatchData &md) const override;
     SearchIterator::UP createFilterSearch(bool strict, FilterConstraint constraint) const override;
 
-    WeakAndBlueprint(uint32_t n) : _n(n) {}
+    WeakAndBlueprint(uint32_t n) : _n(n), _use_block_max(false), _avg_field_length(100.0) {}
     ~WeakAndBlueprint();
     void addTerm(Blueprint::UP bp, uint32_t weight) {
         addChild(std::move(bp));
@@ -103,6 +112,12 @@ public:
     }
     uint32_t getN() const { return _n; }
     const std::vector<uint32_t> &getWeights() const { return _weights; }
+    // Evaluate using block-max weak and (see WeakAndSearch::create_block_max)
+    void set_use_block_max(bool use_block_max, double avg_field_length) {
+        _use_block_max = use_block_max;
+        _avg_field_length = avg_field_length;
+    }
+    bool use_block_max() const { return _use_block_max; }
 };
 
 //-----------------------------------------------------------------------------
@@ -125,6 +140,9 @@ public:
     SearchIterator::UP createFilterSearch(bool strict, FilterConstraint constraint) const override;
 
     NearBlueprint(uint32_t window) : _window(window) {}
+private:
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -166,6 +184,9 @@ public:
                              bool strict, fef::MatchData &md) const override;
     SearchIterator::UP
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
+private:
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -196,6 +217,8 @@ public:
     /** check if this blueprint has the same source selector as the other */
     bool isCompatibleWith(const SourceBlenderBlueprint &other) const;
     bool isSourceBlender() const override { return true; }
+private:
+    double calculate_cost() const override;
 };
 
 }
@@ -32,6 +32,8 @@ private:
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
     void doUnpack(uint32_t docid) override;
+    // children are accessed as bit vector iterators
+    void transform_children(const ChildTransform &) override {}
     static SearchIterator::UP optimizeMultiSearch(SearchIterator::UP parent);
 
     UnpackInfo  _unpackInfo;
@@ -24,6 +24,14 @@ MultiSearch::remove(size_t index)
     return search;
 }
 
+void
+MultiSearch::transform_children(const ChildTransform &func)
+{
+    for (size_t i = 0; i < _children.size(); ++i) {
+        _children[i] = func(std::move(_children[i]), i);
+    }
+}
+
 void
 MultiSearch::doUnpack(uint32_t docid)
 {
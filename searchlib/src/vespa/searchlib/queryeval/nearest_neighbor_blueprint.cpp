@@ -27,6 +27,7 @@ to_string(NearestNeighborBlueprint::Algorithm algorithm)
         case NNBA::EXACT_FALLBACK: return "exact fallback";
         case NNBA::INDEX_TOP_K: return "index top k";
         case NNBA::INDEX_TOP_K_WITH_FILTER: return "index top k using filter";
+        case NNBA::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL: return "index top k using filtered traversal";
     }
     return "unknown";
 }
@@ -58,7 +59,9 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _global_filter(GlobalFilter::create()),
       _global_filter_set(false),
       _global_filter_hits(),
-      _global_filter_hit_ratio()
+      _global_filter_hit_ratio(),
+      _estimated_plain_cost(),
+      _estimated_filtered_cost()
 {
     if (distance_threshold < std::numeric_limits<double>::max()) {
         _distance_threshold = _distance_calc->function().convert_threshold(distance_threshold);
@@ -86,6 +89,7 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
             if (_global_filter_hit_ratio.value() < _global_filter_lower_limit) {
                 _algorithm = Algorithm::EXACT_FALLBACK;
             } else {
+                select_filter_algorithm(nns_index);
                 est_hits = std::min(est_hits, _global_filter_hits.value());
             }
         } else { // post-filtering case
@@ -103,15 +107,34 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
     }
 }
 
+void
+NearestNeighborBlueprint::select_filter_algorithm(const search::tensor::NearestNeighborIndex* nns_index)
+{
+    // Only called when the filter hit ratio is above the brute force limit, which stays a hard bound:
+    // the index is always searched here, and the cost estimates only select how the filter is applied.
+    using FilterTraversal = search::tensor::NearestNeighborIndex::FilterTraversal;
+    auto filter = _global_filter->filter();
+    uint32_t explore_k = _adjusted_target_hits + _explore_additional_hits;
+    _estimated_plain_cost = nns_index->estimate_search_cost(explore_k, filter, FilterTraversal::PLAIN);
+    _estimated_filtered_cost = nns_index->estimate_search_cost(explore_k, filter, FilterTraversal::FILTERED);
+    if (_estimated_filtered_cost.value() < _estimated_plain_cost.value()) {
+        _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL;
+    } else {
+        _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
+    }
+}
+
 void
 NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborIndex* nns_index)
 {
+    using FilterTraversal = search::tensor::NearestNeighborIndex::FilterTraversal;
     auto lhs = _query_tensor.cells();
     uint32_t k = _adjusted_target_hits;
     if (_global_filter->has_filter()) {
         auto filter = _global_filter->filter();
-        _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, k + _explore_additional_hits, _distance_threshold);
-        _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
+        auto traversal = (_algorithm == Algorithm::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL)
+                ? FilterTraversal::FILTERED : FilterTraversal::PLAIN;
+        _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, traversal, k + _explore_additional_hits, _distance_threshold);
     } else {
         _found_hits = nns_index->find_top_k(k, lhs, k + _explore_additional_hits, _distance_threshold);
         _algorithm = Algorithm::INDEX_TOP_K;
@@ -124,6 +147,7 @@ NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
     assert(tfmda.size() == 1);
     fef::TermFieldMatchData &tfmd = *tfmda[0]; // always search in only one field
     switch (_algorithm) {
+    case Algorithm::INDEX_TOP_K_WITH_FILTERED_TRAVERSAL:
     case Algorithm::INDEX_TOP_K_WITH_FILTER:
     case Algorithm::INDEX_TOP_K:
         return NnsIndexIterator::create(tfmd, _found_hits, _distance_calc->function());
@@ -160,6 +184,12 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     if (_global_filter_hit_ratio.has_value()) {
         visitor.visitFloat("hit_ratio", _global_filter_hit_ratio.value());
     }
+    if (_estimated_plain_cost.has_value()) {
+        visitor.visitFloat("estimated_plain_cost", _estimated_plain_cost.value());
+    }
+    if (_estimated_filtered_cost.has_value()) {
+        visitor.visitFloat("estimated_filtered_cost", _estimated_filtered_cost.value());
+    }
     visitor.closeStruct();
 }
 
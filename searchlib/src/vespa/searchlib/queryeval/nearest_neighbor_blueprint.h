@@ -25,7 +25,8 @@ public:
         EXACT,
         EXACT_FALLBACK,
         INDEX_TOP_K,
-        INDEX_TOP_K_WITH_FILTER
+        INDEX_TOP_K_WITH_FILTER,
+        INDEX_TOP_K_WITH_FILTERED_TRAVERSAL
     };
 private:
     std::unique_ptr<search::tensor::DistanceCalculator> _distance_calc;
@@ -45,7 +46,10 @@ private:
     bool _global_filter_set;
     std::optional<uint32_t> _global_filter_hits;
     std::optional<double> _global_filter_hit_ratio;
+    std::optional<double> _estimated_plain_cost;
+    std::optional<double> _estimated_filtered_cost;
 
+    void select_filter_algorithm(const search::tensor::NearestNeighborIndex* nns_index);
     void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index);
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
@@ -11,16 +11,21 @@ namespace search::queryeval {
 
 /**
  * A heap of the K closest distances that can be shared between multiple search iterators.
+ *
+ * All match threads share the distance threshold, which is tightened as soon as any thread
+ * has seen K hits closer than it.
  **/
 class NearestNeighborDistanceHeap {
 private:
     std::mutex _lock;
     size_t _size;
     std::atomic<double> _distance_threshold;
+    std::atomic<bool> _full;
     vespalib::PriorityQueue<double, std::greater<double>> _priQ;
 public:
     explicit NearestNeighborDistanceHeap(size_t maxSize)
       : _size(maxSize), _distance_threshold(std::numeric_limits<double>::max()),
+        _full(false),
         _priQ()
     {
         _priQ.reserve(maxSize);
@@ -32,6 +37,13 @@ public:
         return _distance_threshold.load(std::memory_order_relaxed);
     }
     void used(double distance) {
+        // When the heap is full the threshold is never above the front of the heap,
+        // so a distance not below the threshold cannot change the heap.
+        if (_full.load(std::memory_order_relaxed) &&
+            (distance >= _distance_threshold.load(std::memory_order_relaxed)))
+        {
+            return;
+        }
         std::lock_guard<std::mutex> guard(_lock);
         if (_priQ.size() < _size) {
             _priQ.push(distance);
@@ -43,6 +55,7 @@ public:
             if (_distance_threshold.load(std::memory_order_relaxed) > _priQ.front()) {
                 _distance_threshold.store(_priQ.front(), std::memory_order_relaxed);
             }
+            _full.store(true, std::memory_order_relaxed);
         }
     }
 };
@@ -4,6 +4,8 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/tensor/distance_calculator.h>
 #include <vespa/searchlib/tensor/distance_function.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <algorithm>
 
 using search::tensor::ITensorAttribute;
 using vespalib::ConstArrayRef;
@@ -28,6 +30,15 @@ is_compatible(const vespalib::eval::ValueType& lhs,
  * Uses unpack() as feedback mechanism to track which matches actually became hits.
  * Keeps a heap of the K best hit distances.
  * Currently always does brute-force scanning, which is very expensive.
+ *
+ * When strict, distances are calculated in batches over consecutive candidate documents
+ * while the iterator scans forward on its own. The distance threshold shared between all
+ * match threads is checked when each candidate is considered, so batching does not change
+ * the result. Once the threshold is set, distances in a batch are calculated with early exit
+ * on the threshold seen when the batch was filled; it only gets lower, so a distance that
+ * exited early is still pruned. A seek beyond the scanned range (e.g. driven by another iterator in an AND)
+ * first checks the target document alone with early exit on the distance limit, and batches
+ * then start small and grow while the scan stays dense.
  **/
 template <bool strict, bool has_filter>
 class NearestNeighborImpl : public NearestNeighborIterator
@@ -36,7 +47,14 @@ public:
 
     NearestNeighborImpl(Params params_in)
         : NearestNeighborIterator(params_in),
-          _lastScore(0.0)
+          _lastScore(0.0),
+          _batch_pos(0),
+          _batch_size(0),
+          _batch_begin(0),
+          _batch_end(0),
+          _next_batch_size(min_batch_size),
+          _distances_calculated(0),
+          _distances_pruned(0)
     {
         assert(is_compatible(params().distance_calc.attribute_tensor().getTensorType(),
                              params().distance_calc.query_tensor().type()));
@@ -44,22 +62,29 @@ public:
 
     ~NearestNeighborImpl();
 
+    void initRange(uint32_t begin_id, uint32_t end_id) override {
+        NearestNeighborIterator::initRange(begin_id, end_id);
+        reset_batch();
+    }
+
     void doSeek(uint32_t docId) override {
+        if (strict) {
+            seek_batched(docId);
+            return;
+        }
         double distanceLimit = params().distanceHeap.distanceLimit();
-        while (__builtin_expect((docId < getEndId()), true)) {
+        if (__builtin_expect((docId < getEndId()), true)) {
             if ((!has_filter) || params().filter->testBit(docId)) {
                 double d = computeDistance(docId, distanceLimit);
+                ++_distances_calculated;
                 if (d <= distanceLimit) {
                     _lastScore = d;
                     setDocId(docId);
                     return;
                 }
+                ++_distances_pruned;
             }
-            if (strict) {
-                ++docId;
-            } else {
-                return;
-            }
+            return;
         }
         setAtEnd();
     }
@@ -72,12 +97,110 @@ public:
 
     Trinary is_strict() const override { return strict ? Trinary::True : Trinary::False ; }
 
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        NearestNeighborIterator::visitMembers(visitor);
+        visitor.visitInt("distances_calculated", _distances_calculated);
+        visitor.visitInt("distances_pruned", _distances_pruned);
+    }
+
 private:
+    static constexpr uint32_t min_batch_size = 4;
+    static constexpr uint32_t max_batch_size = 32;
+
     double computeDistance(uint32_t docId, double limit) {
         return params().distance_calc.calc_with_limit(docId, limit);
     }
 
-    double                 _lastScore;
+    void reset_batch() {
+        _batch_pos = 0;
+        _batch_size = 0;
+        _batch_begin = 0;
+        _batch_end = 0;
+        _next_batch_size = min_batch_size;
+    }
+
+    // Seek target not reached by scanning; check it alone, with early exit on the distance limit.
+    bool seek_single(uint32_t docId) {
+        _batch_pos = 0;
+        _batch_size = 0;
+        _batch_begin = docId + 1;
+        _batch_end = docId + 1;
+        _next_batch_size = min_batch_size;
+        if ((!has_filter) || params().filter->testBit(docId)) {
+            double distanceLimit = params().distanceHeap.distanceLimit();
+            double d = computeDistance(docId, distanceLimit);
+            ++_distances_calculated;
+            if (d <= distanceLimit) {
+                _lastScore = d;
+                setDocId(docId);
+                return true;
+            }
+            ++_distances_pruned;
+        }
+        return false;
+    }
+
+    // Calculate distances for the next candidates, starting at docId.
+    void fill_batch(uint32_t docId) {
+        _batch_pos = 0;
+        _batch_size = 0;
+        _batch_begin = docId;
+        uint32_t end_id = getEndId();
+        uint32_t batch_size = _next_batch_size;
+        _next_batch_size = std::min(2 * batch_size, max_batch_size);
+        for (; (docId < end_id) && (_batch_size < batch_size); ++docId) {
+            if ((!has_filter) || params().filter->testBit(docId)) {
+                _batch_docids[_batch_size++] = docId;
+            }
+        }
+        _batch_end = docId;
+        // Once the heap is full the limit is finite, and each distance keeps its early exit
+        double distanceLimit = params().distanceHeap.distanceLimit();
+        params().distance_calc.calc_batch(_batch_docids, _batch_size, _batch_cells, _batch_distances, distanceLimit);
+        _distances_calculated += _batch_size;
+    }
+
+    void seek_batched(uint32_t docId) {
+        uint32_t end_id = getEndId();
+        if ((docId > _batch_end) && (docId < end_id)) {
+            if (seek_single(docId)) {
+                return;
+            }
+            ++docId;
+        }
+        while (__builtin_expect((docId < end_id), true)) {
+            if ((docId < _batch_begin) || (docId >= _batch_end)) {
+                fill_batch(docId);
+            }
+            while ((_batch_pos < _batch_size) && (_batch_docids[_batch_pos] < docId)) {
+                ++_batch_pos;
+            }
+            double distanceLimit = params().distanceHeap.distanceLimit();
+            for (; _batch_pos < _batch_size; ++_batch_pos) {
+                double d = _batch_distances[_batch_pos];
+                if (d <= distanceLimit) {
+                    _lastScore = d;
+                    setDocId(_batch_docids[_batch_pos]);
+                    return;
+                }
+                ++_distances_pruned;
+            }
+            docId = _batch_end;
+        }
+        setAtEnd();
+    }
+
+    double                        _lastScore;
+    uint32_t                      _batch_pos;
+    uint32_t                      _batch_size;
+    uint32_t                      _batch_begin;
+    uint32_t                      _batch_end;
+    uint32_t                      _next_batch_size;
+    uint64_t                      _distances_calculated;
+    uint64_t                      _distances_pruned;
+    uint32_t                      _batch_docids[max_batch_size];
+    double                        _batch_distances[max_batch_size];
+    vespalib::eval::TypedCells    _batch_cells[max_batch_size];
 };
 
 template <bool strict, bool has_filter>
@@ -0,0 +1,113 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "profiled_iterator.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/objects/visit.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cstring>
+
+namespace search::queryeval {
+
+namespace {
+
+vespalib::string
+name_of(const SearchIterator &search)
+{
+    // drop namespaces to keep the task names readable
+    std::string name = search.getClassName();
+    for (const char *prefix : {"search::queryeval::", "search::attribute::", "search::"}) {
+        size_t len = strlen(prefix);
+        for (auto pos = name.find(prefix); pos != std::string::npos; pos = name.find(prefix)) {
+            name.erase(pos, len);
+        }
+    }
+    return name;
+}
+
+SearchIterator::UP
+profile_tree(vespalib::ExecutionProfiler &profiler, SearchIterator::UP search, const vespalib::string &path)
+{
+    search->transform_children([&](SearchIterator::UP child, size_t index) {
+                                   return profile_tree(profiler, std::move(child), path + vespalib::make_string("%zu/", index));
+                               });
+    vespalib::string prefix = path + name_of(*search) + "::";
+    return std::make_unique<ProfiledIterator>(profiler, std::move(search),
+                                              profiler.resolve(prefix + "initRange"),
+                                              profiler.resolve(prefix + "seek"),
+                                              profiler.resolve(prefix + "unpack"),
+                                              profiler.resolve(prefix + "termwise"));
+}
+
+}
+
+ProfiledIterator::ProfiledIterator(Profiler &profiler, UP search,
+                                   TaskId init_tag, TaskId seek_tag, TaskId unpack_tag, TaskId termwise_tag) noexcept
+    : _profiler(profiler),
+      _search(std::move(search)),
+      _init_tag(init_tag),
+      _seek_tag(seek_tag),
+      _unpack_tag(unpack_tag),
+      _termwise_tag(termwise_tag)
+{
+}
+
+ProfiledIterator::~ProfiledIterator() = default;
+
+void
+ProfiledIterator::initRange(uint32_t begin_id, uint32_t end_id)
+{
+    Task task(_profiler, _init_tag);
+    SearchIterator::initRange(begin_id, end_id);
+    _search->initRange(begin_id, end_id);
+    setDocId(_search->getDocId());
+}
+
+void
+ProfiledIterator::doSeek(uint32_t docid)
+{
+    Task task(_profiler, _seek_tag);
+    _search->doSeek(docid);
+    setDocId(_search->getDocId());
+}
+
+void
+ProfiledIterator::doUnpack(uint32_t docid)
+{
+    Task task(_profiler, _unpack_tag);
+    _search->doUnpack(docid);
+}
+
+std::unique_ptr<BitVector>
+ProfiledIterator::get_hits(uint32_t begin_id)
+{
+    Task task(_profiler, _termwise_tag);
+    return _search->get_hits(begin_id);
+}
+
+void
+ProfiledIterator::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    Task task(_profiler, _termwise_tag);
+    _search->or_hits_into(result, begin_id);
+}
+
+void
+ProfiledIterator::and_hits_into(BitVector &result, uint32_t begin_id)
+{
+    Task task(_profiler, _termwise_tag);
+    _search->and_hits_into(result, begin_id);
+}
+
+void
+ProfiledIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    visit(visitor, "search", *_search);
+}
+
+SearchIterator::UP
+ProfiledIterator::profile(Profiler &profiler, UP root)
+{
+    return profile_tree(profiler, std::move(root), "/");
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/vespalib/util/execution_profiler.h>
+
+namespace search::queryeval {
+
+/**
+ * Wraps a search iterator and reports time spent in initRange, seek,
+ * unpack and termwise evaluation to an execution profiler. Each task
+ * is named by the position of the iterator in the tree and its class
+ * name, so that calls from different branches are kept apart.
+ **/
+class ProfiledIterator : public SearchIterator
+{
+private:
+    using Profiler = vespalib::ExecutionProfiler;
+    using TaskId = Profiler::TaskId;
+
+    Profiler &_profiler;
+    UP        _search;
+    TaskId    _init_tag;
+    TaskId    _seek_tag;
+    TaskId    _unpack_tag;
+    TaskId    _termwise_tag;
+
+    struct Task {
+        Profiler &profiler;
+        Task(Profiler &profiler_in, TaskId tag) : profiler(profiler_in) { profiler.start(tag); }
+        ~Task() { profiler.complete(); }
+    };
+
+public:
+    ProfiledIterator(Profiler &profiler, UP search,
+                     TaskId init_tag, TaskId seek_tag, TaskId unpack_tag, TaskId termwise_tag) noexcept;
+    ~ProfiledIterator() override;
+
+    void initRange(uint32_t begin_id, uint32_t end_id) override;
+    void doSeek(uint32_t docid) override;
+    void doUnpack(uint32_t docid) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    const PostingInfo *getPostingInfo() const override { return _search->getPostingInfo(); }
+    Trinary is_strict() const override { return _search->is_strict(); }
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+
+    /**
+     * Wrap all iterators in the given tree (as far as they expose
+     * their children) with profiled iterators.
+     **/
+    static UP profile(Profiler &profiler, UP root);
+};
+
+}
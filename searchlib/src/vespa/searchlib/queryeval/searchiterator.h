@@ -6,6 +6,7 @@
 #include "begin_and_end_id.h"
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/trinary.h>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -355,6 +356,16 @@ public:
 
     virtual Trinary is_strict() const { return Trinary::Undefined; }
 
+    /**
+     * Replace each direct child of this iterator with the result of
+     * calling the given function with the child and its index. This
+     * is used to inject wrappers (like profiling) into a fully built
+     * iterator tree. Iterators without children, or iterators that
+     * depend on the concrete type of their children, ignore this.
+     **/
+    using ChildTransform = std::function<UP(UP child, size_t index)>;
+    virtual void transform_children(const ChildTransform &func) { (void) func; }
+
 };
 
 }
@@ -416,6 +416,35 @@ struct TermFrequencyScorer
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Scorer used with block-max weak and. The max score calculated by
+ * TermFrequencyScorer is scaled by a bm25 style term frequency
+ * normalization based on num occs and field length. The score is
+ * increasing in num occs and decreasing in field length, making the
+ * score for (max num occs, min field length) an upper bound for a
+ * block of documents.
+ */
+class Bm25TermFrequencyScorer
+{
+    double _k1;
+    double _b;
+    double _avg_field_length;
+public:
+    Bm25TermFrequencyScorer(double k1, double b, double avg_field_length)
+        : _k1(k1),
+          _b(b),
+          _avg_field_length(std::max(avg_field_length, 1.0))
+    {
+    }
+    score_t calculate_score(score_t max_score, uint32_t num_occs, uint32_t field_length) const {
+        double norm_field_length = ((double)field_length) / _avg_field_length;
+        double tf = num_occs / (num_occs + _k1 * (1.0 - _b + _b * norm_field_length));
+        return (score_t) (max_score * tf);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 /**
  * Scorer used with WeakAndAlgorithm that calculates a real dot product upper
  * bound as max score and dot product component score per term.
@@ -2,6 +2,7 @@
 
 #include "wand_parts.h"
 #include "weak_and_search.h"
+#include <vespa/searchlib/queryeval/iblock_max_search.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/vespalib/util/left_right_heap.h>
 #include <vespa/vespalib/util/priority_queue.h>
@@ -93,6 +94,221 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Weak and using block-max WAND. Terms are kept sorted on docid. A
+ * pivot is selected using the max score of each term. Before
+ * evaluating the pivot, the block max score of each term at or before
+ * the pivot is checked; if their sum cannot reach the threshold, all
+ * those terms skip to the end of the shortest block.
+ */
+template <bool IS_STRICT>
+class BlockMaxWeakAndSearch : public WeakAndSearch
+{
+private:
+    typedef vespalib::PriorityQueue<score_t> Scores;
+    typedef IBlockMaxSearch::Block Block;
+
+    VectorizedIteratorTerms        _terms;
+    std::vector<IBlockMaxSearch *> _block_max; // nullptr if term lacks block-max support
+    std::vector<Block>             _blocks;    // current block for each term
+    std::vector<ref_t>             _order;     // terms sorted on docid
+    std::vector<ref_t>             _present;   // terms matching current docid
+    Bm25TermFrequencyScorer        _scorer;
+    score_t                        _threshold; // current score threshold
+    score_t                        _score;     // score for current docid
+    Scores                         _scores;    // best n scores
+    const uint32_t                 _n;
+
+    void seek_term(ref_t ref, uint32_t docid) {
+        if (_terms.docId(ref) < docid) {
+            _terms.docId(ref) = _terms.seek(ref, docid);
+        }
+    }
+    void sort_terms() {
+        std::sort(_order.begin(), _order.end(), DocIdOrder(_terms.docId()));
+    }
+    score_t block_score(ref_t ref, uint32_t docid) {
+        IBlockMaxSearch *block_max = _block_max[ref];
+        if (block_max == nullptr) {
+            return _terms.maxScore(ref);
+        }
+        Block &block = _blocks[ref];
+        if (block.last_doc_id < docid || _terms.docId(ref) > block.last_doc_id) {
+            block = block_max->seek_block(docid);
+            // shallow seek might have moved the iterator
+            _terms.docId(ref) = std::max(_terms.docId(ref), _terms.iteratorPack().get_docid(ref));
+        }
+        return _scorer.calculate_score(_terms.maxScore(ref), block.max_num_occs, block.min_field_length);
+    }
+    score_t term_score(ref_t ref) const {
+        const IBlockMaxSearch *block_max = _block_max[ref];
+        if (block_max == nullptr) {
+            return _terms.maxScore(ref);
+        }
+        return _scorer.calculate_score(_terms.maxScore(ref), block_max->get_num_occs(), block_max->get_field_length());
+    }
+    score_t score_present(uint32_t docid) {
+        _present.clear();
+        score_t score = 0;
+        for (ref_t ref : _order) {
+            if (_terms.docId(ref) == docid) {
+                _present.push_back(ref);
+                score += term_score(ref);
+            }
+        }
+        return score;
+    }
+
+    void seek_strict(uint32_t docid) {
+        for (ref_t ref : _order) {
+            seek_term(ref, docid);
+        }
+        for (;;) {
+            sort_terms();
+            size_t pivot_idx = 0;
+            score_t upper_bound = 0;
+            for (; pivot_idx < _order.size(); ++pivot_idx) {
+                upper_bound += _terms.maxScore(_order[pivot_idx]);
+                if (upper_bound >= _threshold) {
+                    break;
+                }
+            }
+            if (pivot_idx == _order.size() || _terms.docId(_order[pivot_idx]) >= getEndId()) {
+                setAtEnd();
+                return;
+            }
+            uint32_t pivot = _terms.docId(_order[pivot_idx]);
+            while (pivot_idx + 1 < _order.size() && _terms.docId(_order[pivot_idx + 1]) == pivot) {
+                ++pivot_idx;
+            }
+            uint32_t next = (pivot_idx + 1 < _order.size()) ? _terms.docId(_order[pivot_idx + 1]) : search::endDocId;
+            score_t block_upper_bound = 0;
+            for (size_t i = 0; i <= pivot_idx; ++i) {
+                ref_t ref = _order[i];
+                block_upper_bound += block_score(ref, pivot);
+                if (_block_max[ref] != nullptr) {
+                    uint32_t last_doc_id = _blocks[ref].last_doc_id;
+                    next = std::min(next, (last_doc_id < search::endDocId) ? last_doc_id + 1 : last_doc_id);
+                }
+            }
+            if (block_upper_bound < _threshold) {
+                // No document in [pivot, next) can reach threshold
+                for (size_t i = 0; i <= pivot_idx; ++i) {
+                    seek_term(_order[i], next);
+                }
+                continue;
+            }
+            bool all_at_pivot = true;
+            for (size_t i = 0; i <= pivot_idx; ++i) {
+                ref_t ref = _order[i];
+                if (_terms.docId(ref) < pivot) {
+                    seek_term(ref, pivot);
+                    all_at_pivot = false;
+                    break;
+                }
+                if (_terms.docId(ref) > pivot) {
+                    // moved by shallow seek
+                    all_at_pivot = false;
+                }
+            }
+            if (!all_at_pivot) {
+                continue;
+            }
+            _score = score_present(pivot);
+            if (_score >= _threshold) {
+                setDocId(pivot);
+                return;
+            }
+            for (ref_t ref : _present) {
+                seek_term(ref, pivot + 1);
+            }
+        }
+    }
+
+    void seek_unstrict(uint32_t docid) {
+        // Block max info is not useful when checking single documents
+        score_t upper_bound = 0;
+        for (ref_t ref : _order) {
+            seek_term(ref, docid);
+            if (_terms.docId(ref) == docid) {
+                upper_bound += _terms.maxScore(ref);
+            }
+        }
+        if (upper_bound >= _threshold) {
+            _score = score_present(docid);
+            if (_score >= _threshold) {
+                setDocId(docid);
+            }
+        }
+    }
+
+public:
+    BlockMaxWeakAndSearch(const Terms &terms, uint32_t n, const BlockMaxParams &params)
+        : _terms(terms,
+                 TermFrequencyScorer(),
+                 0,
+                 fef::MatchData::UP(nullptr)),
+          _block_max(),
+          _blocks(_terms.size(), Block{0, 0, 1}),
+          _order(),
+          _present(),
+          _scorer(params.k1, params.b, params.avg_field_length),
+          _threshold(1),
+          _score(0),
+          _scores(),
+          _n(n)
+    {
+        const Terms &input_terms = _terms.input_terms();
+        for (size_t i = 0; i < input_terms.size(); ++i) {
+            auto *block_max = dynamic_cast<IBlockMaxSearch *>(input_terms[i].search);
+            if (block_max != nullptr && !block_max->has_interleaved_features()) {
+                block_max = nullptr;
+            }
+            _block_max.push_back(block_max);
+            _order.push_back(i);
+        }
+    }
+    size_t get_num_terms() const override { return _terms.size(); }
+    int32_t get_term_weight(size_t idx) const override { return _terms.weight(idx); }
+    score_t get_max_score(size_t idx) const override { return _terms.maxScore(idx); }
+    const Terms &getTerms() const override { return _terms.input_terms(); }
+    uint32_t getN() const override { return _n; }
+    void doSeek(uint32_t docid) override {
+        if (IS_STRICT) {
+            seek_strict(docid);
+        } else {
+            seek_unstrict(docid);
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        _scores.push(_score);
+        if (_scores.size() > _n) {
+            _scores.pop_front();
+        }
+        if (_scores.size() == _n) {
+            _threshold = _scores.front();
+        }
+        for (ref_t ref : _present) {
+            _terms.unpack(ref, docid);
+        }
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        WeakAndSearch::initRange(begin, end);
+        _terms.iteratorPack().initRange(begin, end);
+        for (size_t i = 0; i < _terms.size(); ++i) {
+            _terms.docId(i) = _terms.iteratorPack().get_docid(i);
+            _blocks[i] = Block{0, 0, 1};
+        }
+        _present.clear();
+        if (_n == 0) {
+            setAtEnd();
+        }
+    }
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+};
+
+//-----------------------------------------------------------------------------
+
 } // namespace search::queryeval::wand
 
 //-----------------------------------------------------------------------------
@@ -136,6 +352,16 @@ WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict)
     }
 }
 
+SearchIterator::UP
+WeakAndSearch::create_block_max(const Terms &terms, uint32_t n, bool strict, const BlockMaxParams &params)
+{
+    if (strict) {
+        return std::make_unique<wand::BlockMaxWeakAndSearch<true>>(terms, n, params);
+    } else {
+        return std::make_unique<wand::BlockMaxWeakAndSearch<false>>(terms, n, params);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace queryeval
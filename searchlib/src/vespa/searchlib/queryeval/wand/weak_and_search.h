@@ -10,6 +10,16 @@ namespace queryeval {
 
 struct WeakAndSearch : SearchIterator {
     typedef wand::Terms Terms;
+    /**
+     * Parameters for the bm25 style term frequency normalization used
+     * by block-max weak and.
+     */
+    struct BlockMaxParams {
+        double k1;
+        double b;
+        double avg_field_length;
+        BlockMaxParams() noexcept : k1(1.2), b(0.75), avg_field_length(100.0) {}
+    };
     virtual size_t get_num_terms() const = 0;
     virtual int32_t get_term_weight(size_t idx) const = 0;
     virtual wand::score_t get_max_score(size_t idx) const = 0;
@@ -19,6 +29,14 @@ struct WeakAndSearch : SearchIterator {
     static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict);
     static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict);
     static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict);
+    /**
+     * Create weak and using block-max metadata (see IBlockMaxSearch)
+     * exposed by the terms to skip entire blocks of documents that
+     * cannot score above the current threshold. Term scores are
+     * normalized by num occs and field length for terms exposing
+     * interleaved features.
+     */
+    static SearchIterator::UP create_block_max(const Terms &terms, uint32_t n, bool strict, const BlockMaxParams &params);
 };
 
 } // namespace queryeval
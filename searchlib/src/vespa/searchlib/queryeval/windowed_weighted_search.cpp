@@ -0,0 +1,274 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "windowed_weighted_search.h"
+#include <vespa/searchlib/attribute/iterator_pack.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataPosition;
+
+namespace search::queryeval {
+
+namespace {
+
+// the heap-based iterators switch to a binary heap at this size
+constexpr size_t min_terms = 128;
+
+constexpr uint32_t num_words = WindowedWeightedSearch::window_size / 64;
+
+enum class Mode { FILTER, WEIGHTED_SET, DOT_PRODUCT };
+
+template <Mode mode>
+class WindowedWeightedSearchImpl : public WindowedWeightedSearch
+{
+private:
+    TermFieldMatchData    &_tmd;
+    std::vector<int32_t>   _weights;
+    AttributeIteratorPack  _children;
+    std::vector<uint64_t>  _bits;
+    // DOT_PRODUCT: score per document in the window
+    std::vector<double>    _scores;
+    // WEIGHTED_SET: matching term weights for all documents in the
+    // window, grouped by document; _ends[i] is the end of the group
+    // for document i and the start of the group for document i + 1
+    std::vector<uint32_t>  _ends;
+    std::vector<uint32_t>  _offsets;
+    std::vector<int32_t>   _elem_weights;
+    std::vector<int32_t>   _doc_weights;
+    uint32_t               _window_begin;
+    uint32_t               _window_end;
+
+    void accumulate(uint32_t child) {
+        uint32_t docid = _children.get_docid(child);
+        if (docid < _window_begin) {
+            docid = _children.seek(child, _window_begin);
+        }
+        for (; docid < _window_end; docid = _children.next(child)) {
+            uint32_t offset = docid - _window_begin;
+            _bits[offset >> 6] |= (uint64_t(1) << (offset & 63));
+            if constexpr (mode == Mode::DOT_PRODUCT) {
+                _scores[offset] += double(_weights[child]) * _children.get_weight(child, docid);
+            } else if constexpr (mode == Mode::WEIGHTED_SET) {
+                _offsets.push_back(offset);
+                _elem_weights.push_back(_weights[child]);
+            }
+        }
+    }
+
+    void group_weights() {
+        // counting sort on offset; stable, so each group keeps the
+        // order of the children (sorted by descending weight)
+        uint32_t len = _window_end - _window_begin;
+        std::fill(_ends.begin(), _ends.begin() + len, 0);
+        for (uint32_t offset : _offsets) {
+            ++_ends[offset];
+        }
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < len; ++i) {
+            sum += _ends[i];
+            _ends[i] = sum - _ends[i];
+        }
+        _doc_weights.resize(_offsets.size());
+        for (size_t i = 0; i < _offsets.size(); ++i) {
+            _doc_weights[_ends[_offsets[i]]++] = _elem_weights[i];
+        }
+    }
+
+    bool load_window(uint32_t docid) {
+        uint32_t begin = getEndId();
+        for (size_t i = 0; i < _children.size(); ++i) {
+            uint32_t child_docid = _children.get_docid(i);
+            if (child_docid < docid) {
+                child_docid = _children.seek(i, docid);
+            }
+            begin = std::min(begin, child_docid);
+        }
+        if (begin >= getEndId()) {
+            _window_begin = _window_end = getEndId();
+            return false;
+        }
+        _window_begin = begin;
+        _window_end = std::min(begin + window_size, getEndId());
+        memset(_bits.data(), 0, _bits.size() * sizeof(uint64_t));
+        if constexpr (mode == Mode::DOT_PRODUCT) {
+            std::fill(_scores.begin(), _scores.end(), 0.0);
+        } else if constexpr (mode == Mode::WEIGHTED_SET) {
+            _offsets.clear();
+            _elem_weights.clear();
+        }
+        for (size_t i = 0; i < _children.size(); ++i) {
+            accumulate(i);
+        }
+        if constexpr (mode == Mode::WEIGHTED_SET) {
+            group_weights();
+        }
+        return true;
+    }
+
+    uint32_t find_next(uint32_t offset) const {
+        uint32_t word = offset >> 6;
+        uint64_t bits = _bits[word] & (~uint64_t(0) << (offset & 63));
+        while (bits == 0) {
+            if (++word == num_words) {
+                return window_size;
+            }
+            bits = _bits[word];
+        }
+        return (word << 6) + __builtin_ctzl(bits);
+    }
+
+public:
+    WindowedWeightedSearchImpl(TermFieldMatchData &tmd, std::vector<int32_t> weights, AttributeIteratorPack &&children)
+        : _tmd(tmd),
+          _weights(std::move(weights)),
+          _children(std::move(children)),
+          _bits(num_words, 0),
+          _scores(),
+          _ends(),
+          _offsets(),
+          _elem_weights(),
+          _doc_weights(),
+          _window_begin(0),
+          _window_end(0)
+    {
+        assert(_children.size() > 0);
+        assert(_children.size() == _weights.size());
+        if constexpr (mode == Mode::DOT_PRODUCT) {
+            _scores.resize(window_size, 0.0);
+        } else if constexpr (mode == Mode::WEIGHTED_SET) {
+            _ends.resize(window_size, 0);
+            _tmd.reservePositions(_children.size());
+        } else {
+            _tmd.setRawScore(TermFieldMatchData::invalidId(), 0.0);
+        }
+    }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        WindowedWeightedSearch::initRange(begin, end);
+        _children.initRange(begin, end);
+        _window_begin = _window_end = begin;
+    }
+
+    void doSeek(uint32_t docid) override {
+        if (docid < _window_end) {
+            uint32_t offset = find_next(docid - _window_begin);
+            if (_window_begin + offset < _window_end) {
+                setDocId(_window_begin + offset);
+                return;
+            }
+            docid = _window_end;
+        }
+        if (load_window(docid)) {
+            setDocId(_window_begin);
+        } else {
+            setAtEnd();
+        }
+    }
+
+    void doUnpack(uint32_t docid) override {
+        uint32_t offset = docid - _window_begin;
+        if constexpr (mode == Mode::DOT_PRODUCT) {
+            _tmd.setRawScore(docid, _scores[offset]);
+        } else if constexpr (mode == Mode::WEIGHTED_SET) {
+            _tmd.reset(docid);
+            uint32_t begin = (offset == 0) ? 0 : _ends[offset - 1];
+            for (uint32_t i = begin; i < _ends[offset]; ++i) {
+                TermFieldMatchDataPosition pos;
+                pos.setElementWeight(_doc_weights[i]);
+                _tmd.appendPosition(pos);
+            }
+        } else {
+            _tmd.resetOnlyDocId(docid);
+        }
+    }
+
+    // children run ahead of the current window; move them back to
+    // the current docid before handing out their hits
+    void rewind(uint32_t begin_id) {
+        uint32_t docid = std::max(begin_id, getDocId());
+        _children.initRange(docid, getEndId());
+        _window_begin = _window_end = docid;
+    }
+
+    Trinary is_strict() const override { return Trinary::True; }
+
+    BitVector::UP get_hits(uint32_t begin_id) override {
+        rewind(begin_id);
+        return _children.get_hits(begin_id, getEndId());
+    }
+    void or_hits_into(BitVector &result, uint32_t begin_id) override {
+        rewind(begin_id);
+        _children.or_hits_into(result, begin_id);
+    }
+    void and_hits_into(BitVector &result, uint32_t begin_id) override {
+        result.andWith(*get_hits(begin_id));
+    }
+};
+
+template <Mode mode>
+SearchIterator::UP
+create_search(TermFieldMatchData &tmd, const std::vector<int32_t> &weights, std::vector<DocumentWeightIterator> &&iterators)
+{
+    if constexpr (mode == Mode::WEIGHTED_SET) {
+        // order terms by descending weight; this gives the position
+        // order expected from weighted set term matching
+        std::vector<uint32_t> order(weights.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&weights](uint32_t a, uint32_t b) { return (weights[a] > weights[b]); });
+        std::vector<int32_t> sorted_weights;
+        std::vector<DocumentWeightIterator> sorted_iterators;
+        sorted_weights.reserve(order.size());
+        sorted_iterators.reserve(order.size());
+        for (uint32_t idx : order) {
+            sorted_weights.push_back(weights[idx]);
+            sorted_iterators.push_back(std::move(iterators[idx]));
+        }
+        return std::make_unique<WindowedWeightedSearchImpl<mode>>(tmd, std::move(sorted_weights),
+                                                                  AttributeIteratorPack(std::move(sorted_iterators)));
+    } else {
+        return std::make_unique<WindowedWeightedSearchImpl<mode>>(tmd, weights, AttributeIteratorPack(std::move(iterators)));
+    }
+}
+
+}
+
+bool
+WindowedWeightedSearch::should_use(size_t num_terms, uint64_t total_postings, uint32_t docid_limit)
+{
+    if (num_terms < min_terms) {
+        return false;
+    }
+    // each window costs about one step per term, each posting costs
+    // a heap adjustment (log n steps) when merging
+    uint64_t num_windows = (uint64_t(docid_limit) + window_size - 1) / window_size;
+    return (total_postings >= num_terms * num_windows);
+}
+
+SearchIterator::UP
+WindowedWeightedSearch::create_weighted_set(TermFieldMatchData &tmd, bool field_is_filter,
+                                            const std::vector<int32_t> &weights,
+                                            std::vector<DocumentWeightIterator> &&iterators)
+{
+    if (field_is_filter || tmd.isNotNeeded()) {
+        return create_search<Mode::FILTER>(tmd, weights, std::move(iterators));
+    }
+    return create_search<Mode::WEIGHTED_SET>(tmd, weights, std::move(iterators));
+}
+
+SearchIterator::UP
+WindowedWeightedSearch::create_dot_product(TermFieldMatchData &tmd, bool field_is_filter,
+                                           const std::vector<int32_t> &weights,
+                                           std::vector<DocumentWeightIterator> &&iterators)
+{
+    if (field_is_filter || tmd.isNotNeeded()) {
+        return create_search<Mode::FILTER>(tmd, weights, std::move(iterators));
+    }
+    return create_search<Mode::DOT_PRODUCT>(tmd, weights, std::move(iterators));
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/searchlib/attribute/i_document_weight_attribute.h>
+
+namespace search::fef { class TermFieldMatchData; }
+
+namespace search::queryeval {
+
+/**
+ * Term-at-a-time alternative to WeightedSetTermSearch and
+ * DotProductSearch for queries with many terms.
+ *
+ * Instead of merging the posting lists with a heap, docids are
+ * processed in fixed size windows. For each window, all postings are
+ * accumulated into a dense bit array (and a dense score array for
+ * dot product, or per document weight lists for weighted set) before
+ * hits are emitted. This avoids heap maintenance per posting, but
+ * pays a per-window cost for each term. The iterator is always
+ * strict.
+ **/
+class WindowedWeightedSearch : public SearchIterator
+{
+protected:
+    WindowedWeightedSearch() = default;
+
+public:
+    static constexpr uint32_t window_size = 4096;
+
+    /**
+     * Check if term-at-a-time evaluation is expected to be cheaper
+     * than heap-based merging of the posting lists.
+     *
+     * @param num_terms number of terms (posting lists)
+     * @param total_postings sum of posting list sizes
+     * @param docid_limit docid limit of the searched corpus
+     **/
+    static bool should_use(size_t num_terms, uint64_t total_postings, uint32_t docid_limit);
+
+    static SearchIterator::UP create_weighted_set(fef::TermFieldMatchData &tmd,
+                                                  bool field_is_filter,
+                                                  const std::vector<int32_t> &weights,
+                                                  std::vector<DocumentWeightIterator> &&iterators);
+
+    static SearchIterator::UP create_dot_product(fef::TermFieldMatchData &tmd,
+                                                 bool field_is_filter,
+                                                 const std::vector<int32_t> &weights,
+                                                 std::vector<DocumentWeightIterator> &&iterators);
+};
+
+}
@@ -46,20 +46,29 @@ template <typename FloatType>
 class AngularDistanceHW : public AngularDistance {
 public:
     AngularDistanceHW()
-      : AngularDistance(vespalib::eval::get_cell_type<FloatType>()),
+      : AngularDistanceHW(vespalib::eval::get_cell_type<FloatType>())
+    {
+    }
+    explicit AngularDistanceHW(vespalib::eval::CellType query_cell_type)
+      : AngularDistance(query_cell_type),
         _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
     {
-        assert(expected_cell_type() == vespalib::eval::get_cell_type<FloatType>());
     }
+    static const double *cast(const double * p) { return p; }
+    static const float *cast(const float * p) { return p; }
+    static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
-        assert(lhs.type == expected && rhs.type == expected);
+        if (lhs.type != expected || rhs.type != expected) {
+            return AngularDistance::calc(lhs, rhs);
+        }
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        auto a = &lhs_vector[0];
-        auto b = &rhs_vector[0];
+        auto a = cast(&lhs_vector[0]);
+        auto b = cast(&rhs_vector[0]);
         double a_norm_sq = _computer.dotProduct(a, a, sz);
         double b_norm_sq = _computer.dotProduct(b, b, sz);
         double squared_norms = a_norm_sq * b_norm_sq;
@@ -69,6 +78,28 @@ public:
         double distance = 1.0 - cosine_similarity; // in range [0,2]
         return distance;
     }
+    void calc_batch(const vespalib::eval::TypedCells& lhs,
+                    const vespalib::eval::TypedCells* rhs, size_t num_rhs,
+                    double* result) const override
+    {
+        constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
+        if (num_rhs == 0 || lhs.type != expected || rhs[0].type != expected) {
+            return AngularDistance::calc_batch(lhs, rhs, num_rhs, result);
+        }
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        auto a = cast(&lhs_vector[0]);
+        // the norm of the query vector is only calculated once for the entire batch
+        double a_norm_sq = _computer.dotProduct(a, a, sz);
+        for (size_t i = 0; i < num_rhs; ++i) {
+            auto b = cast(static_cast<const FloatType *>(rhs[i].data));
+            double b_norm_sq = _computer.dotProduct(b, b, sz);
+            double squared_norms = a_norm_sq * b_norm_sq;
+            double dot_product = _computer.dotProduct(a, b, sz);
+            double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+            result[i] = 1.0 - dot_product / div;
+        }
+    }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -5,10 +5,15 @@
 #include "random_level_generator.h"
 #include "inv_log_level_generator.h"
 #include "distance_function_factory.h"
+#include "quantized_vector_store.h"
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/log/log.h>
+
+LOG_SETUP(".searchlib.tensor.default_nearest_neighbor_index_factory");
 
 namespace search::tensor {
 
+using vespalib::eval::CellType;
 using vespalib::eval::ValueType;
 
 namespace {
@@ -28,20 +33,43 @@ make_random_level_generator(uint32_t m)
 std::unique_ptr<NearestNeighborIndex>
 DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          size_t vector_size,
+                                         bool multi_vector,
                                          vespalib::eval::CellType cell_type,
-                                         const search::attribute::HnswIndexParams& params) const
+                                         const search::attribute::HnswIndexParams& params,
+                                         std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const
 {
-    (void) vector_size;
     uint32_t m = params.max_links_per_node();
     HnswIndex::Config cfg(m * 2,
                           m,
                           params.neighbors_to_explore_at_insert(),
                           10000,
-                          true);
+                          true,
+                          multi_vector);
+    std::shared_ptr<vespalib::alloc::MemoryAllocator> link_memory_allocator;
+    if (params.disk_resident()) {
+        if (memory_allocator) {
+            link_memory_allocator = std::move(memory_allocator);
+        } else {
+            LOG(warning, "disk resident hnsw index requires a paged attribute, keeping the graph in memory");
+        }
+    }
+    std::unique_ptr<QuantizedVectorStore> quantized_vectors;
+    // When the full vectors and link arrays are paged, the quantized vectors must be memory resident
+    // to avoid reading the full vectors from disk for every visited node.
+    if (params.int8_quantization() || link_memory_allocator) {
+        if (QuantizedVectorStore::supports(params.distance_metric()) &&
+            (cell_type == CellType::FLOAT || cell_type == CellType::DOUBLE)) {
+            quantized_vectors = std::make_unique<QuantizedVectorStore>(params.distance_metric(), vector_size);
+        } else {
+            LOG(warning, "int8 quantization is not supported for this distance metric and cell type, using full precision vectors");
+        }
+    }
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
-                                       cfg);
+                                       cfg,
+                                       std::move(quantized_vectors),
+                                       std::move(link_memory_allocator));
 }
 
 }
@@ -13,8 +13,10 @@ class DefaultNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
 public:
     std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                size_t vector_size,
+                                               bool multi_vector,
                                                vespalib::eval::CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override;
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override;
 };
 
 }
@@ -12,11 +12,13 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -53,21 +55,6 @@ public:
     FastOS_FileInterface& index_file() { return _index_file.file(); }
 };
 
-bool
-can_use_index_save_file(const search::attribute::Config &config, const search::attribute::AttributeHeader &header)
-{
-    if (!config.hnsw_index_params().has_value() || !header.get_hnsw_index_params().has_value()) {
-        return false;
-    }
-    const auto &config_params = config.hnsw_index_params().value();
-    const auto &header_params = header.get_hnsw_index_params().value();
-    if ((config_params.max_links_per_node() != header_params.max_links_per_node()) ||
-        (config_params.distance_metric() != header_params.distance_metric())) {
-        return false;
-    }
-    return true;
-}
-
 bool
 has_index_file(AttributeVector& attr)
 {
@@ -77,7 +64,7 @@ has_index_file(AttributeVector& attr)
 BlobSequenceReader::BlobSequenceReader(AttributeVector& attr, bool has_index)
     : ReaderBase(attr),
       _use_index_file(has_index && has_index_file(attr) &&
-                      can_use_index_save_file(attr.getConfig(),
+                      TensorAttribute::can_use_index_save_file(attr.getConfig(),
                                               search::attribute::AttributeHeader::extractTags(getDatHeader(), attr.getBaseFileName()))),
       _index_file(_use_index_file ?
                   attribute::LoadUtils::openFile(attr, DenseTensorAttributeSaver::index_file_suffix()) :
@@ -166,7 +153,8 @@ DenseTensorAttribute::DenseTensorAttribute(vespalib::stringref baseFileName, con
         assert(tensor_type.dimensions().size() == 1);
         assert(tensor_type.is_dense());
         size_t vector_size = tensor_type.dimensions()[0].size;
-        _index = index_factory.make(*this, vector_size, tensor_type.cell_type(), cfg.hnsw_index_params().value());
+        _index = index_factory.make(*this, vector_size, false, tensor_type.cell_type(), cfg.hnsw_index_params().value(),
+                                    get_memory_allocator());
     }
 }
 
@@ -204,7 +192,7 @@ DenseTensorAttribute::prepare_set_tensor(DocId docid, const vespalib::eval::Valu
             // With this optimization we avoid doing unnecessary costly work, first removing the vector point, then inserting the same point.
             return {};
         }
-        return _index->prepare_add_document(docid, tensor.cells(), getGenerationHandler().takeGuard());
+        return _index->prepare_add_document(docid, VectorBundle(tensor.cells()), getGenerationHandler().takeGuard());
     }
     return {};
 }
@@ -255,95 +243,108 @@ public:
 }
 
 /**
- * Will load and index documents in parallel. Note that indexing order is not guaranteed,
- * but that is inline with the guarantees vespa already has.
+ * Will load and index documents in parallel, in batches. The documents in a batch are
+ * prepared in parallel on the shared executor, and then completed in lid order in the
+ * loading thread while the next batch is being prepared. The batch size grows with the
+ * number of completed documents, so the initial small graph is built almost sequentially
+ * (keeping it well connected) while later batches use all threads of the shared executor.
+ * Note that indexing order is not guaranteed, but that is inline with the guarantees vespa already has.
  */
 class DenseTensorAttribute::ThreadedLoader : public Loader {
 public:
     ThreadedLoader(DenseTensorAttribute & attr, vespalib::Executor & shared_executor)
         : _attr(attr),
           _shared_executor(shared_executor),
-          _queue(MAX_PENDING),
-          _pending(0)
+          _filling(std::make_unique<Batch>()),
+          _preparing(),
+          _completed(0)
     {}
+    ~ThreadedLoader() override {
+        if (_preparing) {
+            _preparing->latch->await();
+        }
+    }
     void load(uint32_t lid, vespalib::datastore::EntryRef ref) override;
     void wait_complete() override {
-        drainUntilPending(0);
+        if (!_filling->lids.empty()) {
+            start_next_batch();
+        }
+        complete_preparing_batch();
     }
 private:
-    using Entry = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
-    using Queue = vespalib::ArrayQueue<Entry>;
-
-    bool pop(Entry & entry) {
-        std::unique_lock guard(_mutex);
-        if (_queue.empty()) return false;
-        entry = std::move(_queue.front());
-        _queue.pop();
-        return true;
-    }
-    void drainQ() {
-        Queue queue(MAX_PENDING);
-        {
-            std::unique_lock guard(_mutex);
-            queue.swap(_queue);
+    struct Batch {
+        std::vector<uint32_t> lids;
+        std::vector<vespalib::datastore::EntryRef> refs;
+        std::vector<std::unique_ptr<PrepareResult>> prepared;
+        std::unique_ptr<vespalib::CountDownLatch> latch;
+        Batch() : lids(), refs(), prepared(), latch() {}
+        ~Batch() = default;
+    };
+
+    uint32_t target_batch_size() const noexcept {
+        return std::clamp(_completed / BATCH_SIZE_DIVISOR, 1u, MAX_BATCH_SIZE);
+    }
+    void prepare(Batch & batch, size_t begin, size_t end) {
+        auto guard = _attr.getGenerationHandler().takeGuard();
+        for (size_t i = begin; i < end; ++i) {
+            batch.prepared[i] = _attr._index->prepare_add_document(batch.lids[i],
+                                                                   VectorBundle(_attr._denseTensorStore.get_typed_cells(batch.refs[i])),
+                                                                   guard);
         }
-        while (!queue.empty()) {
-            auto item = std::move(queue.front());
-            queue.pop();
-            complete(item.first, std::move(item.second));
+        batch.latch->countDown();
+    }
+    void start_next_batch() {
+        auto & batch = *_filling;
+        size_t num_docs = batch.lids.size();
+        size_t num_tasks = (num_docs + PREPARE_CHUNK_SIZE - 1) / PREPARE_CHUNK_SIZE;
+        batch.prepared.resize(num_docs);
+        batch.latch = std::make_unique<vespalib::CountDownLatch>(num_tasks);
+        for (size_t begin = 0; begin < num_docs; begin += PREPARE_CHUNK_SIZE) {
+            size_t end = std::min(begin + PREPARE_CHUNK_SIZE, num_docs);
+            auto task = vespalib::makeLambdaTask([this, &batch, begin, end]() { prepare(batch, begin, end); });
+            _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
         }
+        // Complete the previous batch while this one is being prepared.
+        complete_preparing_batch();
+        _preparing = std::move(_filling);
+        _filling = std::make_unique<Batch>();
+    }
+    void complete_preparing_batch() {
+        if (!_preparing) {
+            return;
+        }
+        auto & batch = *_preparing;
+        batch.latch->await();
+        for (size_t i = 0; i < batch.lids.size(); ++i) {
+            complete(batch.lids[i], std::move(batch.prepared[i]));
+        }
+        _preparing.reset();
     }
-
     void complete(uint32_t lid, std::unique_ptr<PrepareResult> prepared) {
         _attr.setCommittedDocIdLimit(std::max(_attr.getCommittedDocIdLimit(), lid + 1));
         _attr._index->complete_add_document(lid, std::move(prepared));
-        --_pending;
+        ++_completed;
         if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
             _attr.commit();
         };
     }
-    void drainUntilPending(uint32_t maxPending) {
-        while (_pending > maxPending) {
-            {
-                std::unique_lock guard(_mutex);
-                while (_queue.empty()) {
-                    _cond.wait(guard);
-                }
-            }
-            drainQ();
-        }
-    }
-    static constexpr uint32_t MAX_PENDING = 1000;
+    static constexpr uint32_t BATCH_SIZE_DIVISOR = 8;
+    static constexpr uint32_t MAX_BATCH_SIZE = 4096;
+    static constexpr size_t PREPARE_CHUNK_SIZE = 16;
     DenseTensorAttribute  & _attr;
     vespalib::Executor    & _shared_executor;
-    std::mutex              _mutex;
-    std::condition_variable _cond;
-    Queue                   _queue;
-    uint64_t                _pending; // _pending is only modified in forground thread
+    std::unique_ptr<Batch>  _filling;   // batch being filled by load()
+    std::unique_ptr<Batch>  _preparing; // batch being prepared by the shared executor
+    uint32_t                _completed; // _completed is only modified in forground thread
 };
 
 void
 DenseTensorAttribute::ThreadedLoader::load(uint32_t lid, vespalib::datastore::EntryRef ref) {
-    Entry item;
-    while (pop(item)) {
-        // First process items that are ready to complete
-        complete(item.first, std::move(item.second));
-    }
-    // Then ensure that there no mor ethan MAX_PENDING inflight
-    drainUntilPending(MAX_PENDING);
-
-    // Then we can issue a new one
-    ++_pending;
-    auto task = vespalib::makeLambdaTask([this, ref, lid]() {
-        auto prepared = _attr._index->prepare_add_document(lid, _attr._denseTensorStore.get_typed_cells(ref),
-                                                           _attr.getGenerationHandler().takeGuard());
-        std::unique_lock guard(_mutex);
-        _queue.push(std::make_pair(lid, std::move(prepared)));
-        if (_queue.size() == 1) {
-            _cond.notify_all();
-        }
-    });
-    _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+    _filling->lids.push_back(lid);
+    _filling->refs.push_back(ref);
+    if (_filling->lids.size() >= target_batch_size()) {
+        start_next_batch();
+    }
 }
 class DenseTensorAttribute::ForegroundLoader : public Loader {
 public:
@@ -447,16 +448,13 @@ DenseTensorAttribute::getVersion() const
     return DENSE_TENSOR_ATTRIBUTE_VERSION;
 }
 
-void
-DenseTensorAttribute::onCommit()
+bool
+DenseTensorAttribute::consider_compact(const CompactionStrategy& compaction_strategy)
 {
-    TensorAttribute::onCommit();
-    if (_index) {
-        if (_index->consider_compact(getConfig().getCompactionStrategy())) {
-            incGeneration();
-            updateStat(true);
-        }
+    if (TensorAttribute::consider_compact(compaction_strategy)) {
+        return true;
     }
+    return _index && _index->consider_compact(compaction_strategy);
 }
 
 void
@@ -43,11 +43,13 @@ public:
     std::unique_ptr<vespalib::eval::Value> getTensor(DocId docId) const override;
     vespalib::eval::TypedCells extract_cells_ref(DocId docId) const override;
     bool supports_extract_cells_ref() const override { return true; }
+    VectorBundle get_vectors(uint32_t docid) const override { return VectorBundle(extract_cells_ref(docid)); }
+    bool supports_get_vectors() const override { return true; }
     bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
     uint32_t getVersion() const override;
-    void onCommit() override;
+    bool consider_compact(const CompactionStrategy& compaction_strategy) override;
     void onGenerationChange(generation_t next_gen) override;
     void removeOldGenerations(generation_t first_used_gen) override;
     void get_state(const vespalib::slime::Inserter& inserter) const override;
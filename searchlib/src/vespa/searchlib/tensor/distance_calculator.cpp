@@ -54,6 +54,19 @@ is_compatible(const vespalib::eval::ValueType& lhs,
     return (lhs.dimensions() == rhs.dimensions());
 }
 
+// Returns the type of the dense subspaces of the given (possibly mixed) tensor type.
+ValueType
+dense_subspace_type(const ValueType& type)
+{
+    std::vector<ValueType::Dimension> dims;
+    for (const auto& dim : type.dimensions()) {
+        if (dim.is_indexed()) {
+            dims.push_back(dim);
+        }
+    }
+    return ValueType::make_type(type.cell_type(), std::move(dims));
+}
+
 }
 
 namespace search::tensor {
@@ -66,7 +79,8 @@ DistanceCalculator::DistanceCalculator(const tensor::ITensorAttribute& attr_tens
       _query_tensor_cells(),
       _dist_fun_uptr(make_distance_function(_attr_tensor.distance_metric(),
                                            _attr_tensor.getTensorType().cell_type())),
-      _dist_fun(_dist_fun_uptr.get())
+      _dist_fun(_dist_fun_uptr.get()),
+      _multi_vector(_attr_tensor.getTensorType().count_mapped_dimensions() > 0)
 {
     assert(_dist_fun);
     auto nns_index = _attr_tensor.nearest_neighbor_index();
@@ -92,16 +106,23 @@ DistanceCalculator::DistanceCalculator(const tensor::ITensorAttribute& attr_tens
       _query_tensor(&query_tensor_in),
       _query_tensor_cells(_query_tensor->cells()),
       _dist_fun_uptr(),
-      _dist_fun(&function_in)
+      _dist_fun(&function_in),
+      _multi_vector(_attr_tensor.getTensorType().count_mapped_dimensions() > 0)
 {
 }
 
 DistanceCalculator::~DistanceCalculator() = default;
 
-namespace {
-
-
-
+double
+DistanceCalculator::calc_closest_subspace(uint32_t docid, double limit) const
+{
+    auto vectors = _attr_tensor.get_vectors(docid);
+    double result = std::numeric_limits<double>::max();
+    for (uint32_t subspace = 0; subspace < vectors.subspaces(); ++subspace) {
+        double distance = _dist_fun->calc_with_limit(_query_tensor_cells, vectors.cells(subspace), std::min(limit, result));
+        result = std::min(result, distance);
+    }
+    return result;
 }
 
 std::unique_ptr<DistanceCalculator>
@@ -113,7 +134,13 @@ DistanceCalculator::make_with_validation(const search::attribute::IAttributeVect
         throw IllegalArgumentException("Attribute is not a tensor");
     }
     const auto& at_type = attr_tensor->getTensorType();
-    if ((!at_type.is_dense()) || (at_type.dimensions().size() != 1)) {
+    bool multi_vector = (at_type.count_mapped_dimensions() > 0);
+    if (multi_vector) {
+        if ((at_type.count_indexed_dimensions() != 1) || !attr_tensor->supports_get_vectors()) {
+            throw IllegalArgumentException(make_string("Attribute tensor type (%s) is not a mixed tensor with one indexed dimension",
+                                                       at_type.to_spec().c_str()));
+        }
+    } else if ((!at_type.is_dense()) || (at_type.dimensions().size() != 1)) {
         throw IllegalArgumentException(make_string("Attribute tensor type (%s) is not a dense tensor of order 1",
                                                    at_type.to_spec().c_str()));
     }
@@ -122,11 +149,11 @@ DistanceCalculator::make_with_validation(const search::attribute::IAttributeVect
         throw IllegalArgumentException(make_string("Query tensor type (%s) is not a dense tensor",
                                                    qt_type.to_spec().c_str()));
     }
-    if (!is_compatible(at_type, qt_type)) {
+    if (!is_compatible(multi_vector ? dense_subspace_type(at_type) : at_type, qt_type)) {
         throw IllegalArgumentException(make_string("Attribute tensor type (%s) and query tensor type (%s) are not compatible",
                                                    at_type.to_spec().c_str(), qt_type.to_spec().c_str()));
     }
-    if (!attr_tensor->supports_extract_cells_ref()) {
+    if (!multi_vector && !attr_tensor->supports_extract_cells_ref()) {
         throw IllegalArgumentException(make_string("Attribute tensor does not support access to tensor data (type=%s)",
                                                    at_type.to_spec().c_str()));
     }
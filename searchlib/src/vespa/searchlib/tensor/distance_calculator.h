@@ -3,6 +3,7 @@
 
 #include "distance_function.h"
 #include "i_tensor_attribute.h"
+#include <limits>
 
 namespace vespalib::eval { struct Value; }
 
@@ -15,6 +16,8 @@ namespace search::tensor {
  * where one is stored in a TensorAttribute and the other comes from the query.
  *
  * The distance function to use is defined in the TensorAttribute.
+ * When the attribute tensor has multiple vectors (one per subspace of a mixed tensor),
+ * the distance to the closest vector is used.
  */
 class DistanceCalculator {
 private:
@@ -24,6 +27,9 @@ private:
     vespalib::eval::TypedCells _query_tensor_cells;
     std::unique_ptr<DistanceFunction> _dist_fun_uptr;
     const DistanceFunction* _dist_fun;
+    bool _multi_vector;
+
+    double calc_closest_subspace(uint32_t docid, double limit) const;
 
 public:
     DistanceCalculator(const tensor::ITensorAttribute& attr_tensor,
@@ -43,14 +49,41 @@ public:
     const DistanceFunction& function() const { return *_dist_fun; }
 
     double calc_raw_score(uint32_t docid) const {
+        if (_multi_vector) {
+            return _dist_fun->to_rawscore(calc_closest_subspace(docid, std::numeric_limits<double>::max()));
+        }
         double distance = _dist_fun->calc(_query_tensor_cells, _attr_tensor.extract_cells_ref(docid));
         return _dist_fun->to_rawscore(distance);
     }
 
     double calc_with_limit(uint32_t docid, double limit) const {
+        if (_multi_vector) {
+            return calc_closest_subspace(docid, limit);
+        }
         return _dist_fun->calc_with_limit(_query_tensor_cells, _attr_tensor.extract_cells_ref(docid), limit);
     }
 
+    /**
+     * Calculates the internal distances between the query tensor and the tensors of the given documents.
+     * The cells array must have room for num_docids elements, and is used as scratch space.
+     * Early return is allowed for a document when its distance is > limit, as with calc_with_limit().
+     * The distances are only calculated as one batch when no limit is given.
+     */
+    void calc_batch(const uint32_t* docids, size_t num_docids,
+                    vespalib::eval::TypedCells* cells, double* result,
+                    double limit = std::numeric_limits<double>::max()) const {
+        if (_multi_vector || (limit < std::numeric_limits<double>::max())) {
+            for (size_t i = 0; i < num_docids; ++i) {
+                result[i] = calc_with_limit(docids[i], limit);
+            }
+            return;
+        }
+        for (size_t i = 0; i < num_docids; ++i) {
+            cells[i] = _attr_tensor.extract_cells_ref(docids[i]);
+        }
+        _dist_fun->calc_batch(_query_tensor_cells, cells, num_docids, result);
+    }
+
     /**
      * Create a calculator for the given attribute tensor and query tensor, if possible.
      *
@@ -0,0 +1,18 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "distance_function.h"
+#include <vespa/eval/eval/typed_cells.h>
+
+namespace search::tensor {
+
+void
+DistanceFunction::calc_batch(const vespalib::eval::TypedCells& lhs,
+                             const vespalib::eval::TypedCells* rhs, size_t num_rhs,
+                             double* result) const
+{
+    for (size_t i = 0; i < num_rhs; ++i) {
+        result[i] = calc(lhs, rhs[i]);
+    }
+}
+
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vespa/eval/eval/cell_type.h>
 
@@ -43,6 +44,12 @@ public:
     virtual double calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                    const vespalib::eval::TypedCells& rhs,
                                    double limit) const = 0;
+
+    // calculate internal distance between lhs and each of the num_rhs vectors in rhs,
+    // all rhs vectors must have the same cell type and size as the first one
+    virtual void calc_batch(const vespalib::eval::TypedCells& lhs,
+                            const vespalib::eval::TypedCells* rhs, size_t num_rhs,
+                            double* result) const;
 };
 
 }
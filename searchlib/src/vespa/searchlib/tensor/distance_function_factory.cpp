@@ -22,12 +22,15 @@ make_distance_function(DistanceMetric variant, CellType cell_type)
         case CellType::FLOAT:  return std::make_unique<SquaredEuclideanDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<SquaredEuclideanDistanceHW<double>>();
         case CellType::INT8: return std::make_unique<SquaredEuclideanDistanceHW<vespalib::eval::Int8Float>>();
+        case CellType::BFLOAT16: return std::make_unique<SquaredEuclideanDistanceHW<vespalib::BFloat16>>(CellType::FLOAT);
         default:               return std::make_unique<SquaredEuclideanDistance>(CellType::FLOAT);
         } 
     case DistanceMetric::Angular:
         switch (cell_type) {
         case CellType::FLOAT:  return std::make_unique<AngularDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<AngularDistanceHW<double>>();
+        case CellType::INT8: return std::make_unique<AngularDistanceHW<vespalib::eval::Int8Float>>(CellType::FLOAT);
+        case CellType::BFLOAT16: return std::make_unique<AngularDistanceHW<vespalib::BFloat16>>(CellType::FLOAT);
         default:               return std::make_unique<AngularDistance>(CellType::FLOAT);
         }
     case DistanceMetric::GeoDegrees:
@@ -36,6 +39,8 @@ make_distance_function(DistanceMetric variant, CellType cell_type)
         switch (cell_type) {
         case CellType::FLOAT:  return std::make_unique<InnerProductDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<InnerProductDistanceHW<double>>();
+        case CellType::INT8: return std::make_unique<InnerProductDistanceHW<vespalib::eval::Int8Float>>(CellType::FLOAT);
+        case CellType::BFLOAT16: return std::make_unique<InnerProductDistanceHW<vespalib::BFloat16>>(CellType::FLOAT);
         default:               return std::make_unique<InnerProductDistance>(CellType::FLOAT);
         }
     case DistanceMetric::Hamming:
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "vector_bundle.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <cstdint>
 
@@ -11,11 +12,16 @@ namespace search::tensor {
  * Interface that provides access to the vector that is associated with the the given document id.
  *
  * All vectors should be the same size and either of type float or double.
+ * A document can have multiple vectors (one per subspace of a mixed tensor), accessed via get_vectors().
  */
 class DocVectorAccess {
 public:
     virtual ~DocVectorAccess() {}
     virtual vespalib::eval::TypedCells get_vector(uint32_t docid) const = 0;
+    // The default implementation provides the single vector returned by get_vector() as the only subspace.
+    virtual VectorBundle get_vectors(uint32_t docid) const {
+        return VectorBundle(get_vector(docid));
+    }
 };
 
 }
@@ -47,5 +47,6 @@ SquaredEuclideanDistance::calc_with_limit(const vespalib::eval::TypedCells& lhs,
 
 template class SquaredEuclideanDistanceHW<float>;
 template class SquaredEuclideanDistanceHW<double>;
+template class SquaredEuclideanDistanceHW<vespalib::BFloat16>;
 
 }
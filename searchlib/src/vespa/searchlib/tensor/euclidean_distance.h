@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
 #include <cmath>
 
 namespace search::tensor {
@@ -38,18 +39,24 @@ template <typename FloatType>
 class SquaredEuclideanDistanceHW : public SquaredEuclideanDistance {
 public:
     SquaredEuclideanDistanceHW()
-      : SquaredEuclideanDistance(vespalib::eval::get_cell_type<FloatType>()),
+      : SquaredEuclideanDistanceHW(vespalib::eval::get_cell_type<FloatType>())
+    {
+    }
+    explicit SquaredEuclideanDistanceHW(vespalib::eval::CellType query_cell_type)
+      : SquaredEuclideanDistance(query_cell_type),
         _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
     {
-        assert(expected_cell_type() == vespalib::eval::get_cell_type<FloatType>());
     }
 
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
     static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
-        assert(lhs.type == expected && rhs.type == expected);
+        if (lhs.type != expected || rhs.type != expected) {
+            return SquaredEuclideanDistance::calc(lhs, rhs);
+        }
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
@@ -62,7 +69,9 @@ public:
                            double limit) const override
     {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
-        assert(lhs.type == expected && rhs.type == expected);
+        if (lhs.type != expected || rhs.type != expected) {
+            return SquaredEuclideanDistance::calc_with_limit(lhs, rhs, limit);
+        }
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
         double sum = 0.0;
@@ -74,6 +83,28 @@ public:
         }
         return sum;
     }
+
+    void calc_batch(const vespalib::eval::TypedCells& lhs,
+                    const vespalib::eval::TypedCells* rhs, size_t num_rhs,
+                    double* result) const override
+    {
+        constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
+        if (num_rhs == 0 || lhs.type != expected || rhs[0].type != expected) {
+            return SquaredEuclideanDistance::calc_batch(lhs, rhs, num_rhs, result);
+        }
+        using CellPtr = decltype(cast(static_cast<const FloatType *>(nullptr)));
+        constexpr size_t chunk_size = 64;
+        CellPtr b[chunk_size];
+        auto a = cast(static_cast<const FloatType *>(lhs.data));
+        size_t sz = lhs.size;
+        for (size_t offset = 0; offset < num_rhs; offset += chunk_size) {
+            size_t n = std::min(chunk_size, num_rhs - offset);
+            for (size_t i = 0; i < n; ++i) {
+                b[i] = cast(static_cast<const FloatType *>(rhs[offset + i].data));
+            }
+            _computer.squaredEuclideanDistance(a, b, sz, n, result + offset);
+        }
+    }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -1,7 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "hamming_distance.h"
-#include <vespa/vespalib/util/binary_hamming_distance.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 using vespalib::typify_invoke;
 using vespalib::eval::TypifyCellType;
@@ -37,7 +37,8 @@ HammingDistance::calc(const vespalib::eval::TypedCells& lhs,
     if (__builtin_expect((lhs.type == expected && rhs.type == expected), true)) {
         size_t sz = lhs.size;
         assert(sz == rhs.size);
-        return (double) vespalib::binary_hamming_distance(lhs.data, rhs.data, sz);
+        static const auto & hw = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+        return (double) hw.binaryHammingDistance(lhs.data, rhs.data, sz);
     } else {
         return typify_invoke<2,TypifyCellType,CalcHamming>(lhs.type, rhs.type, lhs, rhs);
     }
@@ -6,11 +6,11 @@
 
 namespace search::tensor {
 
-HnswGraph::HnswGraph()
+HnswGraph::HnswGraph(std::shared_ptr<vespalib::alloc::MemoryAllocator> link_memory_allocator)
   : node_refs(),
     node_refs_size(1u),
     nodes(HnswIndex::make_default_node_store_config(), {}),
-    links(HnswIndex::make_default_link_store_config(), {}),
+    links(HnswIndex::make_default_link_store_config(), std::move(link_memory_allocator)),
     entry_docid_and_level()
 {
     node_refs.ensure_size(1, AtomicEntryRef());
@@ -7,6 +7,8 @@
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
+namespace vespalib::alloc { class MemoryAllocator; }
+
 namespace search::tensor {
 
 /**
@@ -45,7 +47,11 @@ struct HnswGraph {
 
     std::atomic<uint64_t> entry_docid_and_level;
 
-    HnswGraph();
+    /**
+     * The link arrays are allocated using the given memory allocator (optional).
+     * This is used to keep the link arrays in a memory mapped file.
+     */
+    explicit HnswGraph(std::shared_ptr<vespalib::alloc::MemoryAllocator> link_memory_allocator = {});
     ~HnswGraph();
 
     NodeRef make_node_for_document(uint32_t docid, uint32_t num_levels);
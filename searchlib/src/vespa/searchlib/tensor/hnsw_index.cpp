@@ -6,6 +6,7 @@
 #include "hnsw_index.h"
 #include "hnsw_index_loader.hpp"
 #include "hnsw_index_saver.h"
+#include "prefetch_utils.h"
 #include "random_level_generator.h"
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/address_space_usage.h>
@@ -15,9 +16,12 @@
 #include <vespa/vespalib/data/slime/inserter.h>
 #include <vespa/vespalib/datastore/array_store.hpp>
 #include <vespa/vespalib/datastore/compaction_strategy.h>
+#include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <limits>
+#include <optional>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -41,6 +45,12 @@ constexpr float alloc_grow_factor = 0.3;
 constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(100ms);
+// Costs relative to one distance calculation, used by estimate_search_cost() to select between plain and
+// filtered traversal. They are not calibrated, and never decide whether exact search is used instead of
+// the index; that is controlled by the brute force limit. vespa-nearest-neighbor-benchmark reports the
+// estimated cost next to the measured latency for both filter traversal modes, for tuning them.
+constexpr double link_array_read_cost = 0.5;
+constexpr double filter_check_cost = 0.02;
 
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
@@ -63,6 +73,43 @@ bool operator< (const PairDist &a, const PairDist &b) {
 
 }
 
+/**
+ * Loads the graph structure, and then populates the quantized vector store
+ * from the full precision vectors of the nodes in the loaded graph.
+ */
+class HnswIndex::QuantizingLoader : public NearestNeighborIndexLoader {
+private:
+    HnswIndex& _index;
+    std::unique_ptr<NearestNeighborIndexLoader> _graph_loader;
+    bool _graph_loaded;
+    uint32_t _docid;
+
+public:
+    QuantizingLoader(HnswIndex& index, std::unique_ptr<NearestNeighborIndexLoader> graph_loader)
+        : _index(index),
+          _graph_loader(std::move(graph_loader)),
+          _graph_loaded(false),
+          _docid(1)
+    {}
+    ~QuantizingLoader() override;
+    bool load_next() override {
+        if (!_graph_loaded) {
+            _graph_loaded = !_graph_loader->load_next();
+            return true;
+        }
+        const auto& graph = _index._graph;
+        if (_docid < graph.size()) {
+            if (graph.get_node_ref(_docid).valid()) {
+                _index._quantized_vectors->set_vector(_docid, _index.get_vector(_docid));
+            }
+            ++_docid;
+        }
+        return (_docid < graph.size());
+    }
+};
+
+HnswIndex::QuantizingLoader::~QuantizingLoader() = default;
+
 vespalib::datastore::ArrayStoreConfig
 HnswIndex::make_default_node_store_config()
 {
@@ -203,6 +250,9 @@ double
 HnswIndex::calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const
 {
     auto lhs = get_vector(lhs_docid);
+    if (lhs.size == 0) {
+        return std::numeric_limits<double>::max();
+    }
     return calc_distance(lhs, rhs_docid);
 }
 
@@ -210,11 +260,46 @@ double
 HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
 {
     auto rhs = get_vector(rhs_docid);
+    if (rhs.size == 0) {
+        return std::numeric_limits<double>::max();
+    }
     return _distance_func->calc(lhs, rhs);
 }
 
+HnswIndex::NeighborBatch::NeighborBatch() = default;
+HnswIndex::NeighborBatch::~NeighborBatch() = default;
+
+void
+HnswIndex::calc_distances(const SearchVector& lhs, NeighborBatch& batch) const
+{
+    size_t num_neighbors = batch.size();
+    batch.distances.resize(num_neighbors);
+    if (lhs.quantized != nullptr) {
+        _quantized_vectors->calc_distances(*lhs.quantized, batch.docids.data(), num_neighbors, batch.distances.data(),
+                                           batch.raw_vectors);
+        return;
+    }
+    batch.cells.clear();
+    batch.removed.clear();
+    for (uint32_t docid : batch.docids) {
+        auto cells = get_vector(docid);
+        if (cells.size == 0) {
+            // The node was removed while searching. Use the input as placeholder and fix the distance below.
+            batch.removed.push_back(batch.cells.size());
+            cells = lhs.cells;
+        }
+        prefetch_vector_start(cells.data, vespalib::eval::CellTypeUtils::mem_size(cells.type, cells.size));
+        batch.cells.push_back(cells);
+    }
+    _distance_func->calc_batch(lhs.cells, batch.cells.data(), num_neighbors, batch.distances.data());
+    for (uint32_t i : batch.removed) {
+        batch.distances[i] = std::numeric_limits<double>::max();
+    }
+}
+
 uint32_t
-HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const search::BitVector* filter) const
+HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find,
+                                  const search::BitVector* filter, FilterTraversal traversal) const
 {
     uint32_t m_for_level = max_links_for_level(level);
     uint64_t base_estimate = uint64_t(m_for_level) * neighbors_to_find + 100;
@@ -228,16 +313,35 @@ HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_
     if (true_bits == 0) {
         return doc_id_limit;
     }
-    double scaler = double(filter->size()) / true_bits;
-    double scaled_estimate = scaler * base_estimate;
+    double scaled_estimate;
+    if (traversal == FilterTraversal::FILTERED) {
+        // Only nodes matching the filter are used as candidates, but the non-matching
+        // neighbors that are expanded through to their neighbors are also visited.
+        double hit_ratio = double(true_bits) / filter->size();
+        scaled_estimate = (2.0 - hit_ratio) * base_estimate;
+    } else {
+        double scaler = double(filter->size()) / true_bits;
+        scaled_estimate = scaler * base_estimate;
+    }
     if (scaled_estimate >= doc_id_limit) {
         return doc_id_limit;
     }
     return scaled_estimate;
 }
 
+HnswCandidateVector
+HnswIndex::rescore(const TypedCells& input, const HnswCandidateVector& candidates) const
+{
+    HnswCandidateVector result;
+    result.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        result.emplace_back(candidate.docid, candidate.node_ref, calc_distance(input, candidate.docid));
+    }
+    return result;
+}
+
 HnswCandidate
-HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex::find_nearest_in_layer(const SearchVector& input, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -259,8 +363,69 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
 
 template <class VisitedTracker>
 void
-HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex::collect_unvisited_neighbors(const HnswCandidate& node, uint32_t level, const search::BitVector* filter,
+                                       FilterTraversal traversal, uint32_t doc_id_limit,
+                                       VisitedTracker& visited, NeighborBatch& batch) const
+{
+    bool filtered = (filter != nullptr) && (traversal == FilterTraversal::FILTERED);
+    auto neighbors = _graph.get_link_array(node.node_ref, level);
+    uint32_t num_matching = 0;
+    for (uint32_t neighbor_docid : neighbors) {
+        if (neighbor_docid >= doc_id_limit) {
+            continue;
+        }
+        if (filtered && !filter_match(*filter, neighbor_docid)) {
+            continue;
+        }
+        ++num_matching;
+        auto neighbor_ref = _graph.acquire_node_ref(neighbor_docid);
+        if ((! neighbor_ref.valid())
+            || ! visited.try_mark(neighbor_docid))
+        {
+            continue;
+        }
+        batch.add(neighbor_docid, neighbor_ref);
+    }
+    // Adaptive exploration: Only expand through the neighbors not matching the filter
+    // when too few of the direct neighbors match the filter to keep the graph navigable.
+    uint32_t wanted_matching = std::min(_cfg.max_links_on_inserts(), max_links_for_level(level));
+    if (!filtered || num_matching >= wanted_matching) {
+        return;
+    }
+    for (uint32_t neighbor_docid : neighbors) {
+        if (num_matching >= wanted_matching) {
+            break;
+        }
+        if (neighbor_docid >= doc_id_limit || filter_match(*filter, neighbor_docid)) {
+            continue;
+        }
+        auto neighbor_ref = _graph.acquire_node_ref(neighbor_docid);
+        if ((! neighbor_ref.valid())
+            || ! visited.try_mark(neighbor_docid))
+        {
+            continue;
+        }
+        for (uint32_t second_docid : _graph.get_link_array(neighbor_ref, level)) {
+            if (second_docid >= doc_id_limit || !filter_match(*filter, second_docid)) {
+                continue;
+            }
+            ++num_matching;
+            auto second_ref = _graph.acquire_node_ref(second_docid);
+            if ((! second_ref.valid())
+                || ! visited.try_mark(second_docid))
+            {
+                continue;
+            }
+            batch.add(second_docid, second_ref);
+        }
+    }
+}
+
+template <class VisitedTracker>
+void
+HnswIndex::search_layer_helper(const SearchVector& input, uint32_t neighbors_to_find,
                                FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter,
+                               FilterTraversal traversal,
                                uint32_t doc_id_limit, uint32_t estimated_visited_nodes) const
 {
     NearestPriQ candidates;
@@ -271,12 +436,13 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
         }
         candidates.push(entry);
         visited.mark(entry.docid);
-        if (filter && !filter->testBit(entry.docid)) {
+        if (filter && !filter_match(*filter, entry.docid)) {
             assert(best_neighbors.size() == 1);
             best_neighbors.pop();
         }
     }
     double limit_dist = std::numeric_limits<double>::max();
+    NeighborBatch batch;
 
     while (!candidates.empty()) {
         auto cand = candidates.top();
@@ -284,20 +450,16 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
             break;
         }
         candidates.pop();
-        for (uint32_t neighbor_docid : _graph.get_link_array(cand.node_ref, level)) {
-            if (neighbor_docid >= doc_id_limit) {
-                continue;
-            }
-            auto neighbor_ref = _graph.acquire_node_ref(neighbor_docid);
-            if ((! neighbor_ref.valid())
-                || ! visited.try_mark(neighbor_docid))
-            {
-                continue;
-            }
-            double dist_to_input = calc_distance(input, neighbor_docid);
+        batch.clear();
+        collect_unvisited_neighbors(cand, level, filter, traversal, doc_id_limit, visited, batch);
+        calc_distances(input, batch);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            uint32_t neighbor_docid = batch.docids[i];
+            auto neighbor_ref = batch.node_refs[i];
+            double dist_to_input = batch.distances[i];
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
-                if ((!filter) || filter->testBit(neighbor_docid)) {
+                if ((!filter) || filter_match(*filter, neighbor_docid)) {
                     best_neighbors.emplace(neighbor_docid, neighbor_ref, dist_to_input);
                     if (best_neighbors.size() > neighbors_to_find) {
                         best_neighbors.pop();
@@ -310,31 +472,37 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
 }
 
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
-                        FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
+HnswIndex::search_layer(const SearchVector& input, uint32_t neighbors_to_find,
+                        FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter,
+                        FilterTraversal traversal) const
 {
     uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_acquire);
-    if (filter) {
+    if (filter && !_id_mapping) {
         doc_id_limit = std::min(filter->size(), doc_id_limit);
     }
-    uint32_t estimated_visited_nodes = estimate_visited_nodes(level, doc_id_limit, neighbors_to_find, filter);
+    uint32_t estimated_visited_nodes = estimate_visited_nodes(level, doc_id_limit, neighbors_to_find, filter, traversal);
 #if ! USE_OLD_VISITED_TRACKER
     if (estimated_visited_nodes >= doc_id_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+        search_layer_helper<BitVectorVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, traversal, doc_id_limit, estimated_visited_nodes);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+        search_layer_helper<HashSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, traversal, doc_id_limit, estimated_visited_nodes);
     }
 #else
-    search_layer_helper<ReusableSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+    search_layer_helper<ReusableSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, traversal, doc_id_limit, estimated_visited_nodes);
 #endif
 }
 
 HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-                     RandomLevelGenerator::UP level_generator, const Config& cfg)
-    : _graph(),
+                     RandomLevelGenerator::UP level_generator, const Config& cfg,
+                     std::unique_ptr<QuantizedVectorStore> quantized_vectors,
+                     std::shared_ptr<vespalib::alloc::MemoryAllocator> link_memory_allocator)
+    : _graph(link_memory_allocator),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
       _level_generator(std::move(level_generator)),
+      _quantized_vectors(std::move(quantized_vectors)),
+      _id_mapping(cfg.multi_vector() ? std::make_unique<HnswNodeidMapping>() : std::unique_ptr<HnswNodeidMapping>()),
+      _disk_resident(static_cast<bool>(link_memory_allocator)),
       _cfg(cfg),
       _visited_set_pool(),
       _compaction_spec()
@@ -344,10 +512,27 @@ HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distan
 
 HnswIndex::~HnswIndex() = default;
 
+HnswIndex::PreparedAddMultiDoc::~PreparedAddMultiDoc() = default;
+
 void
 HnswIndex::add_document(uint32_t docid)
 {
     vespalib::GenerationHandler::Guard no_guard_needed;
+    if (_id_mapping) {
+        auto vectors = _vectors.get_vectors(docid);
+        if (_graph.get_entry_node().docid == 0) {
+            // The subspaces of the first document are added one by one, so they are linked to each other.
+            auto nodeids = _id_mapping->allocate_ids(docid, vectors.subspaces());
+            for (uint32_t subspace = 0; subspace < nodeids.size(); ++subspace) {
+                PreparedAddDoc op = internal_prepare_add(nodeids[subspace], vectors.cells(subspace), no_guard_needed);
+                internal_complete_add(nodeids[subspace], op);
+            }
+            return;
+        }
+        auto op = internal_prepare_add_multi(docid, vectors, std::move(no_guard_needed));
+        internal_complete_add_multi(docid, *op);
+        return;
+    }
     PreparedAddDoc op = internal_prepare_add(docid, get_vector(docid), no_guard_needed);
     internal_complete_add(docid, op);
 }
@@ -363,12 +548,17 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
         // graph has no entry point
         return op;
     }
+    std::optional<QueryVector> quantized_vector;
+    if (_quantized_vectors) {
+        quantized_vector.emplace(_quantized_vectors->prepare_query(input_vector));
+    }
+    SearchVector input = quantized_vector ? SearchVector(input_vector, *quantized_vector) : SearchVector(input_vector);
     int search_level = entry.level;
-    double entry_dist = calc_distance(input_vector, entry.docid);
+    double entry_dist = calc_distance(input, entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > op.max_level) {
-        entry_point = find_nearest_in_layer(input_vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(input, entry_point, search_level);
         --search_level;
     }
 
@@ -378,8 +568,11 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
 
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(input_vector, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
-        auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
+        search_layer(input, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        // Neighbors are selected using full precision distances, also when the graph is traversed using quantized vectors.
+        auto neighbors = quantized_vector
+                ? select_neighbors(rescore(input_vector, best_neighbors.peek()), _cfg.max_links_on_inserts())
+                : select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         op.connections[search_level].reserve(neighbors.used.size());
         for (const auto & neighbor : neighbors.used) {
             auto neighbor_levels = _graph.get_level_array(neighbor.node_ref);
@@ -395,6 +588,19 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
     return op;
 }
 
+std::unique_ptr<HnswIndex::PreparedAddMultiDoc>
+HnswIndex::internal_prepare_add_multi(uint32_t docid, VectorBundle vectors, vespalib::GenerationHandler::Guard read_guard) const
+{
+    // All subspaces are prepared against the same graph before any of them is linked in,
+    // so a document gets the same links whether it is added in one or two phases.
+    auto op = std::make_unique<PreparedAddMultiDoc>(docid, std::move(read_guard));
+    op->nodes.reserve(vectors.subspaces());
+    for (uint32_t subspace = 0; subspace < vectors.subspaces(); ++subspace) {
+        op->nodes.emplace_back(internal_prepare_add(docid, vectors.cells(subspace), vespalib::GenerationHandler::Guard()));
+    }
+    return op;
+}
+
 HnswIndex::LinkArray 
 HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t self_docid)
 {
@@ -417,6 +623,10 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    if (_quantized_vectors) {
+        // Must be stored before the node is linked into the graph.
+        _quantized_vectors->set_vector(docid, get_vector(docid));
+    }
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -427,9 +637,18 @@ HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
     }
 }
 
+void
+HnswIndex::internal_complete_add_multi(uint32_t docid, PreparedAddMultiDoc &op)
+{
+    auto nodeids = _id_mapping->allocate_ids(docid, op.nodes.size());
+    for (uint32_t subspace = 0; subspace < nodeids.size(); ++subspace) {
+        internal_complete_add(nodeids[subspace], op.nodes[subspace]);
+    }
+}
+
 std::unique_ptr<PrepareResult>
 HnswIndex::prepare_add_document(uint32_t docid, 
-            TypedCells vector,
+            VectorBundle vectors,
             vespalib::GenerationHandler::Guard read_guard) const
 {
     uint32_t max_nodes = _graph.node_refs_size.load(std::memory_order_acquire);
@@ -438,7 +657,13 @@ HnswIndex::prepare_add_document(uint32_t docid,
         // to ensure they are linked together:
         return std::make_unique<PreparedFirstAddDoc>();
     }
-    PreparedAddDoc op = internal_prepare_add(docid, vector, std::move(read_guard));
+    if (_id_mapping) {
+        if (_graph.get_entry_node().docid == 0) {
+            return std::make_unique<PreparedFirstAddDoc>();
+        }
+        return internal_prepare_add_multi(docid, vectors, std::move(read_guard));
+    }
+    PreparedAddDoc op = internal_prepare_add(docid, vectors.cells(0), std::move(read_guard));
     return std::make_unique<PreparedAddDoc>(std::move(op));
 }
 
@@ -446,8 +671,11 @@ void
 HnswIndex::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result)
 {
     auto prepared = dynamic_cast<PreparedAddDoc *>(prepare_result.get());
+    auto prepared_multi = dynamic_cast<PreparedAddMultiDoc *>(prepare_result.get());
     if (prepared && (prepared->docid == docid)) {
         internal_complete_add(docid, *prepared);
+    } else if (prepared_multi && (prepared_multi->docid == docid)) {
+        internal_complete_add_multi(docid, *prepared_multi);
     } else {
         // we expect this for the first documents added, so no warning for them
         if (_graph.node_refs.size() > 1.25 * _cfg.min_size_before_two_phase()) {
@@ -486,19 +714,19 @@ HnswIndex::mutual_reconnect(const LinkArrayRef &cluster, uint32_t level)
 }
 
 void
-HnswIndex::remove_document(uint32_t docid)
+HnswIndex::remove_node(uint32_t nodeid)
 {
-    bool need_new_entrypoint = (docid == get_entry_docid());
-    LevelArrayRef node_levels = _graph.get_level_array(docid);
+    bool need_new_entrypoint = (nodeid == get_entry_docid());
+    LevelArrayRef node_levels = _graph.get_level_array(nodeid);
     for (int level = node_levels.size(); level-- > 0; ) {
-        LinkArrayRef my_links = _graph.get_link_array(docid, level);
+        LinkArrayRef my_links = _graph.get_link_array(nodeid, level);
         for (uint32_t neighbor_id : my_links) {
             if (need_new_entrypoint) {
                 auto entry_node_ref = _graph.get_node_ref(neighbor_id);
                 _graph.set_entry_node({neighbor_id, entry_node_ref, level});
                 need_new_entrypoint = false;
             }
-            remove_link_to(neighbor_id, docid, level);
+            remove_link_to(neighbor_id, nodeid, level);
         }
         mutual_reconnect(my_links, level);
     }
@@ -506,7 +734,23 @@ HnswIndex::remove_document(uint32_t docid)
         HnswGraph::EntryNode entry;
         _graph.set_entry_node(entry);
     }
-    _graph.remove_node_for_document(docid);
+    _graph.remove_node_for_document(nodeid);
+    if (_quantized_vectors) {
+        _quantized_vectors->remove_vector(nodeid);
+    }
+}
+
+void
+HnswIndex::remove_document(uint32_t docid)
+{
+    if (_id_mapping) {
+        for (uint32_t nodeid : _id_mapping->get_ids(docid)) {
+            remove_node(nodeid);
+        }
+        _id_mapping->free_ids(docid);
+        return;
+    }
+    remove_node(docid);
 }
 
 void
@@ -517,6 +761,12 @@ HnswIndex::transfer_hold_lists(generation_t current_gen)
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
+    if (_id_mapping) {
+        _id_mapping->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -525,6 +775,12 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
+    if (_id_mapping) {
+        _id_mapping->trim_hold_lists(first_used_gen);
+    }
 }
 
 void
@@ -580,6 +836,9 @@ HnswIndex::consider_compact(const CompactionStrategy& compaction_strategy)
     if (consider_compact_link_arrays(compaction_strategy)) {
         result = true;
     }
+    if (_quantized_vectors && _quantized_vectors->consider_compact()) {
+        result = true;
+    }
     return result;
 }
 
@@ -597,6 +856,12 @@ HnswIndex::update_stat(const CompactionStrategy& compaction_strategy)
                                                compaction_strategy.should_compact(link_arrays_memory_usage, link_arrays_address_space_usage));
     result.merge(link_arrays_memory_usage);
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->update_stat(compaction_strategy));
+    }
+    if (_id_mapping) {
+        result.merge(_id_mapping->memory_usage());
+    }
     return result;
 }
 
@@ -608,6 +873,12 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
+    if (_id_mapping) {
+        result.merge(_id_mapping->memory_usage());
+    }
     return result;
 }
 
@@ -616,6 +887,9 @@ HnswIndex::populate_address_space_usage(search::AddressSpaceUsage& usage) const
 {
     usage.set(AddressSpaceComponents::hnsw_node_store, _graph.nodes.addressSpaceUsage());
     usage.set(AddressSpaceComponents::hnsw_link_store, _graph.links.addressSpaceUsage());
+    if (_quantized_vectors) {
+        usage.set(AddressSpaceComponents::hnsw_quantized_vector_store, _quantized_vectors->address_space_usage());
+    }
 }
 
 void
@@ -628,6 +902,12 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links.getMemoryUsage(), memUsageObj.setObject("links"));
     StateExplorerUtils::memory_usage_to_slime(_visited_set_pool.memory_usage(), memUsageObj.setObject("visited_set_pool"));
+    if (_quantized_vectors) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
+    if (_id_mapping) {
+        StateExplorerUtils::memory_usage_to_slime(_id_mapping->memory_usage(), memUsageObj.setObject("nodeid_mapping"));
+    }
     auto& visitedObj = object.setObject("visited_set");
     visitedObj.setLong("create_count", _visited_set_pool.create_count());
     visitedObj.setLong("reuse_count", _visited_set_pool.reuse_count());
@@ -659,11 +939,18 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    cfgObj.setBool("int8_quantization", static_cast<bool>(_quantized_vectors));
+    cfgObj.setBool("disk_resident", _disk_resident);
+    cfgObj.setBool("multi_vector", _cfg.multi_vector());
 }
 
 void
 HnswIndex::shrink_lid_space(uint32_t doc_id_limit)
 {
+    if (_id_mapping) {
+        // The node id space is independent of the lid space.
+        return;
+    }
     assert(doc_id_limit >= 1u);
     assert(doc_id_limit >= _graph.node_refs_size.load(std::memory_order_relaxed));
     uint32_t old_doc_id_limit = _graph.node_refs.size();
@@ -671,12 +958,15 @@ HnswIndex::shrink_lid_space(uint32_t doc_id_limit)
         return;
     }
     _graph.node_refs.shrink(doc_id_limit);
+    if (_quantized_vectors) {
+        _quantized_vectors->shrink_lid_space(doc_id_limit);
+    }
 }
 
 std::unique_ptr<NearestNeighborIndexSaver>
 HnswIndex::make_saver() const
 {
-    return std::make_unique<HnswIndexSaver>(_graph);
+    return std::make_unique<HnswIndexSaver>(_graph, _id_mapping.get());
 }
 
 std::unique_ptr<NearestNeighborIndexLoader>
@@ -685,7 +975,11 @@ HnswIndex::make_loader(FastOS_FileInterface& file)
     assert(get_entry_docid() == 0); // cannot load after index has data
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType>;
-    return std::make_unique<LoaderType>(_graph, std::make_unique<ReaderType>(&file));
+    auto graph_loader = std::make_unique<LoaderType>(_graph, std::make_unique<ReaderType>(&file), _id_mapping.get());
+    if (_quantized_vectors) {
+        return std::make_unique<QuantizingLoader>(*this, std::move(graph_loader));
+    }
+    return graph_loader;
 }
 
 struct NeighborsByDocId {
@@ -698,11 +992,14 @@ struct NeighborsByDocId {
 
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
-                          const BitVector *filter, uint32_t explore_k,
-                          double distance_threshold) const
+                          const BitVector *filter, FilterTraversal traversal,
+                          uint32_t explore_k, double distance_threshold) const
 {
     std::vector<Neighbor> result;
-    FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter);
+    if (_id_mapping) {
+        return top_k_by_docid_multi(k, vector, filter, traversal, explore_k, distance_threshold);
+    }
+    FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter, traversal);
     while (candidates.size() > k) {
         candidates.pop();
     }
@@ -715,23 +1012,106 @@ HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
     return result;
 }
 
+std::vector<NearestNeighborIndex::Neighbor>
+HnswIndex::top_k_by_docid_multi(uint32_t k, TypedCells vector,
+                                const BitVector *filter, FilterTraversal traversal,
+                                uint32_t explore_k, double distance_threshold) const
+{
+    // A document can have multiple nodes in the graph, and only the nearest one is returned.
+    // As several of the candidate nodes might belong to the same document, the search is
+    // repeated with twice as many candidates until k documents are found, or there are no more nodes to find.
+    std::vector<Neighbor> result;
+    uint32_t node_limit = _graph.node_refs_size.load(std::memory_order_acquire);
+    uint32_t wanted = std::max(k, explore_k);
+    vespalib::hash_set<uint32_t> seen_docids;
+    for (;;) {
+        FurthestPriQ candidates = top_k_candidates(vector, wanted, filter, traversal);
+        bool exhausted = (candidates.size() < wanted) || (wanted >= node_limit);
+        HnswCandidateVector hits = candidates.peek();
+        std::sort(hits.begin(), hits.end(), LesserDistance());
+        result.clear();
+        seen_docids.clear();
+        for (const HnswCandidate & hit : hits) {
+            if (hit.distance > distance_threshold) {
+                exhausted = true;
+                break;
+            }
+            if (result.size() >= k) {
+                break;
+            }
+            uint32_t docid = get_docid(hit.docid);
+            if (seen_docids.insert(docid).second) {
+                result.emplace_back(docid, hit.distance);
+            }
+        }
+        if (result.size() >= k || exhausted) {
+            break;
+        }
+        wanted = std::min(2 * uint64_t(wanted), uint64_t(node_limit));
+    }
+    std::sort(result.begin(), result.end(), NeighborsByDocId());
+    return result;
+}
+
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
                       double distance_threshold) const
 {
-    return top_k_by_docid(k, vector, nullptr, explore_k, distance_threshold);
+    return top_k_by_docid(k, vector, nullptr, FilterTraversal::PLAIN, explore_k, distance_threshold);
 }
 
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
-                                  const BitVector &filter, uint32_t explore_k,
-                                  double distance_threshold) const
+                                  const BitVector &filter, FilterTraversal traversal,
+                                  uint32_t explore_k, double distance_threshold) const
+{
+    return top_k_by_docid(k, vector, &filter, traversal, explore_k, distance_threshold);
+}
+
+double
+HnswIndex::estimate_search_cost(uint32_t explore_k, const BitVector* filter, FilterTraversal traversal) const
 {
-    return top_k_by_docid(k, vector, &filter, explore_k, distance_threshold);
+    uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_acquire);
+    if (filter && !_id_mapping) {
+        doc_id_limit = std::min(filter->size(), doc_id_limit);
+    }
+    double max_links = max_links_for_level(0);
+    // Number of nodes matching the filter that must be reached (and have their distance calculated).
+    double matching_nodes = max_links * explore_k + 100;
+    double hit_ratio = 1.0;
+    if (filter) {
+        uint32_t true_bits = filter->countTrueBits();
+        if (true_bits == 0) {
+            return doc_id_limit;
+        }
+        hit_ratio = double(true_bits) / filter->size();
+        matching_nodes = std::min(matching_nodes, double(true_bits));
+    }
+    if (traversal == FilterTraversal::PLAIN) {
+        // All neighbors are candidates, and distances are also calculated for the nodes not matching the filter.
+        double distance_calcs = std::min(matching_nodes / hit_ratio, double(doc_id_limit));
+        double expanded_nodes = distance_calcs / max_links;
+        return distance_calcs + expanded_nodes * link_array_read_cost;
+    }
+    // Only neighbors matching the filter are candidates. When too few of the direct neighbors match,
+    // non-matching neighbors are expanded through to their neighbors (see collect_unvisited_neighbors()),
+    // at the cost of reading their link arrays and checking their neighbors against the filter.
+    double wanted_matching = std::min(double(_cfg.max_links_on_inserts()), max_links);
+    double direct_matching = max_links * hit_ratio;
+    double extra_expansions = 0.0;
+    if (direct_matching < wanted_matching) {
+        extra_expansions = std::min(max_links * (1.0 - hit_ratio), (wanted_matching - direct_matching) / direct_matching);
+    }
+    double matching_per_expansion = std::min(max_links, direct_matching * (1.0 + extra_expansions));
+    double distance_calcs = std::min(matching_nodes, double(doc_id_limit));
+    double expanded_nodes = distance_calcs / matching_per_expansion;
+    double link_arrays_read = expanded_nodes * (1.0 + extra_expansions);
+    return distance_calcs + link_arrays_read * (link_array_read_cost + max_links * filter_check_cost);
 }
 
 FurthestPriQ
-HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+HnswIndex::find_top_k_candidates(const SearchVector& input, uint32_t k, const BitVector *filter,
+                                 FilterTraversal traversal) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -740,18 +1120,34 @@ HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVecto
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.docid);
+    double entry_dist = calc_distance(input, entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(input, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
+    search_layer(input, k, best_neighbors, 0, filter, traversal);
     return best_neighbors;
 }
 
+FurthestPriQ
+HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter,
+                            FilterTraversal traversal) const
+{
+    if (!_quantized_vectors) {
+        return find_top_k_candidates(SearchVector(vector), k, filter, traversal);
+    }
+    auto quantized_vector = _quantized_vectors->prepare_query(vector);
+    auto candidates = find_top_k_candidates(SearchVector(vector, quantized_vector), k, filter, traversal);
+    FurthestPriQ result;
+    for (const auto& candidate : rescore(vector, candidates.peek())) {
+        result.push(candidate);
+    }
+    return result;
+}
+
 HnswNode
 HnswIndex::get_node(uint32_t docid) const
 {
@@ -775,6 +1171,9 @@ HnswIndex::set_node(uint32_t docid, const HnswNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    if (_quantized_vectors) {
+        _quantized_vectors->set_vector(docid, get_vector(docid));
+    }
     auto node_ref = _graph.make_node_for_document(docid, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(docid, node.level(level), level);
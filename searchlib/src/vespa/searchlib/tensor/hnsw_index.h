@@ -6,7 +6,9 @@
 #include "doc_vector_access.h"
 #include "hnsw_index_utils.h"
 #include "hnsw_node.h"
+#include "hnsw_nodeid_mapping.h"
 #include "nearest_neighbor_index.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
 #include <vespa/eval/eval/typed_cells.h>
@@ -31,6 +33,10 @@ namespace search::tensor {
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
  * but some adjustments are made to support proper removes.
  *
+ * When multi-vector mode is enabled a document can have multiple vectors (one per subspace of a mixed tensor).
+ * Each vector is then represented by its own node in the graph, and the node ids are mapped to docids
+ * using HnswNodeidMapping. Searches return the best distance among the subspaces of each document.
+ *
  * TODO: Add details on how to handle removes.
  */
 class HnswIndex : public NearestNeighborIndex {
@@ -42,24 +48,28 @@ public:
         uint32_t _neighbors_to_explore_at_construction;
         uint32_t _min_size_before_two_phase;
         bool _heuristic_select_neighbors;
+        bool _multi_vector;
 
     public:
         Config(uint32_t max_links_at_level_0_in,
                uint32_t max_links_on_inserts_in,
                uint32_t neighbors_to_explore_at_construction_in,
                uint32_t min_size_before_two_phase_in,
-               bool heuristic_select_neighbors_in)
+               bool heuristic_select_neighbors_in,
+               bool multi_vector_in = false)
             : _max_links_at_level_0(max_links_at_level_0_in),
               _max_links_on_inserts(max_links_on_inserts_in),
               _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
               _min_size_before_two_phase(min_size_before_two_phase_in),
-              _heuristic_select_neighbors(heuristic_select_neighbors_in)
+              _heuristic_select_neighbors(heuristic_select_neighbors_in),
+              _multi_vector(multi_vector_in)
         {}
         uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
         uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
         uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
         uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
         bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+        bool multi_vector() const { return _multi_vector; }
     };
 
     class HnswIndexCompactionSpec {
@@ -92,11 +102,49 @@ protected:
     using LevelArrayRef = HnswGraph::LevelArrayRef;
 
     using TypedCells = vespalib::eval::TypedCells;
+    using QueryVector = QuantizedVectorStore::QueryVector;
+
+    /**
+     * A vector (query or document being inserted) that is searched for in the graph.
+     * When the quantized query vector is set, the quantized vectors are used to calculate approximate distances.
+     */
+    struct SearchVector {
+        TypedCells cells;
+        const QueryVector* quantized;
+        explicit SearchVector(TypedCells cells_in) noexcept : cells(cells_in), quantized(nullptr) {}
+        SearchVector(TypedCells cells_in, const QueryVector& quantized_in) noexcept : cells(cells_in), quantized(&quantized_in) {}
+    };
+
+    /**
+     * The unvisited neighbors of a node in the graph, for which the distances are calculated in one batch.
+     */
+    struct NeighborBatch {
+        std::vector<uint32_t> docids;
+        std::vector<HnswGraph::NodeRef> node_refs;
+        std::vector<TypedCells> cells;
+        std::vector<double> distances;
+        std::vector<const char*> raw_vectors; // Scratch space for the quantized vector store
+        std::vector<uint32_t> removed;        // Indexes of nodes removed while searching
+        NeighborBatch();
+        ~NeighborBatch();
+        void clear() noexcept {
+            docids.clear();
+            node_refs.clear();
+        }
+        void add(uint32_t docid, HnswGraph::NodeRef node_ref) {
+            docids.push_back(docid);
+            node_refs.push_back(node_ref);
+        }
+        size_t size() const noexcept { return docids.size(); }
+    };
 
     HnswGraph _graph;
     const DocVectorAccess& _vectors;
     DistanceFunction::UP _distance_func;
     RandomLevelGenerator::UP _level_generator;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
+    std::unique_ptr<HnswNodeidMapping> _id_mapping;
+    bool _disk_resident;
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
     HnswIndexCompactionSpec _compaction_spec;
@@ -128,29 +176,85 @@ protected:
     void connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level);
     void mutual_reconnect(const LinkArrayRef &cluster, uint32_t level);
     void remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level);
+    void remove_node(uint32_t nodeid);
 
-    inline TypedCells get_vector(uint32_t docid) const {
-        return _vectors.get_vector(docid);
+    // The graph is built using node ids. Without multi-vector mode the node id is the docid.
+    uint32_t get_docid(uint32_t nodeid) const noexcept {
+        return _id_mapping ? _id_mapping->get_docid(nodeid) : nodeid;
+    }
+    bool filter_match(const search::BitVector& filter, uint32_t nodeid) const {
+        uint32_t docid = get_docid(nodeid);
+        return (docid < filter.size()) && filter.testBit(docid);
+    }
+    /**
+     * Returns the vector of the given node.
+     *
+     * In multi-vector mode a search thread can hold a node id after the document has been removed or
+     * updated to have fewer subspaces. An empty vector is then returned, and distances to it are
+     * calculated as the maximum distance.
+     */
+    inline TypedCells get_vector(uint32_t nodeid) const {
+        if (_id_mapping) {
+            auto vectors = _vectors.get_vectors(_id_mapping->get_docid(nodeid));
+            uint32_t subspace = _id_mapping->get_subspace(nodeid);
+            if (subspace >= vectors.subspaces()) {
+                return TypedCells();
+            }
+            return vectors.cells(subspace);
+        }
+        return _vectors.get_vector(nodeid);
     }
 
     double calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const;
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const;
-    uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const search::BitVector* filter) const;
+    double calc_distance(const SearchVector& lhs, uint32_t rhs_docid) const {
+        if (lhs.quantized != nullptr) {
+            return _quantized_vectors->calc_distance(*lhs.quantized, rhs_docid);
+        }
+        return calc_distance(lhs.cells, rhs_docid);
+    }
+    /**
+     * Calculates the distances between the input and the documents in the batch.
+     * The vectors of all documents are prefetched before any distance is calculated.
+     */
+    void calc_distances(const SearchVector& lhs, NeighborBatch& batch) const;
+    /**
+     * Returns the given candidates with the distances recalculated using the full precision vectors.
+     */
+    HnswCandidateVector rescore(const TypedCells& input, const HnswCandidateVector& candidates) const;
+    uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find,
+                                    const search::BitVector* filter, FilterTraversal traversal) const;
+    /**
+     * Adds the neighbors of the given node that are not yet visited to the batch.
+     * When using filtered traversal, neighbors not matching the filter are replaced by their own
+     * neighbors matching the filter, if too few of the direct neighbors match the filter.
+     */
+    template <class VisitedTracker>
+    void collect_unvisited_neighbors(const HnswCandidate& node, uint32_t level, const search::BitVector* filter,
+                                     FilterTraversal traversal, uint32_t doc_id_limit,
+                                     VisitedTracker& visited, NeighborBatch& batch) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
+    HnswCandidate find_nearest_in_layer(const SearchVector& input, const HnswCandidate& entry_point, uint32_t level) const;
     template <class VisitedTracker>
-    void search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+    void search_layer_helper(const SearchVector& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                              uint32_t level, const search::BitVector *filter,
+                             FilterTraversal traversal,
                              uint32_t doc_id_limit,
                              uint32_t estimated_visited_nodes) const;
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
-                      uint32_t level, const search::BitVector *filter = nullptr) const;
+    void search_layer(const SearchVector& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+                      uint32_t level, const search::BitVector *filter = nullptr,
+                      FilterTraversal traversal = FilterTraversal::PLAIN) const;
+    std::vector<Neighbor> top_k_by_docid_multi(uint32_t k, TypedCells vector,
+                                               const BitVector *filter, FilterTraversal traversal,
+                                               uint32_t explore_k, double distance_threshold) const;
+    FurthestPriQ find_top_k_candidates(const SearchVector& input, uint32_t k, const BitVector *filter,
+                                       FilterTraversal traversal) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
-                                         const BitVector *filter, uint32_t explore_k,
-                                         double distance_threshold) const;
+                                         const BitVector *filter, FilterTraversal traversal,
+                                         uint32_t explore_k, double distance_threshold) const;
 
     struct PreparedFirstAddDoc : public PrepareResult {};
 
@@ -169,13 +273,33 @@ protected:
         ~PreparedAddDoc() = default;
         PreparedAddDoc(PreparedAddDoc&& other) = default;
     };
+
+    // Used in multi-vector mode, with one prepared node per subspace of the document.
+    struct PreparedAddMultiDoc : public PrepareResult {
+        using ReadGuard = vespalib::GenerationHandler::Guard;
+        uint32_t docid;
+        ReadGuard read_guard;
+        std::vector<PreparedAddDoc> nodes;
+        PreparedAddMultiDoc(uint32_t docid_in, ReadGuard read_guard_in)
+          : docid(docid_in),
+            read_guard(std::move(read_guard_in)),
+            nodes()
+        {}
+        ~PreparedAddMultiDoc() override;
+    };
     PreparedAddDoc internal_prepare_add(uint32_t docid, TypedCells input_vector,
                                         vespalib::GenerationHandler::Guard read_guard) const;
+    std::unique_ptr<PreparedAddMultiDoc> internal_prepare_add_multi(uint32_t docid, VectorBundle vectors,
+                                                                    vespalib::GenerationHandler::Guard read_guard) const;
     LinkArray filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t me);
     void internal_complete_add(uint32_t docid, PreparedAddDoc &op);
+    void internal_complete_add_multi(uint32_t docid, PreparedAddMultiDoc &op);
+    class QuantizingLoader;
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-              RandomLevelGenerator::UP level_generator, const Config& cfg);
+              RandomLevelGenerator::UP level_generator, const Config& cfg,
+              std::unique_ptr<QuantizedVectorStore> quantized_vectors = {},
+              std::shared_ptr<vespalib::alloc::MemoryAllocator> link_memory_allocator = {});
     ~HnswIndex() override;
 
     const Config& config() const { return _cfg; }
@@ -183,7 +307,7 @@ public:
     // Implements NearestNeighborIndex
     void add_document(uint32_t docid) override;
     std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid,
-            TypedCells vector,
+            VectorBundle vectors,
             vespalib::GenerationHandler::Guard read_guard) const override;
     void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
     void remove_document(uint32_t docid) override;
@@ -206,11 +330,19 @@ public:
     std::vector<Neighbor> find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
                                      double distance_threshold) const override;
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, TypedCells vector,
-                                                 const BitVector &filter, uint32_t explore_k,
-                                                 double distance_threshold) const override;
+                                                 const BitVector &filter, FilterTraversal traversal,
+                                                 uint32_t explore_k, double distance_threshold) const override;
+    double estimate_search_cost(uint32_t explore_k, const BitVector* filter,
+                                FilterTraversal traversal) const override;
     const DistanceFunction *distance_function() const override { return _distance_func.get(); }
 
-    FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const;
+    /**
+     * Returns the k candidates nearest the given vector, with full precision distances.
+     * When quantized vectors are used, the graph is traversed using approximate distances
+     * and the resulting candidates are rescored using the full precision vectors.
+     */
+    FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter,
+                                  FilterTraversal traversal = FilterTraversal::PLAIN) const;
 
     uint32_t get_entry_docid() const { return _graph.get_entry_node().docid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
@@ -221,6 +353,8 @@ public:
     bool check_link_symmetry() const;
     std::pair<uint32_t, bool> count_reachable_nodes() const;
     HnswGraph& get_graph() { return _graph; }
+    const QuantizedVectorStore* get_quantized_vectors() const noexcept { return _quantized_vectors.get(); }
+    const HnswNodeidMapping* get_id_mapping() const noexcept { return _id_mapping.get(); }
     vespalib::ReusableSetPool& get_visited_set_pool() const noexcept { return _visited_set_pool; }
 
     static vespalib::datastore::ArrayStoreConfig make_default_node_store_config();
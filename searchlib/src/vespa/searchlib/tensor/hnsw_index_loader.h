@@ -13,14 +13,19 @@ class FastOS_FileInterface;
 namespace search::tensor {
 
 struct HnswGraph;
+class HnswNodeidMapping;
 
 /**
  * Implements loading of HNSW graph structure from binary format.
+ *
+ * In multi-vector mode the format version is verified, and the docid
+ * and subspace of each node are loaded into the given node id mapping.
  **/
 template <typename ReaderType>
 class HnswIndexLoader : public NearestNeighborIndexLoader {
 private:
     HnswGraph& _graph;
+    HnswNodeidMapping* _id_mapping;
     std::unique_ptr<ReaderType> _reader;
     uint32_t _entry_docid;
     int32_t _entry_level;
@@ -35,7 +40,7 @@ private:
     }
 
 public:
-    HnswIndexLoader(HnswGraph& graph, std::unique_ptr<ReaderType> reader);
+    HnswIndexLoader(HnswGraph& graph, std::unique_ptr<ReaderType> reader, HnswNodeidMapping* id_mapping = nullptr);
     virtual ~HnswIndexLoader();
     bool load_next() override;
 };
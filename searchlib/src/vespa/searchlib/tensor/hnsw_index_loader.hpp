@@ -4,7 +4,11 @@
 
 #include "hnsw_index_loader.h"
 #include "hnsw_graph.h"
+#include "hnsw_index_saver.h"
+#include "hnsw_nodeid_mapping.h"
 #include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <stdexcept>
 
 namespace search::tensor {
 
@@ -12,6 +16,13 @@ template <typename ReaderType>
 void
 HnswIndexLoader<ReaderType>::init()
 {
+    if (_id_mapping) {
+        uint32_t format_version = next_int();
+        if (format_version != HnswIndexSaver::multi_vector_format_version) {
+            throw std::runtime_error(vespalib::make_string("Unsupported multi-vector hnsw index format version %u (expected %u)",
+                                                           format_version, HnswIndexSaver::multi_vector_format_version));
+        }
+    }
     _entry_docid = next_int();
     _entry_level = next_int();
     _num_nodes = next_int();
@@ -21,8 +32,9 @@ template <typename ReaderType>
 HnswIndexLoader<ReaderType>::~HnswIndexLoader() {}
 
 template <typename ReaderType>
-HnswIndexLoader<ReaderType>::HnswIndexLoader(HnswGraph& graph, std::unique_ptr<ReaderType> reader)
+HnswIndexLoader<ReaderType>::HnswIndexLoader(HnswGraph& graph, std::unique_ptr<ReaderType> reader, HnswNodeidMapping* id_mapping)
     : _graph(graph),
+      _id_mapping(id_mapping),
       _reader(std::move(reader)),
       _entry_docid(0),
       _entry_level(0),
@@ -42,6 +54,11 @@ HnswIndexLoader<ReaderType>::load_next()
     if (_docid < _num_nodes) {
         uint32_t num_levels = next_int();
         if (num_levels > 0) {
+            if (_id_mapping) {
+                uint32_t docid = next_int();
+                uint32_t subspace = next_int();
+                _id_mapping->assign_id(_docid, docid, subspace);
+            }
             _graph.make_node_for_document(_docid, num_levels);
             for (uint32_t level = 0; level < num_levels; ++level) {
                 uint32_t num_links = next_int();
@@ -61,6 +78,9 @@ HnswIndexLoader<ReaderType>::load_next()
         _graph.trim_node_refs_size();
         auto entry_node_ref = _graph.get_node_ref(_entry_docid);
         _graph.set_entry_node({_entry_docid, entry_node_ref, _entry_level});
+        if (_id_mapping) {
+            _id_mapping->on_load(std::max(_num_nodes, 1u));
+        }
         _complete = true;
         return false;
     }
@@ -2,6 +2,7 @@
 
 #include "hnsw_index_saver.h"
 #include "hnsw_graph.h"
+#include "hnsw_nodeid_mapping.h"
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <limits>
 
@@ -28,13 +29,14 @@ HnswIndexSaver::MetaData::MetaData()
     : entry_docid(0),
       entry_level(-1),
       refs(),
-      nodes()
+      nodes(),
+      node_ids()
 {}
 HnswIndexSaver::MetaData::~MetaData() = default;
 HnswIndexSaver::~HnswIndexSaver() = default;
 
-HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
-    : _graph_links(graph.links), _meta_data()
+HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph, const HnswNodeidMapping* id_mapping)
+    : _graph_links(graph.links), _meta_data(), _multi_vector(id_mapping != nullptr)
 {
     auto entry = graph.get_entry_node();
     _meta_data.entry_docid = entry.docid;
@@ -45,6 +47,9 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
     assert (link_array_count <= std::numeric_limits<uint32_t>::max());
     _meta_data.refs.reserve(link_array_count);
     _meta_data.nodes.reserve(num_nodes+1);
+    if (id_mapping) {
+        _meta_data.node_ids.reserve(num_nodes);
+    }
     for (size_t i = 0; i < num_nodes; ++i) {
         _meta_data.nodes.push_back(_meta_data.refs.size());
         auto node_ref = graph.get_node_ref(i);
@@ -54,6 +59,13 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
                 _meta_data.refs.push_back(links_ref.load_relaxed());
             }
         }
+        if (id_mapping) {
+            if (node_ref.valid()) {
+                _meta_data.node_ids.emplace_back(id_mapping->get_docid(i), id_mapping->get_subspace(i));
+            } else {
+                _meta_data.node_ids.emplace_back(0, 0);
+            }
+        }
     }
     _meta_data.nodes.push_back(_meta_data.refs.size());
 }
@@ -61,6 +73,10 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
 void
 HnswIndexSaver::save(BufferWriter& writer) const
 {
+    if (_multi_vector) {
+        uint32_t format_version = multi_vector_format_version;
+        writer.write(&format_version, sizeof(uint32_t));
+    }
     writer.write(&_meta_data.entry_docid, sizeof(uint32_t));
     writer.write(&_meta_data.entry_level, sizeof(int32_t));
     uint32_t num_nodes = _meta_data.nodes.size() - 1;
@@ -70,6 +86,11 @@ HnswIndexSaver::save(BufferWriter& writer) const
         uint32_t next_offset = _meta_data.nodes[i+1];
         uint32_t num_levels = next_offset - offset;
         writer.write(&num_levels, sizeof(uint32_t));
+        if (_multi_vector && num_levels > 0) {
+            const auto& node_id = _meta_data.node_ids[i];
+            writer.write(&node_id.first, sizeof(uint32_t));
+            writer.write(&node_id.second, sizeof(uint32_t));
+        }
         for (; offset < next_offset; offset++) {
             auto links_ref = _meta_data.refs[offset];
             if (links_ref.valid()) {
@@ -10,15 +10,22 @@
 
 namespace search::tensor {
 
+class HnswNodeidMapping;
+
 /**
  * Implements saving of HNSW graph structure in binary format.
  * The constructor takes a snapshot of all meta-data, but
  * the links will be fetched from the graph in the save()
  * method.
+ *
+ * In multi-vector mode the data starts with a format version, and the
+ * docid and subspace of each node is saved together with its levels.
  **/
 class HnswIndexSaver : public NearestNeighborIndexSaver {
 public:
-    HnswIndexSaver(const HnswGraph &graph);
+    static constexpr uint32_t multi_vector_format_version = 1;
+
+    HnswIndexSaver(const HnswGraph &graph, const HnswNodeidMapping* id_mapping = nullptr);
     ~HnswIndexSaver() override;
     void save(BufferWriter& writer) const override;
 
@@ -29,11 +36,14 @@ private:
         int32_t  entry_level;
         std::vector<EntryRef, vespalib::allocator_large<EntryRef>> refs;
         std::vector<uint32_t, vespalib::allocator_large<uint32_t>> nodes;
+        // Only used in multi-vector mode: (docid, subspace) for each node.
+        std::vector<std::pair<uint32_t, uint32_t>, vespalib::allocator_large<std::pair<uint32_t, uint32_t>>> node_ids;
         MetaData();
         ~MetaData();
     };
     const HnswGraph::LinkStore &_graph_links;
     MetaData _meta_data;
+    bool _multi_vector;
 };
 
 }
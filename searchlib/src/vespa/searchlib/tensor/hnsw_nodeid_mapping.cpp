@@ -0,0 +1,189 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_nodeid_mapping.h"
+#include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/small_vector.h>
+#include <algorithm>
+#include <cassert>
+
+namespace search::tensor {
+
+namespace {
+
+constexpr size_t max_small_subspaces_array_size = 64;
+constexpr size_t small_page_size = 4_Ki;
+constexpr size_t min_num_arrays_for_new_buffer = 512_Ki;
+constexpr float alloc_grow_factor = 0.3;
+
+}
+
+vespalib::datastore::ArrayStoreConfig
+HnswNodeidMapping::make_default_nodeid_store_config()
+{
+    return NodeidStore::optimizedConfigForHugePage(max_small_subspaces_array_size, vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                   small_page_size, min_num_arrays_for_new_buffer, alloc_grow_factor).enable_free_lists(true);
+}
+
+HnswNodeidMapping::HnswNodeidMapping()
+    : _nodes(),
+      _refs(),
+      _nodeids(make_default_nodeid_store_config(), {}),
+      _nodeid_limit(1), // Node id 0 is reserved
+      _free_list(),
+      _hold_1_list(),
+      _hold_2_list()
+{
+    _nodes.ensure_size(1, 0);
+}
+
+HnswNodeidMapping::~HnswNodeidMapping() = default;
+
+uint32_t
+HnswNodeidMapping::allocate_id()
+{
+    if (_free_list.empty()) {
+        return _nodeid_limit++;
+    }
+    uint32_t nodeid = _free_list.back();
+    _free_list.pop_back();
+    return nodeid;
+}
+
+vespalib::ConstArrayRef<uint32_t>
+HnswNodeidMapping::allocate_ids(uint32_t docid, uint32_t subspaces)
+{
+    if (docid >= _refs.size()) {
+        _refs.resize(docid + 1);
+    }
+    // A document cannot be added twice.
+    assert(!_refs[docid].valid());
+    if (subspaces == 0) {
+        return {};
+    }
+    vespalib::SmallVector<uint32_t, 8> ids;
+    for (uint32_t subspace = 0; subspace < subspaces; ++subspace) {
+        uint32_t nodeid = allocate_id();
+        _nodes.ensure_size(nodeid + 1, 0);
+        vespalib::atomic::store_ref_release(_nodes[nodeid], (uint64_t(subspace) << 32) | docid);
+        ids.push_back(nodeid);
+    }
+    _refs[docid] = _nodeids.add(ids);
+    return _nodeids.get(_refs[docid]);
+}
+
+void
+HnswNodeidMapping::assign_id(uint32_t nodeid, uint32_t docid, uint32_t subspace)
+{
+    assert(nodeid > 0);
+    // Docid 0 is never used, so it marks node ids that are not assigned.
+    assert(docid > 0);
+    _nodes.ensure_size(nodeid + 1, 0);
+    vespalib::atomic::store_ref_release(_nodes[nodeid], (uint64_t(subspace) << 32) | docid);
+    _nodeid_limit = std::max(_nodeid_limit, nodeid + 1);
+}
+
+void
+HnswNodeidMapping::on_load(uint32_t nodeid_limit)
+{
+    _nodeid_limit = std::max(_nodeid_limit, nodeid_limit);
+    _nodes.ensure_size(_nodeid_limit, 0);
+    // Group the assigned node ids per docid, ordered by subspace.
+    std::vector<uint32_t> offsets;
+    for (uint32_t nodeid = 1; nodeid < _nodeid_limit; ++nodeid) {
+        uint32_t docid = get_docid(nodeid);
+        if (docid != 0) {
+            if (docid >= offsets.size()) {
+                offsets.resize(docid + 1, 0);
+            }
+            offsets[docid] = std::max(offsets[docid], get_subspace(nodeid) + 1);
+        }
+    }
+    uint32_t num_ids = 0;
+    for (auto& offset : offsets) {
+        uint32_t subspaces = offset;
+        offset = num_ids;
+        num_ids += subspaces;
+    }
+    offsets.push_back(num_ids);
+    std::vector<uint32_t> ids(num_ids, 0);
+    _free_list.clear();
+    for (uint32_t nodeid = _nodeid_limit; nodeid-- > 1; ) {
+        uint32_t docid = get_docid(nodeid);
+        if (docid != 0) {
+            ids[offsets[docid] + get_subspace(nodeid)] = nodeid;
+        } else {
+            _free_list.push_back(nodeid);
+        }
+    }
+    _refs.assign(offsets.size() - 1, vespalib::datastore::EntryRef());
+    for (uint32_t docid = 1; docid + 1 < offsets.size(); ++docid) {
+        vespalib::ConstArrayRef<uint32_t> doc_ids(ids.data() + offsets[docid], offsets[docid + 1] - offsets[docid]);
+        if (!doc_ids.empty()) {
+            // All subspaces of a document must have been assigned a node id.
+            assert(std::find(doc_ids.begin(), doc_ids.end(), 0u) == doc_ids.end());
+            _refs[docid] = _nodeids.add(doc_ids);
+        }
+    }
+}
+
+vespalib::ConstArrayRef<uint32_t>
+HnswNodeidMapping::get_ids(uint32_t docid) const
+{
+    if (docid >= _refs.size()) {
+        return {};
+    }
+    return _nodeids.get(_refs[docid]);
+}
+
+void
+HnswNodeidMapping::free_ids(uint32_t docid)
+{
+    if (docid >= _refs.size() || !_refs[docid].valid()) {
+        return;
+    }
+    auto ids = _nodeids.get(_refs[docid]);
+    _hold_1_list.insert(_hold_1_list.end(), ids.begin(), ids.end());
+    _nodeids.remove(_refs[docid]);
+    _refs[docid] = vespalib::datastore::EntryRef();
+}
+
+void
+HnswNodeidMapping::transfer_hold_lists(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _nodes.setGeneration(current_gen + 1);
+    _nodeids.transferHoldLists(current_gen);
+    for (uint32_t nodeid : _hold_1_list) {
+        _hold_2_list.emplace_back(nodeid, current_gen);
+    }
+    _hold_1_list.clear();
+}
+
+void
+HnswNodeidMapping::trim_hold_lists(generation_t first_used_gen)
+{
+    _nodes.removeOldGenerations(first_used_gen);
+    _nodeids.trimHoldLists(first_used_gen);
+    while (!_hold_2_list.empty() && _hold_2_list.front().second < first_used_gen) {
+        _free_list.push_back(_hold_2_list.front().first);
+        _hold_2_list.pop_front();
+    }
+}
+
+vespalib::MemoryUsage
+HnswNodeidMapping::memory_usage() const
+{
+    vespalib::MemoryUsage result = _nodes.getMemoryUsage();
+    result.merge(_nodeids.getMemoryUsage());
+    result.incUsedBytes(_refs.size() * sizeof(vespalib::datastore::EntryRef));
+    result.incAllocatedBytes(_refs.capacity() * sizeof(vespalib::datastore::EntryRef));
+    size_t lists_bytes = (_free_list.capacity() + _hold_1_list.capacity()) * sizeof(uint32_t) +
+                         _hold_2_list.size() * sizeof(std::pair<uint32_t, generation_t>);
+    result.incAllocatedBytes(lists_bytes);
+    result.incUsedBytes(lists_bytes);
+    return result;
+}
+
+}
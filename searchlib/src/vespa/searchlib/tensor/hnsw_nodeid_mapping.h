@@ -0,0 +1,80 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/datastore/array_store.h>
+#include <vespa/vespalib/datastore/entryref.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/atomic.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Class that maps between document ids and node ids in a hnsw graph where
+ * a document can have multiple vectors (one per subspace of a mixed tensor),
+ * and each vector is represented by its own node in the graph.
+ *
+ * The mapping from node id to (docid, subspace) is used by search threads,
+ * while the mapping from docid to node ids is only used by the write thread.
+ * The node ids of each document are stored as one array in an ArrayStore, referenced by an EntryRef per docid.
+ * Node ids that are freed are not reused before all readers that might observe them are gone.
+ * Node id 0 is reserved, as it represents an empty graph (no entry point).
+ */
+class HnswNodeidMapping {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+private:
+    // Node id -> (subspace << 32 | docid).
+    using NodeVector = vespalib::RcuVector<uint64_t>;
+    // Docid -> node ids for all subspaces of the document.
+    using NodeidStore = vespalib::datastore::ArrayStore<uint32_t, vespalib::datastore::EntryRefT<19>>;
+
+    NodeVector _nodes;
+    std::vector<vespalib::datastore::EntryRef> _refs;
+    NodeidStore _nodeids;
+    uint32_t _nodeid_limit;
+    std::vector<uint32_t> _free_list;
+    std::vector<uint32_t> _hold_1_list;
+    std::deque<std::pair<uint32_t, generation_t>> _hold_2_list;
+
+    uint32_t allocate_id();
+    static vespalib::datastore::ArrayStoreConfig make_default_nodeid_store_config();
+
+public:
+    HnswNodeidMapping();
+    ~HnswNodeidMapping();
+
+    /**
+     * Allocates node ids for the given number of subspaces of a document (called by the write thread).
+     */
+    vespalib::ConstArrayRef<uint32_t> allocate_ids(uint32_t docid, uint32_t subspaces);
+    vespalib::ConstArrayRef<uint32_t> get_ids(uint32_t docid) const;
+    void free_ids(uint32_t docid);
+
+    /**
+     * Assigns the given node id to (docid, subspace) when the hnsw graph is loaded.
+     * on_load() must be called when all node ids are assigned, as it builds the docid -> node ids mapping.
+     */
+    void assign_id(uint32_t nodeid, uint32_t docid, uint32_t subspace);
+    void on_load(uint32_t nodeid_limit);
+
+    uint32_t get_docid(uint32_t nodeid) const noexcept {
+        return static_cast<uint32_t>(vespalib::atomic::load_ref_acquire(_nodes.acquire_elem_ref(nodeid)));
+    }
+    uint32_t get_subspace(uint32_t nodeid) const noexcept {
+        return static_cast<uint32_t>(vespalib::atomic::load_ref_acquire(_nodes.acquire_elem_ref(nodeid)) >> 32);
+    }
+
+    void transfer_hold_lists(generation_t current_gen);
+    void trim_hold_lists(generation_t first_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "vector_bundle.h"
 #include <memory>
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/searchcommon/attribute/distance_metric.h>
@@ -26,6 +27,9 @@ public:
     virtual const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const = 0;
     virtual bool supports_extract_cells_ref() const = 0;
     virtual bool supports_get_tensor_ref() const = 0;
+    // Returns the vectors of the given document, one per subspace of the tensor.
+    virtual VectorBundle get_vectors(uint32_t docid) const = 0;
+    virtual bool supports_get_vectors() const = 0;
 
     virtual const vespalib::eval::ValueType & getTensorType() const = 0;
 
@@ -60,6 +60,12 @@ ImportedTensorAttributeVectorReadGuard::get_tensor_ref(uint32_t docid) const
     return _target_tensor_attribute.get_tensor_ref(getTargetLid(docid));
 }
 
+VectorBundle
+ImportedTensorAttributeVectorReadGuard::get_vectors(uint32_t docid) const
+{
+    return _target_tensor_attribute.get_vectors(getTargetLid(docid));
+}
+
 const vespalib::eval::ValueType &
 ImportedTensorAttributeVectorReadGuard::getTensorType() const
 {
@@ -37,6 +37,8 @@ public:
     const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const override;
     bool supports_extract_cells_ref() const override { return _target_tensor_attribute.supports_extract_cells_ref(); }
     bool supports_get_tensor_ref() const override { return _target_tensor_attribute.supports_get_tensor_ref(); }
+    VectorBundle get_vectors(uint32_t docid) const override;
+    bool supports_get_vectors() const override { return _target_tensor_attribute.supports_get_vectors(); }
     DistanceMetric distance_metric() const override { return _target_tensor_attribute.distance_metric(); }
     uint32_t get_num_docs() const override { return getNumDocs(); }
 
@@ -42,19 +42,28 @@ template <typename FloatType>
 class InnerProductDistanceHW : public InnerProductDistance {
 public:
     InnerProductDistanceHW()
-      : InnerProductDistance(vespalib::eval::get_cell_type<FloatType>()),
+      : InnerProductDistanceHW(vespalib::eval::get_cell_type<FloatType>())
+    {
+    }
+    explicit InnerProductDistanceHW(vespalib::eval::CellType query_cell_type)
+      : InnerProductDistance(query_cell_type),
         _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
     {
-        assert(expected_cell_type() == vespalib::eval::get_cell_type<FloatType>());
     }
+    static const double *cast(const double * p) { return p; }
+    static const float *cast(const float * p) { return p; }
+    static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
-        assert(lhs.type == expected && rhs.type == expected);
+        if (lhs.type != expected || rhs.type != expected) {
+            return InnerProductDistance::calc(lhs, rhs);
+        }
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        double score = 1.0 - _computer.dotProduct(&lhs_vector[0], &rhs_vector[0], sz);
+        double score = 1.0 - _computer.dotProduct(cast(&lhs_vector[0]), cast(&rhs_vector[0]), sz);
         return std::max(0.0, score);
     }
 private:
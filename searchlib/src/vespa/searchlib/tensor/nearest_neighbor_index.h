@@ -4,6 +4,7 @@
 
 #include "distance_function.h"
 #include "prepare_result.h"
+#include "vector_bundle.h"
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <cstdint>
@@ -46,6 +47,18 @@ public:
         {}
         Neighbor() noexcept : docid(0), distance(0.0) {}
     };
+    /**
+     * Specifies how the index is traversed when searching with a filter.
+     *
+     * PLAIN: Nodes not matching the filter are visited as any other node, but are not returned.
+     * FILTERED: Distances are only calculated for nodes matching the filter. When too few of the
+     *           neighbors of a node match the filter, the search expands through the non-matching
+     *           neighbors to their neighbors (two-hop) instead.
+     */
+    enum class FilterTraversal {
+        PLAIN,
+        FILTERED
+    };
     virtual ~NearestNeighborIndex() = default;
     virtual void add_document(uint32_t docid) = 0;
 
@@ -53,12 +66,13 @@ public:
      * Performs the prepare step in a two-phase operation to add a document to the index.
      *
      * This function can be called by any thread.
-     * The document to add is represented by the given vector as it is _not_ stored in the enclosing tensor attribute at this point in time.
+     * The document to add is represented by the given vectors as they are _not_ stored in the enclosing tensor attribute at this point in time.
+     * An index that supports multiple vectors per document adds one node per subspace in the given bundle.
      * It should return the result of the costly and non-modifying part of this operation.
      * The given read guard must be kept in the result.
      */
     virtual std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid,
-                                                                vespalib::eval::TypedCells vector,
+                                                                VectorBundle vectors,
                                                                 vespalib::GenerationHandler::Guard read_guard) const = 0;
     /**
      * Performs the complete step in a two-phase operation to add a document to the index.
@@ -102,9 +116,19 @@ public:
     virtual std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
                                                          vespalib::eval::TypedCells vector,
                                                          const BitVector &filter,
+                                                         FilterTraversal traversal,
                                                          uint32_t explore_k,
                                                          double distance_threshold) const = 0;
 
+    /**
+     * Returns the estimated cost, in number of distance calculations, of searching for the explore_k
+     * nearest neighbors using the given filter (optional) and traversal mode.
+     * This is used to select between the traversal modes when the filter hit ratio is above the brute force limit.
+     */
+    virtual double estimate_search_cost(uint32_t explore_k,
+                                        const BitVector* filter,
+                                        FilterTraversal traversal) const = 0;
+
     virtual const DistanceFunction *distance_function() const = 0;
 };
 
@@ -6,6 +6,7 @@
 #include <memory>
 
 namespace search::attribute { class HnswIndexParams; }
+namespace vespalib::alloc { class MemoryAllocator; }
 
 namespace search::tensor {
 
@@ -14,14 +15,20 @@ class NearestNeighborIndex;
 
 /**
  * Factory interface used to instantiate an index used for (approximate) nearest neighbor search.
+ *
+ * In multi-vector mode a document can have multiple vectors (one per subspace of a mixed tensor).
+ * The memory allocator (optional) is the one used by the enclosing attribute,
+ * and can be used for the parts of the index that should follow the paged setting of the attribute.
  */
 class NearestNeighborIndexFactory {
 public:
     virtual ~NearestNeighborIndexFactory() {}
     virtual std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                        size_t vector_size,
+                                                       bool multi_vector,
                                                        vespalib::eval::CellType cell_type,
-                                                       const search::attribute::HnswIndexParams& params) const = 0;
+                                                       const search::attribute::HnswIndexParams& params,
+                                                       std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const = 0;
 };
 
 }
@@ -0,0 +1,31 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace search::tensor {
+
+/**
+ * Issues software prefetches for the start of the given memory area,
+ * at most the first two cache lines.
+ *
+ * Used to start loading several vectors into the cache before calculating
+ * the distances to them, instead of stalling on a cache miss for each vector.
+ * The hardware prefetcher follows the sequential reads of the rest of each
+ * vector. Prefetching all cache lines of all vectors in a batch (e.g. 32
+ * vectors of 768 floats is 96KB) would evict them again before use.
+ */
+inline void prefetch_vector_start(const void* data, size_t bytes) noexcept
+{
+    constexpr size_t cache_line_size = 64;
+    constexpr size_t max_prefetch_bytes = 2 * cache_line_size;
+    auto p = static_cast<const char*>(data);
+    size_t prefetch_bytes = std::min(bytes, max_prefetch_bytes);
+    for (size_t offset = 0; offset < prefetch_bytes; offset += cache_line_size) {
+        __builtin_prefetch(p + offset);
+    }
+}
+
+}
@@ -0,0 +1,275 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include "prefetch_utils.h"
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/datastore/compaction_strategy.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using vespalib::eval::CellType;
+using vespalib::eval::ValueType;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr float max_quantized_value = 127.0;
+
+ValueType
+make_store_type(size_t vector_size, size_t header_size)
+{
+    uint32_t num_cells = vector_size + header_size;
+    return ValueType::make_type(CellType::INT8, {{"x", num_cells}});
+}
+
+template <typename FloatType>
+void
+quantize_cells(const FloatType* src, size_t sz, int8_t* dst, float& scale, float& sq_norm)
+{
+    double max_abs = 0.0;
+    double norm = 0.0;
+    for (size_t i = 0; i < sz; ++i) {
+        double value = src[i];
+        max_abs = std::max(max_abs, std::abs(value));
+        norm += value * value;
+    }
+    sq_norm = norm;
+    if (max_abs == 0.0) {
+        scale = 0.0;
+        std::fill(dst, dst + sz, 0);
+        return;
+    }
+    scale = max_abs / max_quantized_value;
+    double inv_scale = max_quantized_value / max_abs;
+    for (size_t i = 0; i < sz; ++i) {
+        double quantized = std::round(src[i] * inv_scale);
+        dst[i] = static_cast<int8_t>(std::clamp(quantized, -127.0, 127.0));
+    }
+}
+
+}
+
+QuantizedVectorStore::QueryVector::~QueryVector() = default;
+
+QuantizedVectorStore::QuantizedVectorStore(DistanceMetric metric, size_t vector_size)
+    : _metric(metric),
+      _vector_size(vector_size),
+      _store(make_store_type(vector_size, sizeof(Header)), {}),
+      _refs(),
+      _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
+      _compact_store(false)
+{
+    assert(supports(metric));
+    _refs.ensure_size(1, AtomicEntryRef());
+}
+
+QuantizedVectorStore::~QuantizedVectorStore()
+{
+    _store.clearHoldLists();
+}
+
+bool
+QuantizedVectorStore::supports(DistanceMetric metric) noexcept
+{
+    switch (metric) {
+    case DistanceMetric::Euclidean:
+    case DistanceMetric::Angular:
+    case DistanceMetric::InnerProduct:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void
+QuantizedVectorStore::quantize(TypedCells vector, int8_t* cells, Header& header) const
+{
+    assert(vector.size == _vector_size);
+    switch (vector.type) {
+    case CellType::DOUBLE:
+        quantize_cells(vector.typify<double>().data(), vector.size, cells, header.scale, header.sq_norm);
+        break;
+    case CellType::FLOAT:
+        quantize_cells(vector.typify<float>().data(), vector.size, cells, header.scale, header.sq_norm);
+        break;
+    default:
+        abort();
+    }
+}
+
+double
+QuantizedVectorStore::calc_distance(const int8_t* lhs_cells, const Header& lhs, const int8_t* rhs_cells, const Header& rhs) const
+{
+    double dot_product = double(lhs.scale) * double(rhs.scale) * _computer.dotProduct(lhs_cells, rhs_cells, _vector_size);
+    switch (_metric) {
+    case DistanceMetric::Euclidean:
+        return std::max(0.0, double(lhs.sq_norm) + double(rhs.sq_norm) - 2.0 * dot_product);
+    case DistanceMetric::Angular: {
+        double squared_norms = double(lhs.sq_norm) * double(rhs.sq_norm);
+        double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+        return 1.0 - dot_product / div;
+    }
+    case DistanceMetric::InnerProduct:
+        return std::max(0.0, 1.0 - dot_product);
+    default:
+        abort();
+    }
+}
+
+void
+QuantizedVectorStore::set_vector(uint32_t docid, TypedCells vector)
+{
+    _refs.ensure_size(docid + 1, AtomicEntryRef());
+    auto raw = _store.allocRawBuffer();
+    Header header;
+    quantize(vector, reinterpret_cast<int8_t*>(raw.data + sizeof(Header)), header);
+    memcpy(raw.data, &header, sizeof(Header));
+    auto old_ref = _refs[docid].load_relaxed();
+    _refs[docid].store_release(raw.ref);
+    _store.holdTensor(old_ref);
+}
+
+void
+QuantizedVectorStore::remove_vector(uint32_t docid)
+{
+    if (docid >= _refs.get_size()) {
+        return;
+    }
+    auto old_ref = _refs[docid].load_relaxed();
+    _refs[docid].store_release(EntryRef());
+    _store.holdTensor(old_ref);
+}
+
+QuantizedVectorStore::QueryVector
+QuantizedVectorStore::prepare_query(TypedCells vector) const
+{
+    QueryVector result(_vector_size);
+    Header header;
+    quantize(vector, result._cells.data(), header);
+    result._scale = header.scale;
+    result._sq_norm = header.sq_norm;
+    return result;
+}
+
+double
+QuantizedVectorStore::calc_distance(const QueryVector& query, uint32_t docid) const
+{
+    auto ref = acquire_ref(docid);
+    if (!ref.valid()) {
+        return std::numeric_limits<double>::max();
+    }
+    auto raw = static_cast<const char*>(_store.getRawBuffer(ref));
+    Header header;
+    memcpy(&header, raw, sizeof(Header));
+    Header query_header{query._scale, query._sq_norm};
+    return calc_distance(query._cells.data(), query_header, reinterpret_cast<const int8_t*>(raw + sizeof(Header)), header);
+}
+
+void
+QuantizedVectorStore::calc_distances(const QueryVector& query, const uint32_t* docids, size_t num_docids, double* result,
+                                     std::vector<const char*>& raws) const
+{
+    size_t entry_size = sizeof(Header) + _vector_size;
+    raws.clear();
+    for (size_t i = 0; i < num_docids; ++i) {
+        auto ref = acquire_ref(docids[i]);
+        const char* raw = nullptr;
+        if (ref.valid()) {
+            raw = static_cast<const char*>(_store.getRawBuffer(ref));
+            prefetch_vector_start(raw, entry_size);
+        }
+        raws.push_back(raw);
+    }
+    Header query_header{query._scale, query._sq_norm};
+    for (size_t i = 0; i < num_docids; ++i) {
+        const char* raw = raws[i];
+        if (raw == nullptr) {
+            result[i] = std::numeric_limits<double>::max();
+            continue;
+        }
+        Header header;
+        memcpy(&header, raw, sizeof(Header));
+        result[i] = calc_distance(query._cells.data(), query_header, reinterpret_cast<const int8_t*>(raw + sizeof(Header)), header);
+    }
+}
+
+void
+QuantizedVectorStore::transfer_hold_lists(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _refs.setGeneration(current_gen + 1);
+    _store.transferHoldLists(current_gen);
+}
+
+void
+QuantizedVectorStore::trim_hold_lists(generation_t first_used_gen)
+{
+    _refs.removeOldGenerations(first_used_gen);
+    _store.trimHoldLists(first_used_gen);
+}
+
+void
+QuantizedVectorStore::shrink_lid_space(uint32_t doc_id_limit)
+{
+    if (doc_id_limit < _refs.get_size()) {
+        _refs.shrink(doc_id_limit);
+    }
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    result.merge(_refs.getMemoryUsage());
+    result.merge(_store.getMemoryUsage());
+    return result;
+}
+
+vespalib::AddressSpace
+QuantizedVectorStore::address_space_usage() const
+{
+    return _store.get_address_space_usage();
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::update_stat(const CompactionStrategy& compaction_strategy)
+{
+    auto store_memory_usage = _store.getMemoryUsage();
+    _compact_store = compaction_strategy.should_compact_memory(store_memory_usage);
+    vespalib::MemoryUsage result;
+    result.merge(_refs.getMemoryUsage());
+    result.merge(store_memory_usage);
+    return result;
+}
+
+bool
+QuantizedVectorStore::consider_compact()
+{
+    if (_compact_store && !_store.has_held_buffers()) {
+        compact_worst();
+        return true;
+    }
+    return false;
+}
+
+void
+QuantizedVectorStore::compact_worst()
+{
+    uint32_t buffer_id = _store.startCompactWorstBuffer();
+    uint32_t doc_id_limit = _refs.get_size();
+    for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+        auto ref = _refs[docid].load_relaxed();
+        if (ref.valid() && DenseTensorStore::RefType(ref).bufferId() == buffer_id) {
+            _refs[docid].store_release(_store.move(ref));
+        }
+    }
+    _store.finishCompactWorstBuffer(buffer_id);
+    _compact_store = false;
+}
+
+}
@@ -0,0 +1,124 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "dense_tensor_store.h"
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/util/address_space.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <vector>
+
+namespace vespalib::datastore { class CompactionStrategy; }
+namespace vespalib::hwaccelrated { class IAccelrated; }
+
+namespace search::tensor {
+
+/**
+ * Stores an int8 scalar quantized copy of the vectors of the documents in a nearest neighbor index.
+ *
+ * Each vector is quantized using its own scale (max absolute cell value / 127). The scale and
+ * the squared norm of the original vector are stored together with the quantized cells.
+ * This makes it possible to calculate an approximate distance between a quantized query vector
+ * and a quantized document vector using a single int8 dot product, reading only 1/4 of the
+ * memory of a float vector.
+ *
+ * The approximate distances are in the same units as the distance function for the metric,
+ * but should only be used to order candidates. Only the euclidean, angular and innerproduct
+ * distance metrics are supported.
+ *
+ * The store supports 1 write thread and multiple search threads without the use of mutexes,
+ * using the generation handling of the enclosing index.
+ */
+class QuantizedVectorStore {
+public:
+    using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
+    using CompactionStrategy = vespalib::datastore::CompactionStrategy;
+    using DistanceMetric = search::attribute::DistanceMetric;
+    using EntryRef = vespalib::datastore::EntryRef;
+    using TypedCells = vespalib::eval::TypedCells;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    /**
+     * A query vector quantized the same way as the stored vectors.
+     */
+    class QueryVector {
+    private:
+        std::vector<int8_t> _cells;
+        float _scale;
+        float _sq_norm;
+        friend class QuantizedVectorStore;
+    public:
+        QueryVector(size_t vector_size) : _cells(vector_size, 0), _scale(0.0), _sq_norm(0.0) {}
+        ~QueryVector();
+        QueryVector(QueryVector&&) noexcept = default;
+    };
+
+private:
+    struct Header {
+        float scale;
+        float sq_norm;
+    };
+    using RefVector = vespalib::RcuVector<AtomicEntryRef>;
+
+    DistanceMetric _metric;
+    size_t _vector_size;
+    DenseTensorStore _store;
+    RefVector _refs;
+    const vespalib::hwaccelrated::IAccelrated& _computer;
+    bool _compact_store; // Set by update_stat() when the worst buffer of the store should be compacted.
+
+    void quantize(TypedCells vector, int8_t* cells, Header& header) const;
+    double calc_distance(const int8_t* lhs_cells, const Header& lhs, const int8_t* rhs_cells, const Header& rhs) const;
+    EntryRef acquire_ref(uint32_t docid) const {
+        return _refs.acquire_elem_ref(docid).load_acquire();
+    }
+
+public:
+    QuantizedVectorStore(DistanceMetric metric, size_t vector_size);
+    ~QuantizedVectorStore();
+
+    static bool supports(DistanceMetric metric) noexcept;
+
+    /**
+     * Quantizes and stores the given vector for a document (called by the write thread).
+     */
+    void set_vector(uint32_t docid, TypedCells vector);
+    void remove_vector(uint32_t docid);
+
+    QueryVector prepare_query(TypedCells vector) const;
+
+    /**
+     * Calculates the approximate distance between the query and the stored vector for the given document.
+     * Returns max double if the document has no stored vector (e.g. it was removed during the search).
+     */
+    double calc_distance(const QueryVector& query, uint32_t docid) const;
+
+    /**
+     * Calculates the approximate distances between the query and the stored vectors for the given documents.
+     * The stored vectors are prefetched before any distance is calculated.
+     * The raws vector is scratch space owned by the caller, reused between calls.
+     */
+    void calc_distances(const QueryVector& query, const uint32_t* docids, size_t num_docids, double* result,
+                        std::vector<const char*>& raws) const;
+
+    void transfer_hold_lists(generation_t current_gen);
+    void trim_hold_lists(generation_t first_used_gen);
+    void shrink_lid_space(uint32_t doc_id_limit);
+    vespalib::MemoryUsage memory_usage() const;
+    vespalib::AddressSpace address_space_usage() const;
+
+    /**
+     * Returns memory usage and decides whether the store should be compacted.
+     */
+    vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy);
+    /**
+     * Moves the vectors in the worst buffer of the store, if decided by update_stat()
+     * and no buffers from a previous compaction are still held. Returns true if compacted.
+     */
+    bool consider_compact();
+    void compact_worst();
+};
+
+}
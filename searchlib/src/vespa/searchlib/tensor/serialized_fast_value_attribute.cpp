@@ -1,10 +1,17 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "serialized_fast_value_attribute.h"
+#include "nearest_neighbor_index.h"
+#include "nearest_neighbor_index_loader.h"
+#include "nearest_neighbor_index_saver.h"
 #include "streamed_value_saver.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attribute_header.h>
+#include <vespa/searchlib/attribute/load_utils.h>
+#include <vespa/searchlib/util/file_with_header.h>
+#include <vespa/vespalib/data/slime/inserter.h>
 
 #include <vespa/log/log.h>
 
@@ -15,14 +22,34 @@ LOG_SETUP(".searchlib.tensor.serialized_fast_value_attribute");
 
 using namespace vespalib;
 using namespace vespalib::eval;
+using search::attribute::LoadUtils;
+using vespalib::slime::ObjectInserter;
 
 namespace search::tensor {
 
-SerializedFastValueAttribute::SerializedFastValueAttribute(stringref name, const Config &cfg)
+namespace {
+
+constexpr uint32_t LOAD_COMMIT_INTERVAL = 256;
+
+}
+
+SerializedFastValueAttribute::SerializedFastValueAttribute(stringref name, const Config &cfg,
+                                                           const NearestNeighborIndexFactory& index_factory)
   : TensorAttribute(name, cfg, _streamedValueStore),
     _tensor_type(cfg.tensorType()),
-    _streamedValueStore(_tensor_type)
+    _streamedValueStore(_tensor_type),
+    _index()
 {
+    if (cfg.hnsw_index_params().has_value()) {
+        if (supports_get_vectors()) {
+            // Each dense subspace is a separate vector (node) in the index.
+            _index = index_factory.make(*this, _tensor_type.dense_subspace_size(), true, _tensor_type.cell_type(),
+                                        cfg.hnsw_index_params().value(), get_memory_allocator());
+        } else {
+            LOG(warning, "Tensor attribute '%s' of type %s does not support a nearest neighbor index, must have one indexed dimension",
+                getName().c_str(), _tensor_type.to_spec().c_str());
+        }
+    }
 }
 
 
@@ -33,12 +60,90 @@ SerializedFastValueAttribute::~SerializedFastValueAttribute()
 }
 
 void
-SerializedFastValueAttribute::setTensor(DocId docId, const vespalib::eval::Value &tensor)
+SerializedFastValueAttribute::internal_set_tensor(DocId docid, const vespalib::eval::Value& tensor)
 {
-    checkTensorType(tensor);
+    // The index nodes for the subspaces of the old tensor are removed before the new tensor is stored,
+    // as the number of subspaces can change.
+    consider_remove_from_index(docid);
     EntryRef ref = _streamedValueStore.store_tensor(tensor);
     assert(ref.valid());
-    setTensorRef(docId, ref);
+    setTensorRef(docid, ref);
+}
+
+void
+SerializedFastValueAttribute::consider_remove_from_index(DocId docid)
+{
+    if (_index && _refVector[docid].load_relaxed().valid()) {
+        _index->remove_document(docid);
+    }
+}
+
+vespalib::MemoryUsage
+SerializedFastValueAttribute::update_stat()
+{
+    vespalib::MemoryUsage result = TensorAttribute::update_stat();
+    if (_index) {
+        result.merge(_index->update_stat(getConfig().getCompactionStrategy()));
+    }
+    return result;
+}
+
+vespalib::MemoryUsage
+SerializedFastValueAttribute::memory_usage() const
+{
+    vespalib::MemoryUsage result = TensorAttribute::memory_usage();
+    if (_index) {
+        result.merge(_index->memory_usage());
+    }
+    return result;
+}
+
+void
+SerializedFastValueAttribute::populate_address_space_usage(AddressSpaceUsage& usage) const
+{
+    TensorAttribute::populate_address_space_usage(usage);
+    if (_index) {
+        _index->populate_address_space_usage(usage);
+    }
+}
+
+uint32_t
+SerializedFastValueAttribute::clearDoc(DocId docId)
+{
+    consider_remove_from_index(docId);
+    return TensorAttribute::clearDoc(docId);
+}
+
+void
+SerializedFastValueAttribute::setTensor(DocId docId, const vespalib::eval::Value &tensor)
+{
+    checkTensorType(tensor);
+    internal_set_tensor(docId, tensor);
+    if (_index) {
+        _index->add_document(docId);
+    }
+}
+
+std::unique_ptr<PrepareResult>
+SerializedFastValueAttribute::prepare_set_tensor(DocId docid, const vespalib::eval::Value& tensor) const
+{
+    checkTensorType(tensor);
+    if (_index) {
+        // The subspaces are prepared in the same order as they are stored by complete_set_tensor().
+        auto entry = StreamedValueStore::TensorEntry::create_shared_entry(tensor);
+        return _index->prepare_add_document(docid, _streamedValueStore.get_vectors(*entry), getGenerationHandler().takeGuard());
+    }
+    return {};
+}
+
+void
+SerializedFastValueAttribute::complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor,
+                                                  std::unique_ptr<PrepareResult> prepare_result)
+{
+    internal_set_tensor(docid, tensor);
+    if (_index) {
+        _index->complete_add_document(docid, std::move(prepare_result));
+    }
 }
 
 std::unique_ptr<Value>
@@ -64,6 +169,9 @@ SerializedFastValueAttribute::onLoad(vespalib::Executor *)
     if (!tensorReader.hasData()) {
         return false;
     }
+    bool use_index_file = _index && LoadUtils::file_exists(*this, StreamedValueSaver::index_file_suffix()) &&
+                          can_use_index_save_file(getConfig(),
+                                                  attribute::AttributeHeader::extractTags(tensorReader.getDatHeader(), getBaseFileName()));
     setCreateSerialNum(tensorReader.getCreateSerialNum());
     assert(tensorReader.getVersion() == getVersion());
     uint32_t numDocs(tensorReader.getDocIdLimit());
@@ -87,6 +195,35 @@ SerializedFastValueAttribute::onLoad(vespalib::Executor *)
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    if (_index) {
+        try {
+            if (use_index_file) {
+                FileWithHeader index_file(LoadUtils::openFile(*this, StreamedValueSaver::index_file_suffix()));
+                auto index_loader = _index->make_loader(index_file.file());
+                size_t cnt = 0;
+                while (index_loader->load_next()) {
+                    if ((++cnt % LOAD_COMMIT_INTERVAL) == 0) {
+                        commit();
+                    }
+                }
+            } else {
+                // The index is rebuilt from the loaded tensors.
+                for (uint32_t lid = 0; lid < numDocs; ++lid) {
+                    if (_refVector[lid].load_relaxed().valid()) {
+                        _index->add_document(lid);
+                    }
+                    if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
+                        commit();
+                    }
+                }
+            }
+        } catch (const std::runtime_error& ex) {
+            LOG(error, "Exception while loading nearest neighbor index for tensor attribute '%s': %s",
+                getName().c_str(), ex.what());
+            return false;
+        }
+        commit();
+    }
     return true;
 }
 
@@ -96,11 +233,13 @@ SerializedFastValueAttribute::onInitSave(vespalib::stringref fileName)
 {
     vespalib::GenerationHandler::Guard guard(getGenerationHandler().
                                              takeGuard());
+    auto index_saver = (_index ? _index->make_saver() : std::unique_ptr<NearestNeighborIndexSaver>());
     return std::make_unique<StreamedValueSaver>
         (std::move(guard),
          this->createAttributeHeader(fileName),
          getRefCopy(),
-         _streamedValueStore);
+         _streamedValueStore,
+         std::move(index_saver));
 }
 
 void
@@ -109,4 +248,56 @@ SerializedFastValueAttribute::compactWorst()
     doCompactWorst<StreamedValueStore::RefType>();
 }
 
+bool
+SerializedFastValueAttribute::consider_compact(const CompactionStrategy& compaction_strategy)
+{
+    if (TensorAttribute::consider_compact(compaction_strategy)) {
+        return true;
+    }
+    return _index && _index->consider_compact(compaction_strategy);
+}
+
+void
+SerializedFastValueAttribute::onGenerationChange(generation_t next_gen)
+{
+    TensorAttribute::onGenerationChange(next_gen);
+    if (_index) {
+        _index->transfer_hold_lists(next_gen - 1);
+    }
+}
+
+void
+SerializedFastValueAttribute::removeOldGenerations(generation_t first_used_gen)
+{
+    TensorAttribute::removeOldGenerations(first_used_gen);
+    if (_index) {
+        _index->trim_hold_lists(first_used_gen);
+    }
+}
+
+void
+SerializedFastValueAttribute::get_state(const vespalib::slime::Inserter& inserter) const
+{
+    auto& object = inserter.insertObject();
+    populate_state(object);
+    if (_index) {
+        ObjectInserter index_inserter(object, "nearest_neighbor_index");
+        _index->get_state(index_inserter);
+    }
+}
+
+vespalib::eval::TypedCells
+SerializedFastValueAttribute::get_vector(uint32_t docid) const
+{
+    auto vectors = get_vectors(docid);
+    return (vectors.subspaces() > 0) ? vectors.cells(0) : vespalib::eval::TypedCells();
+}
+
+VectorBundle
+SerializedFastValueAttribute::get_vectors(uint32_t docid) const
+{
+    EntryRef ref = acquire_entry_ref(docid);
+    return _streamedValueStore.get_vectors(ref);
+}
+
 }
@@ -2,11 +2,15 @@
 
 #pragma once
 
+#include "default_nearest_neighbor_index_factory.h"
+#include "doc_vector_access.h"
 #include "tensor_attribute.h"
 #include "streamed_value_store.h"
 
 namespace search::tensor {
 
+class NearestNeighborIndex;
+
 /**
  * Attribute vector class storing serialized tensors for all documents in memory.
  *
@@ -15,18 +19,42 @@ namespace search::tensor {
  * mapping, but refer to a common type, while cells() will refer to
  * memory in the serialized store without copying.
  *
+ * When the tensor type has one indexed dimension, a nearest neighbor index
+ * can be used where each dense subspace of a tensor is a separate vector.
  */
-class SerializedFastValueAttribute : public TensorAttribute {
+class SerializedFastValueAttribute : public TensorAttribute, public DocVectorAccess {
     vespalib::eval::ValueType _tensor_type;
     StreamedValueStore _streamedValueStore; // data store for serialized tensors
+    std::unique_ptr<NearestNeighborIndex> _index;
+
+    void internal_set_tensor(DocId docid, const vespalib::eval::Value& tensor);
+    void consider_remove_from_index(DocId docid);
+    vespalib::MemoryUsage update_stat() override;
+    vespalib::MemoryUsage memory_usage() const override;
+    void populate_address_space_usage(AddressSpaceUsage& usage) const override;
 public:
-    SerializedFastValueAttribute(vespalib::stringref baseFileName, const Config &cfg);
+    SerializedFastValueAttribute(vespalib::stringref baseFileName, const Config &cfg,
+                                 const NearestNeighborIndexFactory& index_factory = DefaultNearestNeighborIndexFactory());
     ~SerializedFastValueAttribute() override;
+    uint32_t clearDoc(DocId docId) override;
     void setTensor(DocId docId, const vespalib::eval::Value &tensor) override;
+    std::unique_ptr<PrepareResult> prepare_set_tensor(DocId docid, const vespalib::eval::Value& tensor) const override;
+    void complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor, std::unique_ptr<PrepareResult> prepare_result) override;
     std::unique_ptr<vespalib::eval::Value> getTensor(DocId docId) const override;
+    bool supports_get_vectors() const override { return _tensor_type.count_indexed_dimensions() == 1; }
     bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
+    bool consider_compact(const CompactionStrategy& compaction_strategy) override;
+    void onGenerationChange(generation_t next_gen) override;
+    void removeOldGenerations(generation_t first_used_gen) override;
+    void get_state(const vespalib::slime::Inserter& inserter) const override;
+
+    // Implements DocVectorAccess
+    vespalib::eval::TypedCells get_vector(uint32_t docid) const override;
+    VectorBundle get_vectors(uint32_t docid) const override;
+
+    const NearestNeighborIndex* nearest_neighbor_index() const override { return _index.get(); }
 };
 
 }
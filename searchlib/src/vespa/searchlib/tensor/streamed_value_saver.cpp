@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "streamed_value_saver.h"
+#include "nearest_neighbor_index_saver.h"
 #include "streamed_value_store.h"
 
 #include <vespa/searchlib/attribute/iattributesavetarget.h>
@@ -15,18 +16,31 @@ StreamedValueSaver::
 StreamedValueSaver(GenerationHandler::Guard &&guard,
                    const attribute::AttributeHeader &header,
                    RefCopyVector &&refs,
-                   const StreamedValueStore &tensorStore)
+                   const StreamedValueStore &tensorStore,
+                   IndexSaverUP index_saver)
   : AttributeSaver(std::move(guard), header),
     _refs(std::move(refs)),
-    _tensorStore(tensorStore)
+    _tensorStore(tensorStore),
+    _index_saver(std::move(index_saver))
 {
 }
 
 StreamedValueSaver::~StreamedValueSaver() = default;
 
+vespalib::string
+StreamedValueSaver::index_file_suffix()
+{
+    return "mvnnidx";
+}
+
 bool
 StreamedValueSaver::onSave(IAttributeSaveTarget &saveTarget)
 {
+    if (_index_saver) {
+        if (!saveTarget.setup_writer(index_file_suffix(), "Binary data file for nearest neighbor index")) {
+            return false;
+        }
+    }
     auto datWriter = saveTarget.datWriter().allocBufferWriter();
     const uint32_t docIdLimit(_refs.size());
     vespalib::nbostream stream;
@@ -42,6 +56,11 @@ StreamedValueSaver::onSave(IAttributeSaveTarget &saveTarget)
         }
     }
     datWriter->flush();
+    if (_index_saver) {
+        auto index_writer = saveTarget.get_writer(index_file_suffix()).allocBufferWriter();
+        // Note: Implementation of save() is responsible to call BufferWriter::flush().
+        _index_saver->save(*index_writer);
+    }
     return true;
 }
 
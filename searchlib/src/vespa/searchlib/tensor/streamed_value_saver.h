@@ -7,10 +7,12 @@
 
 namespace search::tensor {
 
+class NearestNeighborIndexSaver;
 class StreamedValueStore;
 
 /*
  * Class for saving a tensor attribute.
+ * Will also save the nearest neighbor index if existing.
  */
 class StreamedValueSaver : public AttributeSaver
 {
@@ -18,18 +20,27 @@ public:
     using RefCopyVector = TensorAttribute::RefCopyVector;
 private:
     using GenerationHandler = vespalib::GenerationHandler;
+    using IndexSaverUP = std::unique_ptr<NearestNeighborIndexSaver>;
 
     RefCopyVector _refs;
     const StreamedValueStore &_tensorStore;
+    IndexSaverUP _index_saver;
 
     bool onSave(IAttributeSaveTarget &saveTarget) override;
 public:
     StreamedValueSaver(GenerationHandler::Guard &&guard,
                        const attribute::AttributeHeader &header,
                        RefCopyVector &&refs,
-                       const StreamedValueStore &tensorStore);
+                       const StreamedValueStore &tensorStore,
+                       IndexSaverUP index_saver);
 
     virtual ~StreamedValueSaver();
+
+    /**
+     * The multi-vector nearest neighbor index uses another file format than
+     * the one saved for dense tensor attributes, and thus a separate file suffix.
+     */
+    static vespalib::string index_file_suffix();
 };
 
 } // namespace search::tensor
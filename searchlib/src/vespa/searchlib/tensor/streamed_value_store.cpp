@@ -140,6 +140,13 @@ StreamedValueStore::TensorEntryImpl<CT>::encode_value(const ValueType &type, ves
     ::vespalib::eval::encode_value(my_value, target);
 }
 
+template <typename CT>
+TypedCells
+StreamedValueStore::TensorEntryImpl<CT>::get_cells() const
+{
+    return TypedCells(cells);
+}
+
 template <typename CT>
 MemoryUsage
 StreamedValueStore::TensorEntryImpl<CT>::get_memory_usage() const
@@ -239,6 +246,24 @@ StreamedValueStore::encode_tensor(EntryRef ref, vespalib::nbostream &target) con
     }
 }
 
+VectorBundle
+StreamedValueStore::get_vectors(const TensorEntry& entry) const
+{
+    auto cells = entry.get_cells();
+    size_t subspace_size = _tensor_type.dense_subspace_size();
+    assert(cells.size % subspace_size == 0);
+    return VectorBundle(cells.data, cells.type, cells.size / subspace_size, subspace_size);
+}
+
+VectorBundle
+StreamedValueStore::get_vectors(EntryRef ref) const
+{
+    if (const auto * entry = get_tensor_entry(ref)) {
+        return get_vectors(*entry);
+    }
+    return {};
+}
+
 TensorStore::EntryRef
 StreamedValueStore::store_tensor(const Value &tensor)
 {
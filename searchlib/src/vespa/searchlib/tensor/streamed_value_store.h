@@ -3,6 +3,7 @@
 #pragma once
 
 #include "tensor_store.h"
+#include "vector_bundle.h"
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/streamed/streamed_value.h>
@@ -26,6 +27,7 @@ public:
         using SP = std::shared_ptr<TensorEntry>;
         virtual Value::UP create_fast_value_view(const ValueType &type_ref) const = 0;
         virtual void encode_value(const ValueType &type, vespalib::nbostream &target) const = 0;
+        virtual vespalib::eval::TypedCells get_cells() const = 0;
         virtual MemoryUsage get_memory_usage() const = 0;
         virtual ~TensorEntry();
         static TensorEntry::SP create_shared_entry(const Value &value);
@@ -39,6 +41,7 @@ public:
         TensorEntryImpl(const Value &value, size_t num_mapped, size_t dense_size);
         Value::UP create_fast_value_view(const ValueType &type_ref) const override;
         void encode_value(const ValueType &type, vespalib::nbostream &target) const override;
+        vespalib::eval::TypedCells get_cells() const override;
         MemoryUsage get_memory_usage() const override;
         ~TensorEntryImpl() override;
     };
@@ -71,6 +74,11 @@ public:
 
     const TensorEntry * get_tensor_entry(EntryRef ref) const;
     bool encode_tensor(EntryRef ref, vespalib::nbostream &target) const;
+    /**
+     * Returns the vectors of the given tensor entry, one per dense subspace in the order they are stored.
+     */
+    VectorBundle get_vectors(const TensorEntry& entry) const;
+    VectorBundle get_vectors(EntryRef ref) const;
 
     EntryRef store_tensor(const vespalib::eval::Value &tensor);
     EntryRef store_encoded_tensor(vespalib::nbostream &encoded);
@@ -4,6 +4,7 @@
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/tensor_data_type.h>
 #include <vespa/searchlib/attribute/address_space_components.h>
+#include <vespa/searchlib/attribute/attribute_header.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/data/slime/cursor.h>
@@ -84,12 +85,23 @@ TensorAttribute::onCommit()
 {
     // Note: Cost can be reduced if unneeded generation increments are dropped
     incGeneration();
+    auto compaction_start = vespalib::steady_clock::now();
+    if (consider_compact(getConfig().getCompactionStrategy())) {
+        finish_compaction_step(compaction_start);
+    }
+}
+
+bool
+TensorAttribute::consider_compact(const CompactionStrategy& compaction_strategy)
+{
     if (getFirstUsedGeneration() > _compactGeneration) {
         // No data held from previous compact operation
-        if (getConfig().getCompactionStrategy().should_compact_memory(_cached_tensor_store_memory_usage)) {
+        if (compaction_strategy.should_compact_memory(_cached_tensor_store_memory_usage)) {
             compactWorst();
+            return true;
         }
     }
+    return false;
 }
 
 void
@@ -217,6 +229,12 @@ TensorAttribute::get_tensor_ref(uint32_t /*docid*/) const
     notImplemented();
 }
 
+VectorBundle
+TensorAttribute::get_vectors(uint32_t /*docid*/) const
+{
+    notImplemented();
+}
+
 const vespalib::eval::ValueType &
 TensorAttribute::getTensorType() const
 {
@@ -317,4 +335,19 @@ TensorAttribute::distance_metric() const {
     return getConfig().distance_metric();
 }
 
+bool
+TensorAttribute::can_use_index_save_file(const Config& config, const attribute::AttributeHeader& header)
+{
+    if (!config.hnsw_index_params().has_value() || !header.get_hnsw_index_params().has_value()) {
+        return false;
+    }
+    const auto &config_params = config.hnsw_index_params().value();
+    const auto &header_params = header.get_hnsw_index_params().value();
+    if ((config_params.max_links_per_node() != header_params.max_links_per_node()) ||
+        (config_params.distance_metric() != header_params.distance_metric())) {
+        return false;
+    }
+    return true;
+}
+
 }
@@ -10,6 +10,7 @@
 #include <vespa/document/update/tensor_update.h>
 
 namespace vespalib::eval { struct Value; struct ValueBuilderFactory; }
+namespace search::attribute { class AttributeHeader; }
 
 namespace search::tensor {
 
@@ -21,6 +22,7 @@ class TensorAttribute : public NotImplementedAttribute, public ITensorAttribute
 protected:
     using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
     using EntryRef = TensorStore::EntryRef;
+    using CompactionStrategy = vespalib::datastore::CompactionStrategy;
     using RefVector = vespalib::RcuVectorBase<AtomicEntryRef>;
 
     RefVector _refVector; // docId -> ref in data store for serialized tensor
@@ -57,6 +59,8 @@ public:
     const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const override;
     bool supports_extract_cells_ref() const override { return false; }
     bool supports_get_tensor_ref() const override { return false; }
+    VectorBundle get_vectors(uint32_t docid) const override;
+    bool supports_get_vectors() const override { return false; }
     const vespalib::eval::ValueType & getTensorType() const override;
     void get_state(const vespalib::slime::Inserter& inserter) const override;
     void clearDocs(DocId lidLow, DocId lidLimit, bool in_shrink_lid_space) override;
@@ -87,6 +91,15 @@ public:
     virtual void complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor, std::unique_ptr<PrepareResult> prepare_result);
 
     virtual void compactWorst() = 0;
+    /*
+     * Performs at most one compaction step. Returns true if something was compacted.
+     */
+    virtual bool consider_compact(const CompactionStrategy& compaction_strategy);
+
+    /*
+     * Returns true if a nearest neighbor index saved with the given attribute header can be loaded using the given config.
+     */
+    static bool can_use_index_save_file(const Config& config, const attribute::AttributeHeader& header);
 };
 
 }
@@ -22,8 +22,6 @@ TensorAttribute::doCompactWorst()
     }
     _tensorStore.finishCompactWorstBuffer(bufferId);
     _compactGeneration = getCurrentGeneration();
-    incGeneration();
-    updateStat(true);
 }
 
 }  // namespace search::tensor
@@ -57,6 +57,10 @@ public:
         return _store.getAddressSpaceUsage();
     }
 
+    bool has_held_buffers() const noexcept {
+        return _store.has_held_buffers();
+    }
+
     uint32_t startCompactWorstBuffer() {
         return _store.startCompactWorstBuffer(_typeId);
     }
@@ -0,0 +1,57 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/cell_type.h>
+#include <vespa/eval/eval/typed_cells.h>
+#include <cassert>
+#include <cstdint>
+
+namespace search::tensor {
+
+/**
+ * Class that provides access to the vectors of the subspaces of a tensor associated with a document.
+ *
+ * A dense tensor has one subspace, while a mixed tensor with one mapped dimension
+ * and one indexed dimension has one subspace per label in the mapped dimension.
+ * All subspaces have the same size and cell type.
+ */
+class VectorBundle {
+    const void*                  _data;
+    vespalib::eval::CellType     _cell_type;
+    uint32_t                     _subspaces;
+    size_t                       _subspace_mem_size;
+    size_t                       _subspace_size;
+public:
+    VectorBundle() noexcept
+        : _data(nullptr),
+          _cell_type(vespalib::eval::CellType::DOUBLE),
+          _subspaces(0),
+          _subspace_mem_size(0),
+          _subspace_size(0)
+    {
+    }
+    VectorBundle(const void* data, vespalib::eval::CellType cell_type, uint32_t subspaces, size_t subspace_size) noexcept
+        : _data(data),
+          _cell_type(cell_type),
+          _subspaces(subspaces),
+          _subspace_mem_size(vespalib::eval::CellTypeUtils::mem_size(cell_type, subspace_size)),
+          _subspace_size(subspace_size)
+    {
+    }
+    /**
+     * Creates a bundle with a single subspace, or no subspaces if the given vector is empty.
+     */
+    explicit VectorBundle(vespalib::eval::TypedCells vector) noexcept
+        : VectorBundle(vector.data, vector.type, (vector.size != 0) ? 1 : 0, vector.size)
+    {
+    }
+    uint32_t subspaces() const noexcept { return _subspaces; }
+    vespalib::eval::TypedCells cells(uint32_t subspace) const noexcept {
+        assert(subspace < _subspaces);
+        return vespalib::eval::TypedCells(static_cast<const char*>(_data) + _subspace_mem_size * subspace,
+                                          _cell_type, _subspace_size);
+    }
+};
+
+}
@@ -173,6 +173,7 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max", _posting_params._encode_block_max);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -797,6 +798,20 @@ public:
     }
 };
 
+class FakeZc4SkipPosOccCfBlockMax : public FakeZc4SkipPosOcc<true>
+{
+    static Zc4PostingParams make_posting_params(const FakeWord &fw) {
+        Zc4PostingParams posting_params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+        posting_params._encode_block_max = true;
+        return posting_params;
+    }
+public:
+    FakeZc4SkipPosOccCfBlockMax(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<true>(fw, make_posting_params(fw), ".zc4skipposoccbe.cf.bm")
+    {
+    }
+};
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
@@ -911,6 +926,11 @@ static FPFactoryInit
 initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax > >));
+
+
 static FPFactoryInit
 initSkipPos0becfnnu(std::make_pair("Zc4SkipPosOccBE.cf.nnu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack > >));
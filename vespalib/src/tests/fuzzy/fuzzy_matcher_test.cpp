@@ -77,4 +77,28 @@ TEST(FuzzyMatcherTest, get_prefix_non_empty) {
     EXPECT_EQ(fuzzy.getPrefix(), "ab");
 }
 
+TEST(FuzzyMatcherTest, match_or_successor_gives_next_candidate) {
+    FuzzyMatcher fuzzy("abcd", 1, 0, false);
+    ASSERT_TRUE(fuzzy.hasSuccessor());
+    vespalib::string successor;
+    EXPECT_TRUE(fuzzy.matchOrSuccessor("ABCD", successor));
+    EXPECT_TRUE(fuzzy.matchOrSuccessor("abxd", successor));
+    EXPECT_FALSE(fuzzy.matchOrSuccessor("ax", successor));
+    EXPECT_EQ(successor, "axbcd");
+    EXPECT_FALSE(fuzzy.matchOrSuccessor("b", successor));
+    EXPECT_EQ(successor, "babcd");
+}
+
+TEST(FuzzyMatcherTest, match_or_successor_with_prefix) {
+    FuzzyMatcher fuzzy("abcdef", 1, 2, false);
+    vespalib::string successor;
+    EXPECT_TRUE(fuzzy.matchOrSuccessor("abcdxf", successor));
+    EXPECT_FALSE(fuzzy.matchOrSuccessor("aa", successor));
+    EXPECT_EQ(successor, "ab\x01" "cdef");
+    EXPECT_FALSE(fuzzy.matchOrSuccessor("abz", successor));
+    EXPECT_EQ(successor, "abzcdef");
+    EXPECT_FALSE(fuzzy.matchOrSuccessor("ac", successor));
+    EXPECT_EQ(successor, "");
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,113 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <vespa/vespalib/fuzzy/levenshtein_distance.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+
+using namespace vespalib;
+
+using Codepoints = std::vector<uint32_t>;
+
+namespace {
+
+Codepoints cp(std::string_view str) {
+    return Codepoints(str.begin(), str.end());
+}
+
+// all strings over the given alphabet with at most max_len characters, sorted
+std::vector<Codepoints> all_strings(std::string_view alphabet, size_t max_len) {
+    std::vector<Codepoints> result = {Codepoints()};
+    for (size_t begin = 0, len = 0; len < max_len; ++len) {
+        size_t end = result.size();
+        for (size_t i = begin; i < end; ++i) {
+            for (char c : alphabet) {
+                Codepoints str = result[i];
+                str.push_back(c);
+                result.push_back(std::move(str));
+            }
+        }
+        begin = end;
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void verify_against_brute_force(std::string_view target, uint32_t max_edits) {
+    SCOPED_TRACE(std::string("target='") + std::string(target) + "', max_edits=" + std::to_string(max_edits));
+    LevenshteinDfa dfa(cp(target), max_edits);
+    auto strings = all_strings("abcd", target.size() + max_edits + 1);
+    std::vector<bool> matches;
+    for (const auto &str : strings) {
+        matches.push_back(LevenshteinDistance::calculate(cp(target), str, max_edits).has_value());
+    }
+    for (size_t i = 0; i < strings.size(); ++i) {
+        Codepoints successor;
+        auto edits = dfa.match(strings[i], &successor);
+        ASSERT_EQ(LevenshteinDistance::calculate(cp(target), strings[i], max_edits), edits);
+        if (edits.has_value()) {
+            continue;
+        }
+        auto next_match = std::find(matches.begin() + i, matches.end(), true);
+        if (successor.empty()) {
+            // no later string can match
+            ASSERT_TRUE(next_match == matches.end());
+            continue;
+        }
+        ASSERT_TRUE(strings[i] < successor);
+        ASSERT_TRUE(LevenshteinDistance::calculate(cp(target), successor, max_edits).has_value());
+        ASSERT_TRUE(dfa.match(successor, nullptr).has_value());
+        // no matching string between the source and its successor
+        if (next_match != matches.end()) {
+            ASSERT_FALSE(strings[next_match - matches.begin()] < successor);
+        }
+    }
+}
+
+}
+
+TEST(LevenshteinDfaTest, match_gives_same_edits_as_levenshtein_distance) {
+    LevenshteinDfa dfa(cp("abc"), 2);
+    EXPECT_EQ(dfa.match(cp("abc"), nullptr), std::optional<uint32_t>(0));
+    EXPECT_EQ(dfa.match(cp("ab1"), nullptr), std::optional<uint32_t>(1));
+    EXPECT_EQ(dfa.match(cp("abcd"), nullptr), std::optional<uint32_t>(1));
+    EXPECT_EQ(dfa.match(cp("a12"), nullptr), std::optional<uint32_t>(2));
+    EXPECT_EQ(dfa.match(cp("a"), nullptr), std::optional<uint32_t>(2));
+    EXPECT_EQ(dfa.match(cp("123"), nullptr), std::nullopt);
+    EXPECT_EQ(dfa.match(cp(""), nullptr), std::nullopt);
+    EXPECT_EQ(dfa.match(cp("abcdef"), nullptr), std::nullopt);
+}
+
+TEST(LevenshteinDfaTest, successor_is_smallest_greater_matching_string) {
+    LevenshteinDfa dfa(cp("food"), 1);
+    Codepoints successor;
+    // source is a prefix of matching strings
+    EXPECT_FALSE(dfa.match(cp("fa"), &successor).has_value());
+    EXPECT_EQ(successor, cp("faod"));
+    // last codepoint must be replaced by a larger one
+    EXPECT_FALSE(dfa.match(cp("fzz"), &successor).has_value());
+    EXPECT_EQ(successor, cp("f{od"));
+    EXPECT_FALSE(dfa.match(cp("zzz"), &successor).has_value());
+    EXPECT_EQ(successor, cp("{food"));
+    // no greater string can match
+    EXPECT_FALSE(dfa.match(Codepoints({0x10ffff, 0x10ffff, 0x10ffff}), &successor).has_value());
+    EXPECT_TRUE(successor.empty());
+    Codepoints smallest;
+    dfa.smallest_match(smallest);
+    EXPECT_EQ(smallest, Codepoints({1, 'f', 'o', 'o', 'd'}));
+}
+
+TEST(LevenshteinDfaTest, successor_matches_brute_force) {
+    for (uint32_t max_edits = 0; max_edits <= LevenshteinDfa::max_supported_edits; ++max_edits) {
+        for (std::string_view target : {"", "a", "ab", "abc", "bcb", "dada"}) {
+            verify_against_brute_force(target, max_edits);
+        }
+    }
+}
+
+TEST(LevenshteinDfaTest, number_of_states_is_bounded_by_target_length) {
+    LevenshteinDfa dfa(cp("levenshteinautomaton"), 2);
+    EXPECT_LT(dfa.num_states(), 20u * 50u);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/binary_hamming_distance.h>
 #include <vespa/log/log.h>
 LOG_SETUP("hwaccelrated_test");
 
@@ -17,6 +19,15 @@ std::vector<T> createAndFill(size_t sz) {
     return v;
 }
 
+template<>
+std::vector<int8_t> createAndFill<int8_t>(size_t sz) {
+    std::vector<int8_t> v(sz);
+    for (size_t i(0); i < sz; i++) {
+        v[i] = rand()%256 - 128;
+    }
+    return v;
+}
+
 template<typename T, typename P>
 void verifyEuclideanDistance(const hwaccelrated::IAccelrated & accel, size_t testLength, double approxFactor) {
     srand(1);
@@ -31,6 +42,12 @@ void verifyEuclideanDistance(const hwaccelrated::IAccelrated & accel, size_t tes
         P hwComputedSum(accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j));
         EXPECT_APPROX(sum, hwComputedSum, sum*approxFactor);
     }
+    const T * batch[3] = { &b[0], &a[0], &b[1] };
+    double batchResult[3];
+    accel.squaredEuclideanDistance(&a[0], batch, testLength - 1, 3, batchResult);
+    for (size_t i(0); i < 3; i++) {
+        EXPECT_EQUAL(accel.squaredEuclideanDistance(&a[0], batch[i], testLength - 1), batchResult[i]);
+    }
 }
 
 void
@@ -38,6 +55,7 @@ verifyEuclideanDistance(const hwaccelrated::IAccelrated & accelrator, size_t tes
     verifyEuclideanDistance<int8_t, double>(accelrator, testLength, 0.0);
     verifyEuclideanDistance<float, double>(accelrator, testLength, 0.0001); // Small deviation requiring EXPECT_APPROX
     verifyEuclideanDistance<double, double>(accelrator, testLength, 0.0);
+    verifyEuclideanDistance<BFloat16, double>(accelrator, testLength, 0.0);
 }
 
 TEST("test euclidean distance") {
@@ -47,4 +65,85 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+template<typename T, typename P>
+void verifyDotProduct(const hwaccelrated::IAccelrated & accel, size_t testLength, double approxFactor) {
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        P sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += P(a[i]) * P(b[i]);
+        }
+        P hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        EXPECT_APPROX(sum, hwComputedSum, std::abs(sum)*approxFactor);
+    }
+}
+
+void
+verifyDotProduct(const hwaccelrated::IAccelrated & accelrator, size_t testLength) {
+    verifyDotProduct<int8_t, int64_t>(accelrator, testLength, 0.0);
+    verifyDotProduct<float, double>(accelrator, testLength, 0.0001);
+    verifyDotProduct<BFloat16, double>(accelrator, testLength, 0.0);
+}
+
+TEST("test dot product") {
+    constexpr size_t TEST_LENGTH = 140000; // must be longer than 64k
+    TEST_DO(verifyDotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyDotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+void
+verifyBinaryHammingDistance(const hwaccelrated::IAccelrated & accel) {
+    srand(1);
+    std::vector<int8_t> a = createAndFill<int8_t>(1000);
+    std::vector<int8_t> b = createAndFill<int8_t>(1000);
+    for (size_t j(0); j < 0x20; j++) {
+        for (size_t sz : {0ul, 1ul, 7ul, 8ul, 33ul, 64ul, 100ul, 1000ul - j}) {
+            EXPECT_EQUAL(binary_hamming_distance(&a[j], &b[j], sz),
+                         accel.binaryHammingDistance(&a[j], &b[j], sz));
+        }
+    }
+}
+
+TEST("test binary hamming distance") {
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::GenericAccelrator()));
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
+template <typename T>
+void
+verifyOrInRange(const hwaccelrated::IAccelrated & accel, T low, T high) {
+    srand(1);
+    std::vector<T> a = createAndFill<T>(1000);
+    for (size_t j(0); j < 0x20; j++) {
+        for (size_t sz : {0ul, 1ul, 7ul, 63ul, 64ul, 65ul, 200ul, 1000ul - j}) {
+            std::vector<uint64_t> expected((sz + 63)/64 + 1, 0x8000000000000000ul);
+            std::vector<uint64_t> actual(expected);
+            for (size_t i(0); i < sz; i++) {
+                if ((low <= a[j + i]) && (a[j + i] <= high)) {
+                    expected[i/64] |= uint64_t(1) << (i%64);
+                }
+            }
+            accel.orInRange(&a[j], sz, low, high, actual.data());
+            EXPECT_TRUE(expected == actual);
+        }
+    }
+}
+
+void
+verifyOrInRange(const hwaccelrated::IAccelrated & accel) {
+    TEST_DO(verifyOrInRange<int8_t>(accel, -10, 30));
+    TEST_DO(verifyOrInRange<int16_t>(accel, 100, 300));
+    TEST_DO(verifyOrInRange<int32_t>(accel, 42, 42));
+    TEST_DO(verifyOrInRange<int64_t>(accel, 0, 250));
+    TEST_DO(verifyOrInRange<float>(accel, 10.5, 200));
+    TEST_DO(verifyOrInRange<double>(accel, 499, 1000));
+}
+
+TEST("test or in range") {
+    TEST_DO(verifyOrInRange(hwaccelrated::GenericAccelrator()));
+    TEST_DO(verifyOrInRange(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 
 #include "fuzzy_matcher.h"
 #include "levenshtein_distance.h"
+#include "levenshtein_dfa.h"
 
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/text/utf8.h>
@@ -26,7 +27,8 @@ vespalib::FuzzyMatcher::FuzzyMatcher():
         _is_cased(false),
         _folded_term_codepoints(),
         _folded_term_codepoints_prefix(),
-        _folded_term_codepoints_suffix()
+        _folded_term_codepoints_suffix(),
+        _dfa()
 {}
 
 vespalib::FuzzyMatcher::FuzzyMatcher(std::string_view term, uint32_t max_edit_distance, uint32_t prefix_size, bool is_cased):
@@ -35,8 +37,23 @@ vespalib::FuzzyMatcher::FuzzyMatcher(std::string_view term, uint32_t max_edit_di
         _is_cased(is_cased),
         _folded_term_codepoints(_is_cased ? cased_convert_to_ucs4(term) : LowerCase::convert_to_ucs4(term)),
         _folded_term_codepoints_prefix(get_prefix(_folded_term_codepoints, _prefix_size)),
-        _folded_term_codepoints_suffix(get_suffix(_folded_term_codepoints, _prefix_size))
-{}
+        _folded_term_codepoints_suffix(get_suffix(_folded_term_codepoints, _prefix_size)),
+        _dfa()
+{
+    if (_max_edit_distance <= LevenshteinDfa::max_supported_edits) {
+        _dfa = std::make_unique<const LevenshteinDfa>(std::vector<uint32_t>(_folded_term_codepoints_suffix.begin(),
+                                                                            _folded_term_codepoints_suffix.end()),
+                                                      _max_edit_distance);
+    }
+}
+
+vespalib::FuzzyMatcher::FuzzyMatcher(FuzzyMatcher &&) noexcept = default;
+vespalib::FuzzyMatcher & vespalib::FuzzyMatcher::operator=(FuzzyMatcher &&) noexcept = default;
+vespalib::FuzzyMatcher::~FuzzyMatcher() = default;
+
+std::vector<uint32_t> vespalib::FuzzyMatcher::convert(std::string_view target) const {
+    return _is_cased ? cased_convert_to_ucs4(target) : LowerCase::convert_to_ucs4(target);
+}
 
 std::span<const uint32_t> vespalib::FuzzyMatcher::get_prefix(const std::vector<uint32_t>& termCodepoints, uint32_t prefixLength) {
     if (prefixLength == 0 || termCodepoints.empty()) {
@@ -57,7 +74,7 @@ std::span<const uint32_t> vespalib::FuzzyMatcher::get_suffix(const std::vector<u
 }
 
 bool vespalib::FuzzyMatcher::isMatch(std::string_view target) const {
-    std::vector<uint32_t> targetCodepoints = _is_cased ? cased_convert_to_ucs4(target) : LowerCase::convert_to_ucs4(target);
+    std::vector<uint32_t> targetCodepoints = convert(target);
 
     if (_prefix_size > 0) { // prefix comparison is meaningless if it's empty
         std::span<const uint32_t> targetPrefix = get_prefix(targetCodepoints, _prefix_size);
@@ -74,6 +91,37 @@ bool vespalib::FuzzyMatcher::isMatch(std::string_view target) const {
             _max_edit_distance).has_value();
 }
 
+bool vespalib::FuzzyMatcher::matchOrSuccessor(std::string_view target, vespalib::string &successor) const {
+    std::vector<uint32_t> targetCodepoints = convert(target);
+    std::span<const uint32_t> targetPrefix = get_prefix(targetCodepoints, _prefix_size);
+    std::vector<uint32_t> successorCodepoints;
+    successor.clear();
+    if (!std::equal(_folded_term_codepoints_prefix.begin(), _folded_term_codepoints_prefix.end(),
+                    targetPrefix.begin(), targetPrefix.end())) {
+        if (!std::lexicographical_compare(targetPrefix.begin(), targetPrefix.end(),
+                                          _folded_term_codepoints_prefix.begin(), _folded_term_codepoints_prefix.end())) {
+            return false; // all later strings have a greater prefix
+        }
+        successorCodepoints.assign(_folded_term_codepoints_prefix.begin(), _folded_term_codepoints_prefix.end());
+        _dfa->smallest_match(successorCodepoints);
+    } else {
+        std::vector<uint32_t> suffixSuccessor;
+        if (_dfa->match(get_suffix(targetCodepoints, _prefix_size), &suffixSuccessor).has_value()) {
+            return true;
+        }
+        if (suffixSuccessor.empty()) {
+            return false; // no more matches with this prefix
+        }
+        successorCodepoints.assign(targetPrefix.begin(), targetPrefix.end());
+        successorCodepoints.insert(successorCodepoints.end(), suffixSuccessor.begin(), suffixSuccessor.end());
+    }
+    Utf8Writer writer(successor);
+    for (uint32_t code : successorCodepoints) {
+        writer.putChar(code);
+    }
+    return false;
+}
+
 vespalib::string vespalib::FuzzyMatcher::getPrefix() const {
     vespalib::string prefix;
     Utf8Writer writer(prefix);
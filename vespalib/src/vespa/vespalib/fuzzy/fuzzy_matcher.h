@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <memory>
 #include <string_view>
 #include <vector>
 #include <span>
@@ -9,6 +10,8 @@
 
 namespace vespalib {
 
+class LevenshteinDfa;
+
 /**
  * Fuzzy matching between lowercased instances of query and document terms based on Levenshtein distance.
  * Class has two main parameters:
@@ -17,6 +20,11 @@ namespace vespalib {
  * Prefix size dictates of how match of a prefix is frozen,
  * i.e. if prefixes between the document and the query do not match (after lowercase)
  * matcher would return false early, without fuzzy match.
+ *
+ * For small max edit distances a Levenshtein automaton is also built,
+ * which can find the next candidate that might match after a
+ * non-matching term. This allows seeking in a sorted dictionary instead
+ * of matching every term in it.
  */
 class FuzzyMatcher {
 private:
@@ -32,13 +40,37 @@ private:
     std::span<const uint32_t> _folded_term_codepoints_prefix;
     std::span<const uint32_t> _folded_term_codepoints_suffix;
 
+    std::unique_ptr<const LevenshteinDfa> _dfa;
+
+    std::vector<uint32_t> convert(std::string_view target) const;
+
 public:
     FuzzyMatcher();
 
     FuzzyMatcher(std::string_view term, uint32_t max_edit_distance, uint32_t prefix_size, bool is_cased);
 
+    FuzzyMatcher(FuzzyMatcher &&) noexcept;
+    FuzzyMatcher & operator=(FuzzyMatcher &&) noexcept;
+    ~FuzzyMatcher();
+
     [[nodiscard]] bool isMatch(std::string_view target) const;
 
+    [[nodiscard]] bool is_cased() const noexcept { return _is_cased; }
+
+    /**
+     * Whether matchOrSuccessor() can be used.
+     */
+    [[nodiscard]] bool hasSuccessor() const noexcept { return static_cast<bool>(_dfa); }
+
+    /**
+     * Match target like isMatch(). If there is no match, successor is set
+     * to the (lowercased unless cased) smallest string greater than target
+     * that might match, or to an empty string if no such string exists.
+     * Strings are ordered by codepoint, which is the order of a folded (or
+     * cased) enum store dictionary. Requires hasSuccessor().
+     */
+    [[nodiscard]] bool matchOrSuccessor(std::string_view target, vespalib::string &successor) const;
+
     [[nodiscard]] vespalib::string getPrefix() const;
 
     static std::span<const uint32_t> get_prefix(const std::vector<uint32_t>& termCodepoints, uint32_t prefixLength);
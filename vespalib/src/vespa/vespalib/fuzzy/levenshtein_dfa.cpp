@@ -0,0 +1,185 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "levenshtein_dfa.h"
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+namespace vespalib {
+
+LevenshteinDfa::LevenshteinDfa(std::vector<uint32_t> target, uint32_t max_edits)
+    : _target(std::move(target)),
+      _alphabet(_target),
+      _max_edits(max_edits),
+      _transitions(),
+      _edits()
+{
+    assert(max_edits <= max_supported_edits);
+    std::sort(_alphabet.begin(), _alphabet.end());
+    _alphabet.erase(std::unique(_alphabet.begin(), _alphabet.end()), _alphabet.end());
+    build();
+}
+
+LevenshteinDfa::LevenshteinDfa(LevenshteinDfa &&) noexcept = default;
+LevenshteinDfa & LevenshteinDfa::operator=(LevenshteinDfa &&) noexcept = default;
+LevenshteinDfa::~LevenshteinDfa() = default;
+
+void
+LevenshteinDfa::build()
+{
+    using Row = std::vector<uint8_t>;
+    const uint32_t m = _target.size();
+    const uint8_t clamp = _max_edits + 1;
+    const size_t num_symbols = _alphabet.size() + 1;
+    std::map<Row, StateId> state_ids;
+    std::vector<Row> rows;
+    rows.emplace_back(m + 1, clamp); // dead state
+    Row start(m + 1);
+    for (uint32_t j = 0; j <= m; ++j) {
+        start[j] = std::min(j, uint32_t(clamp));
+    }
+    state_ids[start] = START;
+    rows.push_back(std::move(start));
+    Row next(m + 1);
+    for (StateId state = 0; state < rows.size(); ++state) {
+        for (size_t sym = 0; sym < num_symbols; ++sym) {
+            if (state == DEAD) {
+                _transitions.push_back(DEAD);
+                continue;
+            }
+            const Row &row = rows[state];
+            // the last symbol stands for all codepoints not in the target
+            uint32_t c = (sym < _alphabet.size()) ? _alphabet[sym] : 0;
+            next[0] = std::min(row[0] + 1, int(clamp));
+            uint8_t min_edits = next[0];
+            for (uint32_t j = 1; j <= m; ++j) {
+                uint32_t cost = (sym < _alphabet.size() && _target[j - 1] == c) ? 0 : 1;
+                int edits = std::min({row[j - 1] + cost, row[j] + 1u, next[j - 1] + 1u});
+                next[j] = std::min(edits, int(clamp));
+                min_edits = std::min(min_edits, next[j]);
+            }
+            if (min_edits >= clamp) {
+                _transitions.push_back(DEAD);
+                continue;
+            }
+            auto ins = state_ids.emplace(next, rows.size());
+            if (ins.second) {
+                rows.push_back(next);
+            }
+            _transitions.push_back(ins.first->second);
+        }
+    }
+    _edits.reserve(rows.size());
+    for (const auto &row : rows) {
+        _edits.push_back(row[m]);
+    }
+}
+
+uint32_t
+LevenshteinDfa::symbol(uint32_t c) const noexcept
+{
+    auto itr = std::lower_bound(_alphabet.begin(), _alphabet.end(), c);
+    if (itr != _alphabet.end() && *itr == c) {
+        return itr - _alphabet.begin();
+    }
+    return _alphabet.size();
+}
+
+std::optional<uint32_t>
+LevenshteinDfa::next_live_char(StateId state, uint32_t after) const
+{
+    if (after >= max_codepoint) {
+        return std::nullopt;
+    }
+    const StateId *transitions = &_transitions[state * (_alphabet.size() + 1)];
+    std::optional<uint32_t> result;
+    auto itr = std::upper_bound(_alphabet.begin(), _alphabet.end(), after);
+    for (; itr != _alphabet.end(); ++itr) {
+        if (transitions[itr - _alphabet.begin()] != DEAD) {
+            result = *itr;
+            break;
+        }
+    }
+    if (transitions[_alphabet.size()] != DEAD) {
+        // smallest codepoint after 'after' not present in the target
+        uint32_t other = after + 1;
+        auto aitr = std::lower_bound(_alphabet.begin(), _alphabet.end(), other);
+        while (aitr != _alphabet.end() && *aitr == other) {
+            ++other;
+            ++aitr;
+        }
+        if (other <= max_codepoint && (!result.has_value() || other < result.value())) {
+            result = other;
+        }
+    }
+    return result;
+}
+
+void
+LevenshteinDfa::append_smallest_completion(StateId state, std::vector<uint32_t> &result) const
+{
+    // Every non-dead state can reach an accepting state, and matching
+    // sequences are bounded in length, so picking the smallest live
+    // codepoint at each step terminates with the smallest completion.
+    while (!accepts(state)) {
+        auto c = next_live_char(state, 0);
+        assert(c.has_value());
+        result.push_back(c.value());
+        state = step(state, c.value());
+    }
+}
+
+void
+LevenshteinDfa::smallest_match(std::vector<uint32_t> &result) const
+{
+    append_smallest_completion(START, result);
+}
+
+std::optional<uint32_t>
+LevenshteinDfa::match(std::span<const uint32_t> source, std::vector<uint32_t> *successor) const
+{
+    StateId state = START;
+    size_t pos = 0;
+    for (; pos < source.size(); ++pos) {
+        StateId next = step(state, source[pos]);
+        if (next == DEAD) {
+            break;
+        }
+        state = next;
+    }
+    if (pos == source.size() && accepts(state)) {
+        return _edits[state];
+    }
+    if (successor == nullptr) {
+        return std::nullopt;
+    }
+    successor->clear();
+    if (pos == source.size()) {
+        // all of source is a prefix of some match; extend it
+        successor->assign(source.begin(), source.end());
+        append_smallest_completion(state, *successor);
+        return std::nullopt;
+    }
+    // Replace the codepoint at the last possible position with a larger
+    // one keeping the automaton alive, then complete with the smallest suffix.
+    std::vector<StateId> states;
+    states.reserve(pos + 1);
+    state = START;
+    states.push_back(state);
+    for (size_t i = 0; i < pos; ++i) {
+        state = step(state, source[i]);
+        states.push_back(state);
+    }
+    for (size_t i = pos + 1; i-- > 0; ) {
+        auto c = next_live_char(states[i], source[i]);
+        if (c.has_value()) {
+            successor->assign(source.begin(), source.begin() + i);
+            successor->push_back(c.value());
+            append_smallest_completion(step(states[i], c.value()), *successor);
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+}
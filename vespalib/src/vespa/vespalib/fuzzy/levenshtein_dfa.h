@@ -0,0 +1,79 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Deterministic finite automaton accepting all codepoint sequences
+ * within a given Levenshtein distance of a target sequence.
+ *
+ * A state is a row of the Levenshtein distance matrix, with all values
+ * above the max edit distance clamped. All reachable states are built up
+ * front, so matching a candidate costs a single state transition per
+ * codepoint. Codepoints not present in the target all behave the same,
+ * so each state has one transition per distinct target codepoint plus one
+ * shared transition for all other codepoints.
+ *
+ * When a candidate does not match, the automaton can also produce the
+ * lexicographically smallest matching sequence that is greater than the
+ * candidate. This is used to seek in a sorted dictionary instead of
+ * matching every dictionary entry.
+ *
+ * The number of states grows quickly with the edit distance, so only
+ * small edit distances are supported.
+ */
+class LevenshteinDfa {
+public:
+    static constexpr uint32_t max_supported_edits = 2;
+
+    LevenshteinDfa(std::vector<uint32_t> target, uint32_t max_edits);
+    LevenshteinDfa(LevenshteinDfa &&) noexcept;
+    LevenshteinDfa &operator=(LevenshteinDfa &&) noexcept;
+    ~LevenshteinDfa();
+
+    /**
+     * Match source against the target. Returns the edit distance if it
+     * is within the max edit distance.
+     *
+     * If there is no match and successor is non-null, it is set to the
+     * smallest matching sequence that is greater than source, or to an
+     * empty sequence if no such sequence exists.
+     */
+    [[nodiscard]] std::optional<uint32_t> match(std::span<const uint32_t> source,
+                                                std::vector<uint32_t> *successor) const;
+
+    /**
+     * Append the smallest sequence matching the target to result.
+     */
+    void smallest_match(std::vector<uint32_t> &result) const;
+
+    [[nodiscard]] size_t num_states() const noexcept { return _edits.size(); }
+
+private:
+    using StateId = uint32_t;
+    static constexpr StateId DEAD = 0;
+    static constexpr StateId START = 1;
+    static constexpr uint32_t max_codepoint = 0x10ffff;
+
+    std::vector<uint32_t> _target;
+    std::vector<uint32_t> _alphabet;     // distinct target codepoints, sorted
+    uint32_t              _max_edits;
+    std::vector<StateId>  _transitions;  // (_alphabet.size() + 1) per state
+    std::vector<uint32_t> _edits;        // edits at end of target per state
+
+    void build();
+    [[nodiscard]] uint32_t symbol(uint32_t c) const noexcept;
+    [[nodiscard]] StateId step(StateId state, uint32_t c) const noexcept {
+        return _transitions[state * (_alphabet.size() + 1) + symbol(c)];
+    }
+    [[nodiscard]] bool accepts(StateId state) const noexcept { return _edits[state] <= _max_edits; }
+    [[nodiscard]] std::optional<uint32_t> next_live_char(StateId state, uint32_t after) const;
+    void append_smallest_completion(StateId state, std::vector<uint32_t> &result) const;
+};
+
+}
@@ -2,9 +2,106 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
+#include <algorithm>
 
 namespace vespalib::hwaccelrated {
 
+namespace {
+
+// Number of int8 elements accumulated in the 32 bit lanes before they are folded into a 64 bit sum.
+constexpr size_t VNNI_CHUNK_SIZE = 0x10000;
+
+inline __m256i
+load(const int8_t * p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+inline int64_t
+sumLanes(__m256i acc) {
+    int32_t lanes[sizeof(__m256i)/sizeof(int32_t)];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    int64_t sum(0);
+    for (int32_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+/*
+ * vpdpbusd multiplies unsigned bytes with signed bytes. The a operand is
+ * biased by 128 (flipping the sign bit) to make it unsigned, and 128 times
+ * the sum of b is subtracted afterwards.
+ */
+__attribute__((target("avxvnni")))
+int64_t
+dotProductInt8Vnni(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t VSZ = 32;
+    const size_t vectorized = sz - (sz % VSZ);
+    const __m256i bias = _mm256_set1_epi8(int8_t(0x80));
+    const __m256i ones = _mm256_set1_epi8(1);
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorized) {
+        const size_t end = std::min(vectorized, i + VNNI_CHUNK_SIZE);
+        __m256i acc = _mm256_setzero_si256();
+        __m256i acc_b = _mm256_setzero_si256();
+        for (; i < end; i += VSZ) {
+            __m256i va = load(a + i);
+            __m256i vb = load(b + i);
+            acc = _mm256_dpbusd_avx_epi32(acc, _mm256_xor_si256(va, bias), vb);
+            acc_b = _mm256_dpbusd_avx_epi32(acc_b, ones, vb);
+        }
+        sum += sumLanes(acc) - 128 * sumLanes(acc_b);
+    }
+    for (; i < sz; i++) {
+        sum += int32_t(a[i]) * int32_t(b[i]);
+    }
+    return sum;
+}
+
+/*
+ * The absolute difference d = |a - b| fits in an unsigned byte, but not in
+ * the signed operand of vpdpbusd. d * d is calculated as 2 * d * (d >> 1) + d * (d & 1).
+ */
+__attribute__((target("avxvnni")))
+double
+squaredEuclideanDistanceInt8Vnni(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t VSZ = 32;
+    const size_t vectorized = sz - (sz % VSZ);
+    const __m256i low7 = _mm256_set1_epi8(0x7f);
+    const __m256i ones = _mm256_set1_epi8(1);
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorized) {
+        const size_t end = std::min(vectorized, i + VNNI_CHUNK_SIZE);
+        __m256i acc_high = _mm256_setzero_si256();
+        __m256i acc_low = _mm256_setzero_si256();
+        for (; i < end; i += VSZ) {
+            __m256i va = load(a + i);
+            __m256i vb = load(b + i);
+            __m256i d = _mm256_sub_epi8(_mm256_max_epi8(va, vb), _mm256_min_epi8(va, vb));
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(d, 1), low7);
+            __m256i low = _mm256_and_si256(d, ones);
+            acc_high = _mm256_dpbusd_avx_epi32(acc_high, d, high);
+            acc_low = _mm256_dpbusd_avx_epi32(acc_low, d, low);
+        }
+        sum += 2 * sumLanes(acc_high) + sumLanes(acc_low);
+    }
+    for (; i < sz; i++) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        sum += d * d;
+    }
+    return sum;
+}
+
+}
+
+double
+Avx2Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return helper::dotProductBFloat16<32, 4>(a, b, sz);
+}
+
 size_t
 Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -25,6 +122,44 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return helper::squaredEuclideanDistanceBFloat16<32, 4>(a, b, sz);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const int8_t * x, const int8_t * y, size_t n) {
+        return helper::squaredEuclideanDistance(x, y, n);
+    });
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const float * x, const float * y, size_t n) {
+        return avx::euclideanDistanceSelectAlignment<float, 32>(x, y, n);
+    });
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const double * x, const double * y, size_t n) {
+        return avx::euclideanDistanceSelectAlignment<double, 32>(x, y, n);
+    });
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const BFloat16 * x, const BFloat16 * y, size_t n) {
+        return helper::squaredEuclideanDistanceBFloat16<32, 4>(x, y, n);
+    });
+}
+
+size_t
+Avx2Accelrator::binaryHammingDistance(const void * a, const void * b, size_t bytes) const {
+    return helper::binaryHammingDistance(a, b, bytes);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
@@ -35,4 +170,21 @@ Avx2Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bo
     helper::orChunks<32u, 2u>(offset, src, dest);
 }
 
+int64_t
+Avx2VnniAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const {
+    return dotProductInt8Vnni(a, b, sz);
+}
+
+double
+Avx2VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return squaredEuclideanDistanceInt8Vnni(a, b, sz);
+}
+
+void
+Avx2VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const int8_t * x, const int8_t * y, size_t n) {
+        return squaredEuclideanDistanceInt8Vnni(x, y, n);
+    });
+}
+
 }
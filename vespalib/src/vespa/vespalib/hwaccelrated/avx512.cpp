@@ -2,9 +2,101 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
+#include <algorithm>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+// Number of int8 elements accumulated in the 32 bit lanes before they are folded into a 64 bit sum.
+constexpr size_t VNNI_CHUNK_SIZE = 0x10000;
+
+inline __m512i
+load(const int8_t * p) {
+    return _mm512_loadu_si512(p);
+}
+
+inline int64_t
+sumLanes(__m512i acc) {
+    int32_t lanes[sizeof(__m512i)/sizeof(int32_t)];
+    _mm512_storeu_si512(lanes, acc);
+    int64_t sum(0);
+    for (int32_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+/*
+ * vpdpbusd multiplies unsigned bytes with signed bytes. The a operand is
+ * biased by 128 (flipping the sign bit) to make it unsigned, and 128 times
+ * the sum of b is subtracted afterwards.
+ */
+__attribute__((target("avx512vnni")))
+int64_t
+dotProductInt8Vnni(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t VSZ = 64;
+    const size_t vectorized = sz - (sz % VSZ);
+    const __m512i bias = _mm512_set1_epi8(int8_t(0x80));
+    const __m512i ones = _mm512_set1_epi8(1);
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorized) {
+        const size_t end = std::min(vectorized, i + VNNI_CHUNK_SIZE);
+        __m512i acc = _mm512_setzero_si512();
+        __m512i acc_b = _mm512_setzero_si512();
+        for (; i < end; i += VSZ) {
+            __m512i va = load(a + i);
+            __m512i vb = load(b + i);
+            acc = _mm512_dpbusd_epi32(acc, _mm512_xor_si512(va, bias), vb);
+            acc_b = _mm512_dpbusd_epi32(acc_b, ones, vb);
+        }
+        sum += sumLanes(acc) - 128 * sumLanes(acc_b);
+    }
+    for (; i < sz; i++) {
+        sum += int32_t(a[i]) * int32_t(b[i]);
+    }
+    return sum;
+}
+
+/*
+ * The absolute difference d = |a - b| fits in an unsigned byte, but not in
+ * the signed operand of vpdpbusd. d * d is calculated as 2 * d * (d >> 1) + d * (d & 1).
+ */
+__attribute__((target("avx512vnni")))
+double
+squaredEuclideanDistanceInt8Vnni(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t VSZ = 64;
+    const size_t vectorized = sz - (sz % VSZ);
+    const __m512i low7 = _mm512_set1_epi8(0x7f);
+    const __m512i ones = _mm512_set1_epi8(1);
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorized) {
+        const size_t end = std::min(vectorized, i + VNNI_CHUNK_SIZE);
+        __m512i acc_high = _mm512_setzero_si512();
+        __m512i acc_low = _mm512_setzero_si512();
+        for (; i < end; i += VSZ) {
+            __m512i va = load(a + i);
+            __m512i vb = load(b + i);
+            __m512i d = _mm512_sub_epi8(_mm512_max_epi8(va, vb), _mm512_min_epi8(va, vb));
+            __m512i high = _mm512_and_si512(_mm512_srli_epi16(d, 1), low7);
+            __m512i low = _mm512_and_si512(d, ones);
+            acc_high = _mm512_dpbusd_epi32(acc_high, d, high);
+            acc_low = _mm512_dpbusd_epi32(acc_low, d, low);
+        }
+        sum += 2 * sumLanes(acc_high) + sumLanes(acc_low);
+    }
+    for (; i < sz; i++) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        sum += d * d;
+    }
+    return sum;
+}
+
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,6 +109,12 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+double
+Avx512Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return helper::dotProductBFloat16<64, 4>(a, b, sz);
+}
+
 size_t
 Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -37,6 +135,44 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+double
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return helper::squaredEuclideanDistanceBFloat16<64, 4>(a, b, sz);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const int8_t * x, const int8_t * y, size_t n) {
+        return helper::squaredEuclideanDistance(x, y, n);
+    });
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const float * x, const float * y, size_t n) {
+        return avx::euclideanDistanceSelectAlignment<float, 64>(x, y, n);
+    });
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const double * x, const double * y, size_t n) {
+        return avx::euclideanDistanceSelectAlignment<double, 64>(x, y, n);
+    });
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const BFloat16 * x, const BFloat16 * y, size_t n) {
+        return helper::squaredEuclideanDistanceBFloat16<64, 4>(x, y, n);
+    });
+}
+
+size_t
+Avx512Accelrator::binaryHammingDistance(const void * a, const void * b, size_t bytes) const {
+    return helper::binaryHammingDistance(a, b, bytes);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
@@ -47,4 +183,21 @@ Avx512Accelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<64, 1>(offset, src, dest);
 }
 
+int64_t
+Avx512VnniAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const {
+    return dotProductInt8Vnni(a, b, sz);
+}
+
+double
+Avx512VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return squaredEuclideanDistanceInt8Vnni(a, b, sz);
+}
+
+void
+Avx512VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const int8_t * x, const int8_t * y, size_t n) {
+        return squaredEuclideanDistanceInt8Vnni(x, y, n);
+    });
+}
+
 }
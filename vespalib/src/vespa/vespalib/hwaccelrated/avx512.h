@@ -14,12 +14,34 @@ class Avx512Accelrator : public Avx2Accelrator
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    double dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+    void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const override;
+    void squaredEuclideanDistance(const float * a, const float * const * b, size_t sz, size_t num_b, double * result) const override;
+    void squaredEuclideanDistance(const double * a, const double * const * b, size_t sz, size_t num_b, double * result) const override;
+    void squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t sz, size_t num_b, double * result) const override;
+    size_t binaryHammingDistance(const void * a, const void * b, size_t bytes) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
 
+/**
+ * Avx-512 implementation, used when the cpu supports AVX512-VNNI.
+ * Computes int8 dot products and distances with the vpdpbusd instruction,
+ * multiplying 4 byte pairs per 32 bit lane.
+ */
+class Avx512VnniAccelrator : public Avx512Accelrator
+{
+public:
+    using Avx512Accelrator::dotProduct;
+    using Avx512Accelrator::squaredEuclideanDistance;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
+    void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const override;
+};
+
 }
@@ -121,6 +121,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 8>(a, b, sz);
 }
 
+double
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return helper::dotProductBFloat16<16, 4>(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -172,6 +178,44 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return helper::squaredEuclideanDistanceBFloat16<16, 4>(a, b, sz);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const int8_t * x, const int8_t * y, size_t n) {
+        return helper::squaredEuclideanDistance(x, y, n);
+    });
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const float * x, const float * y, size_t n) {
+        return squaredEuclideanDistanceT<float, 2>(x, y, n);
+    });
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const double * x, const double * y, size_t n) {
+        return squaredEuclideanDistanceT<double, 2>(x, y, n);
+    });
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t sz, size_t num_b, double * result) const {
+    helper::squaredEuclideanDistanceBatch(a, b, sz, num_b, result, [](const BFloat16 * x, const BFloat16 * y, size_t n) {
+        return helper::squaredEuclideanDistanceBFloat16<16, 4>(x, y, n);
+    });
+}
+
+size_t
+GenericAccelrator::binaryHammingDistance(const void * a, const void * b, size_t bytes) const {
+    return helper::binaryHammingDistance(a, b, bytes);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
@@ -182,4 +226,34 @@ GenericAccelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<16,4>(offset, src, dest);
 }
 
+void
+GenericAccelrator::orInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
+void
+GenericAccelrator::orInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
+void
+GenericAccelrator::orInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
+void
+GenericAccelrator::orInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
+void
+GenericAccelrator::orInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
+void
+GenericAccelrator::orInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const {
+    helper::orInRange(a, sz, low, high, dest);
+}
+
 }
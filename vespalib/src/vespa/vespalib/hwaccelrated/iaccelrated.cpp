@@ -6,7 +6,9 @@
 #include "avx2.h"
 #include "avx512.h"
 #endif
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/memory.h>
+#include <vespa/vespalib/util/optimized.h>
 #include <cstdio>
 #include <vector>
 
@@ -21,9 +23,15 @@ IAccelrated::UP create_accelerator() {
 #ifdef __x86_64__
     __builtin_cpu_init();
     if (__builtin_cpu_supports("avx512f")) {
+        if (__builtin_cpu_supports("avx512vnni")) {
+            return std::make_unique<Avx512VnniAccelrator>();
+        }
         return std::make_unique<Avx512Accelrator>();
     }
     if (__builtin_cpu_supports("avx2")) {
+        if (__builtin_cpu_supports("avxvnni")) {
+            return std::make_unique<Avx2VnniAccelrator>();
+        }
         return std::make_unique<Avx2Accelrator>();
     }
 #endif
@@ -39,7 +47,7 @@ std::vector<T> createAndFill(size_t sz) {
     return v;
 }
 
-template<typename T>
+template<typename T, typename SumT = T>
 void
 verifyDotproduct(const IAccelrated & accel)
 {
@@ -48,11 +56,11 @@ verifyDotproduct(const IAccelrated & accel)
     std::vector<T> a = createAndFill<T>(testLength);
     std::vector<T> b = createAndFill<T>(testLength);
     for (size_t j(0); j < 0x20; j++) {
-        T sum(0);
+        SumT sum(0);
         for (size_t i(j); i < testLength; i++) {
-            sum += a[i]*b[i];
+            sum += SumT(a[i])*SumT(b[i]);
         }
-        T hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        SumT hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
         if (sum != hwComputedSum) {
             fprintf(stderr, "Accelrator is not computing dotproduct correctly.\n");
             LOG_ABORT("should not be reached");
@@ -60,7 +68,7 @@ verifyDotproduct(const IAccelrated & accel)
     }
 }
 
-template<typename T>
+template<typename T, typename SumT = T>
 void
 verifyEuclideanDistance(const IAccelrated & accel) {
     const size_t testLength(255);
@@ -68,11 +76,12 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     std::vector<T> a = createAndFill<T>(testLength);
     std::vector<T> b = createAndFill<T>(testLength);
     for (size_t j(0); j < 0x20; j++) {
-        T sum(0);
+        SumT sum(0);
         for (size_t i(j); i < testLength; i++) {
-            sum += (a[i] - b[i]) * (a[i] - b[i]);
+            SumT d = SumT(a[i]) - SumT(b[i]);
+            sum += d * d;
         }
-        T hwComputedSum(accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j));
+        SumT hwComputedSum(accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j));
         if (sum != hwComputedSum) {
             fprintf(stderr, "Accelrator is not computing euclidean distance correctly.\n");
             LOG_ABORT("should not be reached");
@@ -98,6 +107,32 @@ verifyPopulationCount(const IAccelrated & accel)
     }
 }
 
+void
+verifyBinaryHammingDistance(const IAccelrated & accel)
+{
+    const uint64_t words[7] = {0x123456789abcdef0L,  // 32
+                               0x0000000000000000L,  // 0
+                               0x8000000000000000L,  // 1
+                               0xdeadbeefbeefdeadUL, // 48
+                               0x5555555555555555L,  // 32
+                               0x00000000000000001,  // 1
+                               0xffffffffffffffff};  // 64
+    const uint64_t zeros[7] = {0, 0, 0, 0, 0, 0, 0};
+    const auto * bytes = reinterpret_cast<const char *>(words);
+    const auto * zero_bytes = reinterpret_cast<const char *>(zeros);
+    for (size_t offset(0); offset < 8; offset++) {
+        size_t expected(0);
+        for (size_t i(offset); i < sizeof(words); i++) {
+            expected += Optimized::popCount(static_cast<unsigned int>(static_cast<uint8_t>(bytes[i])));
+        }
+        size_t hwComputed = accel.binaryHammingDistance(bytes + offset, zero_bytes, sizeof(words) - offset);
+        if (hwComputed != expected) {
+            fprintf(stderr, "Accelrator is not computing binaryHammingDistance correctly.Expected %zu, computed %zu\n", expected, hwComputed);
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 void
 fill(std::vector<uint64_t> & v, size_t n) {
     v.reserve(n);
@@ -220,9 +255,14 @@ private:
         verifyDotproduct<double>(accelrated);
         verifyDotproduct<int32_t>(accelrated);
         verifyDotproduct<int64_t>(accelrated);
+        verifyDotproduct<int8_t, int64_t>(accelrated);
+        verifyDotproduct<BFloat16, double>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyEuclideanDistance<int8_t, double>(accelrated);
+        verifyEuclideanDistance<BFloat16, double>(accelrated);
         verifyPopulationCount(accelrated);
+        verifyBinaryHammingDistance(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
     }
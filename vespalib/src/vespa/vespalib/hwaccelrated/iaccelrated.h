@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 
+namespace vespalib { class BFloat16; }
+
 namespace vespalib::hwaccelrated {
 
 /**
@@ -23,6 +25,7 @@ public:
     virtual int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual double dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
@@ -31,11 +34,27 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
+    // Squared euclidean distance between a and each of the num_b vectors in b, all with sz elements
+    virtual void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t sz, size_t num_b, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const float * a, const float * const * b, size_t sz, size_t num_b, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const double * a, const double * const * b, size_t sz, size_t num_b, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t sz, size_t num_b, double * result) const = 0;
+    // Number of bits that differ between a and b, both with the given number of bytes
+    virtual size_t binaryHammingDistance(const void * a, const void * b, size_t bytes) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
     virtual void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
 
+    // Set bit i (bit i%64 of dest[i/64]) for each i < sz where low <= a[i] <= high, other bits are kept
+    virtual void orInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const = 0;
+    virtual void orInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const = 0;
+    virtual void orInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const = 0;
+    virtual void orInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const = 0;
+    virtual void orInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const = 0;
+    virtual void orInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const = 0;
+
     static const IAccelrated & getAccelerator() __attribute__((noinline));
 };
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/optimized.h>
 #include <cstring>
 
@@ -102,5 +103,185 @@ squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) {
     return sum;
 }
 
+/**
+ * Loads VLEN/sizeof(float) bfloat16 values and converts them to float.
+ * A bfloat16 value is the upper 16 bits of the corresponding float.
+ */
+template <typename V, size_t VLEN>
+V loadBFloat16(const BFloat16 * p) {
+    constexpr size_t VSZ = VLEN/sizeof(float);
+    uint16_t bits[VSZ];
+    uint32_t wide[VSZ];
+    memcpy(bits, p, sizeof(bits));
+    for (size_t k(0); k < VSZ; k++) {
+        wide[k] = uint32_t(bits[k]) << 16;
+    }
+    V result;
+    memcpy(&result, wide, sizeof(result));
+    return result;
+}
+
+/**
+ * Converts the VLEN/sizeof(float) floats in v to the two double vectors lo and hi.
+ */
+template <typename VD, typename V, size_t VLEN>
+void convertToDouble(V v, VD & lo, VD & hi) {
+    typedef float VH __attribute__ ((vector_size (VLEN/2)));
+    VH half;
+    memcpy(&half, &v, sizeof(half));
+    lo = __builtin_convertvector(half, VD);
+    memcpy(&half, reinterpret_cast<const char *>(&v) + sizeof(half), sizeof(half));
+    hi = __builtin_convertvector(half, VD);
+}
+
+/**
+ * The product of two bfloat16 values is exact as a float,
+ * so only the accumulation needs to be done in double.
+ */
+template <size_t VLEN, size_t VectorsPerChunk>
+double dotProductBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz) __attribute__((noinline));
+template <size_t VLEN, size_t VectorsPerChunk>
+double dotProductBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz)
+{
+    typedef float V __attribute__ ((vector_size (VLEN)));
+    typedef double VD __attribute__ ((vector_size (VLEN)));
+    constexpr size_t VSZ = VLEN/sizeof(float);
+    constexpr size_t ChunkSize = VSZ*VectorsPerChunk;
+    VD partial[2*VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    size_t i(0);
+    for (; i + ChunkSize <= sz; i += ChunkSize) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            VD lo, hi;
+            convertToDouble<VD, V, VLEN>(loadBFloat16<V, VLEN>(a + i + j*VSZ) * loadBFloat16<V, VLEN>(b + i + j*VSZ), lo, hi);
+            partial[2*j] += lo;
+            partial[2*j + 1] += hi;
+        }
+    }
+    double sum(0);
+    for (; i < sz; i++) {
+        sum += double(a[i].to_float()) * double(b[i].to_float());
+    }
+    for (size_t j(1); j < 2*VectorsPerChunk; j++) {
+        partial[0] += partial[j];
+    }
+    for (size_t k(0); k < VSZ/2; k++) {
+        sum += partial[0][k];
+    }
+    return sum;
+}
+
+/**
+ * The difference is computed as float, as in the generic tensor code,
+ * and squared and accumulated in double.
+ */
+template <size_t VLEN, size_t VectorsPerChunk>
+double squaredEuclideanDistanceBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz) __attribute__((noinline));
+template <size_t VLEN, size_t VectorsPerChunk>
+double squaredEuclideanDistanceBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz)
+{
+    typedef float V __attribute__ ((vector_size (VLEN)));
+    typedef double VD __attribute__ ((vector_size (VLEN)));
+    constexpr size_t VSZ = VLEN/sizeof(float);
+    constexpr size_t ChunkSize = VSZ*VectorsPerChunk;
+    VD partial[2*VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    size_t i(0);
+    for (; i + ChunkSize <= sz; i += ChunkSize) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            VD lo, hi;
+            convertToDouble<VD, V, VLEN>(loadBFloat16<V, VLEN>(a + i + j*VSZ) - loadBFloat16<V, VLEN>(b + i + j*VSZ), lo, hi);
+            partial[2*j] += lo * lo;
+            partial[2*j + 1] += hi * hi;
+        }
+    }
+    double sum(0);
+    for (; i < sz; i++) {
+        double d = a[i].to_float() - b[i].to_float();
+        sum += d * d;
+    }
+    for (size_t j(1); j < 2*VectorsPerChunk; j++) {
+        partial[0] += partial[j];
+    }
+    for (size_t k(0); k < VSZ/2; k++) {
+        sum += partial[0][k];
+    }
+    return sum;
+}
+
+// Calls the (inlined) kernel for each vector in b, avoiding a virtual call per vector
+template <typename T, typename Kernel>
+void
+squaredEuclideanDistanceBatch(const T * a, const T * const * b, size_t sz, size_t num_b, double * result, Kernel kernel) {
+    for (size_t i(0); i < num_b; i++) {
+        result[i] = kernel(a, b[i], sz);
+    }
+}
+
+inline size_t
+binaryHammingDistance(const void * lhs, const void * rhs, size_t bytes) {
+    const auto * a = static_cast<const uint8_t *>(lhs);
+    const auto * b = static_cast<const uint8_t *>(rhs);
+    uint64_t wa[4];
+    uint64_t wb[4];
+    size_t sum(0);
+    size_t i(0);
+    for (; i + sizeof(wa) <= bytes; i += sizeof(wa)) {
+        memcpy(wa, a + i, sizeof(wa));
+        memcpy(wb, b + i, sizeof(wb));
+        sum += Optimized::popCount(wa[0] ^ wb[0]) +
+               Optimized::popCount(wa[1] ^ wb[1]) +
+               Optimized::popCount(wa[2] ^ wb[2]) +
+               Optimized::popCount(wa[3] ^ wb[3]);
+    }
+    for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+        memcpy(wa, a + i, sizeof(uint64_t));
+        memcpy(wb, b + i, sizeof(uint64_t));
+        sum += Optimized::popCount(wa[0] ^ wb[0]);
+    }
+    for (; i < bytes; i++) {
+        sum += Optimized::popCount(static_cast<unsigned int>(a[i] ^ b[i]));
+    }
+    return sum;
+}
+
+
+/**
+ * Packs 64 bytes, each 0 or 1, into a word with bit i taken from byte i.
+ */
+inline uint64_t
+packBits(const uint8_t * bytes) {
+    uint64_t word(0);
+    for (size_t k(0); k < 8; k++) {
+        uint64_t chunk;
+        memcpy(&chunk, bytes + k*8, sizeof(chunk));
+        // moves the lowest bit of byte n to bit 56 + n
+        word |= ((chunk * 0x0102040810204080ul) >> 56) << (k*8);
+    }
+    return word;
+}
+
+template <typename T>
+void
+orInRange(const T * a, size_t sz, T low, T high, uint64_t * dest) {
+    constexpr size_t WordBits = 64;
+    uint8_t hits[WordBits];
+    size_t i(0);
+    for (; i + WordBits <= sz; i += WordBits) {
+        // branch free so that the compare is vectorized
+        for (size_t j(0); j < WordBits; j++) {
+            hits[j] = (low <= a[i + j]) & (a[i + j] <= high);
+        }
+        dest[i/WordBits] |= packBits(hits);
+    }
+    if (i < sz) {
+        uint64_t word(0);
+        for (size_t j(0); i + j < sz; j++) {
+            word |= uint64_t((low <= a[i + j]) & (a[i + j] <= high)) << j;
+        }
+        dest[i/WordBits] |= word;
+    }
+}
+
 }
 }
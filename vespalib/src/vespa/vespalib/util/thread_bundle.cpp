@@ -1,7 +1,28 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "thread_bundle.h"
+#include <cassert>
 
 namespace vespalib {
 
+namespace {
+
+struct TrivialThreadBundle final : ThreadBundle {
+    size_t size() const override { return 1; }
+    void run(const std::vector<Runnable*> &targets) override {
+        assert(targets.size() <= 1);
+        for (auto *target : targets) {
+            target->run();
+        }
+    }
+};
+
+}
+
+ThreadBundle &
+ThreadBundle::trivial() {
+    static TrivialThreadBundle trivial_thread_bundle;
+    return trivial_thread_bundle;
+}
+
 } // namespace vespalib
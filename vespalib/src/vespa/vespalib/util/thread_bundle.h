@@ -33,6 +33,13 @@ struct ThreadBundle {
      * Empty virtual destructor to enable subclassing.
      **/
     virtual ~ThreadBundle() {}
+
+    /**
+     * A thread bundle of size 1 that performs its single target
+     * directly in the calling thread. Useful for code paths that
+     * need a thread bundle but have no threads to spare.
+     **/
+    static ThreadBundle &trivial();
 };
 
 } // namespace vespalib